@@ -0,0 +1,93 @@
+// Startup cost of the solver apis, for every backend whose shared library is
+// found at runtime (the others are reported as skipped):
+//
+//   - <solver>/cold : the library searched for and opened, as on the first
+//     api construction of a process;
+//   - <solver>/cached : the library shared through solver_library_registry,
+//     as on the following ones.
+//
+// Both include the resolution of the functions of the api. The
+// benchmark_api_loading_lazy target, built with MIPPP_LAZY_SOLVER_SYMBOLS,
+// defers it to their first call.
+
+#include <benchmark/benchmark.h>
+
+#include <exception>
+#include <print>
+#include <string>
+
+#include "mippp/detail/solver_library.hpp"
+#include "mippp/solvers/cbc/all.hpp"
+#include "mippp/solvers/clp/all.hpp"
+#include "mippp/solvers/copt/all.hpp"
+#include "mippp/solvers/cplex/all.hpp"
+#include "mippp/solvers/glpk/all.hpp"
+#include "mippp/solvers/gurobi/all.hpp"
+#include "mippp/solvers/highs/all.hpp"
+#include "mippp/solvers/mosek/all.hpp"
+#include "mippp/solvers/scip/all.hpp"
+#include "mippp/solvers/soplex/all.hpp"
+#include "mippp/solvers/xpress/all.hpp"
+
+using namespace mippp;
+
+namespace {
+
+template <typename Api>
+void cold_api(benchmark::State & state) {
+    auto & registry = detail::solver_library_registry::instance();
+    for(auto _ : state) {
+        state.PauseTiming();
+        registry.clear();
+        state.ResumeTiming();
+        const Api api;
+        benchmark::DoNotOptimize(&api);
+    }
+}
+
+template <typename Api>
+void cached_api(benchmark::State & state) {
+    const Api warm;  // keeps the library open, as a living api would
+    for(auto _ : state) {
+        const Api api;
+        benchmark::DoNotOptimize(&api);
+    }
+}
+
+template <typename Api>
+void register_api_benchmarks(const char * solver_key, const char * name) {
+    try {
+        const Api api;
+    } catch(const std::exception & e) {
+        std::println(stderr, "{} skipped: {}", solver_key, e.what());
+        return;
+    }
+    const std::string prefix(name);
+    benchmark::RegisterBenchmark(prefix + "/cold", cold_api<Api>)
+        ->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark(prefix + "/cached", cached_api<Api>)
+        ->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    register_api_benchmarks<cbc_api>("CBC", "cbc");
+    register_api_benchmarks<clp_api>("CLP", "clp");
+    register_api_benchmarks<copt_api>("COPT", "copt");
+    register_api_benchmarks<cplex_api>("CPLEX", "cplex");
+    register_api_benchmarks<glpk_api>("GLPK", "glpk");
+    register_api_benchmarks<gurobi_api>("GUROBI", "gurobi");
+    register_api_benchmarks<highs_api>("HIGHS", "highs");
+    register_api_benchmarks<mosek_api>("MOSEK", "mosek");
+    register_api_benchmarks<scip_api>("SCIP", "scip");
+    register_api_benchmarks<soplex_api>("SOPLEX", "soplex");
+    register_api_benchmarks<xpress_api>("XPRESS", "xpress");
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
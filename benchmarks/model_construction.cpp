@@ -0,0 +1,60 @@
+// Model construction benchmarks, run against every backend whose shared
+// library is found at runtime (the others are reported as skipped). Unlike
+// mippp_nqueens, which only times variable-heavy short-row models, these
+// cover dense rows, long xsum chains, coalescing-heavy rows and column
+// generation loops.
+//
+// Results are machine-readable with the usual Google Benchmark flags, e.g.
+//
+//     benchmark_model_construction --benchmark_filter=highs_lp/ \
+//         --benchmark_out=bench.json --benchmark_out_format=json
+
+#include <benchmark/benchmark.h>
+
+#include "mippp/solvers/cbc/all.hpp"
+#include "mippp/solvers/clp/all.hpp"
+#include "mippp/solvers/copt/all.hpp"
+#include "mippp/solvers/cplex/all.hpp"
+#include "mippp/solvers/glpk/all.hpp"
+#include "mippp/solvers/gurobi/all.hpp"
+#include "mippp/solvers/highs/all.hpp"
+#include "mippp/solvers/mosek/all.hpp"
+#include "mippp/solvers/scip/all.hpp"
+#include "mippp/solvers/soplex/all.hpp"
+#include "mippp/solvers/xpress/all.hpp"
+
+#include "model_construction.hpp"
+
+using namespace mippp;
+using namespace mippp::bench;
+
+int main(int argc, char ** argv) {
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    register_model_benchmarks<cbc_milp, cbc_api>("CBC", "cbc_milp");
+    register_model_benchmarks<clp_lp, clp_api>("CLP", "clp_lp");
+    register_model_benchmarks<copt_lp, copt_api>("COPT", "copt_lp");
+    register_model_benchmarks<copt_milp, copt_api>("COPT", "copt_milp");
+    register_model_benchmarks<cplex_lp, cplex_api>("CPLEX", "cplex_lp");
+    register_model_benchmarks<cplex_milp, cplex_api>("CPLEX", "cplex_milp");
+    register_model_benchmarks<glpk_lp, glpk_api>("GLPK", "glpk_lp");
+    register_model_benchmarks<glpk_milp, glpk_api>("GLPK", "glpk_milp");
+    register_model_benchmarks<gurobi_lp, gurobi_api>("GUROBI", "gurobi_lp");
+    register_model_benchmarks<gurobi_milp, gurobi_api>("GUROBI",
+                                                       "gurobi_milp");
+    register_model_benchmarks<highs_lp, highs_api>("HIGHS", "highs_lp");
+    register_model_benchmarks<highs_milp, highs_api>("HIGHS", "highs_milp");
+    register_model_benchmarks<highs_qp, highs_api>("HIGHS", "highs_qp");
+    register_model_benchmarks<mosek_lp, mosek_api>("MOSEK", "mosek_lp");
+    register_model_benchmarks<mosek_milp, mosek_api>("MOSEK", "mosek_milp");
+    register_model_benchmarks<scip_milp, scip_api>("SCIP", "scip_milp");
+    register_model_benchmarks<soplex_lp, soplex_api>("SOPLEX", "soplex_lp");
+    register_model_benchmarks<xpress_lp, xpress_api>("XPRESS", "xpress_lp");
+    register_model_benchmarks<xpress_milp, xpress_api>("XPRESS",
+                                                       "xpress_milp");
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
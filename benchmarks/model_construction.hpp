@@ -0,0 +1,360 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <print>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mippp/model_concepts.hpp"
+
+namespace mippp::bench {
+
+using namespace mippp::operators;
+
+// The api of a backend is loaded once per process: its construction cost is
+// the one of dlopen-ing the solver library, not the one of the modeling layer.
+template <typename Api>
+const Api * shared_api(const char * solver_key) {
+    static std::optional<const Api> api = [solver_key]() {
+        std::optional<const Api> loaded;
+        try {
+            loaded.emplace();
+        } catch(const std::exception & e) {
+            std::println(stderr, "{} skipped: {}", solver_key, e.what());
+        }
+        return loaded;
+    }();
+    return api.has_value() ? &api.value() : nullptr;
+}
+
+// Model construction is timed with the native model already created, so that
+// the measures reflect the filling of the model, as in mippp_nqueens. The
+// model of an iteration is destroyed by the call of the next one, with the
+// timing paused, so that its teardown is not measured either.
+template <typename Model, typename Api>
+Model & new_model(std::optional<Model> & model_slot, const Api & api) {
+    model_slot.reset();
+    return model_slot.emplace(api);
+}
+
+// The items/s counter reports the number of variables or nonzeros per second.
+inline void report_entries(benchmark::State & state,
+                           std::int64_t num_entries) {
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            num_entries);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////// Variables //////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// range(0) : number of variables
+template <typename Model, typename Api>
+void add_variables(benchmark::State & state, const Api & api) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::optional<Model> model_slot;
+    for(auto _ : state) {
+        state.PauseTiming();
+        Model & model = new_model(model_slot, api);
+        state.ResumeTiming();
+        auto X = model.add_variables(n);
+        benchmark::DoNotOptimize(X);
+    }
+    report_entries(state, state.range(0));
+}
+
+// range(0) : number of variables
+template <typename Model, typename Api>
+void set_objective(benchmark::State & state, const Api & api) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::optional<Model> model_slot;
+    for(auto _ : state) {
+        state.PauseTiming();
+        Model & model = new_model(model_slot, api);
+        auto X = model.add_variables(n);
+        state.ResumeTiming();
+        model.set_objective(xsum(std::views::iota(std::size_t{0}, n),
+                                 [&](std::size_t i) {
+                                     return static_cast<double>(i % 7 + 1) *
+                                            X[i];
+                                 }));
+    }
+    report_entries(state, state.range(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////// Constraints /////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+enum class insertion { one_at_a_time, bulk };
+
+// Dense rows : range(0) rows each referencing all of the range(1) variables.
+template <typename Model, insertion I, bool distinct, typename Api>
+void dense_rows(benchmark::State & state, const Api & api) {
+    const auto m = static_cast<int>(state.range(0));
+    const auto n = static_cast<int>(state.range(1));
+    std::optional<Model> model_slot;
+    for(auto _ : state) {
+        state.PauseTiming();
+        Model & model = new_model(model_slot, api);
+        auto X = model.add_variables(static_cast<std::size_t>(n));
+        state.ResumeTiming();
+        auto row = [&X, n](int i) {
+            return xsum(std::views::iota(0, n), [&X, i](int j) {
+                       return static_cast<double>((i + j) % 5 + 1) * X[j];
+                   }) <= static_cast<double>(n);
+        };
+        if constexpr(I == insertion::bulk) {
+            if constexpr(distinct)
+                model.add_constraints(distinct_variables,
+                                      std::views::iota(0, m), row);
+            else
+                model.add_constraints(std::views::iota(0, m), row);
+        } else {
+            for(int i = 0; i < m; ++i) {
+                if constexpr(distinct)
+                    model.add_constraint(distinct_variables, row(i));
+                else
+                    model.add_constraint(row(i));
+            }
+        }
+    }
+    report_entries(state, state.range(0) * state.range(1));
+}
+
+// Long xsum chains : a single row made of range(0) nested sums of range(1)
+// terms, i.e. a lazily joined range of range(0) * range(1) terms.
+template <typename Model, typename Api>
+void long_xsum_chain(benchmark::State & state, const Api & api) {
+    const auto blocks = static_cast<int>(state.range(0));
+    const auto block_size = static_cast<int>(state.range(1));
+    std::optional<Model> model_slot;
+    for(auto _ : state) {
+        state.PauseTiming();
+        Model & model = new_model(model_slot, api);
+        auto X = model.add_variables(
+            static_cast<std::size_t>(blocks * block_size));
+        state.ResumeTiming();
+        model.add_constraint(
+            xsum(std::views::iota(0, blocks),
+                 [&X, block_size](int b) {
+                     return xsum(std::views::iota(0, block_size),
+                                 [&X, b, block_size](int j) {
+                                     return X[b * block_size + j];
+                                 });
+                 }) <= 1.0);
+    }
+    report_entries(state, state.range(0) * state.range(1));
+}
+
+// Coalescing-heavy rows : range(0) rows of range(1) terms over only range(2)
+// distinct variables, so that every variable occurs range(1) / range(2) times
+// per row and has to be merged by _register_coalescing_entries.
+template <typename Model, insertion I, typename Api>
+void coalescing_rows(benchmark::State & state, const Api & api) {
+    const auto m = static_cast<int>(state.range(0));
+    const auto k = static_cast<int>(state.range(1));
+    const auto n = static_cast<int>(state.range(2));
+    std::optional<Model> model_slot;
+    for(auto _ : state) {
+        state.PauseTiming();
+        Model & model = new_model(model_slot, api);
+        auto X = model.add_variables(static_cast<std::size_t>(n));
+        state.ResumeTiming();
+        auto row = [&X, k, n](int i) {
+            return xsum(std::views::iota(0, k), [&X, i, n](int j) {
+                       return X[(i + j * 7) % n];
+                   }) >= 1.0;
+        };
+        if constexpr(I == insertion::bulk) {
+            model.add_constraints(std::views::iota(0, m), row);
+        } else {
+            for(int i = 0; i < m; ++i) model.add_constraint(row(i));
+        }
+    }
+    report_entries(state, state.range(0) * state.range(1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////////////////// Column generation //////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Column generation loop : range(0) covering rows, then range(1) rounds each
+// adding range(2) columns of 8 entries and, if supported, removing the columns
+// of the previous round as a column manager purging its master would do.
+template <typename Model, typename Api>
+    requires has_add_column<Model>
+void column_generation(benchmark::State & state, const Api & api) {
+    const auto m = static_cast<int>(state.range(0));
+    const auto rounds = static_cast<int>(state.range(1));
+    const auto columns_per_round = static_cast<int>(state.range(2));
+    constexpr int column_size = 8;
+    using constraint = model_constraint_t<Model>;
+    using variable = model_variable_t<Model>;
+    std::vector<std::pair<constraint, double>> column;
+    std::vector<variable> previous_round, current_round;
+    std::vector<constraint> C;
+    std::optional<Model> model_slot;
+    for(auto _ : state) {
+        state.PauseTiming();
+        Model & model = new_model(model_slot, api);
+        auto Y = model.add_variables(static_cast<std::size_t>(m));
+        auto rows = model.add_constraints(std::views::iota(0, m),
+                                          [&Y](int i) { return Y[i] >= 1.0; });
+        C.assign(rows.begin(), rows.end());
+        previous_round.clear();
+        state.ResumeTiming();
+        for(int r = 0; r < rounds; ++r) {
+            current_round.clear();
+            for(int c = 0; c < columns_per_round; ++c) {
+                column.clear();
+                for(int e = 0; e < column_size; ++e)
+                    column.emplace_back(
+                        C[static_cast<std::size_t>(
+                            (r * 31 + c * 17 + e * 13) % m)],
+                        1.0);
+                current_round.emplace_back(model.add_column(
+                    column, {.obj_coef = 1.0, .lower_bound = 0.0}));
+            }
+            if constexpr(has_remove_variable<Model>) {
+                model.remove_variables(previous_round);
+            }
+            std::swap(previous_round, current_round);
+        }
+    }
+    report_entries(state, state.range(1) * state.range(2) * column_size);
+}
+
+// range(0) : number of variables to remove out of 2 * range(0)
+template <typename Model, typename Api>
+    requires has_remove_variable<Model>
+void remove_variables(benchmark::State & state, const Api & api) {
+    const auto n = static_cast<int>(state.range(0));
+    std::vector<model_variable_t<Model>> removed;
+    std::optional<Model> model_slot;
+    for(auto _ : state) {
+        state.PauseTiming();
+        Model & model = new_model(model_slot, api);
+        auto X = model.add_variables(static_cast<std::size_t>(2 * n));
+        model.add_constraints(std::views::iota(0, n), [&X](int i) {
+            return X[2 * i] + X[2 * i + 1] <= 1.0;
+        });
+        removed.clear();
+        for(int i = 0; i < n; ++i) removed.emplace_back(X[2 * i]);
+        state.ResumeTiming();
+        model.remove_variables(removed);
+    }
+    report_entries(state, state.range(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////// Solution ///////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// range(0) : number of variables ; times get_solution() followed by the few
+// reads a re-solve loop typically does.
+template <typename Model, typename Api>
+void get_solution(benchmark::State & state, const Api & api) {
+    const auto n = static_cast<int>(state.range(0));
+    Model model(api);
+    auto X = model.add_variables(
+        static_cast<std::size_t>(n),
+        {.obj_coef = 1.0, .lower_bound = 0.0, .upper_bound = 1.0});
+    model.set_maximization();
+    model.solve();
+    for(auto _ : state) {
+        auto solution = model.get_solution();
+        double sum = 0.0;
+        for(int i = 0; i < n; i += std::max(1, n / 8)) sum += solution[X[i]];
+        benchmark::DoNotOptimize(sum);
+    }
+    report_entries(state, state.range(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//////////////////////////////// Registration /////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename Api, typename F>
+benchmark::internal::Benchmark * register_benchmark(const std::string & name,
+                                                    const Api & api, F && f) {
+    return benchmark::RegisterBenchmark(
+               name.c_str(),
+               [&api, f](benchmark::State & state) { f(state, api); })
+        ->Unit(benchmark::kMillisecond);
+}
+
+// Registers the model construction benchmarks of Model under
+// "<model_name>/<benchmark>/<args>", so that --benchmark_filter=highs_lp/
+// selects one backend and --benchmark_filter=/dense_rows one shape.
+template <typename Model, typename Api>
+void register_model_benchmarks(const char * solver_key,
+                               const std::string & model_name) {
+    const Api * api = shared_api<Api>(solver_key);
+    if(api == nullptr) return;
+    auto name = [&model_name](const char * benchmark_name) {
+        return model_name + "/" + benchmark_name;
+    };
+
+    register_benchmark(name("add_variables"), *api, add_variables<Model, Api>)
+        ->Arg(10'000)
+        ->Arg(1'000'000);
+    register_benchmark(name("set_objective"), *api, set_objective<Model, Api>)
+        ->Arg(10'000)
+        ->Arg(1'000'000);
+
+    auto dense_args = [](benchmark::internal::Benchmark * b) {
+        b->Args({100, 1'000})->Args({1'000, 1'000});
+    };
+    register_benchmark(name("dense_rows"), *api,
+                       dense_rows<Model, insertion::one_at_a_time, false, Api>)
+        ->Apply(dense_args);
+    register_benchmark(name("dense_rows_distinct"), *api,
+                       dense_rows<Model, insertion::one_at_a_time, true, Api>)
+        ->Apply(dense_args);
+    register_benchmark(name("dense_rows_bulk"), *api,
+                       dense_rows<Model, insertion::bulk, false, Api>)
+        ->Apply(dense_args);
+    register_benchmark(name("dense_rows_bulk_distinct"), *api,
+                       dense_rows<Model, insertion::bulk, true, Api>)
+        ->Apply(dense_args);
+
+    register_benchmark(name("long_xsum_chain"), *api,
+                       long_xsum_chain<Model, Api>)
+        ->Args({1'000, 100})
+        ->Args({100'000, 10});
+
+    auto coalescing_args = [](benchmark::internal::Benchmark * b) {
+        b->Args({1'000, 1'000, 100})->Args({1'000, 64, 1'000'000});
+    };
+    register_benchmark(name("coalescing_rows"), *api,
+                       coalescing_rows<Model, insertion::one_at_a_time, Api>)
+        ->Apply(coalescing_args);
+    register_benchmark(name("coalescing_rows_bulk"), *api,
+                       coalescing_rows<Model, insertion::bulk, Api>)
+        ->Apply(coalescing_args);
+
+    if constexpr(has_add_column<Model>) {
+        register_benchmark(name("column_generation"), *api,
+                           column_generation<Model, Api>)
+            ->Args({1'000, 100, 50});
+    }
+    if constexpr(has_remove_variable<Model>) {
+        register_benchmark(name("remove_variables"), *api,
+                           remove_variables<Model, Api>)
+            ->Arg(10'000)
+            ->Arg(100'000);
+    }
+    register_benchmark(name("get_solution"), *api, get_solution<Model, Api>)
+        ->Arg(10'000)
+        ->Arg(1'000'000)
+        ->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace mippp::bench
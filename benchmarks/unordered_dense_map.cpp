@@ -0,0 +1,190 @@
+// unordered_dense_map benchmarks, against the node-based index it replaced
+// (kept below as node_indexed_map) and std::unordered_map. The key streams
+// mimic column generation : each round prices many candidate seeds, most of
+// which are already known to the column_manager.
+//
+//     benchmark_unordered_dense_map --benchmark_filter=find_hit
+
+#include <benchmark/benchmark.h>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "mippp/container/unordered_dense_map.hpp"
+
+namespace {
+
+// The former unordered_dense_map layout : the dense store indexed by a
+// std::unordered_set of positions, whose hash and equality dereference the
+// store. Only what the benchmarks use.
+template <typename Key, typename Value>
+class node_indexed_map {
+private:
+    using Store = std::vector<std::pair<Key, Value>>;
+
+    // not a plain std::size_t, which could collide with Key
+    struct position {
+        std::size_t value;
+    };
+    struct index_hash {
+        using is_transparent = void;
+        const Store * store;
+        std::size_t operator()(position i) const {
+            return std::hash<Key>{}((*store)[i.value].first);
+        }
+        std::size_t operator()(const Key & k) const {
+            return std::hash<Key>{}(k);
+        }
+    };
+    struct index_equal {
+        using is_transparent = void;
+        const Store * store;
+        bool operator()(position a, position b) const {
+            return (*store)[a.value].first == (*store)[b.value].first;
+        }
+        bool operator()(position a, const Key & k) const {
+            return (*store)[a.value].first == k;
+        }
+        bool operator()(const Key & k, position a) const {
+            return k == (*store)[a.value].first;
+        }
+    };
+
+    Store _store;
+    std::unordered_set<position, index_hash, index_equal> _index;
+
+public:
+    node_indexed_map()
+        : _index(0, index_hash{&_store}, index_equal{&_store}) {}
+
+    void reserve(std::size_t n) {
+        _store.reserve(n);
+        _index.reserve(n);
+    }
+    bool try_emplace(const Key & k, const Value & v) {
+        if(_index.find(k) != _index.end()) return false;
+        _store.emplace_back(k, v);
+        _index.insert(position{_store.size() - 1});
+        return true;
+    }
+    bool contains(const Key & k) const {
+        return _index.find(k) != _index.end();
+    }
+};
+
+template <typename Map>
+bool map_try_emplace(Map & map, std::uint64_t k) {
+    if constexpr(std::same_as<Map, node_indexed_map<std::uint64_t, int>>)
+        return map.try_emplace(k, 0);
+    else
+        return map.try_emplace(k, 0).second;
+}
+
+// n distinct keys, spread like the hashes of column seeds
+std::vector<std::uint64_t> random_keys(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::uint64_t> keys(n);
+    for(auto & k : keys) k = rng();
+    return keys;
+}
+
+using dense_map = mippp::unordered_dense_map<std::uint64_t, int>;
+using node_map = node_indexed_map<std::uint64_t, int>;
+using std_map = std::unordered_map<std::uint64_t, int>;
+
+// range(0) : number of keys
+template <typename Map>
+void insert(benchmark::State & state) {
+    const auto keys = random_keys(static_cast<std::size_t>(state.range(0)), 1);
+    for(auto _ : state) {
+        Map map;
+        for(auto k : keys) map_try_emplace(map, k);
+        benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            state.range(0));
+}
+
+// range(0) : number of keys, all present
+template <typename Map>
+void find_hit(benchmark::State & state) {
+    const auto keys = random_keys(static_cast<std::size_t>(state.range(0)), 1);
+    Map map;
+    for(auto k : keys) map_try_emplace(map, k);
+    for(auto _ : state) {
+        std::size_t found = 0;
+        for(auto k : keys)
+            if(map.contains(k)) ++found;
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            state.range(0));
+}
+
+// range(0) : number of keys, none present
+template <typename Map>
+void find_miss(benchmark::State & state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys(n, 1);
+    const auto absent = random_keys(n, 2);
+    Map map;
+    for(auto k : keys) map_try_emplace(map, k);
+    for(auto _ : state) {
+        std::size_t found = 0;
+        for(auto k : absent)
+            if(map.contains(k)) ++found;
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            state.range(0));
+}
+
+// range(0) : number of known keys ; each round offers as many seeds, 90% of
+// them already known, as column_manager::emplace_columns does
+template <typename Map>
+void pricing_rounds(benchmark::State & state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto known = random_keys(n, 1);
+    const auto fresh = random_keys(n, 3);
+    std::vector<std::uint64_t> seeds(n);
+    std::mt19937_64 rng(4);
+    for(std::size_t i = 0; i < n; ++i)
+        seeds[i] = rng() % 10 == 0 ? fresh[i] : known[rng() % n];
+    for(auto _ : state) {
+        state.PauseTiming();
+        Map map;
+        map.reserve(2 * n);
+        for(auto k : known) map_try_emplace(map, k);
+        state.ResumeTiming();
+        std::size_t inserted = 0;
+        for(auto k : seeds)
+            if(map_try_emplace(map, k)) ++inserted;
+        benchmark::DoNotOptimize(inserted);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            state.range(0));
+}
+
+#define MIPPP_MAP_BENCHMARK(name)                                      \
+    BENCHMARK_TEMPLATE(name, dense_map)->RangeMultiplier(10)->Range(   \
+        1'000, 1'000'000);                                             \
+    BENCHMARK_TEMPLATE(name, node_map)->RangeMultiplier(10)->Range(    \
+        1'000, 1'000'000);                                             \
+    BENCHMARK_TEMPLATE(name, std_map)->RangeMultiplier(10)->Range(1'000, \
+                                                                  1'000'000)
+
+MIPPP_MAP_BENCHMARK(insert);
+MIPPP_MAP_BENCHMARK(find_hit);
+MIPPP_MAP_BENCHMARK(find_miss);
+MIPPP_MAP_BENCHMARK(pricing_rounds);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -15,7 +15,7 @@ class MipppRecipe(ConanFile):
     url = "https://github.com/fhamonic/mippp"
     settings = "os", "compiler", "arch", "build_type"
     package_type = "header-library"
-    exports_sources = "include/*", "cmake/*", "CMakeLists.txt", "test/*", "LICENSE.md"
+    exports_sources = "include/*", "cmake/*", "CMakeLists.txt", "test/*", "benchmarks/*", "LICENSE.md"
     no_copy_source = True
     generators = "CMakeToolchain", "CMakeDeps"
     build_policy = "missing"
@@ -26,6 +26,8 @@ class MipppRecipe(ConanFile):
     def build_requirements(self):
         self.test_requires("gtest/[>=1.10.0 <cci]")
         self.test_requires("melon/1.0.0")
+        if os.environ.get("ENABLE_BENCHMARKS"):
+            self.test_requires("benchmark/[>=1.8.0 <2]")
 
     def generate(self):
         print(
@@ -57,6 +59,8 @@ class MipppRecipe(ConanFile):
             variables["TEST_SOURCE"] = test_source
         if test_filter:
             variables["TEST_FILTER"] = test_filter
+        if os.environ.get("ENABLE_BENCHMARKS"):
+            variables["ENABLE_BENCHMARKS"] = "ON"
         cmake.configure(variables=variables)
         cmake.build()
 
@@ -73,6 +77,8 @@ class MipppRecipe(ConanFile):
     def package_info(self):
         self.cpp_info.bindirs = []
         self.cpp_info.libdirs = []
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs = ["pthread"]
 
     def package_id(self):
         self.info.clear()
\ No newline at end of file
@@ -10,7 +10,7 @@ def find_cpp_files(root_folder):
     cpp_files = []
     for root, _, files in os.walk(root_folder):
         for file in files:
-            if file == "dumb.cpp":
+            if file in ("dumb.cpp", "recording.cpp"):
                 continue
             if file.endswith(".cpp"):
                 cpp_files.append(os.path.join(root, file))
@@ -47,7 +47,11 @@ formated_test_names = [
     ("NamedVariablesTest", "Named variables"),
     ("LpStatusTest", "LP status"),
     ("AddColumnTest", "Add column"),
+    ("ConstraintsBatchTest", "Batched constraints"),
+    ("ModificationsBatchTest", "Batched modifications"),
+    ("ParallelConstraintsTest", "Parallel add_constraints"),
     ("RemoveVariableTest", "Remove variable"),
+    ("PartialSolutionTest", "Partial solution"),
     ("DualSolutionTest", "Dual solution"),
     ("ReducedCostsTest", "Reduced costs"),
     ("CuttingStockTest", "Cutting stock example"),
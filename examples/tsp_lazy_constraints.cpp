@@ -2,7 +2,8 @@
 //
 // Showcases MIP++'s branch-and-cut callback: the candidate-solution callback
 // receives a typed handle exposing the incumbent and add_lazy_constraint, so
-// subtours are cut off on the fly.
+// subtours are cut off on the fly. A cut_pool keeps the subtour cuts already
+// sent, so that those found again from later incumbents are not resent.
 //
 // NOTE: the candidate-solution callback is currently validated on Gurobi,
 // CPLEX and COPT. Set the two aliases below to one of those backends; the
@@ -13,6 +14,7 @@
 #include <vector>
 
 #include "mippp/solvers/gurobi/all.hpp"
+#include "mippp/utility/cut_pool.hpp"
 
 using namespace mippp;
 using namespace mippp::operators;
@@ -61,7 +63,9 @@ int main() {
     });
 
     // Lazily forbid any incumbent that splits into several subtours.
+    cut_pool<milp_type> subtour_cuts;
     model.set_candidate_solution_callback([&](auto & handle) {
+        auto cuts = subtour_cuts.new_batch();
         auto sol = handle.get_solution();
         // successor[i] = the city visited right after i in the incumbent.
         std::vector<int> successor(static_cast<std::size_t>(n), 0);
@@ -81,13 +85,14 @@ int main() {
             }
             if(static_cast<int>(subtour.size()) == n) return;  // single tour
             // Arcs staying inside the subtour must number at most |S| - 1.
-            handle.add_lazy_constraint(
+            cuts.add(
                 xsum(std::views::cartesian_product(subtour, subtour),
                      [&](auto && p) {
                          auto && [i, j] = p;
                          return X(i, j);
                      }) <= static_cast<int>(subtour.size()) - 1);
         }
+        cuts.add_lazy_constraints(handle);
     });
 
     model.solve();
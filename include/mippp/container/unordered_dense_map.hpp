@@ -4,15 +4,16 @@
 //
 // Layout:
 //   std::vector<std::pair<Key, Value>>   -- dense storage, iterate over this
-//   std::unordered_set<Index>        -- indices into the vector; hashing and
-//                                       equality dereference through the
-//                                       vector, so the Key is stored exactly
-//                                       once. Index is a strong wrapper over
-//                                       std::size_t so its transparent
-//                                       overloads never collide with Key --
-//                                       even when Key itself is std::size_t.
+//   std::vector<std::size_t>             -- the hash of each stored entry,
+//                                           so that probing compares keys
+//                                           only on full hash matches, and
+//                                           growing never rehashes a key
+//   detail::flat_hash_index              -- open-addressing (SwissTable)
+//                                           index of positions in the
+//                                           vector; the Key is stored
+//                                           exactly once.
 //
-// Requires C++20 (heterogeneous lookup in unordered containers).
+// Requires C++20.
 //
 // STL compatibility:
 //  The public interface mirrors std::unordered_map for the common operations,
@@ -37,13 +38,14 @@
 #include <functional>
 #include <initializer_list>
 #include <iterator>
-#include <memory>
 #include <stdexcept>
+#include <tuple>
 #include <type_traits>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "mippp/detail/flat_hash_index.hpp"
+
 namespace mippp {
 
 template <typename Key, typename Value, typename Hash = std::hash<Key>,
@@ -62,48 +64,38 @@ class unordered_dense_map {
     using Entry = std::pair<Key, Value>;
     using Store = std::vector<Entry>;
 
-    // Strong type wrapping std::size_t so that transparent overloads below
-    // don't collide if Key==std::size_t
-    struct Index {
-        std::size_t value;
-    };
-
-    struct IndexHash {
-        using is_transparent = void;
-        const Store * store;
-        std::size_t operator()(Index i) const {
-            return Hash{}((*store)[i.value].first);
-        }
-        template <typename K>
-        std::size_t operator()(const K & k) const {
-            return Hash{}(k);
-        }
-    };
-
-    struct IndexEqual {
-        using is_transparent = void;
-        const Store * store;
-        bool operator()(Index a, Index b) const {
-            return KeyEqual{}((*store)[a.value].first, (*store)[b.value].first);
-        }
-        template <typename K>
-        bool operator()(Index a, const K & k) const {
-            return KeyEqual{}((*store)[a.value].first, k);
-        }
-        template <typename K>
-        bool operator()(const K & k, Index a) const {
-            return KeyEqual{}(k, (*store)[a.value].first);
-        }
-    };
+    Store store_;
+    std::vector<std::size_t> hashes_;
+    detail::flat_hash_index index_;
 
-    using IndexSet = std::unordered_set<Index, IndexHash, IndexEqual>;
-
-    // unique_ptr keeps the Store's address stable across moves so the pointers
-    // captured by IndexHash and IndexEqual stays valid
-    std::unique_ptr<Store> store_;
-    IndexSet index_;
+    // index slot of the entry of key k, or npos
+    template <typename K>
+    std::size_t find_slot(const K & k, const std::size_t hash) const {
+        return index_.find(hash, [&](std::size_t i) {
+            return hashes_[i] == hash && KeyEqual{}(store_[i].first, k);
+        });
+    }
+    template <typename K>
+    std::size_t find_slot(const K & k) const {
+        return find_slot(k, hash_of(k));
+    }
+    // position in the store of the entry of key k, or npos
+    template <typename K>
+    std::size_t find_position(const K & k) const {
+        const std::size_t slot = find_slot(k);
+        return slot == detail::flat_hash_index::npos ? slot
+                                                     : index_.position(slot);
+    }
 
 public:
+    // The hash under which the entry of key k is indexed. Callers may compute
+    // it ahead of time, e.g. on other threads, and hand it to the pre-hashed
+    // overloads of contains and try_emplace.
+    template <typename K>
+    static std::size_t hash_of(const K & k) {
+        return detail::flat_hash_index::mix(Hash{}(k));
+    }
+
     using key_type = Key;
     using mapped_type = Value;
     using value_type = Entry;
@@ -118,9 +110,7 @@ public:
     using iterator = typename Store::iterator;
     using const_iterator = typename Store::const_iterator;
 
-    unordered_dense_map()
-        : store_(std::make_unique<Store>())
-        , index_(0, IndexHash{store_.get()}, IndexEqual{store_.get()}) {}
+    unordered_dense_map() = default;
 
     template <typename InputIt>
     unordered_dense_map(InputIt first, InputIt last) : unordered_dense_map() {
@@ -131,12 +121,7 @@ public:
         insert(il.begin(), il.end());
     }
 
-    unordered_dense_map(const unordered_dense_map & other)
-        : store_(std::make_unique<Store>(*other.store_))
-        , index_(other.index_.begin(), other.index_.end(),
-                 other.index_.bucket_count(), IndexHash{store_.get()},
-                 IndexEqual{store_.get()}) {}
-
+    unordered_dense_map(const unordered_dense_map &) = default;
     unordered_dense_map(unordered_dense_map &&) noexcept = default;
 
     unordered_dense_map & operator=(const unordered_dense_map & other) {
@@ -156,65 +141,59 @@ public:
 
     void swap(unordered_dense_map & other) noexcept {
         store_.swap(other.store_);
+        hashes_.swap(other.hashes_);
         index_.swap(other.index_);
     }
 
-    iterator begin() { return store_->begin(); }
-    iterator end() { return store_->end(); }
-    const_iterator begin() const { return store_->begin(); }
-    const_iterator end() const { return store_->end(); }
-    const_iterator cbegin() const { return store_->cbegin(); }
-    const_iterator cend() const { return store_->cend(); }
+    iterator begin() { return store_.begin(); }
+    iterator end() { return store_.end(); }
+    const_iterator begin() const { return store_.begin(); }
+    const_iterator end() const { return store_.end(); }
+    const_iterator cbegin() const { return store_.cbegin(); }
+    const_iterator cend() const { return store_.cend(); }
 
-    size_type size() const { return store_->size(); }
-    bool empty() const { return store_->empty(); }
+    size_type size() const { return store_.size(); }
+    bool empty() const { return store_.empty(); }
 
     void reserve(size_type n) {
-        store_->reserve(n);
-        index_.reserve(n);
+        store_.reserve(n);
+        hashes_.reserve(n);
+        index_.reserve(n, hashes_);
     }
 
     void clear() {
         index_.clear();
-        store_->clear();
+        hashes_.clear();
+        store_.clear();
     }
 
-    iterator find(const Key & k) {
-        auto it = index_.find(k);
-        return it == index_.end()
-                   ? end()
-                   : begin() + static_cast<difference_type>(it->value);
-    }
+    iterator find(const Key & k) { return iterator_at(find_position(k)); }
     const_iterator find(const Key & k) const {
-        auto it = index_.find(k);
-        return it == index_.end()
-                   ? end()
-                   : begin() + static_cast<difference_type>(it->value);
+        return iterator_at(find_position(k));
     }
     template <typename K, typename H = Hash, typename E = KeyEqual,
               std::enable_if_t<is_transparent_v<H, E>, int> = 0>
     iterator find(const K & k) {
-        auto it = index_.find(k);
-        return it == index_.end()
-                   ? end()
-                   : begin() + static_cast<difference_type>(it->value);
+        return iterator_at(find_position(k));
     }
     template <typename K, typename H = Hash, typename E = KeyEqual,
               std::enable_if_t<is_transparent_v<H, E>, int> = 0>
     const_iterator find(const K & k) const {
-        auto it = index_.find(k);
-        return it == index_.end()
-                   ? end()
-                   : begin() + static_cast<difference_type>(it->value);
+        return iterator_at(find_position(k));
     }
 
     bool contains(const Key & k) const {
-        return index_.find(k) != index_.end();
+        return find_slot(k) != detail::flat_hash_index::npos;
     }
     template <typename K, typename H = Hash, typename E = KeyEqual,
               std::enable_if_t<is_transparent_v<H, E>, int> = 0>
     bool contains(const K & k) const {
-        return index_.find(k) != index_.end();
+        return find_slot(k) != detail::flat_hash_index::npos;
+    }
+
+    // hash must be hash_of(k)
+    bool contains(const Key & k, const std::size_t hash) const {
+        return find_slot(k, hash) != detail::flat_hash_index::npos;
     }
 
     size_type count(const Key & k) const { return contains(k) ? 1 : 0; }
@@ -245,33 +224,19 @@ public:
         return {it, it == end() ? it : std::next(it)};
     }
 
-    Value & at(const Key & k) {
-        auto it = index_.find(k);
-        if(it == index_.end())
-            throw std::out_of_range("unordered_dense_map::at");
-        return (*store_)[it->value].second;
-    }
+    Value & at(const Key & k) { return store_[checked_position(k)].second; }
     const Value & at(const Key & k) const {
-        auto it = index_.find(k);
-        if(it == index_.end())
-            throw std::out_of_range("unordered_dense_map::at");
-        return (*store_)[it->value].second;
+        return store_[checked_position(k)].second;
     }
     template <typename K, typename H = Hash, typename E = KeyEqual,
               std::enable_if_t<is_transparent_v<H, E>, int> = 0>
     Value & at(const K & k) {
-        auto it = index_.find(k);
-        if(it == index_.end())
-            throw std::out_of_range("unordered_dense_map::at");
-        return (*store_)[it->value].second;
+        return store_[checked_position(k)].second;
     }
     template <typename K, typename H = Hash, typename E = KeyEqual,
               std::enable_if_t<is_transparent_v<H, E>, int> = 0>
     const Value & at(const K & k) const {
-        auto it = index_.find(k);
-        if(it == index_.end())
-            throw std::out_of_range("unordered_dense_map::at");
-        return (*store_)[it->value].second;
+        return store_[checked_position(k)].second;
     }
 
     template <typename... Args>
@@ -283,6 +248,20 @@ public:
         return try_emplace_impl(std::move(k), std::forward<Args>(args)...);
     }
 
+    // hash must be hash_of(k)
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace_hashed(const std::size_t hash,
+                                                 const Key & k,
+                                                 Args &&... args) {
+        return try_emplace_hashed_impl(hash, k, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace_hashed(const std::size_t hash,
+                                                 Key && k, Args &&... args) {
+        return try_emplace_hashed_impl(hash, std::move(k),
+                                       std::forward<Args>(args)...);
+    }
+
     template <typename... Args>
     std::pair<iterator, bool> emplace(Args &&... args) {
         value_type v(std::forward<Args>(args)...);
@@ -305,18 +284,18 @@ public:
 
     template <typename M>
     std::pair<iterator, bool> insert_or_assign(const Key & k, M && obj) {
-        if(auto it = index_.find(k); it != index_.end()) {
-            const size_type i = it->value;
-            (*store_)[i].second = std::forward<M>(obj);
+        if(const size_type i = find_position(k);
+           i != detail::flat_hash_index::npos) {
+            store_[i].second = std::forward<M>(obj);
             return {begin() + static_cast<difference_type>(i), false};
         }
         return try_emplace(k, std::forward<M>(obj));
     }
     template <typename M>
     std::pair<iterator, bool> insert_or_assign(Key && k, M && obj) {
-        if(auto it = index_.find(k); it != index_.end()) {
-            const size_type i = it->value;
-            (*store_)[i].second = std::forward<M>(obj);
+        if(const size_type i = find_position(k);
+           i != detail::flat_hash_index::npos) {
+            store_[i].second = std::forward<M>(obj);
             return {begin() + static_cast<difference_type>(i), false};
         }
         return try_emplace(std::move(k), std::forward<M>(obj));
@@ -347,22 +326,54 @@ public:
         return erase(static_cast<const_iterator>(pos));
     }
 
-    const Store & values() const { return *store_; }
+    const Store & values() const { return store_; }
 
 private:
+    iterator iterator_at(size_type i) {
+        return i == detail::flat_hash_index::npos
+                   ? end()
+                   : begin() + static_cast<difference_type>(i);
+    }
+    const_iterator iterator_at(size_type i) const {
+        return i == detail::flat_hash_index::npos
+                   ? end()
+                   : begin() + static_cast<difference_type>(i);
+    }
+
+    template <typename K>
+    size_type checked_position(const K & k) const {
+        const size_type i = find_position(k);
+        if(i == detail::flat_hash_index::npos)
+            throw std::out_of_range("unordered_dense_map::at");
+        return i;
+    }
+
     template <typename K2, typename... Args>
     std::pair<iterator, bool> try_emplace_impl(K2 && k, Args &&... args) {
-        if(auto it = index_.find(k); it != index_.end())
-            return {begin() + static_cast<difference_type>(it->value), false};
-
-        store_->emplace_back(
+        const std::size_t hash = hash_of(k);
+        return try_emplace_hashed_impl(hash, std::forward<K2>(k),
+                                       std::forward<Args>(args)...);
+    }
+    template <typename K2, typename... Args>
+    std::pair<iterator, bool> try_emplace_hashed_impl(const std::size_t hash,
+                                                      K2 && k,
+                                                      Args &&... args) {
+        if(const std::size_t slot = find_slot(k, hash);
+           slot != detail::flat_hash_index::npos)
+            return {begin() + static_cast<difference_type>(
+                                  index_.position(slot)),
+                    false};
+
+        store_.emplace_back(
             std::piecewise_construct,
             std::forward_as_tuple(std::forward<K2>(k)),
             std::forward_as_tuple(std::forward<Args>(args)...));
         try {
-            index_.insert(Index{store_->size() - 1});
+            hashes_.push_back(hash);
+            index_.insert(hashes_);
         } catch(...) {
-            store_->pop_back();
+            hashes_.resize(store_.size() - 1);
+            store_.pop_back();
             throw;
         }
         return {std::prev(end()), true};
@@ -370,27 +381,29 @@ private:
 
     template <typename K>
     size_type erase_key(const K & k) {
-        auto it = index_.find(k);
-        if(it == index_.end()) return 0;
-        erase_slot(it->value, it);
+        const std::size_t slot = find_slot(k);
+        if(slot == detail::flat_hash_index::npos) return 0;
+        erase_slot(index_.position(slot), slot);
         return 1;
     }
 
-    // swap-and-pop the element at slot i out of both store and index.
-    void erase_slot(size_type i) { erase_slot(i, index_.find(Index{i})); }
+    // swap-and-pop the element at position i out of store and index.
+    void erase_slot(size_type i) {
+        erase_slot(i, index_.find(hashes_[i],
+                                  [i](std::size_t j) { return j == i; }));
+    }
 
-    template <typename SetIt>
-    void erase_slot(size_type i, SetIt it) {
-        const size_type last = store_->size() - 1;
-        index_.erase(it);
+    void erase_slot(size_type i, std::size_t slot) {
+        const size_type last = store_.size() - 1;
+        index_.erase(slot);
         if(i != last) {
-            index_.erase(Index{last});  // un-index the element we move
-            (*store_)[i] = std::move((*store_)[last]);
-            store_->pop_back();
-            index_.insert(Index{i});  // re-index it at its new slot
-        } else {
-            store_->pop_back();
+            // re-index the element we move at its new position
+            index_.relocate(hashes_[last], last, i);
+            store_[i] = std::move(store_[last]);
+            hashes_[i] = hashes_[last];
         }
+        store_.pop_back();
+        hashes_.pop_back();
     }
 };
 
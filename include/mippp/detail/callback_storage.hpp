@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mippp::detail {
+
+// The callable of a callback, stored once when the callback is set and then
+// called through a plain function pointer instantiated for its type : no
+// std::function copy or small buffer check per call, and move-only callables
+// are accepted.
+template <typename Handle>
+class callback_holder {
+private:
+    std::unique_ptr<void, void (*)(void *)> _callable{nullptr, nullptr};
+    void (*_call)(void *, Handle &) = nullptr;
+
+public:
+    template <typename F>
+        requires std::is_invocable_v<std::decay_t<F> &, Handle &>
+    void emplace(F && f) {
+        using callable = std::decay_t<F>;
+        _callable = {new callable(std::forward<F>(f)),
+                     [](void * p) { delete static_cast<callable *>(p); }};
+        _call = [](void * p, Handle & handle) {
+            (*static_cast<callable *>(p))(handle);
+        };
+    }
+
+    explicit operator bool() const noexcept { return _call != nullptr; }
+    void operator()(Handle & handle) const { _call(_callable.get(), handle); }
+};
+
+// Scratch buffers of the callbacks of a model, per solver thread, that
+// outlive the calls so that fetching a solution in a callback only allocates
+// the first time a thread needs that many values. Each fetch of a call gets
+// its own buffer, the buffers of a thread being handed back when its call
+// returns, through the guard of release_on_return(). A thread only ever
+// touches its own buffers, the lock only guards the lookup.
+template <typename Scalar>
+class per_thread_buffers {
+private:
+    struct entry {
+        std::thread::id thread;
+        std::deque<std::vector<Scalar>> buffers;  // stable references
+        std::size_t num_used = 0;
+    };
+    std::mutex _mutex;
+    std::deque<entry> _entries;  // stable references
+
+    entry * _find(const std::thread::id id) {
+        for(auto & e : _entries)
+            if(e.thread == id) return &e;
+        return nullptr;
+    }
+
+public:
+    class release_guard {
+    private:
+        per_thread_buffers * _buffers;
+
+    public:
+        explicit release_guard(per_thread_buffers & buffers)
+            : _buffers(&buffers) {}
+        release_guard(const release_guard &) = delete;
+        release_guard & operator=(const release_guard &) = delete;
+        ~release_guard() { _buffers->release(); }
+    };
+
+    per_thread_buffers() = default;
+    // not while the solver runs, as the model the buffers belong to
+    per_thread_buffers(per_thread_buffers && other) noexcept
+        : _entries(std::move(other._entries)) {}
+    per_thread_buffers & operator=(per_thread_buffers && other) noexcept {
+        _entries = std::move(other._entries);
+        return *this;
+    }
+
+    // a buffer of the calling thread, of at least size values, distinct from
+    // those it got since its last release()
+    Scalar * local(const std::size_t size) {
+        const std::thread::id id = std::this_thread::get_id();
+        entry * e;
+        {
+            std::lock_guard lock(_mutex);
+            e = _find(id);
+            if(e == nullptr) e = &_entries.emplace_back(id);
+        }
+        if(e->num_used == e->buffers.size()) e->buffers.emplace_back();
+        std::vector<Scalar> & values = e->buffers[e->num_used++];
+        if(values.size() < size) values.resize(size);
+        return values.data();
+    }
+    // hands the buffers of the calling thread back, to be reused by its next
+    // calls to local()
+    void release() {
+        const std::thread::id id = std::this_thread::get_id();
+        std::lock_guard lock(_mutex);
+        if(entry * e = _find(id)) e->num_used = 0;
+    }
+    // to hold for the duration of a callback call
+    [[nodiscard]] release_guard release_on_return() {
+        return release_guard(*this);
+    }
+
+    std::size_t num_threads() {
+        std::lock_guard lock(_mutex);
+        return _entries.size();
+    }
+    // before a solve : its threads need not be those of the previous one
+    void clear() {
+        std::lock_guard lock(_mutex);
+        _entries.clear();
+    }
+};
+
+}  // namespace mippp::detail
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace mippp::detail {
+
+// Text output through a fixed size buffer that is handed to the stream each
+// time it fills up, so that the memory used while writing a model does not
+// depend on the model size. Numbers are formatted with std::to_chars, in the
+// shortest form that reads back to the same double.
+// write_binary() copies the object representation of values instead, for
+// the binary formats.
+class chunked_writer {
+private:
+    std::ostream * _os;
+    std::size_t _capacity;
+    std::unique_ptr<char[]> _buffer;
+    std::size_t _size;
+
+    // longest std::to_chars output of a double or a std::size_t
+    static constexpr std::size_t max_number_length = 32;
+
+public:
+    [[nodiscard]] explicit chunked_writer(std::ostream & os,
+                                          std::size_t capacity = 1u << 16)
+        : _os(&os)
+        , _capacity(std::max(capacity, 2 * max_number_length))
+        , _buffer(std::make_unique_for_overwrite<char[]>(_capacity))
+        , _size(0) {}
+    ~chunked_writer() { flush(); }
+
+    chunked_writer(const chunked_writer &) = delete;
+    chunked_writer & operator=(const chunked_writer &) = delete;
+
+    void flush() {
+        if(_size == 0) return;
+        _os->write(_buffer.get(), static_cast<std::streamsize>(_size));
+        _size = 0;
+    }
+
+    chunked_writer & operator<<(const char c) {
+        if(_size == _capacity) flush();
+        _buffer[_size++] = c;
+        return *this;
+    }
+    chunked_writer & operator<<(std::string_view s) {
+        while(!s.empty()) {
+            if(_size == _capacity) flush();
+            const std::size_t n = std::min(s.size(), _capacity - _size);
+            s.copy(_buffer.get() + _size, n);
+            _size += n;
+            s.remove_prefix(n);
+        }
+        return *this;
+    }
+    chunked_writer & operator<<(const std::size_t n) {
+        if(_capacity - _size < max_number_length) flush();
+        char * const first = _buffer.get() + _size;
+        _size += static_cast<std::size_t>(
+            std::to_chars(first, first + max_number_length, n).ptr - first);
+        return *this;
+    }
+    // infinities are written as inf and -inf
+    chunked_writer & operator<<(const double d) {
+        if(_capacity - _size < max_number_length) flush();
+        char * const first = _buffer.get() + _size;
+        _size += static_cast<std::size_t>(
+            std::to_chars(first, first + max_number_length, d).ptr - first);
+        return *this;
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    chunked_writer & write_binary(const T & value) {
+        return *this << std::string_view(
+                   reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+};
+
+}  // namespace mippp::detail
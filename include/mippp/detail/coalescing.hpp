@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mippp::detail {
+
+// A row of n entries over ids in [0, ids_end) is merged with the dense stamp
+// array when n * dense_coalescing_ratio >= ids_end, i.e. when the row touches
+// enough ids to amortize an ids_end sized array ; otherwise with a hash table
+// of about 2n slots, so that short rows of huge models stay cheap.
+inline constexpr std::size_t dense_coalescing_ratio = 16;
+
+using coalescing_cache = std::vector<std::pair<unsigned int, unsigned int>>;
+
+// Merges the entries [first, indices.size()) that share an index into the
+// first of them, keeping the first occurrences order. Stamps cache[id] with
+// ++stamp, the dense cache must then cover every id of the segment.
+template <typename Index, typename Scalar>
+void coalesce_with_stamps(coalescing_cache & cache, unsigned int & stamp,
+                          std::vector<Index> & indices,
+                          std::vector<Scalar> & scalars,
+                          const std::size_t first) {
+    ++stamp;
+    std::size_t last = first;
+    for(std::size_t i = first; i < indices.size(); ++i) {
+        const Index id = indices[i];
+        auto & p = cache[static_cast<std::size_t>(id)];
+        if(p.first == stamp) {
+            scalars[p.second] += scalars[i];
+            continue;
+        }
+        p = std::make_pair(stamp, static_cast<unsigned int>(last));
+        indices[last] = id;
+        scalars[last] = scalars[i];
+        ++last;
+    }
+    indices.resize(last);
+    scalars.resize(last);
+}
+
+// Same as coalesce_with_stamps with an open-addressing table (linear
+// probing) whose slots hold 1 + the position of the merged entry, 0 if empty.
+template <typename Index, typename Scalar>
+void coalesce_with_hash_table(std::vector<unsigned int> & table,
+                              std::vector<Index> & indices,
+                              std::vector<Scalar> & scalars,
+                              const std::size_t first) {
+    const std::size_t num_entries = indices.size() - first;
+    const std::size_t capacity =
+        std::bit_ceil(std::max<std::size_t>(2, 2 * num_entries));
+    const std::size_t mask = capacity - 1;
+    const int shift = 64 - std::countr_zero(capacity);
+    constexpr std::uint64_t fibonacci_multiplier = 11400714819323198485u;
+    table.resize(capacity);
+    std::fill(table.begin(), table.end(), 0u);
+    std::size_t last = first;
+    for(std::size_t i = first; i < indices.size(); ++i) {
+        const Index id = indices[i];
+        // Fibonacci hashing : the high bits of the product depend on all the
+        // bits of the id, so strided ids do not pile up in the same slots
+        std::size_t slot = static_cast<std::size_t>(
+            (static_cast<std::uint64_t>(id) * fibonacci_multiplier) >> shift);
+        while(table[slot] != 0u && indices[table[slot] - 1] != id)
+            slot = (slot + 1) & mask;
+        if(table[slot] != 0u) {
+            scalars[table[slot] - 1] += scalars[i];
+            continue;
+        }
+        table[slot] = static_cast<unsigned int>(last + 1);
+        indices[last] = id;
+        scalars[last] = scalars[i];
+        ++last;
+    }
+    indices.resize(last);
+    scalars.resize(last);
+}
+
+// Picks the strategy for the segment [first, indices.size()) and grows the
+// dense cache lazily, only when a row is long enough to need it.
+template <typename Index, typename Scalar>
+void coalesce_entries(coalescing_cache & cache, unsigned int & stamp,
+                      std::vector<unsigned int> & table,
+                      std::vector<Index> & indices,
+                      std::vector<Scalar> & scalars, const std::size_t first,
+                      const std::size_t ids_end) {
+    const std::size_t num_entries = indices.size() - first;
+    if(num_entries < 2) return;
+    if(num_entries * dense_coalescing_ratio >= ids_end) {
+        if(cache.size() < ids_end) cache.resize(ids_end);
+        coalesce_with_stamps(cache, stamp, indices, scalars, first);
+        return;
+    }
+    coalesce_with_hash_table(table, indices, scalars, first);
+}
+
+}  // namespace mippp::detail
@@ -0,0 +1,260 @@
+#pragma once
+// flat_hash_index: open-addressing index of the entries of a dense store,
+// after the SwissTable layout.
+//
+// Layout:
+//   std::vector<std::int8_t>   -- one control byte per slot : empty, deleted,
+//                                 or the 7 low bits (H2) of the hash of the
+//                                 entry held by a full slot
+//   std::vector<std::size_t>   -- per slot, the position of its entry in the
+//                                 store
+//
+// The slots are probed by groups of control bytes, compared to H2 all at once
+// (16 bytes with SSE2, 8 bytes in a machine word otherwise), so that most
+// lookups touch one group and one store entry. The group is picked by the
+// high bits (H1) of the hash, and the next groups by triangular probing.
+//
+// The index knows nothing of the keys : the caller gives the hash of the
+// searched key and a predicate on store positions. It keeps no hashes either,
+// the caller caches them by store position (see unordered_dense_map) and
+// hands them back to rebuild the index when it grows.
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIPPP_FLAT_HASH_INDEX_SSE2
+#endif
+
+namespace mippp::detail {
+
+class flat_hash_index {
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+private:
+    using ctrl_t = std::int8_t;
+    static constexpr ctrl_t empty_ctrl = -128;  // 0b10000000
+    static constexpr ctrl_t deleted_ctrl = -2;  // 0b11111110
+
+    // positions of the matching bytes of a group, lowest first
+    class bitmask {
+    private:
+        std::uint64_t _mask;
+        int _shift;
+
+    public:
+        constexpr bitmask(std::uint64_t mask, int shift)
+            : _mask(mask), _shift(shift) {}
+        constexpr explicit operator bool() const { return _mask != 0; }
+        constexpr std::size_t lowest() const {
+            return static_cast<std::size_t>(std::countr_zero(_mask) >> _shift);
+        }
+        constexpr void pop() { _mask &= _mask - 1; }
+    };
+
+#ifdef MIPPP_FLAT_HASH_INDEX_SSE2
+    static constexpr std::size_t group_width = 16;
+
+    class group {
+    private:
+        __m128i _ctrl;
+
+    public:
+        explicit group(const ctrl_t * p)
+            : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+        bitmask match(ctrl_t h2) const {
+            return {static_cast<std::uint16_t>(_mm_movemask_epi8(
+                        _mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl))),
+                    0};
+        }
+        bitmask match_empty() const { return match(empty_ctrl); }
+        bitmask match_empty_or_deleted() const {
+            return {static_cast<std::uint16_t>(_mm_movemask_epi8(_ctrl)), 0};
+        }
+    };
+#else
+    static constexpr std::size_t group_width = 8;
+
+    // SWAR fallback : the mask has the high bit of each matching byte set.
+    // match() may report false positives, which the caller's predicate
+    // rejects, as the hash and key comparisons would anyway.
+    class group {
+    private:
+        static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+        static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+        std::uint64_t _ctrl;
+
+        static constexpr std::uint64_t to_little_endian(std::uint64_t x) {
+            if constexpr(std::endian::native == std::endian::big)
+                return std::byteswap(x);
+            return x;
+        }
+
+    public:
+        explicit group(const ctrl_t * p) {
+            std::memcpy(&_ctrl, p, sizeof(_ctrl));
+            _ctrl = to_little_endian(_ctrl);
+        }
+        bitmask match(ctrl_t h2) const {
+            const std::uint64_t x =
+                _ctrl ^ (lsbs * static_cast<std::uint8_t>(h2));
+            return {(x - lsbs) & ~x & msbs, 3};
+        }
+        bitmask match_empty() const {
+            return {_ctrl & ~(_ctrl << 6) & msbs, 3};
+        }
+        bitmask match_empty_or_deleted() const { return {_ctrl & msbs, 3}; }
+    };
+#endif
+
+    std::vector<ctrl_t> _ctrl;
+    std::vector<std::size_t> _slots;
+    std::size_t _size = 0;
+    std::size_t _growth_left = 0;
+
+    std::size_t capacity() const { return _ctrl.size(); }
+    static constexpr std::size_t max_load(std::size_t capacity) {
+        return capacity - capacity / 8;
+    }
+    // smallest capacity, a power of two multiple of group_width, that holds
+    // n entries under the 7/8 maximum load factor
+    static constexpr std::size_t capacity_for(std::size_t n) {
+        std::size_t capacity = group_width;
+        while(max_load(capacity) < n) capacity *= 2;
+        return capacity;
+    }
+
+    static constexpr std::size_t h1(std::size_t hash) { return hash >> 7; }
+    static constexpr ctrl_t h2(std::size_t hash) {
+        return static_cast<ctrl_t>(hash & 0x7f);
+    }
+
+    // visits the groups of the probe sequence of hash until f returns true
+    template <typename F>
+    void probe(std::size_t hash, F && f) const {
+        const std::size_t groups_mask = capacity() / group_width - 1;
+        std::size_t g = h1(hash) & groups_mask;
+        for(std::size_t i = 1;; ++i) {
+            if(f(g * group_width)) return;
+            g = (g + i) & groups_mask;
+        }
+    }
+
+    void set_slot(std::size_t slot, std::size_t hash, std::size_t position) {
+        _ctrl[slot] = h2(hash);
+        _slots[slot] = position;
+    }
+
+    std::size_t find_free_slot(std::size_t hash) const {
+        std::size_t slot = npos;
+        probe(hash, [&](std::size_t first) {
+            const bitmask free = group(&_ctrl[first]).match_empty_or_deleted();
+            if(!free) return false;
+            slot = first + free.lowest();
+            return true;
+        });
+        return slot;
+    }
+
+    void rehash(std::size_t new_capacity,
+                const std::vector<std::size_t> & hashes) {
+        std::vector<ctrl_t> ctrl(new_capacity, empty_ctrl);
+        std::vector<std::size_t> slots(new_capacity);
+        _ctrl.swap(ctrl);
+        _slots.swap(slots);
+        _size = hashes.size();
+        _growth_left = max_load(new_capacity) - _size;
+        for(std::size_t i = 0; i < hashes.size(); ++i)
+            set_slot(find_free_slot(hashes[i]), hashes[i], i);
+    }
+
+public:
+    // Finalizes the hash given by the user, whose low bits may be poor
+    // (std::hash of integers is the identity in common implementations),
+    // since both H1 and H2 are taken from it.
+    static constexpr std::size_t mix(std::size_t hash) {
+        const std::uint64_t x =
+            static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ull;
+        return static_cast<std::size_t>(x ^ (x >> 32));
+    }
+
+    // slot of the entry for which pred(position) holds, or npos
+    template <typename Pred>
+    std::size_t find(std::size_t hash, Pred && pred) const {
+        if(_size == 0) return npos;
+        const ctrl_t h = h2(hash);
+        std::size_t slot = npos;
+        probe(hash, [&](std::size_t first) {
+            const group g(&_ctrl[first]);
+            for(bitmask m = g.match(h); m; m.pop()) {
+                const std::size_t s = first + m.lowest();
+                if(pred(_slots[s])) {
+                    slot = s;
+                    return true;
+                }
+            }
+            return static_cast<bool>(g.match_empty());
+        });
+        return slot;
+    }
+
+    std::size_t position(std::size_t slot) const { return _slots[slot]; }
+
+    // Indexes the last store entry, hashes.back(), which must be absent.
+    // hashes holds the hashes of all the store entries, for rehashing.
+    void insert(const std::vector<std::size_t> & hashes) {
+        const std::size_t hash = hashes.back();
+        std::size_t slot = capacity() > 0 ? find_free_slot(hash) : npos;
+        if(slot == npos || (_growth_left == 0 && _ctrl[slot] == empty_ctrl)) {
+            // grow when full of entries, else only purge the deleted slots
+            std::size_t new_capacity = capacity_for(hashes.size());
+            if(new_capacity <= capacity() &&
+               hashes.size() > max_load(capacity()) / 2)
+                new_capacity = capacity() * 2;
+            rehash(new_capacity, hashes);
+            return;
+        }
+        if(_ctrl[slot] == empty_ctrl) --_growth_left;
+        set_slot(slot, hash, hashes.size() - 1);
+        ++_size;
+    }
+
+    void erase(std::size_t slot) {
+        _ctrl[slot] = deleted_ctrl;
+        --_size;
+    }
+
+    // the entry of the given hash at store position from moved to position to
+    void relocate(std::size_t hash, std::size_t from, std::size_t to) {
+        _slots[find(hash, [from](std::size_t p) { return p == from; })] = to;
+    }
+
+    void reserve(std::size_t n, const std::vector<std::size_t> & hashes) {
+        if(max_load(capacity()) >= n) return;
+        rehash(capacity_for(n), hashes);
+    }
+
+    void clear() {
+        std::ranges::fill(_ctrl, empty_ctrl);
+        _size = 0;
+        _growth_left = max_load(capacity());
+    }
+
+    void swap(flat_hash_index & other) noexcept {
+        _ctrl.swap(other._ctrl);
+        _slots.swap(other._slots);
+        std::swap(_size, other._size);
+        std::swap(_growth_left, other._growth_left);
+    }
+};
+
+}  // namespace mippp::detail
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mippp::detail {
+
+// Read-only view of a whole file. On POSIX systems the file is memory mapped,
+// so that the pages are loaded by the kernel as they are parsed and dropped
+// under memory pressure instead of being copied in a heap buffer. Elsewhere
+// the file is read in memory.
+class mapped_file {
+private:
+#if defined(_WIN32)
+    std::vector<char> _contents;
+#else
+    void * _address = nullptr;
+    std::size_t _size = 0;
+#endif
+
+public:
+    [[nodiscard]] explicit mapped_file(const std::filesystem::path & path) {
+#if defined(_WIN32)
+        std::ifstream file(path, std::ios::binary);
+        if(!file)
+            throw std::runtime_error("mapped_file: cannot open " +
+                                     path.string());
+        _contents.assign(std::istreambuf_iterator<char>(file),
+                         std::istreambuf_iterator<char>());
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            throw std::runtime_error("mapped_file: cannot open " +
+                                     path.string());
+        struct stat st;
+        if(::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("mapped_file: cannot stat " +
+                                     path.string());
+        }
+        _size = static_cast<std::size_t>(st.st_size);
+        if(_size > 0) {
+            _address = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(_address == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("mapped_file: cannot map " +
+                                         path.string());
+            }
+            // the file is parsed front to back
+            ::madvise(_address, _size, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+#endif
+    }
+    ~mapped_file() {
+#if !defined(_WIN32)
+        if(_address != nullptr) ::munmap(_address, _size);
+#endif
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file & operator=(const mapped_file &) = delete;
+
+    std::string_view contents() const noexcept {
+#if defined(_WIN32)
+        return std::string_view(_contents.data(), _contents.size());
+#else
+        if(_address == nullptr) return {};
+        return std::string_view(static_cast<const char *>(_address), _size);
+#endif
+    }
+};
+
+}  // namespace mippp::detail
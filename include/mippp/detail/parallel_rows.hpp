@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mippp/detail/coalescing.hpp"
+#include "mippp/linear_constraint.hpp"
+#include "mippp/model_entities.hpp"
+
+namespace mippp::detail {
+
+// Rows in CSR form, as built by one thread of build_rows_in_parallel, and
+// then as the stitched result handed to the solver bulk call.
+template <typename Index, typename Scalar>
+struct csr_rows {
+    std::vector<Index> begins;
+    std::vector<Index> indices;
+    std::vector<Scalar> scalars;
+    std::vector<constraint_sense> senses;
+    std::vector<Scalar> rhs;
+
+    // same coalescing scheme as model_base::_register_coalescing_entries,
+    // but owned by the slice so that threads do not share it
+    coalescing_cache entry_index_cache;
+    std::vector<unsigned int> coalescing_table;
+    unsigned int register_count = 0;
+    std::size_t ids_end = 0;
+
+    std::size_t num_rows() const { return begins.size(); }
+
+    template <bool distinct, typename IdProj, linear_constraint LC>
+    void register_constraint(LC && lc, IdProj & proj) {
+        begins.emplace_back(static_cast<Index>(indices.size()));
+        senses.emplace_back(lc.sense());
+        rhs.emplace_back(static_cast<Scalar>(lc.rhs()));
+        const std::size_t first = indices.size();
+        for(auto && [var, coef] : lc.linear_terms()) {
+            indices.emplace_back(proj(var));
+            scalars.emplace_back(coef);
+        }
+        if constexpr(!distinct)
+            coalesce_entries(entry_index_cache, register_count,
+                             coalescing_table, indices, scalars, first,
+                             ids_end);
+    }
+    template <bool distinct, typename IdProj, typename Key,
+              typename LastConstrLambda>
+        requires linear_constraint<std::invoke_result_t<LastConstrLambda, Key>>
+    void register_first_valued_constraint(const Key & key, IdProj & proj,
+                                          LastConstrLambda & lc_lambda) {
+        register_constraint<distinct>(lc_lambda(key), proj);
+    }
+    template <bool distinct, typename IdProj, typename Key,
+              typename OptConstrLambda, typename... Tail>
+        requires optional_type<std::invoke_result_t<OptConstrLambda, Key>> &&
+                 linear_constraint<optional_type_value_t<
+                     std::invoke_result_t<OptConstrLambda, Key>>>
+    void register_first_valued_constraint(const Key & key, IdProj & proj,
+                                          OptConstrLambda & opt_lc_lambda,
+                                          Tail &... tail) {
+        if(const auto & opt_lc = opt_lc_lambda(key)) {
+            register_constraint<distinct>(opt_lc.value(), proj);
+            return;
+        }
+        register_first_valued_constraint<distinct>(key, proj, tail...);
+    }
+};
+
+// Below this many keys per thread, spawning threads costs more than it saves.
+inline constexpr std::size_t min_parallel_rows_per_thread = 256;
+
+// Evaluates the constraint lambdas of the keys [begin, end) of each chunk on
+// its own thread, then stitches the slices in key order : row i of the
+// result is the row of keys[i], exactly as in the serial add_constraints.
+// The lambdas are invoked concurrently and must be safe to call so.
+template <bool distinct, typename Index, typename Scalar,
+          std::ranges::random_access_range IR, typename IdProj,
+          typename... CL>
+csr_rows<Index, Scalar> build_rows_in_parallel(IR && keys,
+                                               const std::size_t ids_end,
+                                               IdProj proj,
+                                               CL &... constraint_lambdas) {
+    const auto num_keys = static_cast<std::size_t>(std::ranges::size(keys));
+    const std::size_t num_threads = std::clamp<std::size_t>(
+        num_keys / min_parallel_rows_per_thread, 1,
+        std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<csr_rows<Index, Scalar>> slices(num_threads);
+    std::vector<std::exception_ptr> errors(num_threads);
+    const auto chunk_begin = [&](std::size_t t) {
+        return num_keys * t / num_threads;
+    };
+    const auto run_chunks = [&](auto && f) {
+        std::vector<std::jthread> threads;
+        threads.reserve(num_threads - 1);
+        const auto run = [&](std::size_t t) {
+            try {
+                f(t);
+            } catch(...) {
+                errors[t] = std::current_exception();
+            }
+        };
+        for(std::size_t t = 1; t < num_threads; ++t)
+            threads.emplace_back(run, t);
+        run(0);
+        threads.clear();  // joins
+        for(auto && e : errors)
+            if(e) std::rethrow_exception(e);
+    };
+
+    run_chunks([&](std::size_t t) {
+        auto & slice = slices[t];
+        slice.ids_end = ids_end;
+        const auto first = std::ranges::begin(keys);
+        for(std::size_t i = chunk_begin(t); i < chunk_begin(t + 1); ++i)
+            slice.template register_first_valued_constraint<distinct>(
+                first[static_cast<std::ranges::range_difference_t<IR>>(i)],
+                proj, constraint_lambdas...);
+    });
+
+    if(num_threads == 1) return std::move(slices.front());
+
+    std::vector<std::size_t> entries_offsets(num_threads + 1, 0);
+    for(std::size_t t = 0; t < num_threads; ++t)
+        entries_offsets[t + 1] = entries_offsets[t] + slices[t].indices.size();
+
+    csr_rows<Index, Scalar> rows;
+    rows.begins.resize(num_keys);
+    rows.indices.resize(entries_offsets.back());
+    rows.scalars.resize(entries_offsets.back());
+    rows.senses.resize(num_keys);
+    rows.rhs.resize(num_keys);
+    run_chunks([&](std::size_t t) {
+        auto & slice = slices[t];
+        const auto row_offset = static_cast<std::ptrdiff_t>(chunk_begin(t));
+        const auto entries_offset =
+            static_cast<std::ptrdiff_t>(entries_offsets[t]);
+        std::ranges::transform(
+            slice.begins, rows.begins.begin() + row_offset,
+            [entries_offset](Index b) {
+                return static_cast<Index>(b + entries_offset);
+            });
+        std::ranges::copy(slice.senses, rows.senses.begin() + row_offset);
+        std::ranges::copy(slice.rhs, rows.rhs.begin() + row_offset);
+        std::ranges::copy(slice.indices, rows.indices.begin() + entries_offset);
+        std::ranges::copy(slice.scalars, rows.scalars.begin() + entries_offset);
+        slice = {};
+    });
+    return rows;
+}
+
+}  // namespace mippp::detail
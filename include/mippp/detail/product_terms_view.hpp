@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace mippp::detail {
+
+// Quadratic terms (v1, v2, c1 * c2) of the product of two ranges of linear
+// terms (v1, c1) and (v2, c2).
+//
+// A rectangular view emits the whole cartesian product. A triangular view
+// squares its first range : it emits each unordered pair of term positions
+// once, the pair {i, j} with i < j carrying 2 * c_i * c_j, which halves the
+// stream and leaves nothing for the solver to fold. Only a view of two
+// ranges of the same type can be triangular, and its second range is then
+// ignored.
+template <std::ranges::view V1, std::ranges::view V2>
+    requires std::ranges::forward_range<V1> && std::ranges::forward_range<V2>
+class product_terms_view
+    : public std::ranges::view_interface<product_terms_view<V1, V2>> {
+private:
+    V1 _first;
+    V2 _second;
+    bool _triangular;
+
+    template <bool Const>
+    using base_t = std::conditional_t<Const, const product_terms_view<V1, V2>,
+                                      product_terms_view<V1, V2>>;
+
+    template <bool Const>
+    class iterator {
+        using Parent = base_t<Const>;
+        using FirstBase = std::conditional_t<Const, const V1, V1>;
+        using SecondBase = std::conditional_t<Const, const V2, V2>;
+        using first_term = std::ranges::range_value_t<FirstBase>;
+        using second_term = std::ranges::range_value_t<SecondBase>;
+
+        Parent * _parent = nullptr;
+        std::ranges::iterator_t<FirstBase> _first_it{};
+        std::ranges::iterator_t<SecondBase> _second_it{};
+        bool _diagonal = false;
+
+        constexpr void restart_second() {
+            if constexpr(std::same_as<V1, V2>) {
+                if(_parent->_triangular) {
+                    _second_it = _first_it;
+                    _diagonal = true;
+                    return;
+                }
+            }
+            _second_it = std::ranges::begin(_parent->_second);
+        }
+        constexpr bool second_done() const {
+            if constexpr(std::same_as<V1, V2>) {
+                if(_parent->_triangular)
+                    return _second_it == std::ranges::end(_parent->_first);
+            }
+            return _second_it == std::ranges::end(_parent->_second);
+        }
+        constexpr bool done() const {
+            return _first_it == std::ranges::end(_parent->_first);
+        }
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::tuple<
+            std::decay_t<std::tuple_element_t<0, first_term>>,
+            std::decay_t<std::tuple_element_t<0, second_term>>,
+            std::decay_t<decltype(std::declval<std::tuple_element_t<
+                                      1, first_term>>() *
+                                  std::declval<std::tuple_element_t<
+                                      1, second_term>>())>>;
+        using reference = value_type;
+
+        iterator() = default;
+
+        constexpr explicit iterator(Parent & parent)
+            : _parent(std::addressof(parent))
+            , _first_it(std::ranges::begin(parent._first)) {
+            if(done()) return;
+            restart_second();
+            // an empty second range makes the whole product empty
+            if(second_done())
+                _first_it = std::ranges::next(
+                    _first_it, std::ranges::end(_parent->_first));
+        }
+
+        constexpr reference operator*() const {
+            auto && [v1, c1] = *_first_it;
+            auto && [v2, c2] = *_second_it;
+            auto c = c1 * c2;
+            if(_parent->_triangular && !_diagonal) c *= 2;
+            return value_type(v1, v2, c);
+        }
+
+        constexpr iterator & operator++() {
+            ++_second_it;
+            _diagonal = false;
+            if(second_done()) {
+                ++_first_it;
+                if(!done()) restart_second();
+            }
+            return *this;
+        }
+        constexpr iterator operator++(int) {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        friend constexpr bool operator==(const iterator & it,
+                                         std::default_sentinel_t) {
+            return it.done();
+        }
+        friend constexpr bool operator==(const iterator & lhs,
+                                         const iterator & rhs) {
+            return lhs._first_it == rhs._first_it &&
+                   lhs._second_it == rhs._second_it;
+        }
+    };
+
+public:
+    product_terms_view()
+        requires std::default_initializable<V1> &&
+                     std::default_initializable<V2>
+    = default;
+
+    constexpr product_terms_view(V1 first, V2 second,
+                                 const bool triangular = false)
+        : _first(std::move(first))
+        , _second(std::move(second))
+        , _triangular(triangular) {
+        if constexpr(!std::same_as<V1, V2>) _triangular = false;
+    }
+
+    constexpr auto begin() { return iterator<false>(*this); }
+    constexpr auto begin() const
+        requires std::ranges::forward_range<const V1> &&
+                 std::ranges::forward_range<const V2>
+    {
+        return iterator<true>(*this);
+    }
+
+    constexpr auto end() const noexcept { return std::default_sentinel; }
+
+    constexpr std::size_t size() const
+        requires std::ranges::sized_range<const V1> &&
+                 std::ranges::sized_range<const V2>
+    {
+        const auto n1 = static_cast<std::size_t>(std::ranges::size(_first));
+        if(_triangular) return n1 * (n1 + 1) / 2;
+        return n1 * static_cast<std::size_t>(std::ranges::size(_second));
+    }
+};
+
+template <typename R1, typename R2>
+product_terms_view(R1 &&, R2 &&)
+    -> product_terms_view<std::views::all_t<R1>, std::views::all_t<R2>>;
+template <typename R1, typename R2>
+product_terms_view(R1 &&, R2 &&, bool)
+    -> product_terms_view<std::views::all_t<R1>, std::views::all_t<R2>>;
+
+}  // namespace mippp::detail
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace mippp::detail {
+
+// Read-only handle on a cached array, indexed by uid or native id.
+template <typename Scalar>
+class shared_values {
+private:
+    std::shared_ptr<const Scalar[]> _values;
+
+public:
+    explicit shared_values(std::shared_ptr<const Scalar[]> values)
+        : _values(std::move(values)) {}
+
+    const Scalar & operator[](const std::size_t i) const noexcept {
+        return _values.get()[i];
+    }
+    const Scalar * data() const noexcept { return _values.get(); }
+};
+
+// Values fetched in bulk from the solver after a solve, e.g. the primal
+// solution. The array is shared with the mappings returned to the user, so
+// that get_solution() fetches it at most once per solve and never copies it.
+// A new array is allocated on the next fetch after invalidate(), the mappings
+// still alive keep the previous one.
+template <typename Scalar>
+class solution_cache {
+private:
+    std::shared_ptr<const Scalar[]> _values;
+    std::size_t _size = 0;
+
+public:
+    void invalidate() noexcept { _values.reset(); }
+
+    // nullptr if the values are not cached for this many entities
+    const Scalar * cached(const std::size_t size) const noexcept {
+        if(_values == nullptr || _size != size) return nullptr;
+        return _values.get();
+    }
+
+    template <typename Fetch>
+    shared_values<Scalar> get(const std::size_t size, Fetch && fetch) {
+        if(cached(size) == nullptr) {
+            auto values = std::make_shared_for_overwrite<Scalar[]>(size);
+            std::forward<Fetch>(fetch)(values.get());
+            _values = std::move(values);
+            _size = size;
+        }
+        return shared_values<Scalar>(_values);
+    }
+};
+
+}  // namespace mippp::detail
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -158,84 +163,214 @@ inline std::optional<std::filesystem::path> find_library_in_dir(
     return std::nullopt;
 }
 
-// Loads a solver's shared library as a `dylib::library`, resolving it with
-// the precedence shared by every `<solver>_api` backend (first match wins):
+// Process-wide cache of the solver libraries, shared by the `<solver>_api`
+// objects : a library is searched for and opened once per process, and the
+// apis constructed afterwards share its handle. Thread-safe.
 //
-//   1. `path`, if non-null: the exact library file, used verbatim;
-//   2. the `MIPPP_<key>_LIBRARY` env var (e.g. MIPPP_HIGHS_LIBRARY): idem,
-//      letting versioned sonames like libhighs.so.1.10.0 be pinned;
-//   3. each undecorated name of `names` ("highs" -> libhighs.so), in order,
-//      searched across the loader's directories — dylib 3.0 resolves paths
-//      only, so MIP++ searches itself. Several names cover solvers renamed
-//      across releases (Cbc: libCbc / libCbcSolver).
-inline dylib::library load_solver_library(
-    const char * path, const char * key,
-    std::initializer_list<const char *> names,
-    std::initializer_list<const char *> probe_symbols = {}) {
-    // a candidate must export `probe_symbols`: some distributions ship a
-    // matching name without the C API (Ubuntu's libCbc.so vs libCbcSolver.so)
-    const auto try_load =
-        [probe_symbols](const std::filesystem::path & p,
-                        std::string & err) -> std::optional<dylib::library> {
+// The search result of a key is kept, hence a library installed or moved
+// after the first successful search is only seen after clear(). Failures are
+// not cached. The handles live as long as the registry, or until clear() and
+// the destruction of the last api sharing them.
+class solver_library_registry {
+private:
+    using library_ptr = std::shared_ptr<const dylib::library>;
+
+    std::mutex _mutex;
+    std::optional<std::vector<std::filesystem::path>> _system_dirs;
+    std::map<std::string, std::filesystem::path, std::less<>> _found_paths;
+    std::map<std::filesystem::path, library_ptr> _libraries;
+
+    solver_library_registry() = default;
+
+    // The library at `p`, opened now or before, if it exports
+    // `probe_symbols`: some distributions ship a matching name without the C
+    // API (Ubuntu's libCbc.so vs libCbcSolver.so). Otherwise nullptr, with
+    // the reason appended to `err`.
+    library_ptr _open(const std::filesystem::path & p,
+                      std::initializer_list<const char *> probe_symbols,
+                      std::string & err) {
         try {
-            dylib::library lib{p};
+            library_ptr lib;
+            if(auto it = _libraries.find(p); it != _libraries.end())
+                lib = it->second;
+            else
+                lib = std::make_shared<const dylib::library>(p);
             for(auto && probe_symbol : probe_symbols)
-                lib.get_symbol(probe_symbol);
+                lib->get_symbol(probe_symbol);
+            _libraries.try_emplace(p, lib);
             return lib;
         } catch(const std::exception & e) {
             if(!err.empty()) err += "\n  ";
             err += p.string();
             err += ": ";
             err += e.what();
-            return std::nullopt;
+            return nullptr;
+        }
+    }
+
+public:
+    solver_library_registry(const solver_library_registry &) = delete;
+    solver_library_registry & operator=(const solver_library_registry &) =
+        delete;
+
+    static solver_library_registry & instance() {
+        static solver_library_registry registry;
+        return registry;
+    }
+
+    // see load_solver_library
+    library_ptr load(const char * path, const char * key,
+                     std::initializer_list<const char *> names,
+                     std::initializer_list<const char *> probe_symbols) {
+        std::lock_guard lock(_mutex);
+        std::string errors;
+        if(path != nullptr) {
+            if(auto lib = _open(std::filesystem::path(path), probe_symbols,
+                                errors))
+                return lib;
+            throw std::runtime_error("mippp: failed to load the " +
+                                     std::string(key) +
+                                     " solver library:\n  " + errors);
+        }
+
+        const std::string env_var =
+            detail::concat_str("MIPPP_", key, "_LIBRARY");
+        if(const char * full_path = std::getenv(env_var.c_str());
+           full_path != nullptr && *full_path != '\0') {
+            if(auto lib = _open(std::filesystem::path(full_path),
+                                probe_symbols, errors))
+                return lib;
+            throw std::runtime_error("mippp: failed to load the " +
+                                     std::string(key) +
+                                     " solver library from " + env_var +
+                                     ":\n  " + errors);
+        }
+
+        if(auto it = _found_paths.find(key); it != _found_paths.end())
+            if(auto lib = _open(it->second, probe_symbols, errors))
+                return lib;
+        const dylib::decorations decorations =
+            dylib::decorations::os_default();
+        if(!_system_dirs) _system_dirs = detail::system_library_dirs();
+        for(const char * n : names) {
+            const std::string base =
+                detail::concat_str(decorations.prefix, n);  // libfoo
+            const std::string decorated =
+                detail::concat_str(base, decorations.suffix);  // libfoo.so
+            for(const auto & directory : *_system_dirs) {
+                auto found = detail::find_library_in_dir(
+                    directory, base, decorated, decorations.suffix);
+                if(!found) continue;
+                if(auto lib = _open(*found, probe_symbols, errors)) {
+                    _found_paths.insert_or_assign(key, *found);
+                    return lib;
+                }
+            }
         }
-    };
 
-    std::string errors;
-    if(path != nullptr) {
-        if(auto lib = try_load(std::filesystem::path(path), errors))
-            return std::move(*lib);
-        throw std::runtime_error("mippp: failed to load the " +
-                                 std::string(key) + " solver library:\n  " +
-                                 errors);
+        std::string tried;
+        for(const char * n : names) {
+            if(!tried.empty()) tried += "', '";
+            tried += std::string(decorations.prefix) + n + decorations.suffix;
+        }
+        throw std::runtime_error(
+            "mippp: could not locate a usable " + std::string(key) +
+            " solver library (tried '" + tried + "')." +
+            (errors.empty() ? std::string{}
+                            : "\nCandidates rejected:\n  " + errors) +
+            "\nSet the environment variable " + env_var +
+            " to its full path, or add its directory to LD_LIBRARY_PATH.");
     }
 
-    const std::string env_var = detail::concat_str("MIPPP_", key, "_LIBRARY");
-    if(const char * full_path = std::getenv(env_var.c_str());
-       full_path != nullptr && *full_path != '\0') {
-        if(auto lib = try_load(std::filesystem::path(full_path), errors))
-            return std::move(*lib);
-        throw std::runtime_error("mippp: failed to load the " +
-                                 std::string(key) + " solver library from " +
-                                 env_var + ":\n  " + errors);
+    std::size_t num_libraries() {
+        std::lock_guard lock(_mutex);
+        return _libraries.size();
+    }
+    // Forgets the search results and the library handles, the apis still
+    // alive keep theirs.
+    void clear() {
+        std::lock_guard lock(_mutex);
+        _system_dirs.reset();
+        _found_paths.clear();
+        _libraries.clear();
     }
+};
 
-    const dylib::decorations decorations = dylib::decorations::os_default();
-    const auto directories = detail::system_library_dirs();
-    for(const char * n : names) {
-        const std::string base =
-            detail::concat_str(decorations.prefix, n);  // libfoo
-        const std::string decorated =
-            detail::concat_str(base, decorations.suffix);  // libfoo.so
-        for(const auto & directory : directories)
-            if(auto found = detail::find_library_in_dir(
-                   directory, base, decorated, decorations.suffix))
-                if(auto lib = try_load(*found, errors)) return std::move(*lib);
+// Loads a solver's shared library, resolving it with the precedence shared by
+// every `<solver>_api` backend (first match wins):
+//
+//   1. `path`, if non-null: the exact library file, used verbatim;
+//   2. the `MIPPP_<key>_LIBRARY` env var (e.g. MIPPP_HIGHS_LIBRARY): idem,
+//      letting versioned sonames like libhighs.so.1.10.0 be pinned;
+//   3. each undecorated name of `names` ("highs" -> libhighs.so), in order,
+//      searched across the loader's directories — dylib 3.0 resolves paths
+//      only, so MIP++ searches itself. Several names cover solvers renamed
+//      across releases (Cbc: libCbc / libCbcSolver).
+//
+// The library is opened once per process and shared, see
+// solver_library_registry.
+inline std::shared_ptr<const dylib::library> load_solver_library(
+    const char * path, const char * key,
+    std::initializer_list<const char *> names,
+    std::initializer_list<const char *> probe_symbols = {}) {
+    return solver_library_registry::instance().load(path, key, names,
+                                                    probe_symbols);
+}
+
+// A function of a solver library resolved on its first call rather than when
+// its api is constructed. It converts to the function pointer, hence is
+// called like one. A missing symbol then throws on its first call instead of
+// from the api constructor.
+template <typename F>
+class lazy_function {
+private:
+    const dylib::library * _lib;
+    const char * _name;
+    mutable std::atomic<F *> _function;
+
+    F * _resolve() const {
+        F * f = _lib->template get_function<F>(_name);
+        _function.store(f, std::memory_order_release);
+        return f;
     }
 
-    std::string tried;
-    for(const char * n : names) {
-        if(!tried.empty()) tried += "', '";
-        tried += std::string(decorations.prefix) + n + decorations.suffix;
+public:
+    lazy_function(const dylib::library & lib, const char * name)
+        : _lib(&lib), _name(name), _function(nullptr) {}
+    lazy_function(const lazy_function & other)
+        : _lib(other._lib)
+        , _name(other._name)
+        , _function(other._function.load(std::memory_order_acquire)) {}
+    lazy_function & operator=(const lazy_function &) = delete;
+
+    operator F *() const {
+        F * f = _function.load(std::memory_order_acquire);
+        return f != nullptr ? f : _resolve();
     }
-    throw std::runtime_error(
-        "mippp: could not locate a usable " + std::string(key) +
-        " solver library (tried '" + tried + "')." +
-        (errors.empty() ? std::string{}
-                        : "\nCandidates rejected:\n  " + errors) +
-        "\nSet the environment variable " + env_var +
-        " to its full path, or add its directory to LD_LIBRARY_PATH.");
+};
+
+// The functions of the `*_FUNCTIONS` lists of the apis are resolved when the
+// api is constructed, or on their first call if MIPPP_LAZY_SOLVER_SYMBOLS is
+// defined : most programs call a small part of a solver API, and resolving
+// the hundreds of symbols of a list shows in the startup of short-lived
+// processes. The optional functions, tested for nullptr, are always
+// resolved eagerly.
+#if MIPPP_LAZY_SOLVER_SYMBOLS
+template <typename F>
+using solver_function = lazy_function<F>;
+template <typename F>
+lazy_function<F> load_solver_function(const dylib::library & lib,
+                                      const char * name) {
+    return lazy_function<F>(lib, name);
 }
+#else
+template <typename F>
+using solver_function = F *;
+template <typename F>
+F * load_solver_function(const dylib::library & lib, const char * name) {
+    return lib.get_function<F>(name);
+}
+#endif
 
 // Warns on stderr when the loaded library's version differs from the one the
 // wrapper was written against — usually harmless (the C APIs are stable) but
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace mippp::detail {
+
+// Assembles the Hessian Q of a quadratic objective, 1/2 x^T Q x, from terms
+// c * x_i * x_j : a term adds 2c to Q_ii when i == j, and c to both Q_ij and
+// Q_ji otherwise. Only the lower triangle is stored, in CSC form : column j
+// holds the rows i >= j in increasing order, so the diagonal entry, when
+// present, comes first.
+//
+// The entries are ordered by two counting sorts, by row and then stably by
+// column, in O(nnz + n) time, and the entries of a same (i, j) end adjacent
+// and are merged in place. The buffers are kept between builds, so that
+// rebuilding a Hessian of similar size allocates nothing.
+template <typename Index, typename Scalar>
+class triangular_hessian {
+private:
+    std::vector<Index> _rows;
+    std::vector<Index> _cols;
+    std::vector<Scalar> _values;
+    std::vector<Index> _begins;
+    std::vector<Index> _indices;
+    std::vector<Scalar> _scalars;
+    std::vector<Index> _sorted_cols;
+
+public:
+    void clear() {
+        _rows.resize(0);
+        _cols.resize(0);
+        _values.resize(0);
+    }
+    void reserve(const std::size_t num_terms) {
+        _rows.reserve(num_terms);
+        _cols.reserve(num_terms);
+        _values.reserve(num_terms);
+    }
+    void add_term(Index i, Index j, const Scalar c) {
+        if(i == j) {
+            _rows.emplace_back(i);
+            _cols.emplace_back(j);
+            _values.emplace_back(2 * c);
+            return;
+        }
+        if(i < j) std::swap(i, j);
+        _rows.emplace_back(i);
+        _cols.emplace_back(j);
+        _values.emplace_back(c);
+    }
+
+    // With distinct, each unordered pair {i, j} is assumed to appear in at
+    // most one term and the merge pass is skipped.
+    template <bool distinct = false>
+    void build(const std::size_t num_variables) {
+        _counting_sort(_rows, _cols, _values, _indices, _sorted_cols,
+                       _scalars, _rows, num_variables);
+        _counting_sort(_indices, _sorted_cols, _scalars, _rows, _cols,
+                       _values, _sorted_cols, num_variables);
+        // the sorted entries are back in _rows, _cols and _values
+        if constexpr(!distinct) _merge_duplicates(num_variables);
+        std::swap(_indices, _rows);
+        std::swap(_scalars, _values);
+        _rows.resize(0);
+        _cols.resize(0);
+        _values.resize(0);
+    }
+
+    // column j holds the entries [begins()[j], begins()[j+1])
+    std::span<const Index> begins() const { return _begins; }
+    std::span<const Index> indices() const { return _indices; }
+    std::span<const Scalar> values() const { return _scalars; }
+    std::size_t num_entries() const { return _indices.size(); }
+
+private:
+    // Stable counting sort of the entries by key, from (rows, cols, values)
+    // into (out_rows, out_cols, out_values). Leaves in _begins the offsets
+    // of the n + 1 key buckets.
+    void _counting_sort(const std::vector<Index> & rows,
+                        const std::vector<Index> & cols,
+                        const std::vector<Scalar> & values,
+                        std::vector<Index> & out_rows,
+                        std::vector<Index> & out_cols,
+                        std::vector<Scalar> & out_values,
+                        const std::vector<Index> & keys, const std::size_t n) {
+        const std::size_t num_entries = values.size();
+        _begins.assign(n + 1, Index{0});
+        for(const Index key : keys)
+            ++_begins[static_cast<std::size_t>(key) + 1];
+        for(std::size_t k = 0; k < n; ++k) _begins[k + 1] += _begins[k];
+        out_rows.resize(num_entries);
+        out_cols.resize(num_entries);
+        out_values.resize(num_entries);
+        for(std::size_t e = 0; e < num_entries; ++e) {
+            const auto p = static_cast<std::size_t>(
+                _begins[static_cast<std::size_t>(keys[e])]++);
+            out_rows[p] = rows[e];
+            out_cols[p] = cols[e];
+            out_values[p] = values[e];
+        }
+        // the scatter advanced each offset to the end of its bucket
+        for(std::size_t k = n; k > 0; --k) _begins[k] = _begins[k - 1];
+        _begins[0] = Index{0};
+    }
+
+    void _merge_duplicates(const std::size_t n) {
+        std::size_t last = 0;
+        std::size_t first = 0;
+        for(std::size_t j = 0; j < n; ++j) {
+            const auto end = static_cast<std::size_t>(_begins[j + 1]);
+            _begins[j] = static_cast<Index>(last);
+            for(std::size_t e = first; e < end; ++e) {
+                if(last > static_cast<std::size_t>(_begins[j]) &&
+                   _rows[last - 1] == _rows[e]) {
+                    _values[last - 1] += _values[e];
+                    continue;
+                }
+                _rows[last] = _rows[e];
+                _values[last] = _values[e];
+                ++last;
+            }
+            first = end;
+        }
+        _begins[n] = static_cast<Index>(last);
+        _rows.resize(last);
+        _values.resize(last);
+    }
+};
+
+}  // namespace mippp::detail
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "mippp/io/lp_writer.hpp"
+#include "mippp/io/mps_reader.hpp"
+#include "mippp/io/mps_writer.hpp"
+#include "mippp/io/snapshot.hpp"
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "mippp/detail/chunked_writer.hpp"
+#include "mippp/io/model_source.hpp"
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp::io {
+namespace detail {
+
+inline std::string_view lp_sense(const constraint_sense sense) {
+    switch(sense) {
+        case constraint_sense::less_equal:
+            return " <= ";
+        case constraint_sense::greater_equal:
+            return " >= ";
+        default:
+            return " = ";
+    }
+}
+
+// Writes the terms of a row, breaking the line every few terms to stay far
+// below the 510 characters per line that CPLEX accepts.
+class lp_terms_writer {
+private:
+    mippp::detail::chunked_writer * _out;
+    std::size_t _num_terms = 0;
+
+    static constexpr std::size_t terms_per_line = 8;
+
+public:
+    explicit lp_terms_writer(mippp::detail::chunked_writer & out)
+        : _out(&out) {}
+
+    template <typename Source>
+    void write(const Source & source, std::size_t j, double coef) {
+        if(_num_terms > 0 && _num_terms % terms_per_line == 0)
+            *_out << "\n   ";
+        if(std::signbit(coef))
+            *_out << " - " << -coef << ' ';
+        else
+            *_out << " + " << coef << ' ';
+        source.write_variable_name(*_out, j);
+        ++_num_terms;
+    }
+    // rows without terms are not valid LP, they are written as 0 x0
+    template <typename Source>
+    void finish(const Source & source) {
+        if(_num_terms == 0 && source.num_variables() > 0)
+            write(source, 0, 0.0);
+    }
+};
+
+// The LP format lists the entries row by row : everything but the objective
+// coefficients is streamed in a single pass over the constraints.
+template <typename Source>
+void write_lp(std::ostream & os, const Source & source,
+              const write_options & options) {
+    mippp::detail::chunked_writer out(os, options.buffer_size);
+    const std::size_t num_variables = source.num_variables();
+
+    out << "\\ Problem name: " << options.name << '\n';
+    out << (source.maximize() ? "Maximize\n" : "Minimize\n") << " obj:";
+    {
+        const std::vector<double> objective = source.objective_coefficients();
+        lp_terms_writer terms(out);
+        for(std::size_t j = 0; j < num_variables; ++j)
+            if(objective[j] != 0.0) terms.write(source, j, objective[j]);
+        terms.finish(source);
+        const double offset = source.objective_offset();
+        if(offset != 0.0) {
+            if(std::signbit(offset))
+                out << " - " << -offset;
+            else
+                out << " + " << offset;
+        }
+        out << '\n';
+    }
+
+    out << "Subject To\n";
+    std::size_t i = 0;
+    for(auto && lc : source.constraints()) {
+        out << ' ';
+        source.write_constraint_name(out, i++);
+        out << ':';
+        lp_terms_writer terms(out);
+        for(auto && [var, coef] : lc.linear_terms())
+            terms.write(source, source.column_index(var),
+                        static_cast<double>(coef));
+        terms.finish(source);
+        out << lp_sense(lc.sense()) << static_cast<double>(lc.rhs()) << '\n';
+    }
+
+    out << "Bounds\n";
+    bool has_integers = false;
+    for(std::size_t j = 0; j < num_variables; ++j) {
+        const auto [lb, ub, integer] = source.column(j);
+        has_integers |= integer;
+        if(lb == 0.0 && std::isinf(ub) && ub > 0) continue;
+        out << ' ';
+        if(std::isinf(lb) && lb < 0 && std::isinf(ub) && ub > 0) {
+            source.write_variable_name(out, j);
+            out << " free\n";
+            continue;
+        }
+        if(lb == ub) {
+            source.write_variable_name(out, j);
+            out << " = " << lb << '\n';
+            continue;
+        }
+        out << lb << " <= ";  // -inf is a valid lower bound
+        source.write_variable_name(out, j);
+        out << " <= " << ub << '\n';
+    }
+
+    if(has_integers) {
+        out << "Generals\n";
+        std::size_t num_written = 0;
+        for(std::size_t j = 0; j < num_variables; ++j) {
+            if(!source.column(j).integer) continue;
+            if(num_written > 0 && num_written % 8 == 0) out << '\n';
+            out << ' ';
+            source.write_variable_name(out, j);
+            ++num_written;
+        }
+        out << '\n';
+    }
+    out << "End\n";
+}
+
+}  // namespace detail
+
+// Same as write_mps but in the CPLEX LP format, which is written in a
+// single pass over the constraints.
+template <linear_expression LE, std::ranges::input_range CR,
+          typename ColumnsLambda>
+    requires linear_constraint<std::ranges::range_value_t<CR>> &&
+             std::is_invocable_r_v<column_attributes, ColumnsLambda &,
+                                   std::size_t>
+void write_lp(std::ostream & os, std::size_t num_variables,
+              const LE & objective, CR && constraints,
+              ColumnsLambda && columns_lambda,
+              const write_options & options = {}) {
+    detail::write_lp(
+        os,
+        detail::stream_source(num_variables, objective, constraints,
+                              columns_lambda, options.maximize),
+        options);
+}
+template <linear_expression LE, std::ranges::input_range CR>
+    requires linear_constraint<std::ranges::range_value_t<CR>>
+void write_lp(std::ostream & os, std::size_t num_variables,
+              const LE & objective, CR && constraints,
+              const write_options & options = {}) {
+    write_lp(
+        os, num_variables, objective, constraints,
+        [](std::size_t) { return column_attributes{}; }, options);
+}
+
+// Same as write_mps for a built model, in the CPLEX LP format.
+template <typename M>
+    requires has_readable_objective<M> && has_readable_variables_bounds<M> &&
+             has_readable_constraints<M>
+void write_lp(std::ostream & os, M & model,
+              const write_options & options = {}) {
+    detail::write_lp(os, detail::model_source(model, options.maximize),
+                     options);
+}
+
+}  // namespace mippp::io
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp::io {
+
+struct read_options {
+    // give the names of the file to the model, when it supports names
+    bool read_names = false;
+    // rows are handed to add_constraints by batches of this many, which
+    // bounds the scratch memory the model uses to build the native rows, and
+    // so are the columns of a column-major snapshot to add_columns
+    std::size_t constraints_batch_size = 1u << 16;
+};
+
+template <typename M>
+struct read_result {
+    std::vector<model_variable_t<M>> variables;    // in file order
+    std::vector<model_constraint_t<M>> constraints;  // in file order
+};
+
+namespace detail {
+
+// The readers parse a file in flat arrays, then hand them to the model in
+// bulk through the helpers below.
+
+template <typename M>
+std::optional<model_scalar_t<M>> to_bound(const double b) {
+    if(std::isinf(b)) return std::nullopt;
+    return static_cast<model_scalar_t<M>>(b);
+}
+
+// Adds the columns j in [0, lower_bounds.size()) by runs of consecutive
+// columns with the same bounds and type, one add_variables or
+// add_integer_variables call per run.
+template <lp_model M, typename IsInteger>
+void add_variables_by_runs(M & model, std::span<const double> lower_bounds,
+                           std::span<const double> upper_bounds,
+                           IsInteger && is_integer,
+                           std::vector<model_variable_t<M>> & variables,
+                           std::string_view reader) {
+    const std::size_t num_columns = lower_bounds.size();
+    variables.reserve(variables.size() + num_columns);
+    for(std::size_t first = 0; first < num_columns;) {
+        const bool integer = is_integer(first);
+        std::size_t last = first + 1;
+        while(last < num_columns && is_integer(last) == integer &&
+              lower_bounds[last] == lower_bounds[first] &&
+              upper_bounds[last] == upper_bounds[first])
+            ++last;
+        model_variable_params_t<M> params;
+        params.obj_coef = model_scalar_t<M>{0};
+        params.lower_bound = to_bound<M>(lower_bounds[first]);
+        params.upper_bound = to_bound<M>(upper_bounds[first]);
+        if(!integer) {
+            std::ranges::copy(model.add_variables(last - first, params),
+                              std::back_inserter(variables));
+        } else if constexpr(milp_model<M>) {
+            std::ranges::copy(
+                model.add_integer_variables(last - first, params),
+                std::back_inserter(variables));
+        } else {
+            throw std::invalid_argument(std::string(reader) +
+                                        ": integer columns need a milp model");
+        }
+        first = last;
+    }
+}
+
+template <lp_model M>
+void set_dense_objective(M & model, const bool maximize,
+                         std::span<const double> coefs, const double offset,
+                         const std::vector<model_variable_t<M>> & variables) {
+    using scalar = model_scalar_t<M>;
+    if(maximize)
+        model.set_maximization();
+    else
+        model.set_minimization();
+    std::vector<std::size_t> nonzero_columns;
+    for(std::size_t j = 0; j < coefs.size(); ++j)
+        if(coefs[j] != 0.0) nonzero_columns.emplace_back(j);
+    model.set_objective(
+        distinct_variables,
+        linear_expression_view(
+            std::views::transform(nonzero_columns,
+                                  [&](std::size_t j) {
+                                      return std::make_pair(
+                                          variables[j],
+                                          static_cast<scalar>(coefs[j]));
+                                  }),
+            static_cast<scalar>(offset)));
+}
+
+// Adds the rows row_constraint(i) for i in [0, num_rows) by add_constraints
+// calls of options.constraints_batch_size rows.
+template <bool distinct, lp_model M, typename RowLambda>
+void add_constraints_by_batches(
+    M & model, const std::size_t num_rows, RowLambda && row_constraint,
+    const read_options & options,
+    std::vector<model_constraint_t<M>> & constraints) {
+    constraints.reserve(constraints.size() + num_rows);
+    const std::size_t batch_size =
+        std::max<std::size_t>(options.constraints_batch_size, 1);
+    for(std::size_t first = 0; first < num_rows; first += batch_size) {
+        const auto keys = std::views::iota(
+            first, std::min(first + batch_size, num_rows));
+        if constexpr(distinct)
+            std::ranges::copy(
+                model.add_constraints(distinct_variables, keys, row_constraint),
+                std::back_inserter(constraints));
+        else
+            std::ranges::copy(model.add_constraints(keys, row_constraint),
+                              std::back_inserter(constraints));
+    }
+}
+
+}  // namespace detail
+}  // namespace mippp::io
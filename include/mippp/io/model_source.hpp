@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "mippp/detail/chunked_writer.hpp"
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp::io {
+
+// Bounds and type of a column, as given to the writers by the columns
+// lambda of the stream overloads.
+struct column_attributes {
+    double lower_bound = 0.0;
+    double upper_bound = std::numeric_limits<double>::infinity();
+    bool integer = false;
+};
+
+struct write_options {
+    // objective sense of the stream overloads, and of the models that do not
+    // tell it with is_maximization()
+    bool maximize = false;
+    std::string_view name = "MIPPP";
+    // size of the chunks handed to the std::ostream
+    std::size_t buffer_size = 1u << 16;
+    // MPS only : the COLUMNS section is transposed by blocks of columns
+    // holding at most this many entries, and the constraints are read once
+    // per block. The memory used is bounded by about 16 bytes per entry.
+    std::size_t max_transposed_entries = 1u << 22;
+};
+
+namespace detail {
+
+template <typename Entity>
+Entity make_entity(const std::size_t i) {
+    using id_type = decltype(std::declval<const Entity &>().id());
+    return Entity(static_cast<id_type>(i));
+}
+
+// Writes names[i], or prefix followed by i when the name is missing.
+inline void write_name(mippp::detail::chunked_writer & out,
+                       const std::vector<std::string> & names,
+                       const char prefix, const std::size_t i) {
+    if(i < names.size() && !names[i].empty()) {
+        out << std::string_view(names[i]);
+        return;
+    }
+    out << prefix << i;
+}
+
+// The writers read a model through one of the two sources below : the
+// columns are numbered in [0, num_variables()), column_index(v) giving the
+// column of the variable v of a constraint, and the constraints by their
+// position in the range returned by constraints(), which is iterated once by
+// the LP writer and once per block of columns by the MPS writer.
+
+template <linear_expression LE, std::ranges::input_range CR,
+          typename ColumnsLambda>
+class stream_source {
+private:
+    std::size_t _num_variables;
+    const LE * _objective;
+    CR * _constraints;
+    ColumnsLambda * _columns_lambda;
+    bool _maximize;
+
+public:
+    stream_source(std::size_t num_variables, const LE & objective,
+                  CR & constraints, ColumnsLambda & columns_lambda,
+                  bool maximize)
+        : _num_variables(num_variables)
+        , _objective(&objective)
+        , _constraints(&constraints)
+        , _columns_lambda(&columns_lambda)
+        , _maximize(maximize) {}
+
+    std::size_t num_variables() const { return _num_variables; }
+    bool maximize() const { return _maximize; }
+    double objective_offset() const {
+        return static_cast<double>(_objective->constant());
+    }
+    std::vector<double> objective_coefficients() const {
+        std::vector<double> coefs(_num_variables, 0.0);
+        for(auto && [var, coef] : _objective->linear_terms())
+            coefs[column_index(var)] += static_cast<double>(coef);
+        return coefs;
+    }
+    CR & constraints() const { return *_constraints; }
+    template <typename Var>
+    std::size_t column_index(const Var & v) const {
+        if(v.uid() >= _num_variables)
+            throw std::invalid_argument(
+                "write: variable uid not in [0, num_variables)");
+        return v.uid();
+    }
+    column_attributes column(std::size_t j) const {
+        return (*_columns_lambda)(j);
+    }
+    void write_variable_name(mippp::detail::chunked_writer & out,
+                             std::size_t j) const {
+        out << 'x' << j;
+    }
+    void write_constraint_name(mippp::detail::chunked_writer & out,
+                               std::size_t i) const {
+        out << 'c' << i;
+    }
+};
+
+// A model without readable objective is read with a null objective. The uids
+// of a model whose variables were removed have holes, or are remapped, so
+// the columns are the variables listed by get_objective(), in its order.
+template <typename M>
+    requires has_readable_variables_bounds<M> && has_readable_constraints<M>
+class model_source {
+private:
+    using variable = model_variable_t<M>;
+    using constraint = model_constraint_t<M>;
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    M * _model;
+    bool _maximize;
+    std::vector<variable> _columns;
+    // the column of each uid, npos for the removed ones
+    std::vector<std::size_t> _column_indices;
+    // fetched once, the writers print each name several times
+    std::vector<std::string> _variable_names;
+    std::vector<std::string> _constraint_names;
+
+public:
+    model_source(M & model, bool maximize) : _model(&model) {
+        if constexpr(requires { model.is_maximization(); })
+            _maximize = model.is_maximization();
+        else
+            _maximize = maximize;
+        if constexpr(has_readable_objective<M>) {
+            auto objective = model.get_objective();
+            for(auto && [var, coef] : objective.linear_terms())
+                _columns.emplace_back(var);
+        } else {
+            static_assert(!has_remove_variable<M>,
+                          "the columns of a model with removed variables are "
+                          "listed by get_objective()");
+            _columns.reserve(model.num_variables());
+            for(std::size_t j = 0; j < model.num_variables(); ++j)
+                _columns.emplace_back(make_entity<variable>(j));
+        }
+        for(std::size_t j = 0; j < _columns.size(); ++j) {
+            const std::size_t uid = _columns[j].uid();
+            if(uid >= _column_indices.size())
+                _column_indices.resize(uid + 1, npos);
+            _column_indices[uid] = j;
+        }
+        if constexpr(has_named_variables<M>) {
+            _variable_names.reserve(_columns.size());
+            for(const variable & v : _columns)
+                _variable_names.emplace_back(model.get_variable_name(v));
+        }
+        if constexpr(has_named_constraints<M>) {
+            _constraint_names.reserve(model.num_constraints());
+            for(std::size_t i = 0; i < model.num_constraints(); ++i)
+                _constraint_names.emplace_back(
+                    model.get_constraint_name(make_entity<constraint>(i)));
+        }
+    }
+
+    std::size_t num_variables() const { return _columns.size(); }
+    bool maximize() const { return _maximize; }
+    double objective_offset() const {
+        if constexpr(has_readable_objective<M>)
+            return static_cast<double>(_model->get_objective_offset());
+        else
+            return 0.0;
+    }
+    std::vector<double> objective_coefficients() const {
+        std::vector<double> coefs(num_variables(), 0.0);
+        if constexpr(has_readable_objective<M>)
+            for(std::size_t j = 0; j < coefs.size(); ++j)
+                coefs[j] = static_cast<double>(
+                    _model->get_objective_coefficient(_columns[j]));
+        return coefs;
+    }
+    auto constraints() const {
+        return std::views::transform(
+            std::views::iota(std::size_t{0}, _model->num_constraints()),
+            [model = _model](std::size_t i) {
+                return model->get_constraint(make_entity<constraint>(i));
+            });
+    }
+    std::size_t column_index(const variable & v) const {
+        if(v.uid() >= _column_indices.size() ||
+           _column_indices[v.uid()] == npos)
+            throw std::invalid_argument("write: removed variable in a row");
+        return _column_indices[v.uid()];
+    }
+    column_attributes column(std::size_t j) const {
+        const variable & v = _columns[j];
+        column_attributes attributes{
+            .lower_bound =
+                static_cast<double>(_model->get_variable_lower_bound(v)),
+            .upper_bound =
+                static_cast<double>(_model->get_variable_upper_bound(v))};
+        if constexpr(requires { _model->is_integer(v); })
+            attributes.integer = _model->is_integer(v);
+        return attributes;
+    }
+    void write_variable_name(mippp::detail::chunked_writer & out,
+                             std::size_t j) const {
+        write_name(out, _variable_names, 'x', j);
+    }
+    void write_constraint_name(mippp::detail::chunked_writer & out,
+                               std::size_t i) const {
+        write_name(out, _constraint_names, 'c', i);
+    }
+    // the names given to the model, empty when missing
+    bool has_names() const {
+        return has_named_variables<M> || has_named_constraints<M>;
+    }
+    std::string_view variable_name(std::size_t j) const {
+        if(j < _variable_names.size()) return _variable_names[j];
+        return {};
+    }
+    std::string_view constraint_name(std::size_t i) const {
+        if(i < _constraint_names.size()) return _constraint_names[i];
+        return {};
+    }
+};
+
+// Transposes the constraints of source by blocks of consecutive columns
+// [first, last) holding at most max_entries entries, or a single column,
+// with one pass over the constraints per block. Calls
+// f(first, last, begins, rows, coefs) for each block : the entries of
+// column j are at [begins[j - first], begins[j - first + 1]) in rows and
+// coefs, sorted by row.
+template <typename Source, typename F>
+void for_each_column_block(const Source & source,
+                           const std::vector<std::size_t> & column_sizes,
+                           const std::size_t max_entries, F && f) {
+    const std::size_t num_variables = column_sizes.size();
+    std::vector<std::size_t> begins;
+    std::vector<std::size_t> cursors;
+    std::vector<std::size_t> rows;
+    std::vector<double> coefs;
+    for(std::size_t first = 0; first < num_variables;) {
+        std::size_t last = first + 1;
+        std::size_t block_size = column_sizes[first];
+        while(last < num_variables &&
+              block_size + column_sizes[last] <= max_entries)
+            block_size += column_sizes[last++];
+
+        begins.assign(last - first + 1, 0);
+        for(std::size_t j = first; j < last; ++j)
+            begins[j - first + 1] = begins[j - first] + column_sizes[j];
+        cursors.assign(begins.begin(), begins.end() - 1);
+        rows.resize(block_size);
+        coefs.resize(block_size);
+        if(block_size > 0) {
+            std::size_t i = 0;
+            for(auto && lc : source.constraints()) {
+                for(auto && [var, coef] : lc.linear_terms()) {
+                    const std::size_t j = source.column_index(var);
+                    if(j < first || j >= last) continue;
+                    std::size_t & cursor = cursors[j - first];
+                    rows[cursor] = i;
+                    coefs[cursor] = static_cast<double>(coef);
+                    ++cursor;
+                }
+                ++i;
+            }
+        }
+        f(first, last, std::as_const(begins), std::as_const(rows),
+          std::as_const(coefs));
+        first = last;
+    }
+}
+
+}  // namespace detail
+}  // namespace mippp::io
@@ -0,0 +1,403 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "mippp/container/unordered_dense_map.hpp"
+#include "mippp/detail/mapped_file.hpp"
+#include "mippp/io/model_loader.hpp"
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp::io {
+
+namespace detail {
+
+// Values at least this large are infinite bounds, as in most MPS writers.
+inline constexpr double mps_infinity = 1e30;
+
+// The whole file is parsed in CSC arrays first, as MPS lists the entries
+// column by column. Names are string_views into the file contents and never
+// copied, the tokens are parsed in place.
+class mps_parser {
+public:
+    enum class row_type : char { objective, ignored, constraint };
+
+    std::string_view contents;
+    std::size_t line_number = 0;
+
+    bool maximize = false;
+    double objective_offset = 0.0;
+    unordered_dense_map<std::string_view, std::size_t> row_indices;
+    bool has_objective_row = false;
+    std::vector<row_type> row_types;
+    std::vector<constraint_sense> row_senses;
+    std::vector<double> row_rhs;
+
+    unordered_dense_map<std::string_view, std::size_t> column_indices;
+    std::vector<std::string_view> column_names;
+    std::vector<std::size_t> column_begins;  // num_columns + 1 offsets
+    std::vector<std::size_t> entry_rows;
+    std::vector<double> entry_values;
+    std::vector<double> objective;
+    std::vector<double> lower_bounds;
+    std::vector<double> upper_bounds;
+    std::vector<bool> integers;
+
+private:
+    [[noreturn]] void _fail(std::string_view what) const {
+        throw std::runtime_error("read_mps: line " +
+                                 std::to_string(line_number) + ": " +
+                                 std::string(what));
+    }
+
+    double _parse_number(std::string_view token) const {
+        if(!token.empty() && token.front() == '+') token.remove_prefix(1);
+        double value;
+        const auto [ptr, ec] = std::from_chars(
+            token.data(), token.data() + token.size(), value);
+        if(ec != std::errc{} || ptr != token.data() + token.size())
+            _fail("invalid number");
+        return value;
+    }
+    std::size_t _row(std::string_view name) const {
+        auto it = row_indices.find(name);
+        if(it == row_indices.end()) _fail("unknown row");
+        return it->second;
+    }
+    std::size_t _column(std::string_view name) const {
+        auto it = column_indices.find(name);
+        if(it == column_indices.end()) _fail("unknown column");
+        return it->second;
+    }
+
+    void _parse_row(const std::array<std::string_view, 6> & tokens,
+                    std::size_t num_tokens) {
+        if(num_tokens != 2) _fail("expected a row type and a row name");
+        const std::size_t row = row_types.size();
+        if(!row_indices.try_emplace(tokens[1], row).second)
+            _fail("duplicate row");
+        switch(tokens[0].front()) {
+            case 'N':
+                // the rows after the objective one are free rows
+                row_types.emplace_back(has_objective_row ? row_type::ignored
+                                                         : row_type::objective);
+                has_objective_row = true;
+                row_senses.emplace_back(constraint_sense::equal);
+                break;
+            case 'L':
+                row_types.emplace_back(row_type::constraint);
+                row_senses.emplace_back(constraint_sense::less_equal);
+                break;
+            case 'G':
+                row_types.emplace_back(row_type::constraint);
+                row_senses.emplace_back(constraint_sense::greater_equal);
+                break;
+            case 'E':
+                row_types.emplace_back(row_type::constraint);
+                row_senses.emplace_back(constraint_sense::equal);
+                break;
+            default:
+                _fail("unknown row type");
+        }
+        row_rhs.emplace_back(0.0);
+    }
+    void _parse_column_entries(const std::array<std::string_view, 6> & tokens,
+                               std::size_t num_tokens, bool integer) {
+        if(num_tokens != 3 && num_tokens != 5)
+            _fail("expected a column name and pairs of row and value");
+        if(column_names.empty() || column_names.back() != tokens[0]) {
+            const std::size_t column = column_names.size();
+            if(!column_indices.try_emplace(tokens[0], column).second)
+                _fail("the entries of a column must be contiguous");
+            column_names.emplace_back(tokens[0]);
+            column_begins.emplace_back(entry_rows.size());
+            objective.emplace_back(0.0);
+            lower_bounds.emplace_back(0.0);
+            upper_bounds.emplace_back(std::numeric_limits<double>::infinity());
+            integers.emplace_back(integer);
+        }
+        for(std::size_t t = 1; t < num_tokens; t += 2) {
+            const std::size_t row = _row(tokens[t]);
+            const double value = _parse_number(tokens[t + 1]);
+            if(row_types[row] == row_type::objective) {
+                objective.back() += value;
+                continue;
+            }
+            if(row_types[row] == row_type::ignored) continue;
+            entry_rows.emplace_back(row);
+            entry_values.emplace_back(value);
+        }
+    }
+    void _parse_rhs(const std::array<std::string_view, 6> & tokens,
+                    std::size_t num_tokens) {
+        // the name of the rhs vector is optional in free MPS
+        const std::size_t first = num_tokens % 2;
+        if(num_tokens < 2 || num_tokens > 5)
+            _fail("expected pairs of row and value");
+        for(std::size_t t = first; t < num_tokens; t += 2) {
+            const std::size_t row = _row(tokens[t]);
+            const double value = _parse_number(tokens[t + 1]);
+            if(row_types[row] == row_type::objective)
+                objective_offset = -value;
+            else
+                row_rhs[row] = value;
+        }
+    }
+    void _parse_bound(const std::array<std::string_view, 6> & tokens,
+                      std::size_t num_tokens) {
+        const std::string_view type = tokens[0];
+        const bool has_value = !(type == "FR" || type == "MI" ||
+                                 type == "PL" || type == "BV");
+        // the name of the bound vector is optional in free MPS
+        std::size_t column_token = num_tokens - (has_value ? 2u : 1u);
+        // some writers give BV a value field, which is ignored : it is there
+        // on 4 tokens, and on 3 tokens when the last one is not a column
+        if(type == "BV" &&
+           (num_tokens == 4 ||
+            (num_tokens == 3 && !column_indices.contains(tokens[2]))))
+            --column_token;
+        if(column_token < 1 || column_token > 2)
+            _fail("expected a bound type, a column and a value");
+        const std::size_t j = _column(tokens[column_token]);
+        double value = 0.0;
+        if(has_value) {
+            value = _parse_number(tokens[column_token + 1]);
+            if(value >= mps_infinity)
+                value = std::numeric_limits<double>::infinity();
+            if(value <= -mps_infinity)
+                value = -std::numeric_limits<double>::infinity();
+        }
+        if(type == "UP") {
+            upper_bounds[j] = value;
+        } else if(type == "LO") {
+            lower_bounds[j] = value;
+        } else if(type == "FX") {
+            lower_bounds[j] = upper_bounds[j] = value;
+        } else if(type == "FR") {
+            lower_bounds[j] = -std::numeric_limits<double>::infinity();
+            upper_bounds[j] = std::numeric_limits<double>::infinity();
+        } else if(type == "MI") {
+            lower_bounds[j] = -std::numeric_limits<double>::infinity();
+        } else if(type == "PL") {
+            upper_bounds[j] = std::numeric_limits<double>::infinity();
+        } else if(type == "BV") {
+            integers[j] = true;
+            lower_bounds[j] = 0.0;
+            upper_bounds[j] = 1.0;
+        } else if(type == "LI") {
+            integers[j] = true;
+            lower_bounds[j] = value;
+        } else if(type == "UI") {
+            integers[j] = true;
+            upper_bounds[j] = value;
+        } else {
+            _fail("unsupported bound type");
+        }
+    }
+
+public:
+    explicit mps_parser(std::string_view file_contents)
+        : contents(file_contents) {}
+
+    void parse() {
+        _parse_lines();
+        column_begins.emplace_back(entry_rows.size());
+    }
+
+private:
+    void _parse_lines() {
+        enum class section {
+            none,
+            objsense,
+            rows,
+            columns,
+            rhs,
+            bounds
+        } current = section::none;
+        bool in_integer_block = false;
+        std::array<std::string_view, 6> tokens;
+        std::string_view remaining = contents;
+        while(!remaining.empty()) {
+            const std::size_t eol =
+                std::min(remaining.find('\n'), remaining.size());
+            std::string_view line = remaining.substr(0, eol);
+            remaining.remove_prefix(std::min(eol + 1, remaining.size()));
+            ++line_number;
+            if(!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if(line.empty() || line.front() == '*') continue;
+
+            std::size_t num_tokens = 0;
+            for(std::size_t pos = 0;;) {
+                pos = line.find_first_not_of(" \t", pos);
+                if(pos == std::string_view::npos) break;
+                if(num_tokens == tokens.size()) _fail("too many fields");
+                const std::size_t end =
+                    std::min(line.find_first_of(" \t", pos), line.size());
+                tokens[num_tokens++] = line.substr(pos, end - pos);
+                pos = end;
+            }
+            if(num_tokens == 0) continue;
+
+            // section headers start on the first column, data lines do not
+            if(line.front() != ' ' && line.front() != '\t') {
+                const std::string_view name = tokens[0];
+                if(name == "NAME") {
+                    current = section::none;
+                } else if(name == "OBJSENSE" || name == "OBJSENCE") {
+                    current = section::objsense;
+                    if(num_tokens > 1)
+                        maximize = tokens[1].starts_with("MAX");
+                } else if(name == "ROWS") {
+                    current = section::rows;
+                } else if(name == "COLUMNS") {
+                    current = section::columns;
+                } else if(name == "RHS") {
+                    current = section::rhs;
+                } else if(name == "BOUNDS") {
+                    current = section::bounds;
+                } else if(name == "ENDATA") {
+                    return;
+                } else {
+                    // RANGES, QUADOBJ, SOS, ... have no counterpart in the
+                    // linear models built by the reader
+                    _fail("unsupported section");
+                }
+                continue;
+            }
+            switch(current) {
+                case section::objsense:
+                    maximize = tokens[0].starts_with("MAX");
+                    break;
+                case section::rows:
+                    _parse_row(tokens, num_tokens);
+                    break;
+                case section::columns:
+                    if(num_tokens == 3 && tokens[1] == "'MARKER'") {
+                        in_integer_block = (tokens[2] == "'INTORG'");
+                        break;
+                    }
+                    _parse_column_entries(tokens, num_tokens,
+                                          in_integer_block);
+                    break;
+                case section::rhs:
+                    _parse_rhs(tokens, num_tokens);
+                    break;
+                case section::bounds:
+                    _parse_bound(tokens, num_tokens);
+                    break;
+                default:
+                    _fail("data line outside of a section");
+            }
+        }
+    }
+};
+
+template <lp_model M>
+read_result<M> load_mps(const mps_parser & mps, M & model,
+                        const read_options & options) {
+    using scalar = model_scalar_t<M>;
+    const std::size_t num_columns = mps.column_names.size();
+    read_result<M> result;
+    add_variables_by_runs(
+        model, mps.lower_bounds, mps.upper_bounds,
+        [&](std::size_t j) { return mps.integers[j]; }, result.variables,
+        "read_mps");
+    set_dense_objective(model, mps.maximize, mps.objective,
+                        mps.objective_offset, result.variables);
+
+    // CSC to CSR of the constraint rows, the N rows being dropped
+    const std::size_t num_rows = mps.row_types.size();
+    std::vector<std::size_t> constraint_rows;
+    std::vector<std::size_t> row_begins(num_rows + 1, 0);
+    for(std::size_t r = 0; r < num_rows; ++r)
+        if(mps.row_types[r] == mps_parser::row_type::constraint)
+            constraint_rows.emplace_back(r);
+    for(const std::size_t r : mps.entry_rows) ++row_begins[r + 1];
+    for(std::size_t r = 0; r < num_rows; ++r)
+        row_begins[r + 1] += row_begins[r];
+    std::vector<std::size_t> entry_columns(mps.entry_rows.size());
+    std::vector<scalar> entry_values(mps.entry_rows.size());
+    {
+        std::vector<std::size_t> cursors(row_begins.begin(),
+                                         row_begins.end() - 1);
+        for(std::size_t j = 0; j < num_columns; ++j) {
+            for(std::size_t e = mps.column_begins[j];
+                e < mps.column_begins[j + 1]; ++e) {
+                std::size_t & cursor = cursors[mps.entry_rows[e]];
+                entry_columns[cursor] = j;
+                entry_values[cursor] = static_cast<scalar>(mps.entry_values[e]);
+                ++cursor;
+            }
+        }
+    }
+    add_constraints_by_batches<false>(
+        model, constraint_rows.size(),
+        [&](std::size_t i) {
+            const std::size_t r = constraint_rows[i];
+            return linear_constraint_view(
+                linear_expression_view(
+                    std::views::iota(row_begins[r], row_begins[r + 1]) |
+                        std::views::transform([&](std::size_t e) {
+                            return std::make_pair(
+                                result.variables[entry_columns[e]],
+                                entry_values[e]);
+                        }),
+                    -static_cast<scalar>(mps.row_rhs[r])),
+                mps.row_senses[r]);
+        },
+        options, result.constraints);
+
+    if(options.read_names) {
+        if constexpr(has_named_variables<M>)
+            for(std::size_t j = 0; j < num_columns; ++j)
+                model.set_variable_name(result.variables[j],
+                                        std::string(mps.column_names[j]));
+        if constexpr(has_named_constraints<M>) {
+            std::vector<std::string_view> row_names(num_rows);
+            for(auto && [name, r] : mps.row_indices) row_names[r] = name;
+            for(std::size_t i = 0; i < constraint_rows.size(); ++i)
+                model.set_constraint_name(
+                    result.constraints[i],
+                    std::string(row_names[constraint_rows[i]]));
+        }
+    }
+    return result;
+}
+
+}  // namespace detail
+
+// Builds the free MPS model held in contents into model, without going
+// through the solver reader : the variables are added by runs of identical
+// bounds and types, then the rows by batches of
+// options.constraints_batch_size. Sections other than NAME, OBJSENSE, ROWS,
+// COLUMNS, RHS, BOUNDS and ENDATA, e.g. RANGES, are rejected.
+template <lp_model M>
+read_result<M> parse_mps(std::string_view contents, M & model,
+                         const read_options & options = {}) {
+    detail::mps_parser mps(contents);
+    mps.parse();
+    return detail::load_mps(mps, model, options);
+}
+
+// Same as parse_mps on the contents of a file, which is memory mapped rather
+// than read in memory.
+template <lp_model M>
+read_result<M> read_mps(const std::filesystem::path & path, M & model,
+                        const read_options & options = {}) {
+    const mippp::detail::mapped_file file(path);
+    return parse_mps(file.contents(), model, options);
+}
+
+}  // namespace mippp::io
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "mippp/detail/chunked_writer.hpp"
+#include "mippp/io/model_source.hpp"
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp::io {
+namespace detail {
+
+inline std::string_view mps_sense(const constraint_sense sense) {
+    switch(sense) {
+        case constraint_sense::less_equal:
+            return " L  ";
+        case constraint_sense::greater_equal:
+            return " G  ";
+        default:
+            return " E  ";
+    }
+}
+
+template <typename Source>
+void write_mps_bound(mippp::detail::chunked_writer & out,
+                     const Source & source, std::string_view type,
+                     std::size_t j) {
+    out << ' ' << type << " BND ";
+    source.write_variable_name(out, j);
+}
+
+// The rows are streamed to the ROWS section, while MPS lists the entries
+// column by column : the COLUMNS section is written by blocks of columns
+// holding at most options.max_transposed_entries entries.
+template <typename Source>
+void write_mps(std::ostream & os, const Source & source,
+               const write_options & options) {
+    mippp::detail::chunked_writer out(os, options.buffer_size);
+    const std::size_t num_variables = source.num_variables();
+
+    out << "NAME " << options.name << '\n';
+    if(source.maximize()) out << "OBJSENSE\n    MAX\n";
+    out << "ROWS\n N  obj\n";
+    std::vector<std::size_t> column_sizes(num_variables, 0);
+    std::vector<double> rhs;
+    for(auto && lc : source.constraints()) {
+        out << mps_sense(lc.sense());
+        source.write_constraint_name(out, rhs.size());
+        out << '\n';
+        for(auto && [var, coef] : lc.linear_terms())
+            ++column_sizes[source.column_index(var)];
+        rhs.emplace_back(static_cast<double>(lc.rhs()));
+    }
+
+    out << "COLUMNS\n";
+    const std::vector<double> objective = source.objective_coefficients();
+    bool in_integer_block = false;
+    std::size_t num_markers = 0;
+    const auto write_marker = [&](std::string_view type) {
+        out << "    M" << num_markers++ << "  'MARKER'  " << type << '\n';
+    };
+    const auto write_entry = [&](std::size_t j, auto && write_row_name,
+                                 double coef) {
+        out << "    ";
+        source.write_variable_name(out, j);
+        out << "  ";
+        write_row_name();
+        out << "  " << coef << '\n';
+    };
+    for_each_column_block(
+        source, column_sizes, options.max_transposed_entries,
+        [&](std::size_t first, std::size_t last, auto & begins, auto & rows,
+            auto & coefs) {
+            for(std::size_t j = first; j < last; ++j) {
+                const bool integer = source.column(j).integer;
+                if(integer != in_integer_block) {
+                    write_marker(integer ? "'INTORG'" : "'INTEND'");
+                    in_integer_block = integer;
+                }
+                const std::size_t end = begins[j - first + 1];
+                // an empty column is declared by its objective entry
+                if(objective[j] != 0.0 || begins[j - first] == end)
+                    write_entry(j, [&] { out << "obj"; }, objective[j]);
+                // the entries of a row are contiguous, its duplicates are
+                // merged here
+                for(std::size_t k = begins[j - first]; k < end;) {
+                    const std::size_t row = rows[k];
+                    double coef = coefs[k];
+                    for(++k; k < end && rows[k] == row; ++k) coef += coefs[k];
+                    write_entry(
+                        j, [&] { source.write_constraint_name(out, row); },
+                        coef);
+                }
+            }
+        });
+    if(in_integer_block) write_marker("'INTEND'");
+
+    out << "RHS\n";
+    if(source.objective_offset() != 0.0)
+        out << "    RHS  obj  " << -source.objective_offset() << '\n';
+    for(std::size_t i = 0; i < rhs.size(); ++i) {
+        if(rhs[i] == 0.0) continue;
+        out << "    RHS  ";
+        source.write_constraint_name(out, i);
+        out << "  " << rhs[i] << '\n';
+    }
+
+    // integer columns get explicit bounds : some readers default them to
+    // binary when no bound is given
+    out << "BOUNDS\n";
+    for(std::size_t j = 0; j < num_variables; ++j) {
+        const auto [lb, ub, integer] = source.column(j);
+        if(std::isinf(lb) && lb < 0 && std::isinf(ub) && ub > 0) {
+            write_mps_bound(out, source, "FR", j);
+            out << '\n';
+            continue;
+        }
+        if(lb == ub) {
+            write_mps_bound(out, source, "FX", j);
+            out << "  " << lb << '\n';
+            continue;
+        }
+        if(std::isinf(lb)) {
+            write_mps_bound(out, source, "MI", j);
+            out << '\n';
+        } else if(lb != 0.0 || integer || ub < 0.0) {
+            write_mps_bound(out, source, "LO", j);
+            out << "  " << lb << '\n';
+        }
+        if(!std::isinf(ub)) {
+            write_mps_bound(out, source, "UP", j);
+            out << "  " << ub << '\n';
+        } else if(integer) {
+            write_mps_bound(out, source, "PL", j);
+            out << '\n';
+        }
+    }
+    out << "ENDATA\n";
+}
+
+}  // namespace detail
+
+// Writes the model
+//   minimize (or maximize) objective
+//   subject to constraints
+//   with the variables of uids in [0, num_variables), in [0, +inf) or with
+//   the bounds and type given by columns_lambda(uid)
+// in free MPS format, without building it in a solver. The constraints range
+// is iterated several times and its constraints are named c0, c1, ... in
+// iteration order, the variables x0, x1, ... by uid.
+template <linear_expression LE, std::ranges::forward_range CR,
+          typename ColumnsLambda>
+    requires linear_constraint<std::ranges::range_value_t<CR>> &&
+             std::is_invocable_r_v<column_attributes, ColumnsLambda &,
+                                   std::size_t>
+void write_mps(std::ostream & os, std::size_t num_variables,
+               const LE & objective, CR && constraints,
+               ColumnsLambda && columns_lambda,
+               const write_options & options = {}) {
+    detail::write_mps(
+        os,
+        detail::stream_source(num_variables, objective, constraints,
+                              columns_lambda, options.maximize),
+        options);
+}
+template <linear_expression LE, std::ranges::forward_range CR>
+    requires linear_constraint<std::ranges::range_value_t<CR>>
+void write_mps(std::ostream & os, std::size_t num_variables,
+               const LE & objective, CR && constraints,
+               const write_options & options = {}) {
+    write_mps(
+        os, num_variables, objective, constraints,
+        [](std::size_t) { return column_attributes{}; }, options);
+}
+
+// Writes a built model in free MPS format, with its variables and
+// constraints names when it has some. The columns are the variables listed
+// by get_objective(), in its order, so that the variables removed from the
+// model are skipped, and the constraints are those of ids in
+// [0, num_constraints()).
+template <typename M>
+    requires has_readable_objective<M> && has_readable_variables_bounds<M> &&
+             has_readable_constraints<M>
+void write_mps(std::ostream & os, M & model,
+               const write_options & options = {}) {
+    detail::write_mps(os, detail::model_source(model, options.maximize),
+                      options);
+}
+
+}  // namespace mippp::io
@@ -0,0 +1,554 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "mippp/detail/chunked_writer.hpp"
+#include "mippp/detail/mapped_file.hpp"
+#include "mippp/io/model_loader.hpp"
+#include "mippp/io/model_source.hpp"
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp::io {
+
+enum class snapshot_layout : std::uint8_t { row_major, column_major };
+
+struct snapshot_options {
+    // column_major stores the matrix in the CSC arrays that the column
+    // oriented solvers take as is, see read_snapshot
+    snapshot_layout layout = snapshot_layout::row_major;
+    // store the names of the variables and constraints, if the model has some
+    bool names = false;
+    // objective sense of the models that do not tell it with is_maximization()
+    bool maximize = false;
+    // size of the chunks handed to the std::ostream
+    std::size_t buffer_size = 1u << 16;
+    // column_major only : the matrix is transposed by blocks of columns
+    // holding at most this many entries, as for write_mps
+    std::size_t max_transposed_entries = 1u << 22;
+};
+
+namespace detail {
+
+// A snapshot is the header below followed by the sections
+//   objective, lower bounds, upper bounds : double[num_variables]
+//   rhs : double[num_constraints]
+//   begins : uint64[num_major + 1], num_major being the number of rows in
+//            the row-major layout and the number of columns in the other
+//   values : double[num_entries]
+//   indices : uint32[num_entries], of columns or rows respectively
+//   types : uint8[num_variables], 1 for the integer variables
+//   senses : int8[num_constraints], as constraint_sense
+// then, with the has_names flag,
+//   name offsets : uint64[num_variables + num_constraints + 1]
+//   name characters : char[name_offsets.back()], variables first
+// each section starting at a multiple of 8 bytes. The entries of a row (or
+// column) are distinct. Numbers are stored in the byte order of the writer,
+// which the reader checks, so that the sections of a memory mapped snapshot
+// are read in place.
+struct snapshot_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint32_t byte_order_mark;
+    std::uint32_t reserved;
+    std::uint64_t num_variables;
+    std::uint64_t num_constraints;
+    std::uint64_t num_entries;
+    double objective_offset;
+};
+static_assert(sizeof(snapshot_header) % 8 == 0);
+
+inline constexpr char snapshot_magic[8] = {'M', 'I', 'P', 'P',
+                                           'P', 'S', 'N', 'P'};
+inline constexpr std::uint32_t snapshot_version = 1;
+inline constexpr std::uint32_t snapshot_byte_order_mark = 0x01020304u;
+
+enum snapshot_flags : std::uint32_t {
+    snapshot_column_major = 1u << 0,
+    snapshot_maximize = 1u << 1,
+    snapshot_has_names = 1u << 2
+};
+
+inline void write_padding(mippp::detail::chunked_writer & out,
+                          const std::size_t section_size) {
+    for(std::size_t k = section_size; k % 8 != 0; ++k) out << '\0';
+}
+
+// Sums the terms of a row on the same column, in the order of their first
+// occurrence, with a dense position per column.
+class row_merger {
+private:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> _positions;
+
+public:
+    std::vector<std::pair<std::size_t, double>> entries;
+
+    explicit row_merger(const std::size_t num_variables)
+        : _positions(num_variables, npos) {}
+
+    template <typename Source, typename LC>
+    void merge(const Source & source, const LC & lc) {
+        entries.resize(0);
+        for(auto && [var, coef] : lc.linear_terms()) {
+            const std::size_t j = source.column_index(var);
+            std::size_t & position = _positions[j];
+            if(position != npos) {
+                entries[position].second += static_cast<double>(coef);
+                continue;
+            }
+            position = entries.size();
+            entries.emplace_back(j, static_cast<double>(coef));
+        }
+        for(auto && [j, coef] : entries) _positions[j] = npos;
+    }
+};
+
+// Calls f(row, coef) for the entries of the columns in order, the entries of
+// a column on the same row being summed as by row_merger.
+template <typename Source, typename F>
+void for_each_merged_column_entry(const Source & source,
+                                  const std::vector<std::size_t> & column_sizes,
+                                  const std::size_t max_entries, F && f) {
+    for_each_column_block(
+        source, column_sizes, max_entries,
+        [&](std::size_t first, std::size_t last, auto & begins, auto & rows,
+            auto & coefs) {
+            for(std::size_t j = first; j < last; ++j) {
+                const std::size_t end = begins[j - first + 1];
+                for(std::size_t k = begins[j - first]; k < end;) {
+                    const std::size_t row = rows[k];
+                    double coef = coefs[k];
+                    for(++k; k < end && rows[k] == row; ++k) coef += coefs[k];
+                    f(row, coef);
+                }
+            }
+        });
+}
+
+// The rows are read once to size the sections, then once per section of
+// entries in the row-major layout. The column-major layout transposes the
+// matrix by blocks for each of these sections, as write_mps does.
+template <typename Source>
+void write_snapshot(std::ostream & os, const Source & source,
+                    const snapshot_options & options) {
+    const std::size_t num_variables = source.num_variables();
+    const bool column_major =
+        options.layout == snapshot_layout::column_major;
+    const bool names = options.names && source.has_names();
+
+    row_merger merger(num_variables);
+    std::vector<std::uint64_t> row_begins{0};
+    std::vector<std::size_t> column_sizes(column_major ? num_variables : 0, 0);
+    std::vector<std::uint64_t> column_begins(
+        column_major ? num_variables + 1 : 0, 0);
+    std::vector<double> rhs;
+    std::vector<std::int8_t> senses;
+    for(auto && lc : source.constraints()) {
+        merger.merge(source, lc);
+        row_begins.emplace_back(row_begins.back() + merger.entries.size());
+        if(column_major) {
+            for(auto && [var, coef] : lc.linear_terms())
+                ++column_sizes[source.column_index(var)];
+            for(auto && [j, coef] : merger.entries) ++column_begins[j + 1];
+        }
+        rhs.emplace_back(static_cast<double>(lc.rhs()));
+        senses.emplace_back(static_cast<std::int8_t>(lc.sense()));
+    }
+    const std::size_t num_constraints = rhs.size();
+    if(std::max(num_variables, num_constraints) >
+       std::numeric_limits<std::uint32_t>::max())
+        throw std::invalid_argument(
+            "write_snapshot: more than 2^32 variables or constraints");
+
+    snapshot_header header{};
+    std::ranges::copy(snapshot_magic, header.magic);
+    header.version = snapshot_version;
+    header.flags = (column_major ? snapshot_column_major : 0u) |
+                   (source.maximize() ? snapshot_maximize : 0u) |
+                   (names ? snapshot_has_names : 0u);
+    header.byte_order_mark = snapshot_byte_order_mark;
+    header.num_variables = num_variables;
+    header.num_constraints = num_constraints;
+    header.num_entries = row_begins.back();
+    header.objective_offset = source.objective_offset();
+
+    mippp::detail::chunked_writer out(os, options.buffer_size);
+    out.write_binary(header);
+    for(const double c : source.objective_coefficients()) out.write_binary(c);
+    for(std::size_t j = 0; j < num_variables; ++j)
+        out.write_binary(source.column(j).lower_bound);
+    for(std::size_t j = 0; j < num_variables; ++j)
+        out.write_binary(source.column(j).upper_bound);
+    for(const double b : rhs) out.write_binary(b);
+    if(column_major) {
+        for(std::size_t j = 0; j < num_variables; ++j)
+            column_begins[j + 1] += column_begins[j];
+        for(const std::uint64_t b : column_begins) out.write_binary(b);
+        for_each_merged_column_entry(
+            source, column_sizes, options.max_transposed_entries,
+            [&](std::size_t, double coef) { out.write_binary(coef); });
+        for_each_merged_column_entry(
+            source, column_sizes, options.max_transposed_entries,
+            [&](std::size_t i, double) {
+                out.write_binary(static_cast<std::uint32_t>(i));
+            });
+    } else {
+        for(const std::uint64_t b : row_begins) out.write_binary(b);
+        for(auto && lc : source.constraints()) {
+            merger.merge(source, lc);
+            for(auto && [j, coef] : merger.entries) out.write_binary(coef);
+        }
+        for(auto && lc : source.constraints()) {
+            merger.merge(source, lc);
+            for(auto && [j, coef] : merger.entries)
+                out.write_binary(static_cast<std::uint32_t>(j));
+        }
+    }
+    write_padding(out, row_begins.back() * sizeof(std::uint32_t));
+    for(std::size_t j = 0; j < num_variables; ++j)
+        out.write_binary(static_cast<std::uint8_t>(source.column(j).integer));
+    write_padding(out, num_variables);
+    for(const std::int8_t s : senses) out.write_binary(s);
+    write_padding(out, num_constraints);
+
+    if(!names) return;
+    std::uint64_t offset = 0;
+    out.write_binary(offset);
+    for(std::size_t j = 0; j < num_variables; ++j)
+        out.write_binary(offset += source.variable_name(j).size());
+    for(std::size_t i = 0; i < num_constraints; ++i)
+        out.write_binary(offset += source.constraint_name(i).size());
+    for(std::size_t j = 0; j < num_variables; ++j)
+        out << source.variable_name(j);
+    for(std::size_t i = 0; i < num_constraints; ++i)
+        out << source.constraint_name(i);
+    write_padding(out, static_cast<std::size_t>(offset));
+}
+
+// The sections of a snapshot, viewed in place in its contents.
+struct snapshot_view {
+    snapshot_header header;
+    std::span<const double> objective;
+    std::span<const double> lower_bounds;
+    std::span<const double> upper_bounds;
+    std::span<const double> rhs;
+    std::span<const std::uint64_t> begins;
+    std::span<const double> values;
+    std::span<const std::uint32_t> indices;
+    std::span<const std::uint8_t> types;
+    std::span<const std::int8_t> senses;
+    std::span<const std::uint64_t> name_offsets;
+    std::string_view name_characters;
+
+    bool column_major() const {
+        return (header.flags & snapshot_column_major) != 0;
+    }
+    bool maximize() const { return (header.flags & snapshot_maximize) != 0; }
+    std::string_view name(const std::size_t k) const {
+        const auto first = static_cast<std::size_t>(name_offsets[k]);
+        return name_characters.substr(
+            first, static_cast<std::size_t>(name_offsets[k + 1]) - first);
+    }
+};
+
+[[noreturn]] inline void snapshot_error(const char * what) {
+    throw std::runtime_error(std::string("read_snapshot: ") + what);
+}
+
+// Hands out the consecutive 8-byte aligned sections of contents, whose data
+// must be 8-byte aligned.
+class snapshot_sections {
+private:
+    std::string_view _contents;
+    std::size_t _position;
+
+public:
+    snapshot_sections(std::string_view contents, std::size_t position)
+        : _contents(contents), _position(position) {}
+
+    template <typename T>
+    std::span<const T> take(const std::uint64_t count) {
+        if(count > (_contents.size() - _position) / sizeof(T))
+            snapshot_error("truncated contents");
+        const std::span<const T> section(
+            reinterpret_cast<const T *>(_contents.data() + _position),
+            static_cast<std::size_t>(count));
+        _position = std::min(
+            _contents.size(),
+            _position + (static_cast<std::size_t>(count) * sizeof(T) + 7) /
+                            8 * 8);
+        return section;
+    }
+};
+
+// Checks the header, the matrix indices and the constraint senses, so that a
+// corrupted snapshot throws instead of reading out of the mapped memory or
+// casting to an invalid constraint_sense.
+inline snapshot_view parse_snapshot_sections(std::string_view contents) {
+    snapshot_view s;
+    if(contents.size() < sizeof(snapshot_header))
+        snapshot_error("truncated contents");
+    std::memcpy(&s.header, contents.data(), sizeof(snapshot_header));
+    if(!std::ranges::equal(s.header.magic, snapshot_magic))
+        snapshot_error("not a snapshot");
+    if(s.header.byte_order_mark != snapshot_byte_order_mark)
+        snapshot_error("written with another byte order");
+    if(s.header.version != snapshot_version)
+        snapshot_error("unsupported version");
+
+    const std::uint64_t n = s.header.num_variables;
+    const std::uint64_t m = s.header.num_constraints;
+    const std::uint64_t nnz = s.header.num_entries;
+    snapshot_sections sections(contents, sizeof(snapshot_header));
+    s.objective = sections.take<double>(n);
+    s.lower_bounds = sections.take<double>(n);
+    s.upper_bounds = sections.take<double>(n);
+    s.rhs = sections.take<double>(m);
+    s.begins = sections.take<std::uint64_t>((s.column_major() ? n : m) + 1);
+    s.values = sections.take<double>(nnz);
+    s.indices = sections.take<std::uint32_t>(nnz);
+    s.types = sections.take<std::uint8_t>(n);
+    s.senses = sections.take<std::int8_t>(m);
+    if(s.header.flags & snapshot_has_names) {
+        s.name_offsets = sections.take<std::uint64_t>(n + m + 1);
+        const auto characters = sections.take<char>(s.name_offsets.back());
+        s.name_characters =
+            std::string_view(characters.data(), characters.size());
+    }
+
+    if(s.begins.front() != 0 || s.begins.back() != nnz ||
+       !std::ranges::is_sorted(s.begins))
+        snapshot_error("invalid matrix begins");
+    const std::uint64_t num_minor = s.column_major() ? m : n;
+    if(std::ranges::any_of(s.indices,
+                           [&](std::uint32_t k) { return k >= num_minor; }))
+        snapshot_error("invalid matrix indices");
+    if(std::ranges::any_of(s.senses, [](std::int8_t sense) {
+           return sense < constraint_sense::less_equal ||
+                  sense > constraint_sense::greater_equal;
+       }))
+        snapshot_error("invalid constraint senses");
+    if(!s.name_offsets.empty() && (s.name_offsets.front() != 0 ||
+                                   !std::ranges::is_sorted(s.name_offsets)))
+        snapshot_error("invalid name offsets");
+    return s;
+}
+
+template <lp_model M, typename Begins, typename Columns, typename Values>
+void add_snapshot_rows(M & model, const snapshot_view & snapshot,
+                       const Begins & begins, const Columns & columns,
+                       const Values & values, const read_options & options,
+                       read_result<M> & result) {
+    using scalar = model_scalar_t<M>;
+    add_constraints_by_batches<true>(
+        model, snapshot.rhs.size(),
+        [&](std::size_t i) {
+            return linear_constraint_view(
+                linear_expression_view(
+                    std::views::iota(static_cast<std::size_t>(begins[i]),
+                                     static_cast<std::size_t>(begins[i + 1])) |
+                        std::views::transform([&](std::size_t k) {
+                            return std::make_pair(
+                                result.variables[columns[k]],
+                                static_cast<scalar>(values[k]));
+                        }),
+                    -static_cast<scalar>(snapshot.rhs[i])),
+                static_cast<constraint_sense>(snapshot.senses[i]));
+        },
+        options, result.constraints);
+}
+
+// Column-major snapshots given to models with a bulk add_columns : the rows
+// are added empty, then filled by the columns read in place.
+template <lp_model M>
+    requires has_add_columns<M>
+void add_snapshot_columns(M & model, const snapshot_view & snapshot,
+                          const read_options & options,
+                          read_result<M> & result) {
+    using scalar = model_scalar_t<M>;
+    using variable = model_variable_t<M>;
+    const std::size_t num_variables = snapshot.objective.size();
+    if constexpr(!milp_model<M>) {
+        if(std::ranges::any_of(snapshot.types,
+                               [](std::uint8_t t) { return t != 0; }))
+            throw std::invalid_argument(
+                "read_snapshot: integer columns need a milp model");
+    }
+    if(snapshot.maximize())
+        model.set_maximization();
+    else
+        model.set_minimization();
+    model.set_objective_offset(
+        static_cast<scalar>(snapshot.header.objective_offset));
+    add_constraints_by_batches<true>(
+        model, snapshot.rhs.size(),
+        [&](std::size_t i) {
+            return linear_constraint_view(
+                linear_expression_view(
+                    std::views::empty<std::pair<variable, scalar>>,
+                    -static_cast<scalar>(snapshot.rhs[i])),
+                static_cast<constraint_sense>(snapshot.senses[i]));
+        },
+        options, result.constraints);
+
+    const auto column_entries = [&](std::size_t j) {
+        return std::views::iota(static_cast<std::size_t>(snapshot.begins[j]),
+                                static_cast<std::size_t>(
+                                    snapshot.begins[j + 1])) |
+               std::views::transform([&](std::size_t k) {
+                   return std::make_pair(
+                       result.constraints[snapshot.indices[k]],
+                       static_cast<scalar>(snapshot.values[k]));
+               });
+    };
+    const auto column_params = [&](std::size_t j) {
+        model_variable_params_t<M> params;
+        params.obj_coef = static_cast<scalar>(snapshot.objective[j]);
+        params.lower_bound = to_bound<M>(snapshot.lower_bounds[j]);
+        params.upper_bound = to_bound<M>(snapshot.upper_bounds[j]);
+        return params;
+    };
+    result.variables.reserve(num_variables);
+    const std::size_t batch_size =
+        std::max<std::size_t>(options.constraints_batch_size, 1);
+    for(std::size_t first = 0; first < num_variables; first += batch_size) {
+        const auto keys = std::views::iota(
+            first, std::min(first + batch_size, num_variables));
+        std::ranges::copy(
+            model.add_columns(keys, column_entries, column_params),
+            std::back_inserter(result.variables));
+    }
+    if constexpr(milp_model<M>) {
+        for(std::size_t j = 0; j < num_variables; ++j)
+            if(snapshot.types[j] != 0) model.set_integer(result.variables[j]);
+    }
+}
+
+template <lp_model M>
+void set_snapshot_names(M & model, const snapshot_view & snapshot,
+                        const read_options & options,
+                        const read_result<M> & result) {
+    if(!options.read_names || snapshot.name_offsets.empty()) return;
+    const std::size_t num_variables = result.variables.size();
+    if constexpr(has_named_variables<M>)
+        for(std::size_t j = 0; j < num_variables; ++j)
+            if(auto name = snapshot.name(j); !name.empty())
+                model.set_variable_name(result.variables[j],
+                                        std::string(name));
+    if constexpr(has_named_constraints<M>)
+        for(std::size_t i = 0; i < result.constraints.size(); ++i)
+            if(auto name = snapshot.name(num_variables + i); !name.empty())
+                model.set_constraint_name(result.constraints[i],
+                                          std::string(name));
+}
+
+template <lp_model M>
+read_result<M> load_snapshot(const snapshot_view & snapshot, M & model,
+                             const read_options & options) {
+    read_result<M> result;
+    if constexpr(has_add_columns<M>) {
+        if(snapshot.column_major()) {
+            add_snapshot_columns(model, snapshot, options, result);
+            set_snapshot_names(model, snapshot, options, result);
+            return result;
+        }
+    }
+    add_variables_by_runs(
+        model, snapshot.lower_bounds, snapshot.upper_bounds,
+        [&](std::size_t j) { return snapshot.types[j] != 0; },
+        result.variables, "read_snapshot");
+    set_dense_objective(model, snapshot.maximize(), snapshot.objective,
+                        snapshot.header.objective_offset, result.variables);
+    if(!snapshot.column_major()) {
+        add_snapshot_rows(model, snapshot, snapshot.begins, snapshot.indices,
+                          snapshot.values, options, result);
+    } else {
+        // CSC to CSR, for the models that only take rows
+        const std::size_t num_constraints = snapshot.rhs.size();
+        std::vector<std::size_t> row_begins(num_constraints + 1, 0);
+        for(const std::uint32_t i : snapshot.indices) ++row_begins[i + 1];
+        for(std::size_t i = 0; i < num_constraints; ++i)
+            row_begins[i + 1] += row_begins[i];
+        std::vector<std::size_t> entry_columns(snapshot.indices.size());
+        std::vector<double> entry_values(snapshot.indices.size());
+        std::vector<std::size_t> cursors(row_begins.begin(),
+                                         row_begins.end() - 1);
+        for(std::size_t j = 0; j < result.variables.size(); ++j) {
+            for(auto k = snapshot.begins[j]; k < snapshot.begins[j + 1]; ++k) {
+                std::size_t & cursor = cursors[snapshot.indices[k]];
+                entry_columns[cursor] = j;
+                entry_values[cursor] = snapshot.values[k];
+                ++cursor;
+            }
+        }
+        add_snapshot_rows(model, snapshot, row_begins, entry_columns,
+                          entry_values, options, result);
+    }
+    set_snapshot_names(model, snapshot, options, result);
+    return result;
+}
+
+}  // namespace detail
+
+// Writes a built model in the binary snapshot format : its bounds, objective,
+// variables types, constraint matrix and, on demand, names. The matrix is
+// stored row-major, or column-major for the loaders of column oriented
+// solvers.
+template <typename M>
+    requires has_readable_variables_bounds<M> && has_readable_constraints<M>
+void write_snapshot(std::ostream & os, M & model,
+                    const snapshot_options & options = {}) {
+    detail::write_snapshot(os, detail::model_source(model, options.maximize),
+                           options);
+}
+
+// Builds the snapshot held in contents into model. The bounds, objective and
+// matrix sections are read in place : the variables are added by runs of
+// identical bounds and types and the rows by batches of
+// options.constraints_batch_size, with views on these sections. A
+// column-major snapshot is given to the models with a bulk add_columns
+// column by column, and transposed for the other models.
+template <lp_model M>
+read_result<M> parse_snapshot(std::string_view contents, M & model,
+                              const read_options & options = {}) {
+    if(reinterpret_cast<std::uintptr_t>(contents.data()) %
+           alignof(std::uint64_t) !=
+       0) {
+        std::vector<std::uint64_t> aligned((contents.size() + 7) / 8);
+        std::memcpy(aligned.data(), contents.data(), contents.size());
+        return parse_snapshot(
+            std::string_view(reinterpret_cast<const char *>(aligned.data()),
+                             contents.size()),
+            model, options);
+    }
+    return detail::load_snapshot(detail::parse_snapshot_sections(contents),
+                                 model, options);
+}
+
+// Same as parse_snapshot on the contents of a file, which is memory mapped so
+// that the sections are read from the page cache without being copied.
+template <lp_model M>
+read_result<M> read_snapshot(const std::filesystem::path & path, M & model,
+                             const read_options & options = {}) {
+    const mippp::detail::mapped_file file(path);
+    return parse_snapshot(file.contents(), model, options);
+}
+
+}  // namespace mippp::io
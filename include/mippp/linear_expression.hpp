@@ -130,8 +130,17 @@ public:
         noexcept(noexcept(_expression->constant())) {
         return _expression->constant();
     }
+    [[nodiscard]] constexpr const E & base() const noexcept {
+        return *_expression;
+    }
 };
 
+template <typename E>
+inline constexpr bool is_linear_expression_ref_v = false;
+template <typename E>
+inline constexpr bool is_linear_expression_ref_v<linear_expression_ref<E>> =
+    true;
+
 // Mirror of `std::views::all_t` at the expression level: an rvalue operand is
 // stored by value (the view takes ownership of it), a named operand is stored
 // by reference through `linear_expression_ref`.
@@ -6,10 +6,12 @@
 #include <initializer_list>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <tuple>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "mippp/detail/variadic_helper.hpp"
 #include "mippp/linear_constraint.hpp"
@@ -198,6 +200,12 @@ concept has_refinable_lp_status =
                              status::infeasible_or_unbounded> &&
     requires(T & model) { model.refine_lp_status(); };
 
+template <typename T>
+concept has_partial_solution = requires(T & model) {
+    { model.get_solution(archetype::range<model_variable_t<T>>()) }
+            -> std::same_as<std::vector<model_scalar_t<T>>>;
+};
+
 template <typename T>
 concept has_dual_solution = requires(T & model) {
     { model.get_dual_solution() }
@@ -253,6 +261,13 @@ concept has_memory_limit = requires(T & model) {
             -> variant_containing_a<status::memory_limit>;
 };
 
+// number of threads a solve may use, 0 letting the solver choose
+template <typename T>
+concept has_thread_count = requires(T & model, std::size_t n) {
+    { model.set_thread_count(n) };
+    { model.get_thread_count() } -> std::same_as<std::size_t>;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////// Names ////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -395,6 +410,34 @@ concept has_readable_constraints =
         { model.get_constraint(c) } -> linear_constraint;
     };
 
+template <typename T>
+concept has_constraints_batch = requires(T & model) {
+    { model.batch_constraints() };
+};
+
+template <typename T>
+concept has_modifications_batch = requires(T & model) {
+    { model.batch_modifications() };
+};
+
+// clang-format off
+template <typename T>
+concept has_bulk_modifications =
+    requires(T & model, std::span<const model_scalar_t<T>> s) {
+        { model.set_objective_coefficients(
+                archetype::range<model_variable_t<T>>(), s) };
+        { model.set_variables_bounds(
+                archetype::range<model_variable_t<T>>(), s, s) };
+        { model.set_constraints_rhs(
+                archetype::range<model_constraint_t<T>>(), s) };
+    };
+// clang-format on
+
+template <typename T>
+concept has_clone = requires(T & model) {
+    { model.clone() } -> std::same_as<T>;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////// Special constraints /////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -445,6 +488,24 @@ concept has_add_column = requires(
                        vparams) }
             -> std::same_as<model_variable_t<T>>;
 };
+template <typename T>
+concept has_add_columns = requires(T & model) {
+    { model.add_columns(archetype::range<archetype::any_type>(),
+                        [](archetype::any_type) {
+                            return archetype::range<std::pair<
+                                model_constraint_t<T>, model_scalar_t<T>>>();
+                        }) }
+            -> variables_range<T>;
+    { model.add_columns(archetype::range<archetype::any_type>(),
+                        [](archetype::any_type) {
+                            return archetype::range<std::pair<
+                                model_constraint_t<T>, model_scalar_t<T>>>();
+                        },
+                        [](archetype::any_type) {
+                            return model_variable_params_t<T>();
+                        }) }
+            -> variables_range<T>;
+};
 // clang-format on
 template <typename T>
 concept has_remove_variable = requires(T & model, model_variable_t<T> v) {
@@ -523,6 +584,11 @@ concept has_lp_basis_warm_start =
                                 model_variable_t<T> v, model_constraint_t<T> c,
                                 model_scalar_t<T> s) { model.set_basis(b); };
 
+template <typename T>
+concept has_solution_hint = requires(T & model) {
+    { model.set_solution_hint(model.get_solution()) };
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////// MIP start //////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////// LP basis ///////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The basis statuses of the variables and constraints of an LP, as returned
+// by get_basis() and taken by set_basis() of the simplex backends. The
+// variables are indexed by handle id and the constraints by id, so that a
+// basis stays attached to the right entities across variable removals.
+//
+// Entities added after the basis was taken report the statuses of the slack
+// basis : nonbasic at lower bound for variables and basic for constraints.
+// Setting such a basis on the grown model thus keeps it a valid basis, and
+// the next solve restarts from the previous optimum, typically in a few
+// pivots as in column generation.
+template <typename Variable, typename Constraint>
+class model_lp_basis {
+public:
+    using status = std::variant<basis_status::basic,
+                                basis_status::nonbasic_free,
+                                basis_status::nonbasic_at_lower_bound,
+                                basis_status::nonbasic_at_upper_bound,
+                                basis_status::nonbasic_fixed>;
+    // the index of a status in the status variant, as the backends store it
+    enum class code : std::uint8_t {
+        basic = 0,
+        nonbasic_free = 1,
+        nonbasic_at_lower_bound = 2,
+        nonbasic_at_upper_bound = 3,
+        nonbasic_fixed = 4
+    };
+    static constexpr code default_variable_code = code::nonbasic_at_lower_bound;
+    static constexpr code default_constraint_code = code::basic;
+
+private:
+    std::vector<code> _variables;
+    std::vector<code> _constraints;
+
+    static constexpr std::array<status, 5> _statuses = {
+        basis_status::basic{}, basis_status::nonbasic_free{},
+        basis_status::nonbasic_at_lower_bound{},
+        basis_status::nonbasic_at_upper_bound{},
+        basis_status::nonbasic_fixed{}};
+
+    template <typename S>
+    static constexpr code _code_of() {
+        return static_cast<code>(status(S{}).index());
+    }
+    static void _set(std::vector<code> & codes, const std::size_t i,
+                     const code c, const code default_code) {
+        if(i >= codes.size()) codes.resize(i + 1, default_code);
+        codes[i] = c;
+    }
+
+public:
+    model_lp_basis() = default;
+    model_lp_basis(std::vector<code> variables_codes,
+                   std::vector<code> constraints_codes)
+        : _variables(std::move(variables_codes))
+        , _constraints(std::move(constraints_codes)) {}
+
+    code variable_code(const std::size_t handle_id) const {
+        return handle_id < _variables.size() ? _variables[handle_id]
+                                             : default_variable_code;
+    }
+    code constraint_code(const std::size_t id) const {
+        return id < _constraints.size() ? _constraints[id]
+                                        : default_constraint_code;
+    }
+
+    // Conversions from and to the native status arrays of a backend, whose
+    // columns are ordered by native id : handle_id(i) is the handle id of the
+    // variable of native id i, and num_handle_ids bounds these ids.
+    template <std::ranges::random_access_range CS,
+              std::ranges::random_access_range RS, typename HandleId,
+              typename ColToCode, typename RowToCode>
+    static model_lp_basis from_native(const CS & cols, const RS & rows,
+                                      const std::size_t num_handle_ids,
+                                      HandleId && handle_id,
+                                      ColToCode && col_code,
+                                      RowToCode && row_code) {
+        std::vector<code> variables(num_handle_ids, default_variable_code);
+        for(std::size_t i = 0; i < std::ranges::size(cols); ++i)
+            variables[handle_id(i)] = col_code(cols[i]);
+        std::vector<code> constraints(std::ranges::size(rows));
+        for(std::size_t i = 0; i < constraints.size(); ++i)
+            constraints[i] = row_code(rows[i]);
+        return model_lp_basis(std::move(variables), std::move(constraints));
+    }
+    template <std::ranges::random_access_range CS,
+              std::ranges::random_access_range RS, typename HandleId,
+              typename CodeToCol, typename CodeToRow>
+    void to_native(CS && cols, RS && rows, HandleId && handle_id,
+                   CodeToCol && col_status, CodeToRow && row_status) const {
+        for(std::size_t i = 0; i < std::ranges::size(cols); ++i)
+            cols[i] = col_status(variable_code(handle_id(i)));
+        for(std::size_t i = 0; i < std::ranges::size(rows); ++i)
+            rows[i] = row_status(constraint_code(i));
+    }
+
+    bool is_basic(const Variable & v) const {
+        return variable_code(v.uid()) == code::basic;
+    }
+    bool is_basic(const Constraint & c) const {
+        return constraint_code(c.uid()) == code::basic;
+    }
+    status get_status(const Variable & v) const {
+        return _statuses[static_cast<std::size_t>(variable_code(v.uid()))];
+    }
+    status get_status(const Constraint & c) const {
+        return _statuses[static_cast<std::size_t>(constraint_code(c.uid()))];
+    }
+
+    template <typename S>
+        requires variant_with_alternative<status, S>
+    void set_status(const Variable & v, S) {
+        _set(_variables, v.uid(), _code_of<S>(), default_variable_code);
+    }
+    template <typename S>
+        requires variant_with_alternative<status, S>
+    void set_status(const Constraint & c, S) {
+        _set(_constraints, c.uid(), _code_of<S>(), default_constraint_code);
+    }
+    void set_basic(const Variable & v) {
+        set_status(v, basis_status::basic{});
+    }
+    void set_basic(const Constraint & c) {
+        set_status(c, basis_status::basic{});
+    }
+};
+
+}  // namespace mippp
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <concepts>
+#include <memory>
 #include <ranges>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
+#include "mippp/detail/product_terms_view.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/utility/zero.hpp"
 
@@ -221,16 +223,11 @@ public:
     constexpr explicit linear_expression_square(E && linear_expression)
         : _linear_expression(std::forward<E>(linear_expression)) {}
 
+    // each unordered pair of terms once, see detail::product_terms_view
     [[nodiscard]] constexpr auto quadratic_terms() const & noexcept {
-        return std::views::transform(
-            std::views::cartesian_product(_linear_expression.linear_terms(),
-                                          _linear_expression.linear_terms()),
-            [](auto && p) {
-                auto && [t1, t2] = p;
-                auto && [v1, c1] = t1;
-                auto && [v2, c2] = t2;
-                return std::make_tuple(v1, v2, c1 * c2);
-            });
+        return detail::product_terms_view(_linear_expression.linear_terms(),
+                                          _linear_expression.linear_terms(),
+                                          true);
     }
     [[nodiscard]] constexpr auto linear_part() const & noexcept {
         if constexpr(statically_zero<linear_expression_constant_t<LExpr>>) {
@@ -264,6 +261,16 @@ private:
     LExpr1 _linear_expression_1;
     LExpr2 _linear_expression_2;
 
+    constexpr bool _is_square() const noexcept {
+        if constexpr(std::same_as<LExpr1, LExpr2> &&
+                     detail::is_linear_expression_ref_v<LExpr1>) {
+            return std::addressof(_linear_expression_1.base()) ==
+                   std::addressof(_linear_expression_2.base());
+        } else {
+            return false;
+        }
+    }
+
 public:
     template <typename E1, typename E2>
         requires std::constructible_from<LExpr1, E1 &&> &&
@@ -273,16 +280,11 @@ public:
         : _linear_expression_1(std::forward<E1>(linear_expression_1))
         , _linear_expression_2(std::forward<E2>(linear_expression_2)) {}
 
+    // `e * e` over a named `e` is a square and is emitted as one
     [[nodiscard]] constexpr auto quadratic_terms() const & noexcept {
-        return std::views::transform(
-            std::views::cartesian_product(_linear_expression_1.linear_terms(),
-                                          _linear_expression_2.linear_terms()),
-            [](auto && p) {
-                auto && [t1, t2] = p;
-                auto && [v1, c1] = t1;
-                auto && [v2, c2] = t2;
-                return std::make_tuple(v1, v2, c1 * c2);
-            });
+        return detail::product_terms_view(_linear_expression_1.linear_terms(),
+                                          _linear_expression_2.linear_terms(),
+                                          _is_square());
     }
     [[nodiscard]] constexpr auto linear_part() const & noexcept {
         using constant_1 = linear_expression_constant_t<LExpr1>;
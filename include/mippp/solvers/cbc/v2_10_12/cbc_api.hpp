@@ -16,9 +16,15 @@ using Cbc_Model = void;
 const char * Cbc_getVersion(void);
 Cbc_Model * Cbc_newModel(void);
 void Cbc_deleteModel(Cbc_Model * model);
+Cbc_Model * Cbc_clone(Cbc_Model * model);
 
 void Cbc_setObjSense(Cbc_Model * model, double sense);
 
+void Cbc_loadProblem(Cbc_Model * model, const int numcols, const int numrows,
+                     const int * start, const int * index,
+                     const double * value, const double * collb,
+                     const double * colub, const double * obj,
+                     const double * rowlb, const double * rowub);
 void Cbc_addCol(Cbc_Model * model, const char * name, double lb, double ub,
                 double obj, char isInteger, int nz, int * rows, double * coefs);
 void Cbc_addRow(Cbc_Model * model, const char * name, int nz, const int * cols,
@@ -98,6 +104,8 @@ void OsiCuts_addRowCut(void * osiCuts, int nz, const int * idx,
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -109,7 +117,9 @@ namespace cbc::v2_10_12 {
     F(Cbc_getVersion, getVersion)                           \
     F(Cbc_newModel, newModel)                               \
     F(Cbc_deleteModel, deleteModel)                         \
+    F(Cbc_clone, clone)                                     \
     F(Cbc_setObjSense, setObjSense)                         \
+    F(Cbc_loadProblem, loadProblem)                         \
     F(Cbc_addCol, addCol)                                   \
     F(Cbc_addRow, addRow)                                   \
     F(Cbc_addSOS, addSOS)                                   \
@@ -158,17 +168,21 @@ namespace cbc::v2_10_12 {
     F(Cbc_isContinuousUnbounded, isContinuousUnbounded)     \
     F(Cbc_getObjValue, getObjValue)                         \
     F(Cbc_getColSolution, getColSolution)                   \
-    F(Cbc_bestSolution, bestSolution)
+    F(Cbc_bestSolution, bestSolution)                       \
+    F(Cbc_addCutCallback, addCutCallback)                   \
+    F(Osi_getNumCols, osiGetNumCols)                        \
+    F(Osi_getColSolution, osiGetColSolution)                \
+    F(OsiCuts_addRowCut, osiCutsAddRowCut)
 
 #define DECLARE_CBC_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);  \
-    decltype(FULL) * const SHORT;
+    detail::solver_function<SHORT##_fun_t> SHORT;
 #define CONSTRUCT_CBC_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<decltype(FULL)>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 
 class cbc_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
 public:
     CBC_FUNCTIONS(DECLARE_CBC_FUNCTIONS)
@@ -3,11 +3,14 @@
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <functional>
+#include <numeric>
 #include <optional>
 #include <ostream>
 #include <ranges>
 #include <sstream>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 #include "mippp/linear_constraint.hpp"
@@ -44,6 +47,7 @@ private:
     std::chrono::duration<double> time_limit;
     double objective_offset;
     double feasibility_tol;
+    std::size_t thread_count;  // Cbc only sets its parameters
 
     static constexpr char constraint_sense_to_cbc_sense(constraint_sense rel) {
         if(rel == constraint_sense::less_equal) return 'L';
@@ -61,15 +65,49 @@ private:
     std::size_t _lazy_num_variables;
     std::size_t _lazy_num_constraints;
 
+    // The problem built in staged mode, kept on the mippp side until it is
+    // sent to Cbc by a single Cbc_loadProblem.
+    struct staged_problem {
+        double objective_sense = 1.0;
+        std::vector<double> objective;
+        std::vector<double> col_lower;
+        std::vector<double> col_upper;
+        std::vector<char> col_is_integer;
+        std::vector<std::string> col_names;  // empty until a column is named
+        // rows in CSR, the entries of add_column as (column, row, coef)
+        std::vector<int> row_begins = {0};
+        std::vector<int> row_indices;
+        std::vector<double> row_values;
+        std::vector<double> row_lower;
+        std::vector<double> row_upper;
+        std::vector<std::tuple<int, int, double>> column_entries;
+    };
+    std::optional<staged_problem> _staged;
+
 public:
+    struct staged_build_t {
+        explicit staged_build_t() = default;
+    };
+    // Tag of the staged build constructor.
+    static constexpr staged_build_t staged_build{};
+
     explicit cbc_milp(const cbc_api & api)
         : model_base<int, double>()
         , Cbc(&api)
         , model(Cbc->newModel())
         , objective_offset(0.0)
         , feasibility_tol(1e-4)
+        , thread_count(0)
         , _lazy_num_variables(0)
         , _lazy_num_constraints(0) {}
+    // Staged build : the columns, rows, bounds and objective are kept in
+    // mippp buffers and read from there, then loaded in Cbc at once by the
+    // first solve(), or earlier by an operation that needs the Cbc problem
+    // (add_mip_start, reading a row extended by add_column). The model then
+    // behaves as one built directly.
+    cbc_milp(const cbc_api & api, staged_build_t) : cbc_milp(api) {
+        _staged.emplace();
+    }
     ~cbc_milp() {
         if(model) Cbc->deleteModel(model);
     }
@@ -81,15 +119,96 @@ public:
         , model(other.model)
         , objective_offset(other.objective_offset)
         , feasibility_tol(other.feasibility_tol)
+        , thread_count(other.thread_count)
         , _lazy_num_variables(other._lazy_num_variables)
-        , _lazy_num_constraints(other._lazy_num_constraints) {
+        , _lazy_num_constraints(other._lazy_num_constraints)
+        , _staged(std::move(other._staged)) {
         other.model = nullptr;
     }
 
     constexpr cbc_milp & operator=(const cbc_milp &) = delete;
     constexpr cbc_milp & operator=(cbc_milp && other) = delete;
 
+private:
+    // other on model_copy, a copy of its problem : the handles of other stay
+    // valid and no solution is copied
+    cbc_milp(const cbc_milp & other, Cbc_Model * model_copy)
+        : model_base<int, double>(other)
+        , Cbc(other.Cbc)
+        , model(model_copy)
+        , objective_offset(other.objective_offset)
+        , feasibility_tol(other.feasibility_tol)
+        , thread_count(other.thread_count)
+        , _lazy_num_variables(other._lazy_num_variables)
+        , _lazy_num_constraints(other._lazy_num_constraints)
+        , _staged(other._staged) {
+        _invalidate_solution_caches();
+    }
+
+public:
+    // an independent copy of the model, in which its handles stay valid.
+    // Cbc_clone also copies the cut callbacks, with the address of this
+    // model : a model with a node relaxation callback cannot be cloned
+    [[nodiscard]] cbc_milp clone() {
+        if(node_relaxation_callback)
+            throw std::runtime_error(
+                "cbc_milp: Cannot clone a model with a node relaxation "
+                "callback.");
+        return cbc_milp(*this, Cbc->clone(model));
+    }
+
+    bool is_staged() const noexcept { return _staged.has_value(); }
+
+private:
+    void _load_staged_problem() {
+        if(!_staged) return;
+        staged_problem & p = *_staged;
+        const std::size_t num_cols = p.objective.size();
+        const std::size_t num_rows = p.row_lower.size();
+        // transpose the rows, then append the add_column entries
+        std::vector<int> col_begins(num_cols + 1, 0);
+        for(const int j : p.row_indices)
+            ++col_begins[static_cast<std::size_t>(j) + 1];
+        for(auto && [j, i, coef] : p.column_entries)
+            ++col_begins[static_cast<std::size_t>(j) + 1];
+        std::partial_sum(col_begins.begin(), col_begins.end(),
+                         col_begins.begin());
+        std::vector<int> next(col_begins.begin(), col_begins.end() - 1);
+        tmp_indices.resize(static_cast<std::size_t>(col_begins.back()));
+        tmp_scalars.resize(tmp_indices.size());
+        auto push = [&](const int j, const int i, const double coef) {
+            const auto k = static_cast<std::size_t>(
+                next[static_cast<std::size_t>(j)]++);
+            tmp_indices[k] = i;
+            tmp_scalars[k] = coef;
+        };
+        for(std::size_t i = 0; i < num_rows; ++i)
+            for(auto k = static_cast<std::size_t>(p.row_begins[i]);
+                k < static_cast<std::size_t>(p.row_begins[i + 1]); ++k)
+                push(p.row_indices[k], static_cast<int>(i), p.row_values[k]);
+        for(auto && [j, i, coef] : p.column_entries) push(j, i, coef);
+
+        Cbc->loadProblem(model, static_cast<int>(num_cols),
+                         static_cast<int>(num_rows), col_begins.data(),
+                         tmp_indices.data(), tmp_scalars.data(),
+                         p.col_lower.data(), p.col_upper.data(),
+                         p.objective.data(), p.row_lower.data(),
+                         p.row_upper.data());
+        Cbc->setObjSense(model, p.objective_sense);
+        for(std::size_t j = 0; j < num_cols; ++j) {
+            if(p.col_is_integer[j]) Cbc->setInteger(model, static_cast<int>(j));
+        }
+        for(std::size_t j = 0; j < p.col_names.size(); ++j) {
+            if(p.col_names[j].empty()) continue;
+            Cbc->setColName(model, static_cast<int>(j),
+                            const_cast<char *>(p.col_names[j].c_str()));
+        }
+        _staged.reset();
+    }
+
+public:
     std::size_t num_variables() {
+        if(_staged) return _lazy_num_variables;
         if(static_cast<std::size_t>(Cbc->getNumCols(model)) !=
            _lazy_num_variables)
             throw std::runtime_error(
@@ -97,6 +216,7 @@ public:
         return _lazy_num_variables;
     }
     std::size_t num_constraints() {
+        if(_staged) return _lazy_num_constraints;
         if(static_cast<std::size_t>(Cbc->getNumRows(model)) !=
            _lazy_num_constraints)
             throw std::runtime_error(
@@ -104,16 +224,35 @@ public:
         return _lazy_num_constraints;
     }
     std::size_t num_entries() {
+        if(_staged)
+            return _staged->row_indices.size() + _staged->column_entries.size();
         return static_cast<std::size_t>(Cbc->getNumElements(model));
     }
     ///////////////////////////////////////////////////////////////////////////
     //////////////////////////////// Objective ////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
-    void set_maximization() { Cbc->setObjSense(model, -1); }
-    void set_minimization() { Cbc->setObjSense(model, 1); }
+    void set_maximization() {
+        if(_staged)
+            _staged->objective_sense = -1.0;
+        else
+            Cbc->setObjSense(model, -1);
+    }
+    void set_minimization() {
+        if(_staged)
+            _staged->objective_sense = 1.0;
+        else
+            Cbc->setObjSense(model, 1);
+    }
 
     void set_objective_offset(double offset) { objective_offset = offset; }
     void set_objective(linear_expression auto && le) {
+        if(_staged) {
+            std::ranges::fill(_staged->objective, 0.0);
+            for(auto && [var, coef] : le.linear_terms())
+                _staged->objective[static_cast<std::size_t>(var.id())] += coef;
+            set_objective_offset(le.constant());
+            return;
+        }
         for(auto && v :
             std::views::iota(0, static_cast<int>(_lazy_num_variables))) {
             Cbc->setObjCoeff(model, v, 0.0);
@@ -129,6 +268,12 @@ public:
         set_objective(std::forward<LE>(le));
     }
     void add_objective(linear_expression auto && le) {
+        if(_staged) {
+            for(auto && [var, coef] : le.linear_terms())
+                _staged->objective[static_cast<std::size_t>(var.id())] += coef;
+            set_objective_offset(get_objective_offset() + le.constant());
+            return;
+        }
         for(auto && [var, coef] : le.linear_terms()) {
             set_objective_coefficient(var,
                                       get_objective_coefficient(var) + coef);
@@ -137,11 +282,13 @@ public:
     }
     double get_objective_offset() { return objective_offset; }
     auto get_objective() {
+        const double * coefs = _staged ? _staged->objective.data()
+                                       : Cbc->getObjCoefficients(model);
         return linear_expression_view(
             std::views::transform(
                 std::views::iota(variable_id{0},
                                  static_cast<variable_id>(_lazy_num_variables)),
-                [coefs = Cbc->getObjCoefficients(model)](auto i) {
+                [coefs](auto i) {
                     return std::make_pair(variable(i), coefs[i]);
                 }),
             get_objective_offset());
@@ -150,8 +297,23 @@ public:
     //////////////////////////////// Variables ////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
 private:
+    static std::size_t _col(variable v) {
+        return static_cast<std::size_t>(v.id());
+    }
     inline void _add_var(const variable_params & p, const bool is_integer,
                          const char * name = "") {
+        if(_staged) {
+            _staged->objective.push_back(p.obj_coef);
+            _staged->col_lower.push_back(p.lower_bound.value_or(-COIN_DBL_MAX));
+            _staged->col_upper.push_back(p.upper_bound.value_or(COIN_DBL_MAX));
+            _staged->col_is_integer.push_back(static_cast<char>(is_integer));
+            if(*name != '\0' || !_staged->col_names.empty()) {
+                _staged->col_names.resize(_lazy_num_variables);
+                _staged->col_names.emplace_back(name);
+            }
+            ++_lazy_num_variables;
+            return;
+        }
         Cbc->addCol(model, name, p.lower_bound.value_or(-COIN_DBL_MAX),
                     p.upper_bound.value_or(COIN_DBL_MAX), p.obj_coef,
                     is_integer, 0, nullptr, nullptr);
@@ -253,6 +415,14 @@ private:
     inline variable _add_column(ER && entries, const variable_params & params) {
         _reset_cache();
         _register_constraints_entries<true>(entries);
+        if(_staged) {
+            const int var_id = static_cast<int>(_lazy_num_variables);
+            _add_var(params, false);
+            for(std::size_t k = 0; k < tmp_indices.size(); ++k)
+                _staged->column_entries.emplace_back(var_id, tmp_indices[k],
+                                                     tmp_scalars[k]);
+            return variable(var_id);
+        }
         Cbc->addCol(model, "", params.lower_bound.value_or(-COIN_DBL_MAX),
                     params.upper_bound.value_or(COIN_DBL_MAX), params.obj_coef,
                     false, static_cast<int>(tmp_indices.size()),
@@ -273,9 +443,17 @@ public:
     }
 
     void set_continuous(variable v) noexcept {
-        Cbc->setContinuous(model, v.id());
+        if(_staged)
+            _staged->col_is_integer[_col(v)] = false;
+        else
+            Cbc->setContinuous(model, v.id());
+    }
+    void set_integer(variable v) noexcept {
+        if(_staged)
+            _staged->col_is_integer[_col(v)] = true;
+        else
+            Cbc->setInteger(model, v.id());
     }
-    void set_integer(variable v) noexcept { Cbc->setInteger(model, v.id()); }
     void set_binary(variable v) noexcept {
         set_integer(v);
         set_variable_lower_bound(v, 0);
@@ -283,28 +461,49 @@ public:
     }
 
     void set_objective_coefficient(variable v, double c) {
-        Cbc->setObjCoeff(model, v.id(), c);
+        if(_staged)
+            _staged->objective[_col(v)] = c;
+        else
+            Cbc->setObjCoeff(model, v.id(), c);
     }
     void set_variable_lower_bound(variable v, double lb) {
-        Cbc->setColLower(model, v.id(), lb);
+        if(_staged)
+            _staged->col_lower[_col(v)] = lb;
+        else
+            Cbc->setColLower(model, v.id(), lb);
     }
     void set_variable_upper_bound(variable v, double ub) {
-        Cbc->setColUpper(model, v.id(), ub);
+        if(_staged)
+            _staged->col_upper[_col(v)] = ub;
+        else
+            Cbc->setColUpper(model, v.id(), ub);
     }
     void set_variable_name(variable v, std::string name) {
+        if(_staged) {
+            _staged->col_names.resize(_lazy_num_variables);
+            _staged->col_names[_col(v)] = std::move(name);
+            return;
+        }
         Cbc->setColName(model, v.id(), const_cast<char *>(name.c_str()));
     }
 
     double get_objective_coefficient(variable v) {
+        if(_staged) return _staged->objective[_col(v)];
         return Cbc->getObjCoefficients(model)[v.id()];
     }
     double get_variable_lower_bound(variable v) {
+        if(_staged) return _staged->col_lower[_col(v)];
         return Cbc->getColLower(model)[v.id()];
     }
     double get_variable_upper_bound(variable v) {
+        if(_staged) return _staged->col_upper[_col(v)];
         return Cbc->getColUpper(model)[v.id()];
     }
     std::string get_variable_name(variable v) {
+        if(_staged) {
+            if(_col(v) >= _staged->col_names.size()) return {};
+            return _staged->col_names[_col(v)];
+        }
         // getNumIntegers flushes Cbc internal buffers to update maxNameLength
         [[maybe_unused]] auto n = Cbc->getNumIntegers(model);
         auto max_length = Cbc->maxNameLength(model);
@@ -317,10 +516,30 @@ public:
     /////////////////////////////// Constraints ///////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
 private:
+    void _stage_row(const double lb, const double ub) {
+        _staged->row_indices.insert(_staged->row_indices.end(),
+                                    tmp_indices.begin(), tmp_indices.end());
+        _staged->row_values.insert(_staged->row_values.end(),
+                                   tmp_scalars.begin(), tmp_scalars.end());
+        _staged->row_begins.push_back(
+            static_cast<int>(_staged->row_indices.size()));
+        _staged->row_lower.push_back(lb);
+        _staged->row_upper.push_back(ub);
+        ++_lazy_num_constraints;
+    }
+
     template <bool distinct, linear_constraint LC>
     void _add_constraint(LC && lc) {
         _reset_cache();
         _register_variables_entries<distinct>(lc.linear_terms());
+        if(_staged) {
+            const double rhs = lc.rhs();
+            const constraint_sense sense = lc.sense();
+            _stage_row(
+                sense == constraint_sense::less_equal ? -COIN_DBL_MAX : rhs,
+                sense == constraint_sense::greater_equal ? COIN_DBL_MAX : rhs);
+            return;
+        }
         Cbc->addRow(model, "", static_cast<int>(tmp_indices.size()),
                     tmp_indices.data(), tmp_scalars.data(),
                     constraint_sense_to_cbc_sense(lc.sense()), lc.rhs());
@@ -368,7 +587,7 @@ private:
     auto _add_constraints(IR && keys, CL &... constraint_lambdas) {
         using key_t = std::ranges::range_value_t<IR>;
         if constexpr(!distinct) {
-            tmp_entry_index_cache.resize(_lazy_num_variables);
+            _prepare_coalescing(_lazy_num_variables);
         }
         const int offset = static_cast<int>(_lazy_num_constraints);
         int constr_id = offset;
@@ -429,6 +648,10 @@ public:
         _reset_cache();
         _register_variables_entries<false>(le.linear_terms());
         const double c = le.constant();
+        if(_staged) {
+            _stage_row(lb - c, ub - c);
+            return constraint(constr_id);
+        }
         Cbc->addRow(model, "", static_cast<int>(tmp_indices.size()),
                     tmp_indices.data(), tmp_scalars.data(), 'L', ub - c);
         Cbc->setRowLower(model, constr_id, lb - c);
@@ -437,18 +660,42 @@ public:
     }
     // void set_constraint_name(constraint constr, auto && name);
 
+private:
+    const double & _staged_row_lower(constraint constr) const {
+        return _staged->row_lower[static_cast<std::size_t>(constr.id())];
+    }
+    const double & _staged_row_upper(constraint constr) const {
+        return _staged->row_upper[static_cast<std::size_t>(constr.id())];
+    }
+
+public:
+    // the rows extended by add_column are only complete in Cbc
     auto get_constraint_lhs(constraint constr) {
-        const int num_nz = Cbc->getRowNz(model, constr.id());
-        const int * ids = Cbc->getRowIndices(model, constr.id());
-        const double * coeffs = Cbc->getRowCoeffs(model, constr.id());
+        if(_staged && !_staged->column_entries.empty()) _load_staged_problem();
+        int num_nz;
+        const int * ids;
+        const double * coeffs;
+        if(_staged) {
+            const auto i = static_cast<std::size_t>(constr.id());
+            const int begin = _staged->row_begins[i];
+            num_nz = _staged->row_begins[i + 1] - begin;
+            ids = _staged->row_indices.data() + begin;
+            coeffs = _staged->row_values.data() + begin;
+        } else {
+            num_nz = Cbc->getRowNz(model, constr.id());
+            ids = Cbc->getRowIndices(model, constr.id());
+            coeffs = Cbc->getRowCoeffs(model, constr.id());
+        }
         return std::views::transform(
             std::views::iota(0, num_nz), [ids, coeffs](int i) {
                 return std::make_pair(variable(ids[i]), coeffs[i]);
             });
     }
     constraint_sense get_constraint_sense(constraint constr) {
-        const double lb = Cbc->getRowLower(model)[constr.id()];
-        const double ub = Cbc->getRowUpper(model)[constr.id()];
+        const double lb = _staged ? _staged_row_lower(constr)
+                                  : Cbc->getRowLower(model)[constr.id()];
+        const double ub = _staged ? _staged_row_upper(constr)
+                                  : Cbc->getRowUpper(model)[constr.id()];
         if(lb == ub) return constraint_sense::equal;
         if(lb == -COIN_DBL_MAX) return constraint_sense::less_equal;
         if(ub == COIN_DBL_MAX) return constraint_sense::greater_equal;
@@ -456,6 +703,10 @@ public:
             "Tried to get the sense of a ranged constraint");
     }
     double get_constraint_rhs(constraint constr) {
+        if(_staged) {
+            const double ub = _staged_row_upper(constr);
+            return ub == COIN_DBL_MAX ? _staged_row_lower(constr) : ub;
+        }
         return Cbc->getRowRHS(model, constr.id());
     }
     auto get_constraint(constraint constr) {
@@ -465,6 +716,7 @@ public:
             get_constraint_sense(constr));
     }
     auto get_constraint_name(constraint constr) {
+        if(_staged) return std::string();  // the rows are not named
         auto max_length = Cbc->maxNameLength(model);
         std::string name(max_length, '\0');
         Cbc->getRowName(model, constr.id(), name.data(), max_length);
@@ -472,6 +724,77 @@ public:
         return name;
     }
     ///////////////////////////////////////////////////////////////////////////
+    //////////////////////////////// Callbacks ////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Cbc calls the cut callbacks as cut generators, on the LP relaxation of
+    // the nodes, hence on the columns of the solver it is given.
+    class node_relaxation_callback_handle : public model_base<int, double> {
+    private:
+        const cbc_api * Cbc;
+        void * osi_solver;
+        void * osi_cuts;
+
+    public:
+        node_relaxation_callback_handle(const cbc_api * api,
+                                        void * osi_solver_, void * osi_cuts_)
+            : model_base<int, double>()
+            , Cbc(api)
+            , osi_solver(osi_solver_)
+            , osi_cuts(osi_cuts_) {}
+
+        std::size_t num_variables() {
+            return static_cast<std::size_t>(Cbc->osiGetNumCols(osi_solver));
+        }
+
+    private:
+        template <bool distinct, linear_constraint LC>
+        void _add_cut(LC && lc) {
+            if constexpr(!distinct) _prepare_coalescing(num_variables());
+            _reset_cache();
+            _register_variables_entries<distinct>(lc.linear_terms());
+            Cbc->osiCutsAddRowCut(osi_cuts,
+                                  static_cast<int>(tmp_indices.size()),
+                                  tmp_indices.data(), tmp_scalars.data(),
+                                  constraint_sense_to_cbc_sense(lc.sense()),
+                                  lc.rhs());
+        }
+
+    public:
+        template <linear_constraint LC>
+        void add_cut(LC && lc) {
+            _add_cut<false>(std::forward<LC>(lc));
+        }
+        template <linear_constraint LC>
+        void add_cut(distinct_variables_t, LC && lc) {
+            _add_cut<true>(std::forward<LC>(lc));
+        }
+        // valid until the callback returns
+        auto get_relaxation_solution() {
+            return variable_mapping(Cbc->osiGetColSolution(osi_solver));
+        }
+    };
+
+private:
+    std::function<void(node_relaxation_callback_handle &)>
+        node_relaxation_callback;
+
+    static void node_relaxation_callback_fun(void * osi_solver,
+                                             void * osi_cuts, void * appdata) {
+        auto * milp = static_cast<cbc_milp *>(appdata);
+        node_relaxation_callback_handle handle(milp->Cbc, osi_solver,
+                                               osi_cuts);
+        milp->node_relaxation_callback(handle);
+    }
+
+public:
+    template <typename F>
+    void set_node_relaxation_callback(F && f) {
+        if(!node_relaxation_callback)
+            Cbc->addCutCallback(model, node_relaxation_callback_fun,
+                                "node_relaxation_callback", this);
+        node_relaxation_callback = std::forward<F>(f);
+    }
+    ///////////////////////////////////////////////////////////////////////////
     //////////////////////////////// MIP start ////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
 private:
@@ -484,12 +807,15 @@ private:
     }
 
 public:
+    // Cbc maps the start to the columns of its problem
     template <std::ranges::range ER>
     void add_mip_start(ER && entries) {
+        _load_staged_problem();
         _add_mip_start(entries);
     }
     void add_mip_start(
         std::initializer_list<std::pair<variable, scalar>> entries) {
+        _load_staged_problem();
         _add_mip_start(entries);
     }
     ///////////////////////////////////////////////////////////////////////////
@@ -513,6 +839,12 @@ public:
     auto get_solution_limit() {
         return static_cast<std::size_t>(Cbc->getMaximumSolutions(model));
     }
+    // 0 lets Cbc choose, which is one thread unless it was built otherwise
+    void set_thread_count(std::size_t n) {
+        thread_count = n;
+        Cbc->setParameter(model, "threads", std::to_string(n).c_str());
+    }
+    std::size_t get_thread_count() { return thread_count; }
     ///////////////////////////////////////////////////////////////////////////
     ////////////////////////// Tolerance parameters ///////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -601,6 +933,7 @@ public:
         if(_lazy_num_variables == 0u) {
             add_variable();  // ?
         };
+        _load_staged_problem();
         Cbc->solve(model);
         _status = _get_status();
     }
@@ -616,6 +949,13 @@ public:
         if(sol == nullptr) sol = Cbc->getColSolution(model);
         return variable_mapping(std::move(sol));
     }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        const double * sol = Cbc->bestSolution(model);
+        if(sol == nullptr) sol = Cbc->getColSolution(model);
+        return _gather_values(vars, sol);
+    }
 };
 
 }  // namespace cbc::v2_10_12
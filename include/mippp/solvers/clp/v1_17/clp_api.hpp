@@ -16,6 +16,7 @@ Clp_Simplex * Clp_newModel(void);
 void Clp_deleteModel(Clp_Simplex * model);
 
 void Clp_setObjSense(Clp_Simplex * model, double objsen);
+double Clp_optimizationDirection(Clp_Simplex * model);
 void Clp_setObjectiveOffset(Clp_Simplex * model, double value);
 double Clp_objectiveOffset(Clp_Simplex * model);
 
@@ -44,6 +45,7 @@ CoinBigIndex Clp_getNumElements(Clp_Simplex * model);
 int Clp_lengthNames(Clp_Simplex * model);
 
 const CoinBigIndex * Clp_getVectorStarts(Clp_Simplex * model);
+const int * Clp_getVectorLengths(Clp_Simplex * model);
 const int * Clp_getIndices(Clp_Simplex * model);
 const double * Clp_getElements(Clp_Simplex * model);
 void Clp_modifyCoefficient(Clp_Simplex * model, int row, int column,
@@ -51,11 +53,21 @@ void Clp_modifyCoefficient(Clp_Simplex * model, int row, int column,
 
 double Clp_primalTolerance(Clp_Simplex * model);
 void Clp_setPrimalTolerance(Clp_Simplex * model, double value);
+double Clp_dualTolerance(Clp_Simplex * model);
+void Clp_setDualTolerance(Clp_Simplex * model, double value);
+int Clp_maximumIterations(Clp_Simplex * model);
+void Clp_setMaximumIterations(Clp_Simplex * model, int value);
+double Clp_maximumSeconds(Clp_Simplex * model);
+void Clp_setMaximumSeconds(Clp_Simplex * model, double value);
+int Clp_logLevel(Clp_Simplex * model);
+void Clp_setLogLevel(Clp_Simplex * model, int value);
 
 void Clp_setColumnStatus(Clp_Simplex * model, int sequence, int value);
 int Clp_getColumnStatus(Clp_Simplex * model, int sequence);
 void Clp_setRowStatus(Clp_Simplex * model, int sequence, int value);
 int Clp_getRowStatus(Clp_Simplex * model, int sequence);
+unsigned char * Clp_statusArray(Clp_Simplex * model);
+void Clp_copyinStatus(Clp_Simplex * model, const unsigned char * statusArray);
 
 int Clp_initialSolve(Clp_Simplex * model);
 int Clp_primal(Clp_Simplex * model, int ifValuesPass);
@@ -77,6 +89,8 @@ void Clp_loadProblem(Clp_Simplex * model, const int numcols, const int numrows,
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -88,6 +102,7 @@ namespace clp::v1_17 {
     F(Clp_newModel, newModel)                                 \
     F(Clp_deleteModel, deleteModel)                           \
     F(Clp_setObjSense, setObjSense)                           \
+    F(Clp_optimizationDirection, optimizationDirection)       \
     F(Clp_setObjectiveOffset, setObjectiveOffset)             \
     F(Clp_objectiveOffset, objectiveOffset)                   \
     F(Clp_addColumns, addColumns)                             \
@@ -106,15 +121,26 @@ namespace clp::v1_17 {
     F(Clp_getNumElements, getNumElements)                     \
     F(Clp_lengthNames, lengthNames)                           \
     F(Clp_getVectorStarts, getVectorStarts)                   \
+    F(Clp_getVectorLengths, getVectorLengths)                 \
     F(Clp_getIndices, getIndices)                             \
     F(Clp_getElements, getElements)                           \
     F(Clp_modifyCoefficient, modifyCoefficient)               \
     F(Clp_primalTolerance, primalTolerance)                   \
     F(Clp_setPrimalTolerance, setPrimalTolerance)             \
+    F(Clp_dualTolerance, dualTolerance)                       \
+    F(Clp_setDualTolerance, setDualTolerance)                 \
+    F(Clp_maximumIterations, maximumIterations)               \
+    F(Clp_setMaximumIterations, setMaximumIterations)         \
+    F(Clp_maximumSeconds, maximumSeconds)                     \
+    F(Clp_setMaximumSeconds, setMaximumSeconds)               \
+    F(Clp_logLevel, logLevel)                                 \
+    F(Clp_setLogLevel, setLogLevel)                           \
     F(Clp_setColumnStatus, setColumnStatus)                   \
     F(Clp_getColumnStatus, getColumnStatus)                   \
     F(Clp_setRowStatus, setRowStatus)                         \
     F(Clp_getRowStatus, getRowStatus)                         \
+    F(Clp_statusArray, statusArray)                           \
+    F(Clp_copyinStatus, copyinStatus)                         \
     F(Clp_initialSolve, initialSolve)                         \
     F(Clp_primal, primal)                                     \
     F(Clp_status, status)                                     \
@@ -128,13 +154,13 @@ namespace clp::v1_17 {
 
 #define DECLARE_CLP_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);  \
-    SHORT##_fun_t const * SHORT;
+    detail::solver_function<SHORT##_fun_t> SHORT;
 #define CONSTRUCT_CLP_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<SHORT##_fun_t>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 
 class clp_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
 public:
     CLP_FUNCTIONS(DECLARE_CLP_FUNCTIONS)
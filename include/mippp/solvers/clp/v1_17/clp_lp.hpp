@@ -6,7 +6,10 @@
 #include <optional>
 #include <ostream>
 #include <ranges>
+#include <span>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -14,6 +17,7 @@
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
 #include "mippp/model_entities.hpp"
+#include "mippp/model_lp_basis.hpp"
 
 #include "mippp/solvers/clp/v1_17/clp_api.hpp"
 #include "mippp/solvers/model_base.hpp"
@@ -47,6 +51,7 @@ private:
     std::vector<index> tmp_begins;
     std::vector<scalar> tmp_lower_bounds;
     std::vector<scalar> tmp_upper_bounds;
+    std::vector<scalar> tmp_objective_coefs;
 
     std::vector<int> _free_variable_ids;
 
@@ -65,6 +70,7 @@ public:
         , tmp_begins(std::move(other.tmp_begins))
         , tmp_lower_bounds(std::move(other.tmp_lower_bounds))
         , tmp_upper_bounds(std::move(other.tmp_upper_bounds))
+        , tmp_objective_coefs(std::move(other.tmp_objective_coefs))
         , _free_variable_ids(std::move(other._free_variable_ids)) {
         other.model = nullptr;
     }
@@ -72,6 +78,69 @@ public:
     constexpr clp_lp & operator=(const clp_lp &) = delete;
     constexpr clp_lp & operator=(clp_lp && other) = delete;
 
+private:
+    // other on model_copy, a copy of its problem : the handles of other stay
+    // valid and no solution is copied
+    clp_lp(const clp_lp & other, Clp_Simplex * model_copy)
+        : model_base<int, double>(other)
+        , Clp(other.Clp)
+        , model(model_copy)
+        , _free_variable_ids(other._free_variable_ids) {
+        _invalidate_solution_caches();
+    }
+
+public:
+    // an independent copy of the model, in which its handles stay valid :
+    // Clp has no copy function, the problem is loaded in a new model with one
+    // Clp_loadProblem call. The optimization direction, the tolerances, the
+    // iteration and time limits and the log level are copied, not the basis
+    [[nodiscard]] clp_lp clone() {
+        const int num_cols = Clp->getNumCols(model);
+        const int num_rows = Clp->getNumRows(model);
+        const index * starts = Clp->getVectorStarts(model);
+        const int * lengths = Clp->getVectorLengths(model);
+        const int * indices = Clp->getIndices(model);
+        const double * elements = Clp->getElements(model);
+        // the columns of Clp may be separated by gaps, closed here
+        tmp_begins.resize(0);
+        _reset_cache();
+        tmp_begins.emplace_back(0);
+        for(int j = 0; j < num_cols; ++j) {
+            const index begin = starts[j];
+            const index end = begin + lengths[j];
+            for(index k = begin; k < end; ++k) {
+                tmp_indices.emplace_back(indices[k]);
+                tmp_scalars.emplace_back(elements[k]);
+            }
+            tmp_begins.emplace_back(static_cast<index>(tmp_indices.size()));
+        }
+        Clp_Simplex * model_copy = Clp->newModel();
+        Clp->loadProblem(model_copy, num_cols, num_rows, tmp_begins.data(),
+                         tmp_indices.data(), tmp_scalars.data(),
+                         Clp->columnLower(model), Clp->columnUpper(model),
+                         Clp->objective(model), Clp->rowLower(model),
+                         Clp->rowUpper(model));
+        Clp->setObjSense(model_copy, Clp->optimizationDirection(model));
+        Clp->setObjectiveOffset(model_copy, Clp->objectiveOffset(model));
+        Clp->setPrimalTolerance(model_copy, Clp->primalTolerance(model));
+        Clp->setDualTolerance(model_copy, Clp->dualTolerance(model));
+        Clp->setMaximumIterations(model_copy, Clp->maximumIterations(model));
+        Clp->setMaximumSeconds(model_copy, Clp->maximumSeconds(model));
+        Clp->setLogLevel(model_copy, Clp->logLevel(model));
+        if(const int length = Clp->lengthNames(model); length > 0) {
+            std::string name(static_cast<std::size_t>(length) + 1, '\0');
+            for(int j = 0; j < num_cols; ++j) {
+                Clp->columnName(model, j, name.data());
+                Clp->setColumnName(model_copy, j, name.data());
+            }
+            for(int i = 0; i < num_rows; ++i) {
+                Clp->rowName(model, i, name.data());
+                Clp->setRowName(model_copy, i, name.data());
+            }
+        }
+        return clp_lp(*this, model_copy);
+    }
+
     std::size_t num_variables() {
         return static_cast<std::size_t>(Clp->getNumCols(model)) -
                _free_variable_ids.size();
@@ -255,6 +324,41 @@ public:
         const variable_params params = default_variable_params) {
         return _add_column(entries, params);
     }
+    // Adds one column per key in a single addColumns call, whose entries are
+    // entries_lambda(key) and whose parameters are params_lambda(key). The
+    // constraints of the entries of a column must be distinct.
+    template <std::ranges::range IR, typename EL, typename PL>
+    auto add_columns(IR && keys, EL && entries_lambda, PL && params_lambda) {
+        _reset_cache();
+        tmp_begins.resize(0);
+        tmp_lower_bounds.resize(0);
+        tmp_upper_bounds.resize(0);
+        tmp_objective_coefs.resize(0);
+        for(auto && key : keys) {
+            const variable_params params = params_lambda(key);
+            tmp_begins.emplace_back(static_cast<index>(tmp_indices.size()));
+            tmp_objective_coefs.emplace_back(params.obj_coef);
+            tmp_lower_bounds.emplace_back(
+                params.lower_bound.value_or(-COIN_DBL_MAX));
+            tmp_upper_bounds.emplace_back(
+                params.upper_bound.value_or(COIN_DBL_MAX));
+            _register_constraints_entries<true>(entries_lambda(key));
+        }
+        tmp_begins.emplace_back(static_cast<index>(tmp_indices.size()));
+        const std::size_t offset = num_native_ids_variables();
+        const std::size_t count = tmp_objective_coefs.size();
+        Clp->addColumns(model, static_cast<int>(count),
+                        tmp_lower_bounds.data(), tmp_upper_bounds.data(),
+                        tmp_objective_coefs.data(), tmp_begins.data(),
+                        tmp_indices.data(), tmp_scalars.data());
+        return _make_variables_view(offset, count);
+    }
+    template <std::ranges::range IR, typename EL>
+    auto add_columns(IR && keys, EL && entries_lambda) {
+        return add_columns(
+            std::forward<IR>(keys), std::forward<EL>(entries_lambda),
+            [](auto &&) { return default_variable_params; });
+    }
 
     void remove_variable(variable v) {
         set_objective_coefficient(v, 0);
@@ -481,6 +585,161 @@ public:
     }
     // auto get_constraint(const constraint constr) const;
 
+    ///////////////////////////////////////////////////////////////////////////
+    /////////////////////////////// Bulk access ///////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Clp keeps the objective and the bounds in arrays of the model that it
+    // reads at the next solve : the bulk setters write them directly, in one
+    // loop and without a call into the library per value. values[i] is the
+    // new value of the i-th entity of the range, and the overloads without a
+    // range set the entities of ids 0 to values.size() - 1.
+private:
+    [[noreturn]] static void _throw_bulk_sizes_mismatch() {
+        throw std::invalid_argument(
+            "The numbers of entities and values differ");
+    }
+    // a range that is not sized is counted while it is walked, see
+    // _check_bulk_index and _check_bulk_count
+    template <typename ER>
+    static void _check_bulk_sizes(ER && entities,
+                                  const std::size_t num_values) {
+        if constexpr(std::ranges::sized_range<ER>) {
+            if(std::ranges::size(entities) == num_values) return;
+            _throw_bulk_sizes_mismatch();
+        }
+    }
+    template <typename ER>
+    static void _check_bulk_index(const std::size_t i,
+                                  const std::size_t num_values) {
+        if constexpr(!std::ranges::sized_range<ER>)
+            if(i >= num_values) _throw_bulk_sizes_mismatch();
+    }
+    template <typename ER>
+    static void _check_bulk_count(const std::size_t count,
+                                  const std::size_t num_values) {
+        if constexpr(!std::ranges::sized_range<ER>)
+            if(count != num_values) _throw_bulk_sizes_mismatch();
+    }
+    static void _check_dense_size(const std::size_t num_values,
+                                  const std::size_t num_entities) {
+        if(num_values <= num_entities) return;
+        throw std::invalid_argument("More values than entities");
+    }
+    template <std::ranges::range ER>
+    static void _scatter(ER && entities, std::span<const scalar> values,
+                         scalar * array) {
+        _check_bulk_sizes(entities, values.size());
+        std::size_t i = 0;
+        for(auto && e : entities) {
+            _check_bulk_index<ER>(i, values.size());
+            array[e.id()] = values[i++];
+        }
+        _check_bulk_count<ER>(i, values.size());
+    }
+
+public:
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    void set_objective_coefficients(VR && vars,
+                                    std::span<const scalar> coefs) {
+        _scatter(vars, coefs, Clp->objective(model));
+    }
+    void set_objective_coefficients(std::span<const scalar> coefs) {
+        _check_dense_size(coefs.size(), num_native_ids_variables());
+        std::ranges::copy(coefs, Clp->objective(model));
+    }
+private:
+    static void _check_bounds_sizes(std::span<const scalar> lower_bounds,
+                                    std::span<const scalar> upper_bounds) {
+        if(lower_bounds.size() == upper_bounds.size()) return;
+        throw std::invalid_argument(
+            "The numbers of lower and upper bounds differ");
+    }
+
+public:
+    // all the sizes are checked before any bound is written, which counts
+    // the variables of a range that is not sized in a first pass
+    template <std::ranges::forward_range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    void set_variables_bounds(VR && vars, std::span<const scalar> lower_bounds,
+                              std::span<const scalar> upper_bounds) {
+        _check_bounds_sizes(lower_bounds, upper_bounds);
+        if(static_cast<std::size_t>(std::ranges::distance(vars)) !=
+           lower_bounds.size())
+            _throw_bulk_sizes_mismatch();
+        scalar * column_lower = Clp->columnLower(model);
+        scalar * column_upper = Clp->columnUpper(model);
+        std::size_t i = 0;
+        for(auto && x : vars) {
+            column_lower[x.id()] = lower_bounds[i];
+            column_upper[x.id()] = upper_bounds[i++];
+        }
+    }
+    void set_variables_bounds(std::span<const scalar> lower_bounds,
+                              std::span<const scalar> upper_bounds) {
+        _check_bounds_sizes(lower_bounds, upper_bounds);
+        _check_dense_size(lower_bounds.size(), num_native_ids_variables());
+        std::ranges::copy(lower_bounds, Clp->columnLower(model));
+        std::ranges::copy(upper_bounds, Clp->columnUpper(model));
+    }
+
+private:
+    // the bound of the row that holds its rhs, as in set_constraint_rhs
+    static void _set_row_rhs(scalar & lb, scalar & ub, const scalar rhs) {
+        if(lb == ub) {
+            lb = ub = rhs;
+        } else if(lb == -COIN_DBL_MAX) {
+            ub = rhs;
+        } else if(ub == COIN_DBL_MAX) {
+            lb = rhs;
+        } else {
+            throw std::runtime_error(
+                "Tried to set the rhs of a ranged constraint");
+        }
+    }
+
+public:
+    template <std::ranges::range CR>
+        requires std::same_as<std::ranges::range_value_t<CR>, constraint>
+    void set_constraints_rhs(CR && constrs, std::span<const scalar> rhs) {
+        _check_bulk_sizes(constrs, rhs.size());
+        scalar * row_lower = Clp->rowLower(model);
+        scalar * row_upper = Clp->rowUpper(model);
+        std::size_t i = 0;
+        for(auto && c : constrs) {
+            _check_bulk_index<CR>(i, rhs.size());
+            _set_row_rhs(row_lower[c.id()], row_upper[c.id()], rhs[i++]);
+        }
+        _check_bulk_count<CR>(i, rhs.size());
+    }
+    void set_constraints_rhs(std::span<const scalar> rhs) {
+        _check_dense_size(rhs.size(), num_constraints());
+        scalar * row_lower = Clp->rowLower(model);
+        scalar * row_upper = Clp->rowUpper(model);
+        for(std::size_t i = 0; i < rhs.size(); ++i)
+            _set_row_rhs(row_lower[i], row_upper[i], rhs[i]);
+    }
+
+    // Views over the arrays of the model, indexed by variable and constraint
+    // ids and invalidated by the next addition of variables or constraints.
+    // A removed variable keeps its id, with null objective and bounds.
+    std::span<const scalar> get_objective_coefficients() {
+        return {Clp->objective(model), num_native_ids_variables()};
+    }
+    std::span<const scalar> get_variables_lower_bounds() {
+        return {Clp->columnLower(model), num_native_ids_variables()};
+    }
+    std::span<const scalar> get_variables_upper_bounds() {
+        return {Clp->columnUpper(model), num_native_ids_variables()};
+    }
+    // the rows as lb <= lhs <= ub, with -COIN_DBL_MAX and COIN_DBL_MAX for
+    // the missing sides
+    std::span<const scalar> get_constraints_lower_bounds() {
+        return {Clp->rowLower(model), num_constraints()};
+    }
+    std::span<const scalar> get_constraints_upper_bounds() {
+        return {Clp->rowUpper(model), num_constraints()};
+    }
     ///////////////////////////////////////////////////////////////////////////
     ////////////////////////// Tolerance parameters ///////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -488,6 +747,10 @@ public:
         Clp->setPrimalTolerance(model, tol);
     }
     scalar get_feasibility_tolerance() { return Clp->primalTolerance(model); }
+    void set_optimality_tolerance(scalar tol) {
+        Clp->setDualTolerance(model, tol);
+    }
+    scalar get_optimality_tolerance() { return Clp->dualTolerance(model); }
     ///////////////////////////////////////////////////////////////////////////
     ////////////////////////////// Solve status ///////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -529,12 +792,76 @@ public:
     auto get_solution() {
         return variable_mapping(Clp->primalColumnSolution(model));
     }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _gather_values(vars, Clp->primalColumnSolution(model));
+    }
     auto get_dual_solution() {
         return constraint_mapping(Clp->dualRowSolution(model));
     }
     auto get_reduced_costs() {
         return variable_mapping(Clp->dualColumnSolution(model));
     }
+    ///////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////// Basis //////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    using basis = model_lp_basis<variable, constraint>;
+
+private:
+    // ClpSimplex::Status, in the 3 low bits of the status array entries
+    static basis::code _basis_code(const unsigned char status) {
+        switch(status & 7) {
+            case 1:
+                return basis::code::basic;
+            case 2:
+                return basis::code::nonbasic_at_upper_bound;
+            case 3:
+                return basis::code::nonbasic_at_lower_bound;
+            case 5:
+                return basis::code::nonbasic_fixed;
+            default:  // free or superbasic
+                return basis::code::nonbasic_free;
+        }
+    }
+    static unsigned char _basis_status(const basis::code code) {
+        switch(code) {
+            case basis::code::basic:
+                return 1;
+            case basis::code::nonbasic_free:
+                return 0;
+            case basis::code::nonbasic_at_upper_bound:
+                return 2;
+            case basis::code::nonbasic_fixed:
+                return 5;
+            default:
+                return 3;
+        }
+    }
+    static std::size_t _handle_id(const std::size_t i) { return i; }
+
+public:
+    // the basis of the last solve, read from the status array of the model,
+    // columns then rows ; without one, the slack basis
+    basis get_basis() {
+        const auto num_cols = static_cast<std::size_t>(Clp->getNumCols(model));
+        const auto num_rows = num_constraints();
+        const unsigned char * status = Clp->statusArray(model);
+        if(status == nullptr) return basis();
+        return basis::from_native(std::span(status, num_cols),
+                                  std::span(status + num_cols, num_rows),
+                                  num_cols, _handle_id, _basis_code,
+                                  _basis_code);
+    }
+    // warm starts the next solve from b, copied in as a whole status array
+    void set_basis(const basis & b) {
+        const auto num_cols = static_cast<std::size_t>(Clp->getNumCols(model));
+        std::vector<unsigned char> status(num_cols + num_constraints());
+        b.to_native(std::span(status).first(num_cols),
+                    std::span(status).subspan(num_cols), _handle_id,
+                    _basis_status, _basis_status);
+        Clp->copyinStatus(model, status.data());
+    }
 };
 
 }  // namespace clp::v1_17
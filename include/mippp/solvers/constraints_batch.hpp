@@ -0,0 +1,48 @@
+#pragma once
+
+#include <exception>
+#include <utility>
+
+namespace mippp {
+
+// Scope returned by model.batch_constraints() : while it is alive,
+// add_constraint stages the rows on the mippp side and returns their handles
+// right away. The staged rows are sent to the solver in a single bulk call
+// when the scope ends, when commit() is called, or earlier if an operation
+// needs to see them (reading a constraint, add_column, solve, ...). If the
+// scope is left by an exception, the rows still staged are discarded.
+template <typename Model>
+class constraints_batch {
+private:
+    Model * _model;
+    int _uncaught_exceptions;
+
+public:
+    [[nodiscard]] explicit constraints_batch(Model & model)
+        : _model(&model), _uncaught_exceptions(std::uncaught_exceptions()) {
+        _model->_begin_constraints_batch();
+    }
+    ~constraints_batch() noexcept(false) {
+        if(_model == nullptr) return;
+        if(std::uncaught_exceptions() > _uncaught_exceptions) {
+            _model->_discard_constraints_batch();
+            return;
+        }
+        _model->_end_constraints_batch();
+    }
+
+    constraints_batch(const constraints_batch &) = delete;
+    constraints_batch(constraints_batch && other) noexcept
+        : _model(std::exchange(other._model, nullptr))
+        , _uncaught_exceptions(other._uncaught_exceptions) {}
+
+    constraints_batch & operator=(const constraints_batch &) = delete;
+    constraints_batch & operator=(constraints_batch &&) = delete;
+
+    void commit() {
+        if(_model == nullptr) return;
+        std::exchange(_model, nullptr)->_end_constraints_batch();
+    }
+};
+
+}  // namespace mippp
@@ -28,6 +28,7 @@ ret_code COPT_CreateEnv(copt_env ** p_env);
 ret_code COPT_DeleteEnv(copt_env ** p_env);
 ret_code COPT_CreateProb(copt_env * env, copt_prob ** p_prob);
 ret_code COPT_DeleteProb(copt_prob ** p_prob);
+ret_code COPT_CreateCopy(copt_prob * src_prob, copt_prob ** p_dst_prob);
 
 constexpr int COPT_BUFFSIZE = 1000;
 int COPT_GetRetcodeMsg(int code, char * buff, int buffSize);
@@ -44,6 +45,11 @@ ret_code COPT_SetDblParam(copt_prob * prob, const char * paramName,
                           double dblParam);
 ret_code COPT_GetDblParam(copt_prob * prob, const char * paramName,
                           double * p_dblParam);
+constexpr const char * COPT_INTPARAM_THREADS = "Threads";
+ret_code COPT_SetIntParam(copt_prob * prob, const char * paramName,
+                          int intParam);
+ret_code COPT_GetIntParam(copt_prob * prob, const char * paramName,
+                          int * p_intParam);
 ret_code COPT_GetIntAttr(copt_prob * prob, const char * attrName,
                          int * p_intAttr);
 ret_code COPT_GetDblAttr(copt_prob * prob, const char * attrName,
@@ -93,6 +99,7 @@ constexpr const char * COPT_DBLINFO_LB = "LB";
 ret_code COPT_SetColUpper(copt_prob * prob, int num, const int * list,
                           const double * upper);
 constexpr const char * COPT_DBLINFO_UB = "UB";
+constexpr const char * COPT_DBLINFO_VALUE = "Value";  // solution
 ret_code COPT_GetColInfo(copt_prob * prob, const char * infoName, int num,
                          const int * list, double * info);
 ret_code COPT_SetColNames(copt_prob * prob, int num, const int * list,
@@ -202,6 +209,8 @@ ret_code COPT_AddCallbackLazyConstr(void * cbdata, int nRowMatCnt,
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -214,11 +223,14 @@ namespace copt::v7_2 {
     F(COPT_CreateEnv, CreateEnv)                     \
     F(COPT_DeleteEnv, DeleteEnv)                     \
     F(COPT_CreateProb, CreateProb)                   \
+    F(COPT_CreateCopy, CreateCopy)                   \
     F(COPT_DeleteProb, DeleteProb)                   \
     F(COPT_GetRetcodeMsg, GetRetcodeMsg)             \
     F(COPT_GetLicenseMsg, GetLicenseMsg)             \
     F(COPT_SetDblParam, SetDblParam)                 \
     F(COPT_GetDblParam, GetDblParam)                 \
+    F(COPT_SetIntParam, SetIntParam)                 \
+    F(COPT_GetIntParam, GetIntParam)                 \
     F(COPT_GetIntAttr, GetIntAttr)                   \
     F(COPT_GetDblAttr, GetDblAttr)                   \
     F(COPT_SetObjSense, SetObjSense)                 \
@@ -258,13 +270,13 @@ namespace copt::v7_2 {
 
 #define DECLARE_COPT_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);   \
-    SHORT##_fun_t const * SHORT;
+    detail::solver_function<SHORT##_fun_t> SHORT;
 #define CONSTRUCT_COPT_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<SHORT##_fun_t>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 
 class copt_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
 public:
     COPT_FUNCTIONS(DECLARE_COPT_FUNCTIONS)
@@ -1,16 +1,19 @@
 #pragma once
 
+#include <execution>
 #include <memory>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <vector>
 
+#include "mippp/detail/parallel_rows.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
 #include "mippp/model_entities.hpp"
 
+#include "mippp/solvers/constraints_batch.hpp"
 #include "mippp/solvers/copt/v7_2/copt_api.hpp"
 #include "mippp/solvers/model_base.hpp"
 
@@ -39,12 +42,25 @@ public:
 protected:
     const copt_api * COPT;
     copt_env * env;
+    // the clones of a model share its environment, deleted with the last
+    std::shared_ptr<copt_env> _env_owner;
     copt_prob * prob;
 
     std::vector<indice> tmp_begins;
     std::vector<char> tmp_types;
     std::vector<scalar> tmp_rhs;
 
+    // rows added by add_constraint inside a batch_constraints() scope
+    int _constraints_batch_depth;
+    std::vector<indice> staged_begins;
+    std::vector<indice> staged_indices;
+    std::vector<scalar> staged_scalars;
+    std::vector<char> staged_types;
+    std::vector<scalar> staged_rhs;
+
+    template <typename>
+    friend class mippp::constraints_batch;
+
     void check(const ret_code error) { COPT->_check(env, error); }
     static constexpr char constraint_sense_to_copt_sense(constraint_sense rel) {
         if(rel == constraint_sense::less_equal) return COPT_LESS_EQUAL;
@@ -60,13 +76,18 @@ protected:
 
 public:
     [[nodiscard]] explicit copt_base(const copt_api & api)
-        : model_base<int, double>(), COPT(&api), env(nullptr), prob(nullptr) {
+        : model_base<int, double>()
+        , COPT(&api)
+        , env(nullptr)
+        , prob(nullptr)
+        , _constraints_batch_depth(0) {
         check(COPT->CreateEnv(&env));
+        _env_owner = std::shared_ptr<copt_env>(
+            env, [api = COPT](copt_env * e) { api->DeleteEnv(&e); });
         check(COPT->CreateProb(env, &prob));
     }
     ~copt_base() {
         if(prob) check(COPT->DeleteProb(&prob));
-        if(env) check(COPT->DeleteEnv(&env));
     }
 
     constexpr copt_base(const copt_base &) = delete;
@@ -74,10 +95,17 @@ public:
         : model_base<int, double>(std::move(other))
         , COPT(other.COPT)
         , env(other.env)
+        , _env_owner(std::move(other._env_owner))
         , prob(other.prob)
         , tmp_begins(std::move(other.tmp_begins))
         , tmp_types(std::move(other.tmp_types))
-        , tmp_rhs(std::move(other.tmp_rhs)) {
+        , tmp_rhs(std::move(other.tmp_rhs))
+        , _constraints_batch_depth(other._constraints_batch_depth)
+        , staged_begins(std::move(other.staged_begins))
+        , staged_indices(std::move(other.staged_indices))
+        , staged_scalars(std::move(other.staged_scalars))
+        , staged_types(std::move(other.staged_types))
+        , staged_rhs(std::move(other.staged_rhs)) {
         other.env = nullptr;
         other.prob = nullptr;
     }
@@ -85,17 +113,37 @@ public:
     constexpr copt_base & operator=(const copt_base &) = delete;
     constexpr copt_base & operator=(copt_base && other) = delete;
 
+protected:
+    // other on prob_copy, a copy of its problem : the handles of other stay
+    // valid, its staged rows are already added and no solution is copied
+    copt_base(const copt_base & other, copt_prob * prob_copy)
+        : model_base<int, double>(other)
+        , COPT(other.COPT)
+        , env(other.env)
+        , _env_owner(other._env_owner)
+        , prob(prob_copy)
+        , _constraints_batch_depth(0) {
+        _invalidate_solution_caches();
+    }
+    copt_base _clone_base() {
+        _flush_staged_constraints();
+        copt_prob * prob_copy = nullptr;
+        check(COPT->CreateCopy(prob, &prob_copy));
+        return copt_base(*this, prob_copy);
+    }
+
+public:
     std::size_t num_variables() {
         int num;
         check(COPT->GetIntAttr(prob, COPT_INTATTR_COLS, &num));
         return static_cast<std::size_t>(num);
     }
     std::size_t num_constraints() {
-        int num;
-        check(COPT->GetIntAttr(prob, COPT_INTATTR_ROWS, &num));
-        return static_cast<std::size_t>(num);
+        _flush_staged_constraints();
+        return _num_native_constraints();
     }
     std::size_t num_entries() {
+        _flush_staged_constraints();
         int num;
         check(COPT->GetIntAttr(prob, COPT_INTATTR_ELEMS, &num));
         return static_cast<std::size_t>(num);
@@ -260,6 +308,7 @@ private:
     template <typename ER>
     inline variable _add_column(ER && entries, const variable_params & params,
                                 const char & type) {
+        _flush_staged_constraints();
         const int var_id = static_cast<int>(num_variables());
         _reset_cache();
         _register_constraints_entries<true>(entries);
@@ -328,14 +377,59 @@ public:
         return name;
     }
 
+protected:
+    std::size_t _num_native_constraints() {
+        int num;
+        check(COPT->GetIntAttr(prob, COPT_INTATTR_ROWS, &num));
+        return static_cast<std::size_t>(num);
+    }
+
+    void _begin_constraints_batch() { ++_constraints_batch_depth; }
+    void _end_constraints_batch() {
+        if(--_constraints_batch_depth == 0) _flush_staged_constraints();
+    }
+    void _discard_constraints_batch() {
+        if(--_constraints_batch_depth == 0) _clear_staged_constraints();
+    }
+    void _clear_staged_constraints() {
+        staged_begins.resize(0);
+        staged_indices.resize(0);
+        staged_scalars.resize(0);
+        staged_types.resize(0);
+        staged_rhs.resize(0);
+    }
+    void _flush_staged_constraints() {
+        if(staged_rhs.empty()) return;
+        staged_begins.emplace_back(static_cast<indice>(staged_indices.size()));
+        const ret_code error = COPT->AddRows(
+            prob, static_cast<int>(staged_rhs.size()), staged_begins.data(),
+            nullptr, staged_indices.data(), staged_scalars.data(),
+            staged_types.data(), staged_rhs.data(), nullptr, nullptr);
+        _clear_staged_constraints();
+        check(error);
+    }
+
 private:
     template <bool distinct, linear_constraint LC>
     constraint _add_constraint(LC && lc) {
-        auto constr_id = static_cast<constraint_id>(num_constraints());
+        auto constr_id = static_cast<constraint_id>(_num_native_constraints() +
+                                                    staged_rhs.size());
         if constexpr(!distinct) _prepare_coalescing(num_variables());
         _reset_cache();
         _register_variables_entries<distinct>(lc.linear_terms());
         const scalar b = lc.rhs();
+        if(_constraints_batch_depth > 0) {
+            staged_begins.emplace_back(
+                static_cast<indice>(staged_indices.size()));
+            staged_indices.insert(staged_indices.end(), tmp_indices.cbegin(),
+                                  tmp_indices.cend());
+            staged_scalars.insert(staged_scalars.end(), tmp_scalars.cbegin(),
+                                  tmp_scalars.cend());
+            staged_types.emplace_back(
+                constraint_sense_to_copt_sense(lc.sense()));
+            staged_rhs.emplace_back(b);
+            return constraint(constr_id);
+        }
         check(COPT->AddRow(prob, static_cast<int>(tmp_indices.size()),
                            tmp_indices.data(), tmp_scalars.data(),
                            constraint_sense_to_copt_sense(lc.sense()), b,
@@ -352,6 +446,7 @@ public:
     constraint add_constraint(distinct_variables_t, LC && lc) {
         return _add_constraint<true>(std::forward<LC>(lc));
     }
+    [[nodiscard]] auto batch_constraints() { return constraints_batch(*this); }
 
 private:
     template <bool distinct, linear_constraint LC>
@@ -385,6 +480,7 @@ private:
 
     template <bool distinct, std::ranges::range IR, typename... CL>
     auto _add_constraints(IR && keys, CL &... constraint_lambdas) {
+        _flush_staged_constraints();
         if constexpr(!distinct) _prepare_coalescing(num_variables());
         _reset_cache();
         tmp_begins.resize(0);
@@ -421,6 +517,77 @@ public:
                                       constraint_lambdas...);
     }
 
+private:
+    template <bool distinct, std::ranges::random_access_range IR,
+              typename... CL>
+    auto _add_constraints_parallel(IR && keys, CL &... constraint_lambdas) {
+        _flush_staged_constraints();
+        const indice offset = static_cast<indice>(_num_native_constraints());
+        auto rows = detail::build_rows_in_parallel<distinct, indice, scalar>(
+            keys, num_variables(),
+            [](const variable & v) { return v.id(); },
+            constraint_lambdas...);
+        const std::size_t num_rows = rows.num_rows();
+        tmp_types.resize(num_rows);
+        std::ranges::transform(rows.senses, tmp_types.begin(),
+                               constraint_sense_to_copt_sense);
+        rows.begins.emplace_back(static_cast<indice>(rows.indices.size()));
+        check(COPT->AddRows(prob, static_cast<int>(num_rows),
+                            rows.begins.data(), nullptr, rows.indices.data(),
+                            rows.scalars.data(), tmp_types.data(),
+                            rows.rhs.data(), nullptr, nullptr));
+        return constraints_range(
+            std::forward<IR>(keys),
+            std::views::transform(
+                std::views::iota(offset,
+                                 offset + static_cast<indice>(num_rows)),
+                [](auto && i) { return constraint{i}; }));
+    }
+
+public:
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<false>(std::forward<IR>(keys),
+                                                constraint_lambdas...);
+    }
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &,
+                         distinct_variables_t, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<true>(std::forward<IR>(keys),
+                                               constraint_lambdas...);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //////////////////////////////// Solution /////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+protected:
+    // only the requested columns, unless the whole solution is cached
+    template <std::ranges::range VR>
+    std::vector<double> _get_solution_values(VR && vars) {
+        if(const double * x = _solution_cache.cached(num_variables()))
+            return _gather_values(vars, x);
+        tmp_indices.clear();
+        for(auto && v : vars) tmp_indices.emplace_back(v.id());
+        std::vector<double> values(tmp_indices.size());
+        check(COPT->GetColInfo(prob, COPT_DBLINFO_VALUE,
+                               static_cast<int>(tmp_indices.size()),
+                               tmp_indices.data(), values.data()));
+        return values;
+    }
+
+    // -1 lets COPT choose
+    void set_thread_count(std::size_t n) {
+        check(COPT->SetIntParam(prob, COPT_INTPARAM_THREADS,
+                                n == 0 ? -1 : static_cast<int>(n)));
+    }
+    std::size_t get_thread_count() {
+        int n;
+        check(COPT->GetIntParam(prob, COPT_INTPARAM_THREADS, &n));
+        return n < 0 ? 0 : static_cast<std::size_t>(n);
+    }
+
 protected:
     static void check_lp_status(int status) {
         if(status >= 1 && status <= 3) return;
@@ -11,9 +11,15 @@ namespace mippp {
 namespace copt::v7_2 {
 
 class copt_lp : public copt_base {
+private:
+    explicit copt_lp(copt_base && base) : copt_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit copt_lp(const copt_api & api) : copt_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] copt_lp clone() { return copt_lp(_clone_base()); }
+
     ///////////////////////////////////////////////////////////////////////////
     ////////////////////////////// Solve status ///////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -56,6 +62,8 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
         check(COPT->SolveLp(prob));
         _status = _get_status();
     }
@@ -65,25 +73,30 @@ public:
         return val;
     }
     auto get_solution() {
-        auto solution =
-            std::make_unique_for_overwrite<double[]>(num_variables());
-        check(COPT->GetLpSolution(prob, solution.get(), nullptr, nullptr,
-                                  nullptr));
-        return variable_mapping(std::move(solution));
+        return variable_mapping(
+            _solution_cache.get(num_variables(), [this](double * solution) {
+                check(COPT->GetLpSolution(prob, solution, nullptr, nullptr,
+                                          nullptr));
+            }));
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_solution_values(vars);
     }
     auto get_dual_solution() {
-        auto dual_solution =
-            std::make_unique_for_overwrite<double[]>(num_variables());
-        check(COPT->GetLpSolution(prob, nullptr, nullptr, dual_solution.get(),
-                                  nullptr));
-        return constraint_mapping(std::move(dual_solution));
+        return constraint_mapping(_dual_solution_cache.get(
+            num_constraints(), [this](double * dual_solution) {
+                check(COPT->GetLpSolution(prob, nullptr, nullptr,
+                                          dual_solution, nullptr));
+            }));
     }
     auto get_reduced_costs() {
-        auto reduced_costs =
-            std::make_unique_for_overwrite<double[]>(num_variables());
-        check(COPT->GetLpSolution(prob, nullptr, nullptr, nullptr,
-                                  reduced_costs.get()));
-        return variable_mapping(std::move(reduced_costs));
+        return variable_mapping(_reduced_costs_cache.get(
+            num_variables(), [this](double * reduced_costs) {
+                check(COPT->GetLpSolution(prob, nullptr, nullptr, nullptr,
+                                          reduced_costs));
+            }));
     }
 };
 
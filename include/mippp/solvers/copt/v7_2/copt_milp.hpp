@@ -1,10 +1,10 @@
 #pragma once
 
-#include <functional>
 #include <numeric>
 #include <optional>
 #include <vector>
 
+#include "mippp/detail/callback_storage.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
@@ -19,9 +19,19 @@ class copt_milp : public copt_base {
 private:
     int _is_mip;
 
+    explicit copt_milp(copt_base && base) : copt_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit copt_milp(const copt_api & api) : copt_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid,
+    // without the callbacks
+    [[nodiscard]] copt_milp clone() {
+        copt_milp copy(_clone_base());
+        if(solution_callback || relaxation_callback) copy._update_callbacks();
+        return copy;
+    }
+
     variable add_integer_variable(
         const variable_params params = default_variable_params) {
         return _add_variable(params, COPT_INTEGER);
@@ -95,19 +105,23 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     //////////////////////////////// Callbacks ////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
-    class candidate_solution_callback_handle : public model_base<int, double> {
-    private:
+private:
+    class callback_handle_base : public model_base<int, double> {
+    protected:
         const copt_api * COPT;
         copt_prob * prob;
         void * cbdata;
+        detail::per_thread_buffers<double> * buffers;
 
     public:
-        candidate_solution_callback_handle(const copt_api * api,
-                                           copt_prob * prob_, void * cbdata_)
+        callback_handle_base(const copt_api * api, copt_prob * prob_,
+                             void * cbdata_,
+                             detail::per_thread_buffers<double> & buffers_)
             : model_base<int, double>()
             , COPT(api)
             , prob(prob_)
-            , cbdata(cbdata_) {}
+            , cbdata(cbdata_)
+            , buffers(&buffers_) {}
 
         void check(const ret_code error) { COPT->_check(nullptr, error); }
 
@@ -116,6 +130,15 @@ public:
             check(COPT->GetIntAttr(prob, COPT_INTATTR_COLS, &num));
             return static_cast<std::size_t>(num);
         }
+    };
+
+public:
+    class candidate_solution_callback_handle : public callback_handle_base {
+    public:
+        candidate_solution_callback_handle(
+            const copt_api * api, copt_prob * prob_, void * cbdata_,
+            detail::per_thread_buffers<double> & buffers_)
+            : callback_handle_base(api, prob_, cbdata_, buffers_) {}
 
     private:
         template <bool distinct, linear_constraint LC>
@@ -143,33 +166,103 @@ public:
             check(COPT->GetCallbackInfo(cbdata, COPT_CBINFO_MIPCANDOBJ, &obj));
             return obj;
         }
+        // valid until the callback returns
         auto get_solution() {
-            auto num_vars = num_variables();
-            auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
+            double * solution = buffers->local(num_variables());
             check(COPT->GetCallbackInfo(cbdata, COPT_CBINFO_MIPCANDIDATE,
-                                        solution.get()));
-            return variable_mapping(std::move(solution));
+                                        solution));
+            return variable_mapping(static_cast<const double *>(solution));
+        }
+    };
+
+    class node_relaxation_callback_handle : public callback_handle_base {
+    public:
+        node_relaxation_callback_handle(
+            const copt_api * api, copt_prob * prob_, void * cbdata_,
+            detail::per_thread_buffers<double> & buffers_)
+            : callback_handle_base(api, prob_, cbdata_, buffers_) {}
+
+    private:
+        template <bool distinct, linear_constraint LC>
+        void _add_cut(LC && lc) {
+            if constexpr(!distinct) _prepare_coalescing(num_variables());
+            _reset_cache();
+            _register_variables_entries<distinct>(lc.linear_terms());
+            check(COPT->AddCallbackUserCut(
+                cbdata, static_cast<int>(tmp_indices.size()),
+                tmp_indices.data(), tmp_scalars.data(),
+                constraint_sense_to_copt_sense(lc.sense()), lc.rhs()));
+        }
+
+    public:
+        template <linear_constraint LC>
+        void add_cut(LC && lc) {
+            _add_cut<false>(std::forward<LC>(lc));
+        }
+        template <linear_constraint LC>
+        void add_cut(distinct_variables_t, LC && lc) {
+            _add_cut<true>(std::forward<LC>(lc));
+        }
+        double get_relaxation_value() {
+            double obj;
+            check(COPT->GetCallbackInfo(cbdata, COPT_CBINFO_RELAXSOLOBJ, &obj));
+            return obj;
+        }
+        // valid until the callback returns
+        auto get_relaxation_solution() {
+            double * solution = buffers->local(num_variables());
+            check(COPT->GetCallbackInfo(cbdata, COPT_CBINFO_RELAXSOLUTION,
+                                        solution));
+            return variable_mapping(static_cast<const double *>(solution));
         }
     };
 
 private:
-    std::function<void(candidate_solution_callback_handle &)> solution_callback;
+    detail::callback_holder<candidate_solution_callback_handle>
+        solution_callback;
+    detail::callback_holder<node_relaxation_callback_handle>
+        relaxation_callback;
+    detail::per_thread_buffers<double> _callback_buffers;
 
-    static int candidate_solution_callback_func(copt_prob * prob, void * cbdata,
-                                                int cbctx, void * userdata) {
-        if(cbctx != COPT_CBCONTEXT_MIPSOL) return 0;
+    // COPT keeps a single callback function per problem, hence all the
+    // contexts are dispatched from here, possibly by several threads at once
+    static int main_callback(copt_prob * prob, void * cbdata, int cbctx,
+                             void * userdata) {
         auto * model = static_cast<copt_milp *>(userdata);
-        candidate_solution_callback_handle handle(model->COPT, prob, cbdata);
-        model->solution_callback(handle);
+        if(cbctx == COPT_CBCONTEXT_MIPSOL) {
+            const auto guard = model->_callback_buffers.release_on_return();
+            candidate_solution_callback_handle handle(
+                model->COPT, prob, cbdata, model->_callback_buffers);
+            model->solution_callback(handle);
+        } else if(cbctx == COPT_CBCONTEXT_MIPRELAX) {
+            int node_status;
+            model->check(model->COPT->GetCallbackInfo(
+                cbdata, COPT_CBINFO_NODESTATUS, &node_status));
+            if(node_status != COPT_LPSTATUS_OPTIMAL) return 0;
+            const auto guard = model->_callback_buffers.release_on_return();
+            node_relaxation_callback_handle handle(model->COPT, prob, cbdata,
+                                                   model->_callback_buffers);
+            model->relaxation_callback(handle);
+        }
         return 0;
     }
+    void _update_callbacks() {
+        int cbctx = 0;
+        if(solution_callback) cbctx |= COPT_CBCONTEXT_MIPSOL;
+        if(relaxation_callback) cbctx |= COPT_CBCONTEXT_MIPRELAX;
+        check(COPT->SetCallback(prob, main_callback, cbctx, this));
+    }
 
 public:
     template <typename F>
     void set_candidate_solution_callback(F && f) {
-        solution_callback = std::forward<F>(f);
-        check(COPT->SetCallback(prob, candidate_solution_callback_func,
-                                COPT_CBCONTEXT_MIPSOL, this));
+        solution_callback.emplace(std::forward<F>(f));
+        _update_callbacks();
+    }
+    template <typename F>
+    void set_node_relaxation_callback(F && f) {
+        relaxation_callback.emplace(std::forward<F>(f));
+        _update_callbacks();
     }
     ///////////////////////////////////////////////////////////////////////////
     //////////////////////////////// MIP start ////////////////////////////////
@@ -282,6 +375,9 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
+        _callback_buffers.clear();
         check(COPT->GetIntAttr(prob, COPT_INTATTR_ISMIP, &_is_mip));
         if(_is_mip) {
             check(COPT->Solve(prob));
@@ -301,14 +397,19 @@ public:
         return val;
     }
     auto get_solution() {
-        auto solution =
-            std::make_unique_for_overwrite<double[]>(num_variables());
-        if(_is_mip)
-            check(COPT->GetSolution(prob, solution.get()));
-        else
-            check(COPT->GetLpSolution(prob, solution.get(), nullptr, nullptr,
-                                      nullptr));
-        return variable_mapping(std::move(solution));
+        return variable_mapping(
+            _solution_cache.get(num_variables(), [this](double * solution) {
+                if(_is_mip)
+                    check(COPT->GetSolution(prob, solution));
+                else
+                    check(COPT->GetLpSolution(prob, solution, nullptr,
+                                              nullptr, nullptr));
+            }));
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_solution_values(vars);
     }
 };
 
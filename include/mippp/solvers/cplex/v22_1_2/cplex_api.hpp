@@ -13,6 +13,7 @@ struct cpxlp;
 using CPXLPptr = struct cpxlp *;
 using CPXCLPptr = const struct cpxlp *;
 using CPXCCHARptr = const char *;
+using CPXLONG = long long;
 
 constexpr double CPX_INFBOUND = 1e20;
 
@@ -27,6 +28,7 @@ constexpr int CPXPROB_MILP = 1;
 int CPXgetprobtype(CPXCENVptr env, CPXCLPptr lp);
 int CPXchgprobtype(CPXCENVptr env, CPXLPptr lp, int type);
 int CPXfreeprob(CPXCENVptr env, CPXLPptr * lp_p);
+CPXLPptr CPXcloneprob(CPXCENVptr env, CPXCLPptr lp, int * status_p);
 constexpr int CPXMESSAGEBUFSIZE = 1024;
 const char * CPXgeterrorstring(CPXCENVptr env, int errcode, char * buffer_str);
 
@@ -115,6 +117,7 @@ constexpr int CPXPARAM_Simplex_Limits_Iterations = 1020;
 constexpr int CPXPARAM_MIP_Limits_Nodes = 2017;
 constexpr int CPXPARAM_MIP_Limits_Solutions = 2015;
 constexpr int CPXPARAM_MIP_Limits_TreeMemory = 2027;
+constexpr int CPXPARAM_Threads = 1067;
 constexpr int CPXPARAM_MIP_Tolerances_MIPGap = 2009;
 constexpr int CPXPARAM_MIP_Tolerances_Linearization = 2068;
 // constexpr int CPXPARAM_MIP_Tolerances_Integrality = 2010;
@@ -131,6 +134,20 @@ enum PrereduceType : int {
 };
 int CPXgetintparam(CPXCENVptr env, int whichparam, int * value_p);
 int CPXsetintparam(CPXENVptr env, int whichparam, int newvalue);
+int CPXgetlongparam(CPXCENVptr env, int whichparam, CPXLONG * value_p);
+int CPXsetlongparam(CPXENVptr env, int whichparam, CPXLONG newvalue);
+constexpr int CPX_STR_PARAM_MAX = 512;
+int CPXgetstrparam(CPXCENVptr env, int whichparam, char * value_str);
+int CPXsetstrparam(CPXENVptr env, int whichparam, char const * newvalue_str);
+
+constexpr int CPX_PARAMTYPE_INT = 1;
+constexpr int CPX_PARAMTYPE_DOUBLE = 2;
+constexpr int CPX_PARAMTYPE_STRING = 3;
+constexpr int CPX_PARAMTYPE_LONG = 4;
+int CPXgetparamtype(CPXCENVptr env, int whichparam, int * paramtype);
+constexpr int CPXERR_NEGATIVE_SURPLUS = 1207;
+int CPXgetchgparam(CPXCENVptr env, int * cnt_p, int * paramnum, int pspace,
+                   int * surplus_p);
 
 int CPXprimopt(CPXCENVptr env, CPXLPptr lp);
 int CPXdualopt(CPXCENVptr env, CPXLPptr lp);
@@ -224,7 +241,15 @@ int CPXgetpi(CPXCENVptr env, CPXCLPptr lp, double * pi, int begin, int end);
 int CPXsolution(CPXCENVptr env, CPXCLPptr lp, int * lpstat_p, double * objval_p,
                 double * x, double * pi, double * slack, double * dj);
 
-using CPXLONG = long long;
+constexpr int CPX_AT_LOWER = 0;
+constexpr int CPX_BASIC = 1;
+constexpr int CPX_AT_UPPER = 2;
+constexpr int CPX_FREE_SUPER = 3;
+constexpr int CPXERR_NO_BASIS = 1262;
+int CPXgetbase(CPXCENVptr env, CPXCLPptr lp, int * cstat, int * rstat);
+int CPXcopybase(CPXCENVptr env, CPXLPptr lp, const int * cstat,
+                const int * rstat);
+
 constexpr CPXLONG CPX_CALLBACKCONTEXT_BRANCHING = 0x0080;
 constexpr CPXLONG CPX_CALLBACKCONTEXT_CANDIDATE = 0x0020;
 constexpr CPXLONG CPX_CALLBACKCONTEXT_GLOBAL_PROGRESS = 0x0010;
@@ -239,6 +264,8 @@ int CPXcallbacksetfunc(CPXENVptr env, CPXLPptr lp, CPXLONG contextmask,
                        CPXCALLBACKFUNC callback, void * userhandle);
 int CPXcallbackgetcandidatepoint(CPXCALLBACKCONTEXTptr context, double * x,
                                  int begin, int end, double * obj_p);
+int CPXcallbackgetrelaxationpoint(CPXCALLBACKCONTEXTptr context, double * x,
+                                  int begin, int end, double * obj_p);
 int CPXcallbackrejectcandidate(CPXCALLBACKCONTEXTptr context, int rcnt,
                                int nzcnt, double const * rhs,
                                char const * sense, int const * rmatbeg,
@@ -248,6 +275,9 @@ int CPXcallbackrejectcandidatelocal(CPXCALLBACKCONTEXTptr context, int rcnt,
                                     char const * sense, int const * rmatbeg,
                                     int const * rmatind,
                                     double const * rmatval);
+constexpr int CPX_USECUT_FORCE = 0;
+constexpr int CPX_USECUT_PURGE = 1;
+constexpr int CPX_USECUT_FILTER = 2;
 int CPXcallbackaddusercuts(CPXCALLBACKCONTEXTptr context, int rcnt, int nzcnt,
                            double const * rhs, char const * sense,
                            int const * rmatbeg, int const * rmatind,
@@ -260,6 +290,8 @@ void CPXcallbackabort(CPXCALLBACKCONTEXTptr context);
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -277,6 +309,7 @@ namespace cplex::v22_1_2 {
     F(CPXgetprobtype, getprobtype)                                   \
     F(CPXchgprobtype, chgprobtype)                                   \
     F(CPXfreeprob, freeprob)                                         \
+    F(CPXcloneprob, cloneprob)                                       \
     F(CPXgeterrorstring, geterrorstring)                             \
     F(CPXchgobjsen, chgobjsen)                                       \
     F(CPXgetobjsen, getobjsen)                                       \
@@ -312,6 +345,12 @@ namespace cplex::v22_1_2 {
     F(CPXsetdblparam, setdblparam)                                   \
     F(CPXgetintparam, getintparam)                                   \
     F(CPXsetintparam, setintparam)                                   \
+    F(CPXgetlongparam, getlongparam)                                 \
+    F(CPXsetlongparam, setlongparam)                                 \
+    F(CPXgetstrparam, getstrparam)                                   \
+    F(CPXsetstrparam, setstrparam)                                   \
+    F(CPXgetparamtype, getparamtype)                                 \
+    F(CPXgetchgparam, getchgparam)                                   \
     F(CPXprimopt, primopt)                                           \
     F(CPXdualopt, dualopt)                                           \
     F(CPXlpopt, lpopt)                                               \
@@ -325,8 +364,11 @@ namespace cplex::v22_1_2 {
     F(CPXgetx, getx)                                                 \
     F(CPXgetpi, getpi)                                               \
     F(CPXsolution, solution)                                         \
+    F(CPXgetbase, getbase)                                           \
+    F(CPXcopybase, copybase)                                         \
     F(CPXcallbacksetfunc, callbacksetfunc)                           \
     F(CPXcallbackgetcandidatepoint, callbackgetcandidatepoint)       \
+    F(CPXcallbackgetrelaxationpoint, callbackgetrelaxationpoint)     \
     F(CPXcallbackrejectcandidate, callbackrejectcandidate)           \
     F(CPXcallbackrejectcandidatelocal, callbackrejectcandidatelocal) \
     F(CPXcallbackaddusercuts, callbackaddusercuts)                   \
@@ -334,13 +376,13 @@ namespace cplex::v22_1_2 {
 
 #define DECLARE_CPLEX_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);    \
-    SHORT##_fun_t const * SHORT;
+    detail::solver_function<SHORT##_fun_t> SHORT;
 #define CONSTRUCT_CPLEX_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<SHORT##_fun_t>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 
 class cplex_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
 public:
     CPLEX_FUNCTIONS(DECLARE_CPLEX_FUNCTIONS)
@@ -1,18 +1,24 @@
 #pragma once
 
 #include <cassert>
+#include <execution>
 #include <memory>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <vector>
 
+#include "mippp/detail/parallel_rows.hpp"
+#include "mippp/container/unordered_dense_map.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
 #include "mippp/model_entities.hpp"
+#include "mippp/model_lp_basis.hpp"
 
+#include "mippp/solvers/constraints_batch.hpp"
 #include "mippp/solvers/cplex/v22_1_2/cplex_api.hpp"
+#include "mippp/solvers/modifications_batch.hpp"
 #include "mippp/solvers/remapping_model_base.hpp"
 
 namespace mippp {
@@ -45,6 +51,26 @@ protected:
     std::vector<char> tmp_types;
     std::vector<double> tmp_rhs;
 
+    // rows added by add_constraint inside a batch_constraints() scope
+    int _constraints_batch_depth;
+    std::vector<int> staged_begins;
+    std::vector<int> staged_indices;
+    std::vector<double> staged_scalars;
+    std::vector<char> staged_types;
+    std::vector<double> staged_rhs;
+
+    // values set inside a batch_modifications() scope, by native id
+    int _modifications_batch_depth;
+    unordered_dense_map<int, double> _objective_changes;
+    unordered_dense_map<int, double> _lower_bound_changes;
+    unordered_dense_map<int, double> _upper_bound_changes;
+    unordered_dense_map<int, double> _rhs_changes;
+
+    template <typename>
+    friend class mippp::constraints_batch;
+    template <typename>
+    friend class mippp::modifications_batch;
+
     void check(const int error) { CPX->_check(env, error); }
     static constexpr char constraint_sense_to_cplex_sense(
         constraint_sense rel) {
@@ -64,7 +90,9 @@ public:
         : remapping_model_base<int, double>()
         , CPX(&api)
         , env(CPX->_create_env())
-        , lp(CPX->_create_prob(env)) {}
+        , lp(CPX->_create_prob(env))
+        , _constraints_batch_depth(0)
+        , _modifications_batch_depth(0) {}
     ~cplex_base() {
         if(lp) check(CPX->freeprob(env, &lp));
         if(env) CPX->_close_env(env);
@@ -78,7 +106,18 @@ public:
         , lp(other.lp)
         , tmp_begins(std::move(other.tmp_begins))
         , tmp_types(std::move(other.tmp_types))
-        , tmp_rhs(std::move(other.tmp_rhs)) {
+        , tmp_rhs(std::move(other.tmp_rhs))
+        , _constraints_batch_depth(other._constraints_batch_depth)
+        , staged_begins(std::move(other.staged_begins))
+        , staged_indices(std::move(other.staged_indices))
+        , staged_scalars(std::move(other.staged_scalars))
+        , staged_types(std::move(other.staged_types))
+        , staged_rhs(std::move(other.staged_rhs))
+        , _modifications_batch_depth(other._modifications_batch_depth)
+        , _objective_changes(std::move(other._objective_changes))
+        , _lower_bound_changes(std::move(other._lower_bound_changes))
+        , _upper_bound_changes(std::move(other._upper_bound_changes))
+        , _rhs_changes(std::move(other._rhs_changes)) {
         other.env = nullptr;
         other.lp = nullptr;
     }
@@ -86,27 +125,101 @@ public:
     constexpr cplex_base & operator=(const cplex_base &) = delete;
     constexpr cplex_base & operator=(cplex_base && other) = delete;
 
+protected:
+    // other on lp_copy, a copy of its problem in the environment env_copy :
+    // the handles of other stay valid, its batches are already flushed and
+    // no solution is copied
+    cplex_base(const cplex_base & other, CPXENVptr env_copy, CPXLPptr lp_copy)
+        : remapping_model_base<int, double>(other)
+        , CPX(other.CPX)
+        , env(env_copy)
+        , lp(lp_copy)
+        , _constraints_batch_depth(0)
+        , _modifications_batch_depth(0) {
+        _invalidate_solution_caches();
+    }
+    // CPLEX parameters belong to the environment, so the copy gets its own,
+    // with the parameters changed in env
+    void _copy_changed_params(CPXENVptr env_copy) {
+        int count, surplus;
+        const int error = CPX->getchgparam(env, &count, nullptr, 0, &surplus);
+        if(error != CPXERR_NEGATIVE_SURPLUS) check(error);
+        if(surplus == 0) return;
+        std::vector<int> params(static_cast<std::size_t>(-surplus));
+        check(CPX->getchgparam(env, &count, params.data(), -surplus,
+                               &surplus));
+        for(const int param : params) {
+            int type;
+            check(CPX->getparamtype(env, param, &type));
+            if(type == CPX_PARAMTYPE_INT) {
+                int value;
+                check(CPX->getintparam(env, param, &value));
+                check(CPX->setintparam(env_copy, param, value));
+            } else if(type == CPX_PARAMTYPE_DOUBLE) {
+                double value;
+                check(CPX->getdblparam(env, param, &value));
+                check(CPX->setdblparam(env_copy, param, value));
+            } else if(type == CPX_PARAMTYPE_LONG) {
+                CPXLONG value;
+                check(CPX->getlongparam(env, param, &value));
+                check(CPX->setlongparam(env_copy, param, value));
+            } else if(type == CPX_PARAMTYPE_STRING) {
+                char value[CPX_STR_PARAM_MAX];
+                check(CPX->getstrparam(env, param, value));
+                check(CPX->setstrparam(env_copy, param, value));
+            }
+        }
+    }
+    cplex_base _clone_base() {
+        _lazily_remove_variables();
+        _flush_modifications();
+        CPXENVptr env_copy = CPX->_create_env();
+        int status = 0;
+        CPXLPptr lp_copy = nullptr;
+        try {
+            _copy_changed_params(env_copy);
+            lp_copy = CPX->cloneprob(env_copy, lp, &status);
+            check(status);
+        } catch(...) {
+            if(lp_copy) CPX->freeprob(env_copy, &lp_copy);
+            CPX->_close_env(env_copy);
+            throw;
+        }
+        return cplex_base(*this, env_copy, lp_copy);
+    }
+
 public:
     std::size_t num_variables() {
         return static_cast<std::size_t>(CPX->getnumcols(env, lp)) -
                _var_handles_to_delete.size();
     }
     std::size_t num_constraints() {
-        return static_cast<std::size_t>(CPX->getnumrows(env, lp));
+        _flush_staged_constraints();
+        return _num_native_constraints();
     }
     std::size_t num_entries() {
+        _flush_staged_constraints();
         return static_cast<std::size_t>(CPX->getnumnz(env, lp));
     }
     ///////////////////////////////////////////////////////////////////////////
     //////////////////////////////// Objective ////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
-    void set_maximization() { check(CPX->chgobjsen(env, lp, CPX_MAX)); }
-    void set_minimization() { check(CPX->chgobjsen(env, lp, CPX_MIN)); }
+    void set_maximization() {
+        _invalidate_solution_caches();
+        check(CPX->chgobjsen(env, lp, CPX_MAX));
+    }
+    void set_minimization() {
+        _invalidate_solution_caches();
+        check(CPX->chgobjsen(env, lp, CPX_MIN));
+    }
 
+    // also reached by set_objective and add_objective
     void set_objective_offset(double constant) {
+        _invalidate_solution_caches();
         check(CPX->chgobjoffset(env, lp, constant));
     }
     void set_objective(linear_expression auto && le) {
+        _objective_changes.clear();
         const std::size_t num_vars = _num_var_native_ids();
         tmp_indices.resize(num_vars);
         std::iota(tmp_indices.begin(), tmp_indices.end(), 0);
@@ -124,6 +237,7 @@ public:
         set_objective(std::forward<LE>(le));
     }
     void add_objective(linear_expression auto && le) {
+        _flush_modifications();
         const std::size_t num_vars = _num_var_native_ids();
         tmp_indices.resize(num_vars);
         std::iota(tmp_indices.begin(), tmp_indices.end(), 0);
@@ -143,6 +257,7 @@ public:
         return objective_offset;
     }
     auto get_objective() {
+        _flush_modifications();
         const std::size_t num_vars = _num_var_native_ids();
         auto coefs = std::make_shared_for_overwrite<double[]>(num_vars);
         check(CPX->getobj(env, lp, coefs.get(), 0,
@@ -168,6 +283,7 @@ protected:
     }
     void _lazily_remove_variables() {
         if(_var_handles_to_delete.empty()) return;
+        _flush_modifications();
         const std::size_t old_num_variables =
             static_cast<std::size_t>(CPX->getnumcols(env, lp));
         tmp_indices.resize(old_num_variables);
@@ -176,6 +292,7 @@ protected:
             tmp_indices[static_cast<std::size_t>(_native_id(var))] = 1;
         }
         check(CPX->delsetcols(env, lp, tmp_indices.data()));
+        _invalidate_solution_caches();
 
         if(!_remap_ids) {
             _native_ids_map.resize(old_num_variables);
@@ -208,6 +325,7 @@ protected:
 protected:
     variable _add_variable(const variable_params & params, char type,
                            char * name = nullptr) {
+        _invalidate_solution_caches();
         const int var_id = _new_var_native_id();
         const double lb = params.lower_bound.value_or(-CPX_INFBOUND);
         const double ub = params.upper_bound.value_or(CPX_INFBOUND);
@@ -217,6 +335,7 @@ protected:
     }
     std::size_t _add_variables(std::size_t count,
                                const variable_params & params, char type) {
+        _invalidate_solution_caches();
         if(_remap_ids) _extend_handle_ids_map(count);
         const std::size_t handle_ids_begin =
             _new_var_handle_range(_num_var_native_ids(), count);
@@ -316,6 +435,8 @@ public:
 private:
     template <typename ER>
     inline variable _add_column(ER && entries, const variable_params & params) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
         const int var_id = _new_var_native_id();
         const int cmatbeg = 0;
         _reset_cache();
@@ -356,15 +477,30 @@ public:
     }
 
     void set_objective_coefficient(variable v, double c) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _objective_changes.insert_or_assign(_native_id(v), c);
+            return;
+        }
         int var_id = _native_id(v);
         check(CPX->chgobj(env, lp, 1, &var_id, &c));
     }
     void set_variable_lower_bound(variable v, double lb) noexcept {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _lower_bound_changes.insert_or_assign(_native_id(v), lb);
+            return;
+        }
         int var_id = _native_id(v);
         char lu = 'L';
         check(CPX->chgbds(env, lp, 1, &var_id, &lu, &lb));
     }
     void set_variable_upper_bound(variable v, double ub) noexcept {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _upper_bound_changes.insert_or_assign(_native_id(v), ub);
+            return;
+        }
         int var_id = _native_id(v);
         char lu = 'U';
         check(CPX->chgbds(env, lp, 1, &var_id, &lu, &ub));
@@ -376,18 +512,21 @@ public:
     }
 
     double get_objective_coefficient(variable v) {
+        _flush_modifications();
         const int var_id = _native_id(v);
         double coef;
         check(CPX->getobj(env, lp, &coef, var_id, var_id));
         return coef;
     }
     double get_variable_lower_bound(variable v) noexcept {
+        _flush_modifications();
         const int var_id = _native_id(v);
         double b;
         check(CPX->getlb(env, lp, &b, var_id, var_id));
         return b;
     }
     double get_variable_upper_bound(variable v) noexcept {
+        _flush_modifications();
         const int var_id = _native_id(v);
         double b;
         check(CPX->getub(env, lp, &b, var_id, var_id));
@@ -413,16 +552,110 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     /////////////////////////////// Constraints ///////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
+protected:
+    std::size_t _num_native_constraints() {
+        return static_cast<std::size_t>(CPX->getnumrows(env, lp));
+    }
+
+    void _begin_constraints_batch() { ++_constraints_batch_depth; }
+    void _end_constraints_batch() {
+        if(--_constraints_batch_depth == 0) _flush_staged_constraints();
+    }
+    void _discard_constraints_batch() {
+        if(--_constraints_batch_depth == 0) _clear_staged_constraints();
+    }
+    void _clear_staged_constraints() {
+        staged_begins.resize(0);
+        staged_indices.resize(0);
+        staged_scalars.resize(0);
+        staged_types.resize(0);
+        staged_rhs.resize(0);
+    }
+    void _begin_modifications_batch() { ++_modifications_batch_depth; }
+    void _end_modifications_batch() {
+        if(--_modifications_batch_depth == 0) _flush_modifications();
+    }
+    void _discard_modifications_batch() {
+        if(--_modifications_batch_depth > 0) return;
+        _objective_changes.clear();
+        _lower_bound_changes.clear();
+        _upper_bound_changes.clear();
+        _rhs_changes.clear();
+    }
+    void _load_changes(unordered_dense_map<int, double> & changes) {
+        tmp_indices.resize(0);
+        tmp_scalars.resize(0);
+        for(auto && [native_id, value] : changes.values()) {
+            tmp_indices.emplace_back(native_id);
+            tmp_scalars.emplace_back(value);
+        }
+        changes.clear();
+    }
+    // CPXchgbds takes both sides in one call, told apart by 'L' and 'U'
+    void _flush_bounds_changes() {
+        if(_lower_bound_changes.empty() && _upper_bound_changes.empty())
+            return;
+        tmp_types.resize(0);
+        tmp_types.resize(_lower_bound_changes.size(), 'L');
+        tmp_types.resize(tmp_types.size() + _upper_bound_changes.size(), 'U');
+        _load_changes(_lower_bound_changes);
+        for(auto && [native_id, ub] : _upper_bound_changes.values()) {
+            tmp_indices.emplace_back(native_id);
+            tmp_scalars.emplace_back(ub);
+        }
+        _upper_bound_changes.clear();
+        check(CPX->chgbds(env, lp, static_cast<int>(tmp_indices.size()),
+                          tmp_indices.data(), tmp_types.data(),
+                          tmp_scalars.data()));
+    }
+    // rhs changes may target staged rows, which are flushed first
+    void _flush_modifications() {
+        _flush_staged_constraints();
+        if(!_objective_changes.empty()) {
+            _load_changes(_objective_changes);
+            check(CPX->chgobj(env, lp, static_cast<int>(tmp_indices.size()),
+                              tmp_indices.data(), tmp_scalars.data()));
+        }
+        _flush_bounds_changes();
+        if(!_rhs_changes.empty()) {
+            _load_changes(_rhs_changes);
+            check(CPX->chgrhs(env, lp, static_cast<int>(tmp_indices.size()),
+                              tmp_indices.data(), tmp_scalars.data()));
+        }
+    }
+    void _flush_staged_constraints() {
+        if(staged_rhs.empty()) return;
+        const int error = CPX->addrows(
+            env, lp, 0, static_cast<int>(staged_rhs.size()),
+            static_cast<int>(staged_indices.size()), staged_rhs.data(),
+            staged_types.data(), staged_begins.data(), staged_indices.data(),
+            staged_scalars.data(), nullptr, nullptr);
+        _clear_staged_constraints();
+        check(error);
+    }
+
 private:
     template <bool distinct, linear_constraint LC>
     constraint _add_constraint(LC && lc) {
-        int constr_id = static_cast<int>(num_constraints());
+        _invalidate_solution_caches();
+        int constr_id =
+            static_cast<int>(_num_native_constraints() + staged_rhs.size());
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids());
         _reset_cache();
         _register_variables_entries<distinct>(lc.linear_terms());
         int matbegin = 0;
         const double b = lc.rhs();
         const char sense = constraint_sense_to_cplex_sense(lc.sense());
+        if(_constraints_batch_depth > 0) {
+            staged_begins.emplace_back(static_cast<int>(staged_indices.size()));
+            staged_indices.insert(staged_indices.end(), tmp_indices.cbegin(),
+                                  tmp_indices.cend());
+            staged_scalars.insert(staged_scalars.end(), tmp_scalars.cbegin(),
+                                  tmp_scalars.cend());
+            staged_types.emplace_back(sense);
+            staged_rhs.emplace_back(b);
+            return constraint(constr_id);
+        }
         check(CPX->addrows(env, lp, 0, 1, static_cast<int>(tmp_indices.size()),
                            &b, &sense, &matbegin, tmp_indices.data(),
                            tmp_scalars.data(), nullptr, nullptr));
@@ -438,6 +671,10 @@ public:
     constraint add_constraint(distinct_variables_t, LC && lc) {
         return _add_constraint<true>(std::forward<LC>(lc));
     }
+    [[nodiscard]] auto batch_constraints() { return constraints_batch(*this); }
+    [[nodiscard]] auto batch_modifications() {
+        return modifications_batch(*this);
+    }
 
 private:
     template <bool distinct, linear_constraint LC>
@@ -471,6 +708,8 @@ private:
 
     template <bool distinct, std::ranges::range IR, typename... CL>
     auto _add_constraints(IR && keys, CL &... constraint_lambdas) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids());
         _reset_cache();
         tmp_begins.resize(0);
@@ -507,11 +746,62 @@ public:
                                       constraint_lambdas...);
     }
 
+private:
+    template <bool distinct, std::ranges::random_access_range IR,
+              typename... CL>
+    auto _add_constraints_parallel(IR && keys, CL &... constraint_lambdas) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
+        const int offset = static_cast<int>(_num_native_constraints());
+        auto rows = detail::build_rows_in_parallel<distinct, int, double>(
+            keys, _num_var_native_ids(),
+            [this](const variable & v) { return _native_id(v); },
+            constraint_lambdas...);
+        const std::size_t num_rows = rows.num_rows();
+        tmp_types.resize(num_rows);
+        std::ranges::transform(rows.senses, tmp_types.begin(),
+                               constraint_sense_to_cplex_sense);
+        check(CPX->addrows(env, lp, 0, static_cast<int>(num_rows),
+                           static_cast<int>(rows.indices.size()),
+                           rows.rhs.data(), tmp_types.data(),
+                           rows.begins.data(), rows.indices.data(),
+                           rows.scalars.data(), nullptr, nullptr));
+        return constraints_range(
+            std::forward<IR>(keys),
+            std::views::transform(
+                std::views::iota(offset,
+                                 offset + static_cast<int>(num_rows)),
+                [](auto && i) { return constraint{i}; }));
+    }
+
+public:
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<false>(std::forward<IR>(keys),
+                                                constraint_lambdas...);
+    }
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &,
+                         distinct_variables_t, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<true>(std::forward<IR>(keys),
+                                               constraint_lambdas...);
+    }
+
     void set_constraint_rhs(constraint constr, double rhs) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _rhs_changes.insert_or_assign(constr.id(), rhs);
+            return;
+        }
+        _flush_staged_constraints();
         int constr_id = constr.id();
         check(CPX->chgrhs(env, lp, 1, &constr_id, &rhs));
     }
     void set_constraint_sense(constraint constr, constraint_sense r) {
+        _invalidate_solution_caches();
+        _flush_staged_constraints();
         int constr_id = constr.id();
         char sense = constraint_sense_to_cplex_sense(r);
         check(CPX->chgsense(env, lp, 1, &constr_id, &sense));
@@ -519,6 +809,7 @@ public:
 
     auto get_constraint_lhs(constraint constr) {
         int palceholder, surplus, beg;
+        _flush_staged_constraints();
         if(int error =
                CPX->getrows(env, lp, &palceholder, nullptr, nullptr, nullptr, 0,
                             &surplus, constr.id(), constr.id());
@@ -542,11 +833,13 @@ public:
     }
     double get_constraint_rhs(constraint constr) {
         double rhs;
+        _flush_modifications();
         check(CPX->getrhs(env, lp, &rhs, constr.id(), constr.id()));
         return rhs;
     }
     constraint_sense get_constraint_sense(constraint constr) {
         char sense;
+        _flush_staged_constraints();
         check(CPX->getsense(env, lp, &sense, constr.id(), constr.id()));
         return cplex_sense_to_constraint_sense(sense);
     }
@@ -556,6 +849,112 @@ public:
                                    -get_constraint_rhs(constr)),
             get_constraint_sense(constr));
     }
+    ///////////////////////////////////////////////////////////////////////////
+    //////////////////////////////// Solution /////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+protected:
+    // one CPXsolution per solve, shared by the returned mappings ; dropped on
+    // any modification of the model, see highs_base
+    auto _get_cached_solution() {
+        return _solution_cache.get(_num_var_native_ids(), [this](double * x) {
+            check(CPX->solution(env, lp, nullptr, nullptr, x, nullptr, nullptr,
+                                nullptr));
+        });
+    }
+    auto _make_variables_values_mapping(detail::shared_values<double> values) {
+        return variable_mapping(
+            [this, values = std::move(values)](const variable & v) {
+                return values[static_cast<std::size_t>(_native_id(v))];
+            });
+    }
+    // CPXgetx reads a range of columns : only the span of the requested ones
+    // is fetched, unless the whole solution is already cached
+    template <std::ranges::range VR>
+    std::vector<double> _get_solution_values(VR && vars) {
+        const auto native_id = [this](const variable & v) {
+            return _native_id(v);
+        };
+        if(const double * x = _solution_cache.cached(_num_var_native_ids()))
+            return _gather_values(vars, x, native_id);
+        tmp_indices.clear();
+        for(auto && v : vars) tmp_indices.emplace_back(native_id(v));
+        if(tmp_indices.empty()) return {};
+        const auto [min_id, max_id] = std::ranges::minmax(tmp_indices);
+        tmp_scalars.resize(static_cast<std::size_t>(max_id - min_id + 1));
+        check(CPX->getx(env, lp, tmp_scalars.data(), min_id, max_id));
+        std::vector<double> values;
+        values.reserve(tmp_indices.size());
+        for(auto && id : tmp_indices)
+            values.emplace_back(
+                tmp_scalars[static_cast<std::size_t>(id - min_id)]);
+        return values;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////// Basis //////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+public:
+    using basis = model_lp_basis<variable, constraint>;
+
+private:
+    static basis::code _basis_code(const int status) {
+        switch(status) {
+            case CPX_BASIC:
+                return basis::code::basic;
+            case CPX_AT_UPPER:
+                return basis::code::nonbasic_at_upper_bound;
+            case CPX_FREE_SUPER:
+                return basis::code::nonbasic_free;
+            default:
+                return basis::code::nonbasic_at_lower_bound;
+        }
+    }
+    static int _basis_status(const basis::code code) {
+        switch(code) {
+            case basis::code::basic:
+                return CPX_BASIC;
+            case basis::code::nonbasic_free:
+                return CPX_FREE_SUPER;
+            case basis::code::nonbasic_at_upper_bound:
+                return CPX_AT_UPPER;
+            default:
+                return CPX_AT_LOWER;
+        }
+    }
+    auto _var_handle_id_of() {
+        return [this](std::size_t i) {
+            return _var_handle(static_cast<int>(i)).uid();
+        };
+    }
+
+public:
+    // the basis of the last solve, read with one CPXgetbase call ; without
+    // one, the slack basis
+    basis get_basis() {
+        _lazily_remove_variables();
+        _flush_modifications();
+        std::vector<int> cstat(_num_var_native_ids());
+        std::vector<int> rstat(_num_native_constraints());
+        const int error = CPX->getbase(env, lp, cstat.data(), rstat.data());
+        if(error == CPXERR_NO_BASIS) return basis();
+        check(error);
+        return basis::from_native(
+            cstat, rstat,
+            _remap_ids ? _native_ids_map.size() : _num_var_native_ids(),
+            _var_handle_id_of(), _basis_code, _basis_code);
+    }
+    // warm starts the next solve from b, loaded with one CPXcopybase call
+    void set_basis(const basis & b) {
+        _lazily_remove_variables();
+        _flush_modifications();
+        std::vector<int> cstat(_num_var_native_ids());
+        std::vector<int> rstat(_num_native_constraints());
+        b.to_native(cstat, rstat, _var_handle_id_of(), _basis_status,
+                    _basis_status);
+        check(CPX->copybase(env, lp, cstat.data(), rstat.data()));
+    }
+
+public:
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////// Limits //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -567,6 +966,15 @@ public:
         check(CPX->getdblparam(env, CPXPARAM_TimeLimit, &t));
         return std::chrono::duration<double>(t);
     }
+
+    void set_thread_count(std::size_t n) {
+        check(CPX->setintparam(env, CPXPARAM_Threads, static_cast<int>(n)));
+    }
+    std::size_t get_thread_count() {
+        int n;
+        check(CPX->getintparam(env, CPXPARAM_Threads, &n));
+        return static_cast<std::size_t>(n);
+    }
 };
 
 }  // namespace cplex::v22_1_2
@@ -13,9 +13,15 @@ namespace mippp {
 namespace cplex::v22_1_2 {
 
 class cplex_lp : public cplex_base {
+private:
+    explicit cplex_lp(cplex_base && base) : cplex_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit cplex_lp(const cplex_api & api) : cplex_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] cplex_lp clone() { return cplex_lp(_clone_base()); }
+
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////// Limits //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -103,6 +109,8 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_modifications();
+        _invalidate_solution_caches();
         check(CPX->primopt(env, lp));
         _status = _get_status();
     }
@@ -115,6 +123,7 @@ public:
         check(CPX->setintparam(env, CPXPARAM_Advance, 0));
         check(CPX->setintparam(env, CPXPARAM_Preprocessing_Reduce,
                                CPX_PREREDUCE_NOPRIMALORDUAL));
+        _invalidate_solution_caches();
         check(CPX->primopt(env, lp));
         _status = _get_status();
         check(CPX->setintparam(env, CPXPARAM_Advance, tmp_advance_param));
@@ -130,31 +139,26 @@ public:
         return val;
     }
     auto get_solution() {
-        auto solution =
-            std::make_unique_for_overwrite<double[]>(num_variables());
-        check(CPX->solution(env, lp, nullptr, nullptr, solution.get(), nullptr,
-                            nullptr, nullptr));
-        return variable_mapping(
-            [this, solution = std::move(solution)](const variable & v) {
-                return *(solution.get() + _native_id(v));
-            });
+        return _make_variables_values_mapping(_get_cached_solution());
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_solution_values(vars);
     }
     auto get_dual_solution() {
-        auto dual_solution =
-            std::make_unique_for_overwrite<double[]>(num_constraints());
-        check(CPX->solution(env, lp, nullptr, nullptr, nullptr,
-                            dual_solution.get(), nullptr, nullptr));
-        return constraint_mapping(std::move(dual_solution));
+        return constraint_mapping(_dual_solution_cache.get(
+            num_constraints(), [this](double * pi) {
+                check(CPX->solution(env, lp, nullptr, nullptr, nullptr, pi,
+                                    nullptr, nullptr));
+            }));
     }
     auto get_reduced_costs() {
-        auto reduced_costs =
-            std::make_unique_for_overwrite<double[]>(num_variables());
-        check(CPX->solution(env, lp, nullptr, nullptr, nullptr, nullptr,
-                            nullptr, reduced_costs.get()));
-        return variable_mapping([this, reduced_costs = std::move(
-                                           reduced_costs)](const variable & v) {
-            return *(reduced_costs.get() + _native_id(v));
-        });
+        return _make_variables_values_mapping(_reduced_costs_cache.get(
+            _num_var_native_ids(), [this](double * dj) {
+                check(CPX->solution(env, lp, nullptr, nullptr, nullptr,
+                                    nullptr, nullptr, dj));
+            }));
     }
 };
 
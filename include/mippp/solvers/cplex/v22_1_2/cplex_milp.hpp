@@ -1,10 +1,10 @@
 #pragma once
 
-#include <functional>
 #include <numeric>
 #include <optional>
 #include <vector>
 
+#include "mippp/detail/callback_storage.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_entities.hpp"
@@ -17,10 +17,23 @@ namespace mippp {
 namespace cplex::v22_1_2 {
 
 class cplex_milp : public cplex_base {
+private:
+    explicit cplex_milp(cplex_base && base) : cplex_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit cplex_milp(const cplex_api & api)
         : cplex_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid,
+    // without the callbacks
+    [[nodiscard]] cplex_milp clone() {
+        cplex_milp copy(_clone_base());
+        if(candidate_solution_callback || node_relaxation_callback)
+            copy.check(CPX->callbacksetfunc(copy.env, copy.lp, 0, nullptr,
+                                            nullptr));
+        return copy;
+    }
+
     variable add_integer_variable(
         const variable_params params = default_variable_params) {
         int var_id = _new_var_native_id();
@@ -46,6 +59,7 @@ public:
 
 private:
     inline std::size_t _add_binary_variables(const std::size_t & count) {
+        _invalidate_solution_caches();
         const std::size_t handle_ids_begin =
             _new_var_handle_range(_num_var_native_ids(), count);
         tmp_scalars.resize(2 * count);
@@ -80,19 +94,24 @@ public:
                                             std::forward<IL>(id_lambda));
     }
     void set_continuous(variable v) noexcept {
+        _invalidate_solution_caches();
         int var_id = _native_id(v);
         char type = CPX_CONTINUOUS;
         check(CPX->chgctype(env, lp, 1, &var_id, &type));
     }
     void set_integer(variable v) noexcept {
+        _invalidate_solution_caches();
         int var_id = _native_id(v);
         char type = CPX_INTEGER;
         check(CPX->chgctype(env, lp, 1, &var_id, &type));
     }
     void set_binary(variable v) noexcept {
+        _invalidate_solution_caches();
         int var_id = _native_id(v);
         char type = CPX_BINARY;
         check(CPX->chgctype(env, lp, 1, &var_id, &type));
+        _lower_bound_changes.erase(var_id);
+        _upper_bound_changes.erase(var_id);
         int ids[2] = {var_id, var_id};
         char lu[2] = {'L', 'U'};
         double bd[2] = {0.0, 1.0};
@@ -104,6 +123,7 @@ public:
 private:
     template <bool distinct, linear_constraint LC>
     void _add_indicator_constraint(variable x, bool val, LC && lc) {
+        _invalidate_solution_caches();
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids());
         _reset_cache();
         _register_variables_entries<distinct>(lc.linear_terms());
@@ -152,6 +172,13 @@ private:
             return static_cast<std::size_t>(
                 CPX->getnumcols(model->env, model->lp));
         }
+
+    protected:
+        // entries are coalesced on handle ids, then remapped to native ids
+        std::size_t _num_var_handle_ids() {
+            if(model->_remap_ids) return model->_native_ids_map.size();
+            return model->_num_var_native_ids();
+        }
     };
 
 public:
@@ -165,8 +192,7 @@ public:
     private:
         template <bool distinct, linear_constraint LC>
         void _add_lazy_constraint(LC && lc) {
-            if constexpr(!distinct)
-                _prepare_coalescing(model->_num_var_native_ids());
+            if constexpr(!distinct) _prepare_coalescing(_num_var_handle_ids());
             _reset_cache();
             _register_variables_entries<distinct>(lc.linear_terms());
             if(model->_remap_ids) {
@@ -196,38 +222,117 @@ public:
                 CPX->callbackgetcandidatepoint(context, nullptr, 0, 0, &obj));
             return obj;
         }
+        // valid until the callback returns
         auto get_solution() {
             auto num_vars = model->_num_var_native_ids();
-            auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
+            double * solution = model->_callback_buffers.local(num_vars);
             cbcheck(CPX->callbackgetcandidatepoint(
-                context, solution.get(), 0, static_cast<int>(num_vars) - 1,
+                context, solution, 0, static_cast<int>(num_vars) - 1,
+                nullptr));
+            return variable_mapping([this, solution](const variable & v) {
+                return solution[model->_native_id(v)];
+            });
+        }
+    };
+
+    class node_relaxation_callback_handle : public callback_handle_base {
+    public:
+        node_relaxation_callback_handle(const cplex_api * api,
+                                        CPXCALLBACKCONTEXTptr context_,
+                                        cplex_milp * model_)
+            : callback_handle_base(api, context_, model_) {}
+
+    private:
+        template <bool distinct, linear_constraint LC>
+        void _add_cut(LC && lc) {
+            if constexpr(!distinct) _prepare_coalescing(_num_var_handle_ids());
+            _reset_cache();
+            _register_variables_entries<distinct>(lc.linear_terms());
+            if(model->_remap_ids) {
+                for(auto & id : tmp_indices)
+                    id = model->_native_ids_map[static_cast<std::size_t>(id)];
+            }
+            int matbegin = 0;
+            const double b = lc.rhs();
+            const char sense = constraint_sense_to_cplex_sense(lc.sense());
+            const int purgeable = CPX_USECUT_FILTER;
+            const int local = 0;
+            cbcheck(CPX->callbackaddusercuts(
+                context, 1, static_cast<int>(tmp_indices.size()), &b, &sense,
+                &matbegin, tmp_indices.data(), tmp_scalars.data(), &purgeable,
+                &local));
+        }
+
+    public:
+        template <linear_constraint LC>
+        void add_cut(LC && lc) {
+            return _add_cut<false>(std::forward<LC>(lc));
+        }
+        template <linear_constraint LC>
+        void add_cut(distinct_variables_t, LC && lc) {
+            return _add_cut<true>(std::forward<LC>(lc));
+        }
+        double get_relaxation_value() {
+            double obj;
+            cbcheck(
+                CPX->callbackgetrelaxationpoint(context, nullptr, 0, 0, &obj));
+            return obj;
+        }
+        // valid until the callback returns
+        auto get_relaxation_solution() {
+            auto num_vars = model->_num_var_native_ids();
+            double * solution = model->_callback_buffers.local(num_vars);
+            cbcheck(CPX->callbackgetrelaxationpoint(
+                context, solution, 0, static_cast<int>(num_vars) - 1,
                 nullptr));
-            return variable_mapping(
-                [this, solution = std::move(solution)](const variable & v) {
-                    return *(solution.get() + model->_native_id(v));
-                });
+            return variable_mapping([this, solution](const variable & v) {
+                return solution[model->_native_id(v)];
+            });
         }
     };
 
 private:
-    std::function<void(candidate_solution_callback_handle &)>
+    detail::callback_holder<candidate_solution_callback_handle>
         candidate_solution_callback;
+    detail::callback_holder<node_relaxation_callback_handle>
+        node_relaxation_callback;
+    detail::per_thread_buffers<double> _callback_buffers;
 
-    static int candidate_solution_callback_fun(
-        CPXCALLBACKCONTEXTptr context, [[maybe_unused]] CPXLONG contextid,
-        void * userhandle) {
+    // CPLEX keeps a single callback function per problem, hence all the
+    // contexts are dispatched from here, by each of its threads concurrently
+    static int main_callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid,
+                             void * userhandle) {
         auto * model = static_cast<cplex_milp *>(userhandle);
-        candidate_solution_callback_handle handle(model->CPX, context, model);
-        model->candidate_solution_callback(handle);
+        const auto guard = model->_callback_buffers.release_on_return();
+        if(contextid == CPX_CALLBACKCONTEXT_CANDIDATE) {
+            candidate_solution_callback_handle handle(model->CPX, context,
+                                                      model);
+            model->candidate_solution_callback(handle);
+        } else if(contextid == CPX_CALLBACKCONTEXT_RELAXATION) {
+            node_relaxation_callback_handle handle(model->CPX, context, model);
+            model->node_relaxation_callback(handle);
+        }
         return 0;
     }
+    void _update_callbacks() {
+        CPXLONG contextmask = 0;
+        if(candidate_solution_callback)
+            contextmask |= CPX_CALLBACKCONTEXT_CANDIDATE;
+        if(node_relaxation_callback)
+            contextmask |= CPX_CALLBACKCONTEXT_RELAXATION;
+        check(CPX->callbacksetfunc(env, lp, contextmask, main_callback, this));
+    }
 
 public:
     template <typename F>
     void set_candidate_solution_callback(F && f) {
-        candidate_solution_callback = std::forward<F>(f);
-        check(CPX->callbacksetfunc(env, lp, CPX_CALLBACKCONTEXT_CANDIDATE,
-                                   candidate_solution_callback_fun, this));
+        candidate_solution_callback.emplace(std::forward<F>(f));
+        _update_callbacks();
+    }
+    template <typename F>
+    void set_node_relaxation_callback(F && f) {
+        node_relaxation_callback.emplace(std::forward<F>(f));
+        _update_callbacks();
     }
     ///////////////////////////////////////////////////////////////////////////
     //////////////////////////////// MIP start ////////////////////////////////
@@ -394,6 +499,9 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_modifications();
+        _invalidate_solution_caches();
+        _callback_buffers.clear();
         int probtype = CPX->getprobtype(env, lp);
         switch(probtype) {
             case CPXPROB_MILP:
@@ -401,10 +509,10 @@ public:
                 _status = _get_status_milp();
                 return;
             case CPXPROB_LP:
-                if(candidate_solution_callback)
+                if(candidate_solution_callback || node_relaxation_callback)
                     throw std::runtime_error(
                         "cplex_milp: can't solve lp (no integer variables) "
-                        "with candidate_solution_callback");
+                        "with MIP callbacks");
                 check(CPX->lpopt(env, lp));
                 _status = _get_status_lp();
                 return;
@@ -423,14 +531,12 @@ public:
         // return val;
     }
     auto get_solution() {
-        auto solution =
-            std::make_unique_for_overwrite<double[]>(_num_var_native_ids());
-        check(CPX->solution(env, lp, nullptr, nullptr, solution.get(), nullptr,
-                            nullptr, nullptr));
-        return variable_mapping(
-            [this, solution = std::move(solution)](const variable & v) {
-                return *(solution.get() + _native_id(v));
-            });
+        return _make_variables_values_mapping(_get_cached_solution());
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_solution_values(vars);
     }
 };
 
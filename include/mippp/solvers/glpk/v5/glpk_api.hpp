@@ -10,6 +10,7 @@ using glp_prob = struct glp_prob;
 
 glp_prob * glp_create_prob(void);
 void glp_delete_prob(glp_prob * P);
+void glp_copy_prob(glp_prob * dest, glp_prob * prob, int names);
 constexpr int GLP_EBADB = 0x01;    // invalid basis
 constexpr int GLP_ESING = 0x02;    // singular matrix
 constexpr int GLP_ECOND = 0x03;    // ill-conditioned matrix
@@ -193,6 +194,8 @@ double glp_mip_col_val(glp_prob * P, int j);
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -203,6 +206,7 @@ namespace glpk::v5 {
 #define GLPK_FUNCTIONS(F)               \
     F(glp_create_prob, create_prob)     \
     F(glp_delete_prob, delete_prob)     \
+    F(glp_copy_prob, copy_prob)         \
     F(glp_set_obj_dir, set_obj_dir)     \
     F(glp_get_obj_dir, get_obj_dir)     \
     F(glp_add_cols, add_cols)           \
@@ -248,13 +252,13 @@ namespace glpk::v5 {
 
 #define DECLARE_GLPK_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);   \
-    SHORT##_fun_t const * SHORT;
+    detail::solver_function<SHORT##_fun_t> SHORT;
 #define CONSTRUCT_GLPK_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<SHORT##_fun_t>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 
 class glpk_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
 public:
     GLPK_FUNCTIONS(DECLARE_GLPK_FUNCTIONS)
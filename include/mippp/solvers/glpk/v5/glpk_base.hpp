@@ -66,20 +66,14 @@ protected:
             tmp_scalars.emplace_back(coef);
         }
     }
+    // glpk arrays are 1-based : the stored indices are the ids shifted by 1
     template <std::ranges::range Entries>
     void _register_coalescing_entries(Entries && entries) {
-        ++register_count;
-        for(auto && [entity, coef] : entries) {
-            const int id = entity.id();
-            auto & p = *(tmp_entry_index_cache.data() + id);
-            if(p.first == register_count) {
-                tmp_scalars[p.second] += static_cast<scalar>(coef);
-                continue;
-            }
-            p = std::make_pair(register_count, tmp_indices.size());
-            tmp_indices.emplace_back(id + 1);
-            tmp_scalars.emplace_back(coef);
-        }
+        const std::size_t first = tmp_indices.size();
+        _register_raw_entries(std::forward<Entries>(entries));
+        detail::coalesce_entries(tmp_entry_index_cache, register_count,
+                                 tmp_coalescing_table, tmp_indices,
+                                 tmp_scalars, first, _coalescing_ids_end);
     }
 
 public:
@@ -104,6 +98,23 @@ public:
     constexpr glpk_base & operator=(const glpk_base &) = delete;
     constexpr glpk_base & operator=(glpk_base && other) = delete;
 
+protected:
+    // other on model_copy, a copy of its problem : the handles of other
+    // stay valid and no solution is copied
+    glpk_base(const glpk_base & other, glp_prob * model_copy)
+        : model_base<int, double>(other)
+        , glp(other.glp)
+        , model(model_copy)
+        , objective_offset(other.objective_offset) {
+        _invalidate_solution_caches();
+    }
+    glpk_base _clone_base() {
+        glp_prob * model_copy = glp->create_prob();
+        glp->copy_prob(model_copy, model, GLP_ON);
+        return glpk_base(*this, model_copy);
+    }
+
+public:
     std::size_t num_variables() {
         return static_cast<std::size_t>(glp->get_num_cols(model));
     }
@@ -342,14 +353,14 @@ private:
 public:
     template <linear_constraint LC>
     constraint add_constraint(LC && lc) {
-        tmp_entry_index_cache.resize(num_variables());
+        _prepare_coalescing(num_variables() + 1);
         int constr_id = static_cast<int>(num_constraints());
         _add_constraint<false>(constr_id, std::forward<LC>(lc));
         return constraint(constr_id);
     }
     template <linear_constraint LC>
     constraint add_constraint(distinct_variables_t, LC && lc) {
-        tmp_entry_index_cache.resize(num_variables());
+        _prepare_coalescing(num_variables() + 1);
         int constr_id = static_cast<int>(num_constraints());
         _add_constraint<true>(constr_id, std::forward<LC>(lc));
         return constraint(constr_id);
@@ -381,7 +392,7 @@ private:
     template <bool distinct, std::ranges::range IR, typename... CL>
     auto _add_constraints(IR && keys, CL &... constraint_lambdas) {
         if constexpr(!distinct) {
-            tmp_entry_index_cache.resize(num_variables());
+            _prepare_coalescing(num_variables() + 1);
         }
         const int offset = static_cast<int>(num_constraints());
         int constr_id = offset;
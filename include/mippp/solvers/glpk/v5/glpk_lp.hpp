@@ -2,9 +2,11 @@
 
 #include <limits>
 #include <optional>
+#include <vector>
 
 #include "mippp/model_concepts.hpp"
 #include "mippp/model_entities.hpp"
+#include "mippp/model_lp_basis.hpp"
 
 #include "mippp/solvers/glpk/v5/glpk_base.hpp"
 
@@ -15,6 +17,9 @@ class glpk_lp : public glpk_base {
 private:
     glp_smcp model_params;
 
+    glpk_lp(glpk_base && base, const glp_smcp & params)
+        : glpk_base(std::move(base)), model_params(params) {}
+
 public:
     [[nodiscard]] explicit glpk_lp(const glpk_api & api)
         : glpk_base(api), model_params() {
@@ -38,6 +43,11 @@ public:
         model_params.shift = 0;
         model_params.aorn = GLP_USE_AT;
     }
+
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] glpk_lp clone() {
+        return glpk_lp(_clone_base(), model_params);
+    }
     ///////////////////////////////////////////////////////////////////////////
     ////////////////////////// Tolerance parameters ///////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -65,6 +75,7 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _invalidate_solution_caches();
         switch(glp->simplex(model, &model_params)) {
             case GLP_ENOPFS:
                 _status.emplace<status::unbounded>();
@@ -91,30 +102,102 @@ public:
         return objective_offset + glp->get_obj_val(model);
     }
     auto get_solution() {
-        auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
-        for(std::size_t var = 0u; var < num_vars; ++var) {
-            solution[var] = glp->get_col_prim(model, static_cast<int>(var) + 1);
-        }
-        return variable_mapping(std::move(solution));
+        const auto num_vars = num_variables();
+        return variable_mapping(
+            _solution_cache.get(num_vars, [&](double * solution) {
+                for(std::size_t var = 0u; var < num_vars; ++var)
+                    solution[var] =
+                        glp->get_col_prim(model, static_cast<int>(var) + 1);
+            }));
+    }
+    // glpk reads columns one by one : only the requested ones are read
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        if(const double * x = _solution_cache.cached(num_variables()))
+            return _gather_values(vars, x);
+        std::vector<double> values;
+        for(auto && v : vars)
+            values.emplace_back(glp->get_col_prim(model, v.id() + 1));
+        return values;
     }
     auto get_dual_solution() {
-        auto num_constrs = num_constraints();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_constrs);
-        for(std::size_t constr = 0u; constr < num_constrs; ++constr) {
-            solution[constr] =
-                glp->get_row_dual(model, static_cast<int>(constr) + 1);
-        }
-        return constraint_mapping(std::move(solution));
+        const auto num_constrs = num_constraints();
+        return constraint_mapping(
+            _dual_solution_cache.get(num_constrs, [&](double * solution) {
+                for(std::size_t constr = 0u; constr < num_constrs; ++constr)
+                    solution[constr] = glp->get_row_dual(
+                        model, static_cast<int>(constr) + 1);
+            }));
     }
     auto get_reduced_costs() {
-        auto num_vars = num_variables();
-        auto reduced_costs = std::make_unique_for_overwrite<double[]>(num_vars);
-        for(std::size_t var = 0u; var < num_vars; ++var) {
-            reduced_costs[var] =
-                glp->get_col_dual(model, static_cast<int>(var) + 1);
+        const auto num_vars = num_variables();
+        return variable_mapping(
+            _reduced_costs_cache.get(num_vars, [&](double * reduced_costs) {
+                for(std::size_t var = 0u; var < num_vars; ++var)
+                    reduced_costs[var] =
+                        glp->get_col_dual(model, static_cast<int>(var) + 1);
+            }));
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////// Basis //////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    using basis = model_lp_basis<variable, constraint>;
+
+private:
+    static basis::code _basis_code(const int stat) {
+        switch(stat) {
+            case GLP_BS:
+                return basis::code::basic;
+            case GLP_NU:
+                return basis::code::nonbasic_at_upper_bound;
+            case GLP_NF:
+                return basis::code::nonbasic_free;
+            case GLP_NS:
+                return basis::code::nonbasic_fixed;
+            default:
+                return basis::code::nonbasic_at_lower_bound;
+        }
+    }
+    static int _basis_stat(const basis::code code) {
+        switch(code) {
+            case basis::code::basic:
+                return GLP_BS;
+            case basis::code::nonbasic_free:
+                return GLP_NF;
+            case basis::code::nonbasic_at_upper_bound:
+                return GLP_NU;
+            case basis::code::nonbasic_fixed:
+                return GLP_NS;
+            default:
+                return GLP_NL;
         }
-        return variable_mapping(std::move(reduced_costs));
+    }
+
+public:
+    // glpk has no bulk basis access : the statuses are read and set one by
+    // one. The problem always holds a basis, the standard one before any
+    // simplex call.
+    basis get_basis() {
+        std::vector<basis::code> variables(num_variables());
+        for(std::size_t var = 0u; var < variables.size(); ++var)
+            variables[var] = _basis_code(
+                glp->get_col_stat(model, static_cast<int>(var) + 1));
+        std::vector<basis::code> constraints(num_constraints());
+        for(std::size_t constr = 0u; constr < constraints.size(); ++constr)
+            constraints[constr] = _basis_code(
+                glp->get_row_stat(model, static_cast<int>(constr) + 1));
+        return basis(std::move(variables), std::move(constraints));
+    }
+    void set_basis(const basis & b) {
+        const auto num_vars = num_variables();
+        for(std::size_t var = 0u; var < num_vars; ++var)
+            glp->set_col_stat(model, static_cast<int>(var) + 1,
+                              _basis_stat(b.variable_code(var)));
+        const auto num_constrs = num_constraints();
+        for(std::size_t constr = 0u; constr < num_constrs; ++constr)
+            glp->set_row_stat(model, static_cast<int>(constr) + 1,
+                              _basis_stat(b.constraint_code(constr)));
     }
 };
 
@@ -17,6 +17,9 @@ class glpk_milp : public glpk_base {
 private:
     glp_iocp model_params;
 
+    glpk_milp(glpk_base && base, const glp_iocp & params)
+        : glpk_base(std::move(base)), model_params(params) {}
+
 public:
     [[nodiscard]] explicit glpk_milp(const glpk_api & api)
         : glpk_base(api), model_params() {
@@ -43,6 +46,11 @@ public:
         model_params.sr_heur = GLP_ON;
     }
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] glpk_milp clone() {
+        return glpk_milp(_clone_base(), model_params);
+    }
+
     variable add_integer_variable(
         const variable_params params = default_variable_params) {
         int var_id = static_cast<int>(num_variables());
@@ -139,6 +147,7 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _invalidate_solution_caches();
         switch(glp->intopt(model, &model_params)) {
             case 0:
             case GLP_EMIPGAP:
@@ -164,12 +173,24 @@ public:
         return objective_offset + glp->mip_obj_val(model);
     }
     auto get_solution() {
-        auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
-        for(std::size_t var = 0u; var < num_vars; ++var) {
-            solution[var] = glp->mip_col_val(model, static_cast<int>(var) + 1);
-        }
-        return variable_mapping(std::move(solution));
+        const auto num_vars = num_variables();
+        return variable_mapping(
+            _solution_cache.get(num_vars, [&](double * solution) {
+                for(std::size_t var = 0u; var < num_vars; ++var)
+                    solution[var] =
+                        glp->mip_col_val(model, static_cast<int>(var) + 1);
+            }));
+    }
+    // glpk reads columns one by one : only the requested ones are read
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        if(const double * x = _solution_cache.cached(num_variables()))
+            return _gather_values(vars, x);
+        std::vector<double> values;
+        for(auto && v : vars)
+            values.emplace_back(glp->mip_col_val(model, v.id() + 1));
+        return values;
     }
 };
 
@@ -24,6 +24,7 @@ int GRBnewmodel(GRBenv * env, GRBmodel ** modelP, const char * Pname,
                 int numvars, double * obj, double * lb, double * ub,
                 char * vtype, char ** varnames);
 int GRBfreemodel(GRBmodel * model);
+GRBmodel * GRBcopymodel(GRBmodel * model);
 const char * GRBgeterrormsg(GRBenv * env);
 int GRBupdatemodel(GRBmodel * model);
 
@@ -69,6 +70,8 @@ int GRBoptimize(GRBmodel * model);
 
 constexpr const char * GRB_INT_PAR_DUALREDUCTIONS = "DualReductions";
 constexpr const char * GRB_INT_PAR_LAZYCONSTRAINTS = "LazyConstraints";
+constexpr const char * GRB_INT_PAR_PRECRUSH = "PreCrush";
+constexpr const char * GRB_INT_PAR_THREADS = "Threads";
 int GRBsetintparam(GRBenv * env, const char * paramname, int value);
 int GRBgetintparam(GRBenv * env, const char * paramname, int * valueP);
 constexpr const char * GRB_DBL_PAR_TIMELIMIT = "TimeLimit";
@@ -118,6 +121,15 @@ int GRBsetintattrarray(GRBmodel * model, const char * attrname, int first,
                        int len, int * newvalues);
 int GRBgetintattrarray(GRBmodel * model, const char * attrname, int first,
                        int len, int * values);
+constexpr const char * GRB_INT_ATTR_VBASIS = "VBasis";
+constexpr const char * GRB_INT_ATTR_CBASIS = "CBasis";
+enum BasisStatus : int {
+    GRB_BASIC = 0,
+    GRB_NONBASIC_LOWER = -1,
+    GRB_NONBASIC_UPPER = -2,
+    GRB_SUPERBASIC = -3
+};
+constexpr int GRB_ERROR_DATA_NOT_AVAILABLE = 10005;
 constexpr const char * GRB_DBL_ATTR_OBJCON = "ObjCon";  // objective offset
 constexpr const char * GRB_DBL_ATTR_OBJ = "Obj";        // variable obj coef
 constexpr const char * GRB_DBL_ATTR_LB = "LB";          // variable lower bound
@@ -141,6 +153,8 @@ int GRBgetdblattrarray(GRBmodel * model, const char * attrname, int first,
                        int len, double * values);
 int GRBsetdblattrlist(GRBmodel * model, const char * attrname, int len,
                       int * ind, double * newvalues);
+int GRBgetdblattrlist(GRBmodel * model, const char * attrname, int len,
+                      int * ind, double * values);
 constexpr const char * GRB_CHAR_ATTR_SENSE = "Sense";
 enum ConstraintSense : char {
     GRB_LESS_EQUAL = '<',
@@ -184,6 +198,8 @@ using callback_func_t = int(GRBmodel *, void *, int, void *);
 int GRBsetcallbackfunc(GRBmodel * model, callback_func_t * cb, void * usrdata);
 int GRBcbproceed(void * cbdata);
 constexpr int GRB_CB_MIPSOL_SOL = 4001;
+constexpr int GRB_CB_MIPNODE_STATUS = 5001;
+constexpr int GRB_CB_MIPNODE_REL = 5002;
 int GRBcbget(void * cbdata, int where, int what, void * resultP);
 int GRBcbsetintparam(void * cbdata, const char * paramname, int newvalue);
 int GRBcbsetdblparam(void * cbdata, const char * paramname, double newvalue);
@@ -199,6 +215,8 @@ int GRBcblazy(void * cbdata, int lazylen, const int * lazyind,
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -214,6 +232,7 @@ namespace gurobi::v12_0 {
     F(GRBfreeenv, freeenv)                             \
     F(GRBnewmodel, newmodel)                           \
     F(GRBfreemodel, freemodel)                         \
+    F(GRBcopymodel, copymodel)                         \
     F(GRBgeterrormsg, geterrormsg)                     \
     F(GRBupdatemodel, updatemodel)                     \
     F(GRBaddvar, addvar)                               \
@@ -249,6 +268,7 @@ namespace gurobi::v12_0 {
     F(GRBsetdblattrarray, setdblattrarray)             \
     F(GRBgetdblattrarray, getdblattrarray)             \
     F(GRBsetdblattrlist, setdblattrlist)               \
+    F(GRBgetdblattrlist, getdblattrlist)               \
     F(GRBsetcharattrelement, setcharattrelement)       \
     F(GRBgetcharattrelement, getcharattrelement)       \
     F(GRBsetcharattrarray, setcharattrarray)           \
@@ -272,20 +292,23 @@ namespace gurobi::v12_0 {
 
 #define DECLARE_GRB_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);  \
+    detail::solver_function<SHORT##_fun_t> SHORT;
+#define DECLARE_GRB_OPTIONAL_FUNCTIONS(FULL, SHORT) \
+    using SHORT##_fun_t = decltype(FULL);           \
     SHORT##_fun_t const * SHORT;
 #define CONSTRUCT_GRB_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<SHORT##_fun_t>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 #define CONSTRUCT_GRB_OPTIONAL_FUNCTIONS(FULL, SHORT) \
     , SHORT(_try_load<SHORT##_fun_t>(#FULL))
 
 class gurobi_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
     template <typename T>
     T * _try_load(const char * symbol_name) const {
         try {
-            return lib.get_function<T>(symbol_name);
+            return lib->get_function<T>(symbol_name);
         } catch(const dylib::symbol_error &) {
             return nullptr;
         }
@@ -293,7 +316,7 @@ private:
 
 public:
     GRB_FUNCTIONS(DECLARE_GRB_FUNCTIONS)
-    GRB_OPTIONAL_FUNCTIONS(DECLARE_GRB_FUNCTIONS)
+    GRB_OPTIONAL_FUNCTIONS(DECLARE_GRB_OPTIONAL_FUNCTIONS)
     int major, minor, technical;
 
 public:
@@ -326,6 +349,7 @@ public:
 
 #undef CONSTRUCT_GRB_FUNCTIONS
 #undef DECLARE_GRB_FUNCTIONS
+#undef DECLARE_GRB_OPTIONAL_FUNCTIONS
 #undef GRB_OPTIONAL_FUNCTIONS
 #undef GRB_FUNCTIONS
 
@@ -1,17 +1,23 @@
 #pragma once
 
+#include <execution>
 #include <memory>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <vector>
 
+#include "mippp/detail/parallel_rows.hpp"
+#include "mippp/container/unordered_dense_map.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
 #include "mippp/model_entities.hpp"
+#include "mippp/model_lp_basis.hpp"
 
+#include "mippp/solvers/constraints_batch.hpp"
 #include "mippp/solvers/gurobi/v12_0/gurobi_api.hpp"
+#include "mippp/solvers/modifications_batch.hpp"
 #include "mippp/solvers/remapping_model_base.hpp"
 
 namespace mippp {
@@ -62,15 +68,37 @@ protected:
     std::vector<char> tmp_types;
     std::vector<double> tmp_rhs;
 
+    // rows added by add_constraint inside a batch_constraints() scope
+    int _constraints_batch_depth;
+    std::vector<int> staged_begins;
+    std::vector<int> staged_indices;
+    std::vector<double> staged_scalars;
+    std::vector<char> staged_types;
+    std::vector<double> staged_rhs;
+
+    // values set inside a batch_modifications() scope, by native id
+    int _modifications_batch_depth;
+    unordered_dense_map<int, double> _objective_changes;
+    unordered_dense_map<int, double> _lower_bound_changes;
+    unordered_dense_map<int, double> _upper_bound_changes;
+    unordered_dense_map<int, double> _rhs_changes;
+
     std::vector<bool> _var_name_set;
 
+    template <typename>
+    friend class mippp::constraints_batch;
+    template <typename>
+    friend class mippp::modifications_batch;
+
 public:
     [[nodiscard]] explicit gurobi_base(const gurobi_api & api)
         : remapping_model_base<int, double>()
         , GRB(&api)
         , env(GRB->_empty_env())
         , _num_var_native_ids(0)
-        , _lazy_num_constraints(0) {
+        , _lazy_num_constraints(0)
+        , _constraints_batch_depth(0)
+        , _modifications_batch_depth(0) {
         check(GRB->startenv(env));
         check(GRB->newmodel(env, &model, "GUROBI", 0, nullptr, nullptr, nullptr,
                             nullptr, nullptr));
@@ -95,6 +123,17 @@ public:
         , tmp_begins(std::move(other.tmp_begins))
         , tmp_types(std::move(other.tmp_types))
         , tmp_rhs(std::move(other.tmp_rhs))
+        , _constraints_batch_depth(other._constraints_batch_depth)
+        , staged_begins(std::move(other.staged_begins))
+        , staged_indices(std::move(other.staged_indices))
+        , staged_scalars(std::move(other.staged_scalars))
+        , staged_types(std::move(other.staged_types))
+        , staged_rhs(std::move(other.staged_rhs))
+        , _modifications_batch_depth(other._modifications_batch_depth)
+        , _objective_changes(std::move(other._objective_changes))
+        , _lower_bound_changes(std::move(other._lower_bound_changes))
+        , _upper_bound_changes(std::move(other._upper_bound_changes))
+        , _rhs_changes(std::move(other._rhs_changes))
         , _var_name_set(std::move(other._var_name_set)) {
         other.model = nullptr;
         other.env = nullptr;
@@ -104,7 +143,95 @@ public:
     constexpr gurobi_base & operator=(gurobi_base && other) = delete;
 
 protected:
-    void update_gurobi_model() { check(GRB->updatemodel(model)); }
+    // other on model_copy, a copy of its model : the handles of other stay
+    // valid, its batches are already flushed and no solution is copied
+    gurobi_base(const gurobi_base & other, GRBmodel * model_copy)
+        : remapping_model_base<int, double>(other)
+        , GRB(other.GRB)
+        , env(GRB->getenv(model_copy))
+        , model(model_copy)
+        , _num_var_native_ids(other._num_var_native_ids)
+        , _lazy_num_constraints(other._lazy_num_constraints)
+        , _constraints_batch_depth(0)
+        , _modifications_batch_depth(0)
+        , _var_name_set(other._var_name_set) {
+        _invalidate_solution_caches();
+    }
+    gurobi_base _clone_base() {
+        _lazily_remove_variables();
+        update_gurobi_model();
+        GRBmodel * model_copy = GRB->copymodel(model);
+        if(model_copy == nullptr)
+            throw std::runtime_error("gurobi_base: Could not copy the model.");
+        return gurobi_base(*this, model_copy);
+    }
+
+    void _begin_constraints_batch() { ++_constraints_batch_depth; }
+    void _end_constraints_batch() {
+        if(--_constraints_batch_depth == 0) _flush_staged_constraints();
+    }
+    void _discard_constraints_batch() {
+        if(--_constraints_batch_depth > 0) return;
+        _lazy_num_constraints -= staged_rhs.size();
+        _clear_staged_constraints();
+    }
+    void _clear_staged_constraints() {
+        staged_begins.resize(0);
+        staged_indices.resize(0);
+        staged_scalars.resize(0);
+        staged_types.resize(0);
+        staged_rhs.resize(0);
+    }
+    void _flush_staged_constraints() {
+        if(staged_rhs.empty()) return;
+        const int error = GRB->addconstrs(
+            model, static_cast<int>(staged_rhs.size()),
+            static_cast<int>(staged_indices.size()), staged_begins.data(),
+            staged_indices.data(), staged_scalars.data(), staged_types.data(),
+            staged_rhs.data(), nullptr);
+        if(error) _lazy_num_constraints -= staged_rhs.size();
+        _clear_staged_constraints();
+        check(error);
+    }
+
+    void _begin_modifications_batch() { ++_modifications_batch_depth; }
+    void _end_modifications_batch() {
+        if(--_modifications_batch_depth == 0) _flush_modifications();
+    }
+    void _discard_modifications_batch() {
+        if(--_modifications_batch_depth > 0) return;
+        _objective_changes.clear();
+        _lower_bound_changes.clear();
+        _upper_bound_changes.clear();
+        _rhs_changes.clear();
+    }
+    void _flush_changes(const char * attribute,
+                        unordered_dense_map<int, double> & changes) {
+        if(changes.empty()) return;
+        tmp_indices.resize(0);
+        tmp_scalars.resize(0);
+        for(auto && [native_id, value] : changes.values()) {
+            tmp_indices.emplace_back(native_id);
+            tmp_scalars.emplace_back(value);
+        }
+        changes.clear();
+        check(GRB->setdblattrlist(model, attribute,
+                                  static_cast<int>(tmp_indices.size()),
+                                  tmp_indices.data(), tmp_scalars.data()));
+    }
+    // rhs changes may target staged rows, which are flushed first
+    void _flush_modifications() {
+        _flush_staged_constraints();
+        _flush_changes(GRB_DBL_ATTR_OBJ, _objective_changes);
+        _flush_changes(GRB_DBL_ATTR_LB, _lower_bound_changes);
+        _flush_changes(GRB_DBL_ATTR_UB, _upper_bound_changes);
+        _flush_changes(GRB_DBL_ATTR_RHS, _rhs_changes);
+    }
+
+    void update_gurobi_model() {
+        _flush_modifications();
+        check(GRB->updatemodel(model));
+    }
 
     int _new_var_native_id() {
         if(_remap_ids) _extend_handle_ids_map(1);
@@ -120,6 +247,7 @@ protected:
         std::ranges::sort(tmp_indices);
         check(GRB->delvars(model, static_cast<int>(tmp_indices.size()),
                            tmp_indices.data()));
+        _invalidate_solution_caches();
 
         update_gurobi_model();
 
@@ -198,16 +326,21 @@ public:
     //////////////////////////////// Objective ////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void set_maximization() {
+        _invalidate_solution_caches();
         check(GRB->setintattr(model, GRB_INT_ATTR_MODELSENSE, GRB_MAXIMIZE));
     }
     void set_minimization() {
+        _invalidate_solution_caches();
         check(GRB->setintattr(model, GRB_INT_ATTR_MODELSENSE, GRB_MINIMIZE));
     }
 
+    // also reached by set_objective and add_objective
     void set_objective_offset(double constant) {
+        _invalidate_solution_caches();
         check(GRB->setdblattr(model, GRB_DBL_ATTR_OBJCON, constant));
     }
     void set_objective(linear_expression auto && le) {
+        _objective_changes.clear();
         tmp_scalars.resize(_num_var_native_ids);
         std::fill(tmp_scalars.begin(), tmp_scalars.end(), 0.0);
         for(auto && [var, coef] : le.linear_terms()) {
@@ -226,6 +359,7 @@ public:
 private:
     template <bool distinct, linear_expression LE>
     void _add_objective(LE && le) {
+        update_gurobi_model();
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids);
         _reset_cache();
         _register_variables_entries<distinct>(le.linear_terms());
@@ -275,6 +409,7 @@ public:
 protected:
     inline variable _add_variable(const variable_params & params,
                                   const char & type, const char * name_str) {
+        _invalidate_solution_caches();
         check(GRB->addvar(model, 0, nullptr, nullptr, params.obj_coef,
                           params.lower_bound.value_or(-GRB_INFINITY),
                           params.upper_bound.value_or(GRB_INFINITY), type,
@@ -284,6 +419,7 @@ protected:
     inline std::size_t _add_variables(const std::size_t & count,
                                       const variable_params & params,
                                       const char & type) {
+        _invalidate_solution_caches();
         if(_remap_ids) _extend_handle_ids_map(count);
         const int new_native_ids_begin = static_cast<int>(_num_var_native_ids);
         const std::size_t handle_ids_begin =
@@ -375,6 +511,8 @@ private:
     template <typename ER>
     inline variable _add_column(ER && entries, const variable_params & params,
                                 const char & type) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
         _reset_cache();
         _register_constraints_entries<true>(entries);
         check(GRB->addvar(
@@ -413,14 +551,29 @@ public:
     }
 
     void set_objective_coefficient(variable v, double c) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _objective_changes.insert_or_assign(_native_id(v), c);
+            return;
+        }
         check(
             GRB->setdblattrelement(model, GRB_DBL_ATTR_OBJ, _native_id(v), c));
     }
     void set_variable_lower_bound(variable v, double lb) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _lower_bound_changes.insert_or_assign(_native_id(v), lb);
+            return;
+        }
         check(
             GRB->setdblattrelement(model, GRB_DBL_ATTR_LB, _native_id(v), lb));
     }
     void set_variable_upper_bound(variable v, double ub) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _upper_bound_changes.insert_or_assign(_native_id(v), ub);
+            return;
+        }
         check(
             GRB->setdblattrelement(model, GRB_DBL_ATTR_UB, _native_id(v), ub));
     }
@@ -466,10 +619,22 @@ public:
 private:
     template <bool distinct, linear_constraint LC>
     constraint _add_constraint(LC && lc) {
+        _invalidate_solution_caches();
         const int constr_id = static_cast<int>(_lazy_num_constraints++);
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids);
         _reset_cache();
         _register_variables_entries<distinct>(lc.linear_terms());
+        if(_constraints_batch_depth > 0) {
+            staged_begins.emplace_back(static_cast<int>(staged_indices.size()));
+            staged_indices.insert(staged_indices.end(), tmp_indices.cbegin(),
+                                  tmp_indices.cend());
+            staged_scalars.insert(staged_scalars.end(), tmp_scalars.cbegin(),
+                                  tmp_scalars.cend());
+            staged_types.emplace_back(
+                constraint_sense_to_gurobi_sense(lc.sense()));
+            staged_rhs.emplace_back(lc.rhs());
+            return constraint(constr_id);
+        }
         check(GRB->addconstr(model, static_cast<int>(tmp_indices.size()),
                              tmp_indices.data(), tmp_scalars.data(),
                              constraint_sense_to_gurobi_sense(lc.sense()),
@@ -486,6 +651,10 @@ public:
     constraint add_constraint(distinct_variables_t, LC && lc) {
         return _add_constraint<true>(std::forward<LC>(lc));
     }
+    [[nodiscard]] auto batch_constraints() { return constraints_batch(*this); }
+    [[nodiscard]] auto batch_modifications() {
+        return modifications_batch(*this);
+    }
 
 private:
     template <bool distinct, linear_constraint LC>
@@ -519,6 +688,8 @@ private:
     }
     template <bool distinct, std::ranges::range IR, typename... CL>
     auto _add_constraints(IR && keys, CL &... constraint_lambdas) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids);
         _reset_cache();
         tmp_begins.resize(0);
@@ -555,11 +726,63 @@ public:
                                       constraint_lambdas...);
     }
 
+private:
+    template <bool distinct, std::ranges::random_access_range IR,
+              typename... CL>
+    auto _add_constraints_parallel(IR && keys, CL &... constraint_lambdas) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
+        const int offset = static_cast<int>(_lazy_num_constraints);
+        auto rows = detail::build_rows_in_parallel<distinct, int, double>(
+            keys, _num_var_native_ids,
+            [this](const variable & v) { return _native_id(v); },
+            constraint_lambdas...);
+        const std::size_t num_rows = rows.num_rows();
+        tmp_types.resize(num_rows);
+        std::ranges::transform(rows.senses, tmp_types.begin(),
+                               constraint_sense_to_gurobi_sense);
+        check(GRB->addconstrs(model, static_cast<int>(num_rows),
+                              static_cast<int>(rows.indices.size()),
+                              rows.begins.data(), rows.indices.data(),
+                              rows.scalars.data(), tmp_types.data(),
+                              rows.rhs.data(), nullptr));
+        _lazy_num_constraints += num_rows;
+        return constraints_range(
+            std::forward<IR>(keys),
+            std::views::transform(
+                std::views::iota(offset,
+                                 offset + static_cast<int>(num_rows)),
+                [](auto && i) { return constraint{i}; }));
+    }
+
+public:
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<false>(std::forward<IR>(keys),
+                                                constraint_lambdas...);
+    }
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &,
+                         distinct_variables_t, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<true>(std::forward<IR>(keys),
+                                               constraint_lambdas...);
+    }
+
     void set_constraint_rhs(constraint constr, double rhs) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _rhs_changes.insert_or_assign(constr.id(), rhs);
+            return;
+        }
+        _flush_staged_constraints();
         check(
             GRB->setdblattrelement(model, GRB_DBL_ATTR_RHS, constr.id(), rhs));
     }
     void set_constraint_sense(constraint constr, constraint_sense r) {
+        _invalidate_solution_caches();
+        _flush_staged_constraints();
         check(GRB->setcharattrelement(model, GRB_CHAR_ATTR_SENSE, constr.id(),
                                       constraint_sense_to_gurobi_sense(r)));
     }
@@ -567,6 +790,8 @@ public:
 private:
     template <bool distinct, linear_expression LE>
     constraint _add_ranged_constraint(LE && le, double lb, double ub) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
         int constr_id = static_cast<int>(_lazy_num_constraints++);
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids);
         _reset_cache();
@@ -646,6 +871,121 @@ public:
         return tol;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    //////////////////////////////// Solution /////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+protected:
+    // one GRBgetdblattrarray per solve, shared by the returned mappings ;
+    // dropped on any modification of the model, see highs_base
+    auto _get_cached_variables_attr(detail::solution_cache<double> & cache,
+                                    const char * attr) {
+        auto values = cache.get(_num_var_native_ids, [&](double * v) {
+            check(GRB->getdblattrarray(
+                model, attr, 0, static_cast<int>(_num_var_native_ids), v));
+        });
+        return variable_mapping(
+            [this, values = std::move(values)](const variable & v) {
+                return values[static_cast<std::size_t>(_native_id(v))];
+            });
+    }
+    // only the requested entries, unless the whole array is already cached
+    template <std::ranges::range VR>
+    std::vector<double> _get_variables_attr(
+        const detail::solution_cache<double> & cache, const char * attr,
+        VR && vars) {
+        const auto native_id = [this](const variable & v) {
+            return _native_id(v);
+        };
+        if(const double * values = cache.cached(_num_var_native_ids))
+            return _gather_values(vars, values, native_id);
+        tmp_indices.clear();
+        for(auto && v : vars) tmp_indices.emplace_back(native_id(v));
+        std::vector<double> values(tmp_indices.size());
+        check(GRB->getdblattrlist(model, attr,
+                                  static_cast<int>(tmp_indices.size()),
+                                  tmp_indices.data(), values.data()));
+        return values;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////// Basis //////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+public:
+    using basis = model_lp_basis<variable, constraint>;
+
+private:
+    static basis::code _basis_code(const int status) {
+        switch(status) {
+            case GRB_BASIC:
+                return basis::code::basic;
+            case GRB_NONBASIC_UPPER:
+                return basis::code::nonbasic_at_upper_bound;
+            case GRB_SUPERBASIC:
+                return basis::code::nonbasic_free;
+            default:
+                return basis::code::nonbasic_at_lower_bound;
+        }
+    }
+    static int _variable_basis_status(const basis::code code) {
+        switch(code) {
+            case basis::code::basic:
+                return GRB_BASIC;
+            case basis::code::nonbasic_free:
+                return GRB_SUPERBASIC;
+            case basis::code::nonbasic_at_upper_bound:
+                return GRB_NONBASIC_UPPER;
+            default:
+                return GRB_NONBASIC_LOWER;
+        }
+    }
+    // CBasis only tells basic slacks from nonbasic ones
+    static int _constraint_basis_status(const basis::code code) {
+        return code == basis::code::basic ? GRB_BASIC : GRB_NONBASIC_LOWER;
+    }
+    auto _var_handle_id_of() {
+        return [this](std::size_t i) {
+            return _var_handle(static_cast<int>(i)).uid();
+        };
+    }
+
+public:
+    // the basis of the last solve, read as the VBasis and CBasis arrays ;
+    // without one, the slack basis
+    basis get_basis() {
+        _lazily_remove_variables();
+        update_gurobi_model();
+        std::vector<int> vbasis(_num_var_native_ids);
+        std::vector<int> cbasis(_lazy_num_constraints);
+        int error = GRB->getintattrarray(model, GRB_INT_ATTR_VBASIS, 0,
+                                         static_cast<int>(vbasis.size()),
+                                         vbasis.data());
+        if(error == GRB_ERROR_DATA_NOT_AVAILABLE) return basis();
+        check(error);
+        check(GRB->getintattrarray(model, GRB_INT_ATTR_CBASIS, 0,
+                                   static_cast<int>(cbasis.size()),
+                                   cbasis.data()));
+        return basis::from_native(
+            vbasis, cbasis,
+            _remap_ids ? _native_ids_map.size() : _num_var_native_ids,
+            _var_handle_id_of(), _basis_code, _basis_code);
+    }
+    // warm starts the next solve from b, set as the VBasis and CBasis arrays
+    void set_basis(const basis & b) {
+        _lazily_remove_variables();
+        update_gurobi_model();
+        std::vector<int> vbasis(_num_var_native_ids);
+        std::vector<int> cbasis(_lazy_num_constraints);
+        b.to_native(vbasis, cbasis, _var_handle_id_of(),
+                    _variable_basis_status, _constraint_basis_status);
+        check(GRB->setintattrarray(model, GRB_INT_ATTR_VBASIS, 0,
+                                   static_cast<int>(vbasis.size()),
+                                   vbasis.data()));
+        check(GRB->setintattrarray(model, GRB_INT_ATTR_CBASIS, 0,
+                                   static_cast<int>(cbasis.size()),
+                                   cbasis.data()));
+    }
+
+public:
     ///////////////////////////////// Limits //////////////////////////////////
     void set_time_limit(std::chrono::duration<double> t) {
         check(GRB->setdblparam(env, GRB_DBL_PAR_TIMELIMIT, t.count()));
@@ -664,6 +1004,15 @@ public:
         check(GRB->getdblparam(env, GRB_DBL_PAR_SOFTMEMLIMIT, &gb));
         return static_cast<std::size_t>(gb);
     }
+
+    void set_thread_count(std::size_t n) {
+        check(GRB->setintparam(env, GRB_INT_PAR_THREADS, static_cast<int>(n)));
+    }
+    std::size_t get_thread_count() {
+        int n;
+        check(GRB->getintparam(env, GRB_INT_PAR_THREADS, &n));
+        return static_cast<std::size_t>(n);
+    }
 };
 
 }  // namespace gurobi::v12_0
@@ -8,10 +8,16 @@ namespace mippp {
 namespace gurobi::v12_0 {
 
 class gurobi_lp : public gurobi_base {
+private:
+    explicit gurobi_lp(gurobi_base && base) : gurobi_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit gurobi_lp(const gurobi_api & api)
         : gurobi_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] gurobi_lp clone() { return gurobi_lp(_clone_base()); }
+
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////// Limits //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -78,6 +84,8 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_modifications();
+        _invalidate_solution_caches();
         check(GRB->optimize(model));
         _status = _get_status();
     }
@@ -87,6 +95,7 @@ public:
         check(GRB->getintparam(env, GRB_INT_PAR_DUALREDUCTIONS,
                               &tmp_dual_reductions));
         check(GRB->setintparam(env, GRB_INT_PAR_DUALREDUCTIONS, 0));
+        _invalidate_solution_caches();
         check(GRB->optimize(model));
         _status = _get_status();
         check(GRB->setintparam(env, GRB_INT_PAR_DUALREDUCTIONS,
@@ -100,34 +109,25 @@ public:
         return value;
     }
     auto get_solution() {
-        auto solution =
-            std::make_unique_for_overwrite<double[]>(_num_var_native_ids);
-        check(GRB->getdblattrarray(model, GRB_DBL_ATTR_X, 0,
-                                  static_cast<int>(_num_var_native_ids),
-                                  solution.get()));
-        return variable_mapping(
-            [this, solution = std::move(solution)](const variable & v) {
-                return *(solution.get() + _native_id(v));
-            });
+        return _get_cached_variables_attr(_solution_cache, GRB_DBL_ATTR_X);
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_variables_attr(_solution_cache, GRB_DBL_ATTR_X, vars);
     }
     auto get_dual_solution() {
         auto num_constrs = num_constraints();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_constrs);
-        check(GRB->getdblattrarray(model, GRB_DBL_ATTR_PI, 0,
-                                  static_cast<int>(num_constrs),
-                                  solution.get()));
-        return constraint_mapping(std::move(solution));
+        return constraint_mapping(
+            _dual_solution_cache.get(num_constrs, [&](double * solution) {
+                check(GRB->getdblattrarray(model, GRB_DBL_ATTR_PI, 0,
+                                          static_cast<int>(num_constrs),
+                                          solution));
+            }));
     }
     auto get_reduced_costs() {
-        auto reduced_costs =
-            std::make_unique_for_overwrite<double[]>(_num_var_native_ids);
-        check(GRB->getdblattrarray(model, GRB_DBL_ATTR_RC, 0,
-                                  static_cast<int>(_num_var_native_ids),
-                                  reduced_costs.get()));
-        return variable_mapping([this, reduced_costs = std::move(
-                                           reduced_costs)](const variable & v) {
-            return *(reduced_costs.get() + _native_id(v));
-        });
+        return _get_cached_variables_attr(_reduced_costs_cache,
+                                          GRB_DBL_ATTR_RC);
     }
 };
 
@@ -1,7 +1,6 @@
 #pragma once
 
-#include <functional>
-
+#include "mippp/detail/callback_storage.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/model_concepts.hpp"
 #include "mippp/model_entities.hpp"
@@ -13,10 +12,23 @@ namespace mippp {
 namespace gurobi::v12_0 {
 
 class gurobi_milp : public gurobi_base {
+private:
+    explicit gurobi_milp(gurobi_base && base)
+        : gurobi_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit gurobi_milp(const gurobi_api & api)
         : gurobi_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid,
+    // without the callbacks
+    [[nodiscard]] gurobi_milp clone() {
+        gurobi_milp copy(_clone_base());
+        if(candidate_solution_callback || node_relaxation_callback)
+            copy.check(GRB->setcallbackfunc(copy.model, nullptr, nullptr));
+        return copy;
+    }
+
     variable add_integer_variable(
         const variable_params params = default_variable_params) {
         return _add_variable(params, GRB_INTEGER, nullptr);
@@ -40,6 +52,7 @@ public:
 
 private:
     inline std::size_t _add_binary_variables(const std::size_t & count) {
+        _invalidate_solution_caches();
         tmp_types.resize(count);
         std::fill(tmp_types.begin(), tmp_types.end(), GRB_BINARY);
         check(GRB->addvars(model, static_cast<int>(count), 0, nullptr, nullptr,
@@ -70,14 +83,17 @@ public:
                                             std::forward<IL>(id_lambda));
     }
     void set_continuous(variable v) noexcept {
+        _invalidate_solution_caches();
         check(GRB->setcharattrelement(model, GRB_CHAR_ATTR_VTYPE, v.id(),
                                       GRB_CONTINUOUS));
     }
     void set_integer(variable v) noexcept {
+        _invalidate_solution_caches();
         check(GRB->setcharattrelement(model, GRB_CHAR_ATTR_VTYPE, v.id(),
                                       GRB_INTEGER));
     }
     void set_binary(variable v) noexcept {
+        _invalidate_solution_caches();
         check(GRB->setcharattrelement(model, GRB_CHAR_ATTR_VTYPE, v.id(),
                                       GRB_BINARY));
     }
@@ -89,11 +105,12 @@ public:
 private:
     template <bool distinct, linear_constraint LC>
     void _add_indicator_constraint(variable x, bool val, LC && lc) {
+        _invalidate_solution_caches();
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids);
         _reset_cache();
         _register_variables_entries<distinct>(lc.linear_terms());
         check(GRB->addgenconstrIndicator(
-            model, nullptr, x.id(), static_cast<int>(val),
+            model, nullptr, _native_id(x), static_cast<int>(val),
             static_cast<int>(tmp_indices.size()), tmp_indices.data(),
             tmp_scalars.data(), constraint_sense_to_gurobi_sense(lc.sense()),
             lc.rhs()));
@@ -129,6 +146,21 @@ private:
             parent.GRB->getintattr(master_model, GRB_INT_ATTR_NUMVARS, &num);
             return static_cast<std::size_t>(num);
         }
+
+    protected:
+        void check(const int error) const {
+            parent.GRB->_check(parent.env, error);
+        }
+        // cuts are coalesced on handle ids, then remapped to native ids
+        std::size_t _num_var_handle_ids() {
+            if(parent._remap_ids) return parent._native_ids_map.size();
+            return num_variables();
+        }
+        void _remap_to_native_ids(std::vector<int> & indices) const {
+            if(!parent._remap_ids) return;
+            for(auto & id : indices)
+                id = parent._native_ids_map[static_cast<std::size_t>(id)];
+        }
     };
 
 public:
@@ -150,13 +182,14 @@ public:
     private:
         template <bool distinct, linear_constraint LC>
         void _add_lazy_constraint(LC && lc) {
-            if constexpr(!distinct) _prepare_coalescing(num_variables());
+            if constexpr(!distinct) _prepare_coalescing(_num_var_handle_ids());
             _reset_cache();
             _register_variables_entries<distinct>(lc.linear_terms());
-            parent.GRB->cblazy(cbdata, static_cast<int>(tmp_indices.size()),
-                               tmp_indices.data(), tmp_scalars.data(),
-                               constraint_sense_to_gurobi_sense(lc.sense()),
-                               lc.rhs());
+            _remap_to_native_ids(tmp_indices);
+            check(parent.GRB->cblazy(
+                cbdata, static_cast<int>(tmp_indices.size()),
+                tmp_indices.data(), tmp_scalars.data(),
+                constraint_sense_to_gurobi_sense(lc.sense()), lc.rhs()));
         }
 
     public:
@@ -168,42 +201,108 @@ public:
         void add_lazy_constraint(distinct_variables_t, LC && lc) {
             _add_lazy_constraint<true>(std::forward<LC>(lc));
         }
+        // valid until the callback returns
         auto get_solution() {
-            auto solution =
-                std::make_unique_for_overwrite<double[]>(num_variables());
+            double * solution =
+                parent._callback_buffers.local(num_variables());
             parent.GRB->cbget(cbdata, GRB_CB_MIPSOL, GRB_CB_MIPSOL_SOL,
-                              solution.get());
-            return variable_mapping(
-                [this, solution = std::move(solution)](const variable & x) {
-                    return *(solution.get() + parent._native_id(x));
-                });
+                              solution);
+            return variable_mapping([this, solution](const variable & x) {
+                return solution[parent._native_id(x)];
+            });
+        }
+    };
+
+    class node_relaxation_callback_handle : public callback_handle_base,
+                                            public model_base<int, double> {
+    public:
+        node_relaxation_callback_handle(const gurobi_milp & parent_,
+                                        GRBmodel * master_model_,
+                                        void * cbdata_)
+            : callback_handle_base(parent_, master_model_, cbdata_)
+            , model_base<int, double>() {}
+
+    private:
+        template <bool distinct, linear_constraint LC>
+        void _add_cut(LC && lc) {
+            if constexpr(!distinct) _prepare_coalescing(_num_var_handle_ids());
+            _reset_cache();
+            _register_variables_entries<distinct>(lc.linear_terms());
+            _remap_to_native_ids(tmp_indices);
+            check(parent.GRB->cbcut(
+                cbdata, static_cast<int>(tmp_indices.size()),
+                tmp_indices.data(), tmp_scalars.data(),
+                constraint_sense_to_gurobi_sense(lc.sense()), lc.rhs()));
+        }
+
+    public:
+        template <linear_constraint LC>
+        void add_cut(LC && lc) {
+            _add_cut<false>(std::forward<LC>(lc));
+        }
+        template <linear_constraint LC>
+        void add_cut(distinct_variables_t, LC && lc) {
+            _add_cut<true>(std::forward<LC>(lc));
+        }
+        // valid until the callback returns
+        auto get_relaxation_solution() {
+            double * solution =
+                parent._callback_buffers.local(num_variables());
+            parent.GRB->cbget(cbdata, GRB_CB_MIPNODE, GRB_CB_MIPNODE_REL,
+                              solution);
+            return variable_mapping([this, solution](const variable & x) {
+                return solution[parent._native_id(x)];
+            });
         }
     };
 
 private:
-    std::function<void(candidate_solution_callback_handle &)>
+    detail::callback_holder<candidate_solution_callback_handle>
         candidate_solution_callback;
+    detail::callback_holder<node_relaxation_callback_handle>
+        node_relaxation_callback;
+    mutable detail::per_thread_buffers<double> _callback_buffers;
 
     static int main_callback(GRBmodel * master_model, void * cbdata, int where,
                              void * usrdata) {
         const gurobi_milp & parent = *static_cast<gurobi_milp *>(usrdata);
         if((where == GRB_CB_MIPSOL) && parent.candidate_solution_callback) {
+            const auto guard = parent._callback_buffers.release_on_return();
             candidate_solution_callback_handle handle(parent, master_model,
                                                       cbdata);
             parent.candidate_solution_callback(handle);
         }
+        if((where == GRB_CB_MIPNODE) && parent.node_relaxation_callback) {
+            // the relaxation is only available at optimally solved nodes
+            int node_status;
+            parent.GRB->cbget(cbdata, GRB_CB_MIPNODE, GRB_CB_MIPNODE_STATUS,
+                              &node_status);
+            if(node_status != GRB_OPTIMAL) return 0;
+            const auto guard = parent._callback_buffers.release_on_return();
+            node_relaxation_callback_handle handle(parent, master_model,
+                                                   cbdata);
+            parent.node_relaxation_callback(handle);
+        }
         return 0;
     }
     void _enable_callbacks() {
-        check(GRB->setintparam(env, GRB_INT_PAR_LAZYCONSTRAINTS, 1));
         check(GRB->setcallbackfunc(model, main_callback, this));
     }
 
 public:
     template <typename F>
     void set_candidate_solution_callback(F && f) {
+        check(GRB->setintparam(env, GRB_INT_PAR_LAZYCONSTRAINTS, 1));
         _enable_callbacks();
-        candidate_solution_callback = std::forward<F>(f);
+        candidate_solution_callback.emplace(std::forward<F>(f));
+    }
+    // Cuts are expressed on the original variables, hence presolve must keep
+    // the crushing of such cuts possible.
+    template <typename F>
+    void set_node_relaxation_callback(F && f) {
+        check(GRB->setintparam(env, GRB_INT_PAR_PRECRUSH, 1));
+        _enable_callbacks();
+        node_relaxation_callback.emplace(std::forward<F>(f));
     }
     ///////////////////////////////////////////////////////////////////////////
     //////////////////////////////// MIP start ////////////////////////////////
@@ -315,6 +414,9 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_modifications();
+        _invalidate_solution_caches();
+        _callback_buffers.clear();
         check(GRB->optimize(model));
         _status = _get_status();
     }
@@ -324,15 +426,12 @@ public:
         return value;
     }
     auto get_solution() {
-        auto solution =
-            std::make_unique_for_overwrite<double[]>(_num_var_native_ids);
-        check(GRB->getdblattrarray(model, GRB_DBL_ATTR_X, 0,
-                                   static_cast<int>(_num_var_native_ids),
-                                   solution.get()));
-        return variable_mapping(
-            [this, solution = std::move(solution)](const variable & x) {
-                return *(solution.get() + _native_id(x));
-            });
+        return _get_cached_variables_attr(_solution_cache, GRB_DBL_ATTR_X);
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_variables_attr(_solution_cache, GRB_DBL_ATTR_X, vars);
     }
 };
 
@@ -57,6 +57,10 @@ HighsInt Highs_changeColsCostBySet(void * highs, const HighsInt num_set_entries,
                                    const HighsInt * set, const double * cost);
 HighsInt Highs_changeColBounds(void * highs, const HighsInt col,
                                const double lower, const double upper);
+HighsInt Highs_changeColsBoundsBySet(void * highs,
+                                     const HighsInt num_set_entries,
+                                     const HighsInt * set, const double * lower,
+                                     const double * upper);
 HighsInt Highs_getColsByRange(const void * highs, const HighsInt from_col,
                               const HighsInt to_col, HighsInt * num_col,
                               double * costs, double * lower, double * upper,
@@ -104,11 +108,20 @@ HighsInt Highs_getColName(const void * highs, const HighsInt col, char * name);
 
 HighsInt Highs_changeRowBounds(void * highs, const HighsInt row,
                                const double lower, const double upper);
+HighsInt Highs_changeRowsBoundsBySet(void * highs,
+                                     const HighsInt num_set_entries,
+                                     const HighsInt * set, const double * lower,
+                                     const double * upper);
 HighsInt Highs_getRowsByRange(const void * highs, const HighsInt from_row,
                               const HighsInt to_row, HighsInt * num_row,
                               double * lower, double * upper, HighsInt * num_nz,
                               HighsInt * matrix_start, HighsInt * matrix_index,
                               double * matrix_value);
+HighsInt Highs_getRowsBySet(const void * highs, const HighsInt num_set_entries,
+                            const HighsInt * set, HighsInt * num_row,
+                            double * lower, double * upper, HighsInt * num_nz,
+                            HighsInt * matrix_start, HighsInt * matrix_index,
+                            double * matrix_value);
 HighsInt Highs_passRowName(const void * highs, const HighsInt row,
                            const char * name);
 HighsInt Highs_getRowName(const void * highs, const HighsInt row, char * name);
@@ -116,10 +129,40 @@ HighsInt Highs_getRowName(const void * highs, const HighsInt row, char * name);
 HighsInt Highs_getNumCol(const void * highs);
 HighsInt Highs_getNumRow(const void * highs);
 HighsInt Highs_getNumNz(const void * highs);
+HighsInt Highs_getHessianNumNz(const void * highs);
+
+constexpr HighsInt kHighsMatrixFormatColwise = 1;
+HighsInt Highs_getModel(const void * highs, const HighsInt a_format,
+                        const HighsInt q_format, HighsInt * num_col,
+                        HighsInt * num_row, HighsInt * num_nz,
+                        HighsInt * hessian_num_nz, HighsInt * sense,
+                        double * offset, double * col_cost, double * col_lower,
+                        double * col_upper, double * row_lower,
+                        double * row_upper, HighsInt * a_start,
+                        HighsInt * a_index, double * a_value,
+                        HighsInt * q_start, HighsInt * q_index,
+                        double * q_value, HighsInt * integrality);
+HighsInt Highs_passModel(void * highs, const HighsInt num_col,
+                         const HighsInt num_row, const HighsInt num_nz,
+                         const HighsInt q_num_nz, const HighsInt a_format,
+                         const HighsInt q_format, const HighsInt sense,
+                         const double offset, const double * col_cost,
+                         const double * col_lower, const double * col_upper,
+                         const double * row_lower, const double * row_upper,
+                         const HighsInt * a_start, const HighsInt * a_index,
+                         const double * a_value, const HighsInt * q_start,
+                         const HighsInt * q_index, const double * q_value,
+                         const HighsInt * integrality);
 
 HighsInt Highs_getNumOptions(const void * highs);
 HighsInt Highs_getOptionName(const void * highs, const HighsInt index,
                              char ** name);
+constexpr HighsInt kHighsOptionTypeBool = 0;
+constexpr HighsInt kHighsOptionTypeInt = 1;
+constexpr HighsInt kHighsOptionTypeDouble = 2;
+constexpr HighsInt kHighsOptionTypeString = 3;
+HighsInt Highs_getOptionType(const void * highs, const char * option,
+                             HighsInt * type);
 HighsInt Highs_setBoolOptionValue(void * highs, const char * option,
                                   const HighsInt value);
 HighsInt Highs_setIntOptionValue(void * highs, const char * option,
@@ -232,6 +275,8 @@ HighsInt Highs_startCallback(void * highs, const int callback_type);
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -262,6 +307,7 @@ namespace highs::v1_10 {
     F(Highs_changeColsCostByRange, changeColsCostByRange)               \
     F(Highs_changeColsCostBySet, changeColsCostBySet)                   \
     F(Highs_changeColBounds, changeColBounds)                           \
+    F(Highs_changeColsBoundsBySet, changeColsBoundsBySet)               \
     F(Highs_getColsByRange, getColsByRange)                             \
     F(Highs_getColsBySet, getColsBySet)                                 \
     F(Highs_addRow, addRow)                                             \
@@ -273,14 +319,20 @@ namespace highs::v1_10 {
     F(Highs_passColName, passColName)                                   \
     F(Highs_getColName, getColName)                                     \
     F(Highs_changeRowBounds, changeRowBounds)                           \
+    F(Highs_changeRowsBoundsBySet, changeRowsBoundsBySet)               \
     F(Highs_getRowsByRange, getRowsByRange)                             \
+    F(Highs_getRowsBySet, getRowsBySet)                                 \
     F(Highs_passRowName, passRowName)                                   \
     F(Highs_getRowName, getRowName)                                     \
     F(Highs_getNumCol, getNumCol)                                       \
     F(Highs_getNumRow, getNumRow)                                       \
     F(Highs_getNumNz, getNumNz)                                         \
+    F(Highs_getHessianNumNz, getHessianNumNz)                           \
+    F(Highs_getModel, getModel)                                         \
+    F(Highs_passModel, passModel)                                       \
     F(Highs_getNumOptions, getNumOptions)                               \
     F(Highs_getOptionName, getOptionName)                               \
+    F(Highs_getOptionType, getOptionType)                               \
     F(Highs_setBoolOptionValue, setBoolOptionValue)                     \
     F(Highs_setIntOptionValue, setIntOptionValue)                       \
     F(Highs_setDoubleOptionValue, setDoubleOptionValue)                 \
@@ -305,20 +357,23 @@ namespace highs::v1_10 {
 
 #define DECLARE_HIGHS_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);    \
+    detail::solver_function<SHORT##_fun_t> SHORT;
+#define DECLARE_HIGHS_OPTIONAL_FUNCTIONS(FULL, SHORT) \
+    using SHORT##_fun_t = decltype(FULL);             \
     SHORT##_fun_t const * SHORT;
 #define CONSTRUCT_HIGHS_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<SHORT##_fun_t>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 #define CONSTRUCT_HIGHS_OPTIONAL_FUNCTIONS(FULL, SHORT) \
     , SHORT(_try_load<SHORT##_fun_t>(#FULL))
 
 class highs_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
     template <typename T>
     T * _try_load(const char * symbol_name) const {
         try {
-            return lib.get_function<T>(symbol_name);
+            return lib->get_function<T>(symbol_name);
         } catch(const dylib::symbol_error &) {
             return nullptr;
         }
@@ -326,7 +381,7 @@ private:
 
 public:
     HIGHS_FUNCTIONS(DECLARE_HIGHS_FUNCTIONS)
-    HIGHS_OPTIONAL_FUNCTIONS(DECLARE_HIGHS_FUNCTIONS)
+    HIGHS_OPTIONAL_FUNCTIONS(DECLARE_HIGHS_OPTIONAL_FUNCTIONS)
 
 public:
     inline highs_api(const char * lib_path = nullptr)
@@ -348,6 +403,7 @@ public:
 
 #undef CONSTRUCT_HIGHS_FUNCTIONS
 #undef DECLARE_HIGHS_FUNCTIONS
+#undef DECLARE_HIGHS_OPTIONAL_FUNCTIONS
 #undef HIGHS_FUNCTIONS
 
 }  // namespace highs::v1_10
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <concepts>
+#include <cstdlib>
 #include <cstring>
+#include <execution>
 #include <limits>
 #include <memory>
 #include <numeric>
@@ -8,12 +11,17 @@
 #include <ranges>
 #include <vector>
 
+#include "mippp/detail/parallel_rows.hpp"
+#include "mippp/container/unordered_dense_map.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
 #include "mippp/model_entities.hpp"
+#include "mippp/model_lp_basis.hpp"
 
+#include "mippp/solvers/constraints_batch.hpp"
 #include "mippp/solvers/highs/v1_10/highs_api.hpp"
+#include "mippp/solvers/modifications_batch.hpp"
 #include "mippp/solvers/remapping_model_base.hpp"
 
 namespace mippp {
@@ -48,11 +56,33 @@ protected:
     std::vector<scalar> tmp_lower_bounds;
     std::vector<scalar> tmp_upper_bounds;
 
+    // rows added by add_constraint inside a batch_constraints() scope
+    int _constraints_batch_depth;
+    std::vector<index> staged_begins;
+    std::vector<index> staged_indices;
+    std::vector<scalar> staged_scalars;
+    std::vector<scalar> staged_lower_bounds;
+    std::vector<scalar> staged_upper_bounds;
+
+    // values set inside a batch_modifications() scope, by native id
+    int _modifications_batch_depth;
+    unordered_dense_map<index, scalar> _objective_changes;
+    unordered_dense_map<index, scalar> _lower_bound_changes;
+    unordered_dense_map<index, scalar> _upper_bound_changes;
+    unordered_dense_map<index, scalar> _rhs_changes;
+
+    template <typename>
+    friend class mippp::constraints_batch;
+    template <typename>
+    friend class mippp::modifications_batch;
+
 public:
     [[nodiscard]] explicit highs_base(const highs_api & api)
         : remapping_model_base<int, double>()
         , Highs(&api)
-        , model(Highs->create()) {}
+        , model(Highs->create())
+        , _constraints_batch_depth(0)
+        , _modifications_batch_depth(0) {}
     ~highs_base() {
         if(model) Highs->destroy(model);
     }
@@ -64,38 +94,156 @@ public:
         , model(other.model)
         , tmp_begins(std::move(other.tmp_begins))
         , tmp_lower_bounds(std::move(other.tmp_lower_bounds))
-        , tmp_upper_bounds(std::move(other.tmp_upper_bounds)) {
+        , tmp_upper_bounds(std::move(other.tmp_upper_bounds))
+        , _constraints_batch_depth(other._constraints_batch_depth)
+        , staged_begins(std::move(other.staged_begins))
+        , staged_indices(std::move(other.staged_indices))
+        , staged_scalars(std::move(other.staged_scalars))
+        , staged_lower_bounds(std::move(other.staged_lower_bounds))
+        , staged_upper_bounds(std::move(other.staged_upper_bounds))
+        , _modifications_batch_depth(other._modifications_batch_depth)
+        , _objective_changes(std::move(other._objective_changes))
+        , _lower_bound_changes(std::move(other._lower_bound_changes))
+        , _upper_bound_changes(std::move(other._upper_bound_changes))
+        , _rhs_changes(std::move(other._rhs_changes)) {
         other.model = nullptr;
     }
 
     constexpr highs_base & operator=(const highs_base &) = delete;
     constexpr highs_base & operator=(highs_base && other) = delete;
 
+protected:
+    // other on model_copy, a copy of its model : the handles of other stay
+    // valid, its batches are already flushed and no solution is copied
+    highs_base(const highs_base & other, void * model_copy)
+        : remapping_model_base<int, double>(other)
+        , Highs(other.Highs)
+        , model(model_copy)
+        , _constraints_batch_depth(0)
+        , _modifications_batch_depth(0) {
+        _invalidate_solution_caches();
+    }
+    // the options of model changed from their defaults, set on model_copy
+    void _copy_changed_options(void * model_copy) {
+        const HighsInt num_options = Highs->getNumOptions(model);
+        char value[kHighsMaximumStringLength];
+        char default_value[kHighsMaximumStringLength];
+        for(HighsInt i = 0; i < num_options; ++i) {
+            char * name_ptr = nullptr;
+            check(Highs->getOptionName(model, i, &name_ptr));
+            const std::unique_ptr<char, void (*)(void *)> name(name_ptr,
+                                                                &std::free);
+            HighsInt type;
+            check(Highs->getOptionType(model, name.get(), &type));
+            if(type == kHighsOptionTypeBool) {
+                HighsInt v, d;
+                check(Highs->getBoolOptionValue(model, name.get(), &v));
+                check(Highs->getBoolOptionValue(model_copy, name.get(), &d));
+                if(v != d)
+                    check(Highs->setBoolOptionValue(model_copy, name.get(), v));
+            } else if(type == kHighsOptionTypeInt) {
+                HighsInt v, d;
+                check(Highs->getIntOptionValue(model, name.get(), &v));
+                check(Highs->getIntOptionValue(model_copy, name.get(), &d));
+                if(v != d)
+                    check(Highs->setIntOptionValue(model_copy, name.get(), v));
+            } else if(type == kHighsOptionTypeDouble) {
+                double v, d;
+                check(Highs->getDoubleOptionValue(model, name.get(), &v));
+                check(Highs->getDoubleOptionValue(model_copy, name.get(), &d));
+                if(v != d)
+                    check(Highs->setDoubleOptionValue(model_copy, name.get(),
+                                                      v));
+            } else if(type == kHighsOptionTypeString) {
+                check(Highs->getStringOptionValue(model, name.get(), value));
+                check(Highs->getStringOptionValue(model_copy, name.get(),
+                                                  default_value));
+                if(std::strcmp(value, default_value) != 0)
+                    check(Highs->setStringOptionValue(model_copy, name.get(),
+                                                      value));
+            }
+        }
+    }
+    // HiGHS has no copy function : the model is read with one Highs_getModel
+    // call and passed to a new instance with one Highs_passModel call
+    highs_base _clone_base() {
+        _lazily_remove_variables();
+        _flush_modifications();
+        HighsInt num_col = Highs->getNumCol(model);
+        HighsInt num_row = Highs->getNumRow(model);
+        HighsInt num_nz = Highs->getNumNz(model);
+        HighsInt q_num_nz = Highs->getHessianNumNz(model);
+        const auto nc = static_cast<std::size_t>(num_col);
+        const auto nr = static_cast<std::size_t>(num_row);
+        std::vector<double> col_cost(nc), col_lower(nc), col_upper(nc);
+        std::vector<double> row_lower(nr), row_upper(nr);
+        std::vector<HighsInt> a_start(nc + 1);
+        std::vector<HighsInt> a_index(static_cast<std::size_t>(num_nz));
+        std::vector<double> a_value(static_cast<std::size_t>(num_nz));
+        std::vector<HighsInt> q_start(q_num_nz > 0 ? nc + 1 : 0);
+        std::vector<HighsInt> q_index(static_cast<std::size_t>(q_num_nz));
+        std::vector<double> q_value(static_cast<std::size_t>(q_num_nz));
+        std::vector<HighsInt> integrality(nc, kHighsVarTypeContinuous);
+        HighsInt sense;
+        double offset;
+        check(Highs->getModel(
+            model, kHighsMatrixFormatColwise, kHighsHessianFormatTriangular,
+            &num_col, &num_row, &num_nz, &q_num_nz, &sense, &offset,
+            col_cost.data(), col_lower.data(), col_upper.data(),
+            row_lower.data(), row_upper.data(), a_start.data(), a_index.data(),
+            a_value.data(), q_start.data(), q_index.data(), q_value.data(),
+            integrality.data()));
+
+        void * model_copy = Highs->create();
+        try {
+            check(Highs->passModel(
+                model_copy, num_col, num_row, num_nz, q_num_nz,
+                kHighsMatrixFormatColwise, kHighsHessianFormatTriangular,
+                sense, offset, col_cost.data(), col_lower.data(),
+                col_upper.data(), row_lower.data(), row_upper.data(),
+                a_start.data(), a_index.data(), a_value.data(),
+                q_start.data(), q_index.data(), q_value.data(),
+                integrality.data()));
+            _copy_changed_options(model_copy);
+        } catch(...) {
+            Highs->destroy(model_copy);
+            throw;
+        }
+        return highs_base(*this, model_copy);
+    }
+
 public:
     std::size_t num_variables() {
         return _num_var_native_ids() - _var_handles_to_delete.size();
     }
     std::size_t num_constraints() {
-        return static_cast<std::size_t>(Highs->getNumRow(model));
+        _flush_staged_constraints();
+        return _num_native_constraints();
     }
     std::size_t num_entries() {
+        _flush_staged_constraints();
         return static_cast<std::size_t>(Highs->getNumNz(model));
     }
     ///////////////////////////////////////////////////////////////////////////
     //////////////////////////////// Objective ////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void set_maximization() {
+        _invalidate_solution_caches();
         check(Highs->changeObjectiveSense(model, kHighsObjSenseMaximize));
     }
     void set_minimization() {
+        _invalidate_solution_caches();
         check(Highs->changeObjectiveSense(model, kHighsObjSenseMinimize));
     }
 
+    // also reached by set_objective and add_objective
     void set_objective_offset(scalar offset) {
+        _invalidate_solution_caches();
         check(Highs->changeObjectiveOffset(model, offset));
     }
     template <linear_expression LE>
     void set_objective(LE && le) {
+        _objective_changes.clear();
         const auto num_vars = _num_var_native_ids();
         tmp_scalars.resize(num_vars);
         std::fill(tmp_scalars.begin(), tmp_scalars.end(), 0.0);
@@ -114,6 +262,7 @@ public:
 private:
     template <bool distinct, linear_expression LE>
     void _add_objective(LE && le) {
+        _flush_modifications();
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids());
         _reset_cache();
         _register_variables_entries<distinct>(le.linear_terms());
@@ -154,6 +303,7 @@ public:
         return offset;
     }
     auto get_objective() {
+        _flush_modifications();
         const auto num_vars = _num_var_native_ids();
         auto coefs = std::make_shared_for_overwrite<double[]>(num_vars);
         int dummy_int;
@@ -184,6 +334,7 @@ protected:
 
     void _lazily_remove_variables() {
         if(_var_handles_to_delete.empty()) return;
+        _flush_modifications();
         tmp_indices.resize(0);
         for(const variable & var : _var_handles_to_delete)
             tmp_indices.emplace_back(_native_id(var));
@@ -192,6 +343,7 @@ protected:
         const std::size_t old_num_native_ids = _num_var_native_ids();
         check(Highs->deleteColsBySet(
             model, static_cast<int>(tmp_indices.size()), tmp_indices.data()));
+        _invalidate_solution_caches();
 
         const std::size_t new_num_native_ids =
             old_num_native_ids - tmp_indices.size();
@@ -237,6 +389,7 @@ protected:
 
 protected:
     variable _add_variable(const variable_params & params, int type) {
+        _invalidate_solution_caches();
         HighsInt var_id = _new_var_native_id();
         check(Highs->addCol(
             model, params.obj_coef,
@@ -249,6 +402,7 @@ protected:
     }
     std::size_t _add_variables(std::size_t count,
                                const variable_params & params, int type) {
+        _invalidate_solution_caches();
         if(_remap_ids) _extend_handle_ids_map(count);
         const std::size_t offset = _num_var_native_ids();
         const std::size_t handle_ids_begin =
@@ -329,6 +483,8 @@ public:
 private:
     template <typename ER>
     inline variable _add_column(ER && entries, const variable_params & params) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
         const int var_id = _new_var_native_id();
         _reset_cache();
         _register_constraints_entries<true>(entries);
@@ -370,17 +526,37 @@ public:
 
 protected:
     void _set_variable_bounds(variable v, scalar lb, scalar ub) {
+        if(_modifications_batch_depth > 0) {
+            _lower_bound_changes.insert_or_assign(_native_id(v), lb);
+            _upper_bound_changes.insert_or_assign(_native_id(v), ub);
+            return;
+        }
         check(Highs->changeColBounds(model, _native_id(v), lb, ub));
     }
 
 public:
     void set_objective_coefficient(variable v, scalar c) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _objective_changes.insert_or_assign(_native_id(v), c);
+            return;
+        }
         check(Highs->changeColCost(model, _native_id(v), c));
     }
     void set_variable_lower_bound(variable v, scalar lb) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _lower_bound_changes.insert_or_assign(_native_id(v), lb);
+            return;
+        }
         _set_variable_bounds(v, lb, get_variable_upper_bound(v));
     }
     void set_variable_upper_bound(variable v, scalar ub) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _upper_bound_changes.insert_or_assign(_native_id(v), ub);
+            return;
+        }
         _set_variable_bounds(v, get_variable_lower_bound(v), ub);
     }
     void set_variable_name(variable v, const std::string & name) {
@@ -391,6 +567,7 @@ public:
         scalar coef;
         index dummy_int;
         scalar dummy_dbl;
+        _flush_modifications();
         const int native_id = _native_id(v);
         check(Highs->getColsByRange(model, native_id, native_id, &dummy_int,
                                     &coef, &dummy_dbl, &dummy_dbl, &dummy_int,
@@ -401,6 +578,7 @@ public:
         scalar lb;
         int dummy_int;
         double dummy_dbl;
+        _flush_modifications();
         const int native_id = _native_id(v);
         check(Highs->getColsByRange(model, native_id, native_id, &dummy_int,
                                     &dummy_dbl, &lb, &dummy_dbl, &dummy_int,
@@ -411,6 +589,7 @@ public:
         scalar ub;
         int dummy_int;
         double dummy_dbl;
+        _flush_modifications();
         const int native_id = _native_id(v);
         check(Highs->getColsByRange(model, native_id, native_id, &dummy_int,
                                     &dummy_dbl, &dummy_dbl, &ub, &dummy_int,
@@ -427,21 +606,157 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     /////////////////////////////// Constraints ///////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
+protected:
+    std::size_t _num_native_constraints() {
+        return static_cast<std::size_t>(Highs->getNumRow(model));
+    }
+
+    void _begin_constraints_batch() { ++_constraints_batch_depth; }
+    void _end_constraints_batch() {
+        if(--_constraints_batch_depth == 0) _flush_staged_constraints();
+    }
+    void _discard_constraints_batch() {
+        if(--_constraints_batch_depth == 0) _clear_staged_constraints();
+    }
+    void _clear_staged_constraints() {
+        staged_begins.resize(0);
+        staged_indices.resize(0);
+        staged_scalars.resize(0);
+        staged_lower_bounds.resize(0);
+        staged_upper_bounds.resize(0);
+    }
+    void _flush_staged_constraints() {
+        if(staged_begins.empty()) return;
+        const int status = Highs->addRows(
+            model, static_cast<HighsInt>(staged_begins.size()),
+            staged_lower_bounds.data(), staged_upper_bounds.data(),
+            static_cast<HighsInt>(staged_indices.size()), staged_begins.data(),
+            staged_indices.data(), staged_scalars.data());
+        _clear_staged_constraints();
+        check(status);
+    }
+
+    void _begin_modifications_batch() { ++_modifications_batch_depth; }
+    void _end_modifications_batch() {
+        if(--_modifications_batch_depth == 0) _flush_modifications();
+    }
+    void _discard_modifications_batch() {
+        if(--_modifications_batch_depth > 0) return;
+        _objective_changes.clear();
+        _lower_bound_changes.clear();
+        _upper_bound_changes.clear();
+        _rhs_changes.clear();
+    }
+    // the BySet functions of HiGHS expect increasing indices
+    void _load_sorted_changes(unordered_dense_map<index, scalar> & changes) {
+        tmp_indices.resize(0);
+        tmp_scalars.resize(0);
+        for(auto && [native_id, value] : changes.values()) {
+            tmp_indices.emplace_back(native_id);
+            tmp_scalars.emplace_back(value);
+        }
+        changes.clear();
+        std::ranges::sort(std::views::zip(tmp_indices, tmp_scalars),
+                          [](const auto & e1, const auto & e2) {
+                              return std::get<0>(e1) < std::get<0>(e2);
+                          });
+    }
+    void _flush_objective_changes() {
+        if(_objective_changes.empty()) return;
+        _load_sorted_changes(_objective_changes);
+        check(Highs->changeColsCostBySet(
+            model, static_cast<HighsInt>(tmp_indices.size()),
+            tmp_indices.data(), tmp_scalars.data()));
+    }
+    // a column whose lower or upper bound alone changed keeps its other bound
+    void _flush_bounds_changes() {
+        if(_lower_bound_changes.empty() && _upper_bound_changes.empty())
+            return;
+        tmp_indices.resize(0);
+        for(auto && [native_id, lb] : _lower_bound_changes.values())
+            tmp_indices.emplace_back(native_id);
+        for(auto && [native_id, ub] : _upper_bound_changes.values())
+            if(!_lower_bound_changes.contains(native_id))
+                tmp_indices.emplace_back(native_id);
+        std::ranges::sort(tmp_indices);
+        const std::size_t num_columns = tmp_indices.size();
+        tmp_lower_bounds.resize(num_columns);
+        tmp_upper_bounds.resize(num_columns);
+        int dummy_int;
+        check(Highs->getColsBySet(
+            model, static_cast<HighsInt>(num_columns), tmp_indices.data(),
+            &dummy_int, nullptr, tmp_lower_bounds.data(),
+            tmp_upper_bounds.data(), &dummy_int, nullptr, nullptr, nullptr));
+        for(std::size_t i = 0; i < num_columns; ++i) {
+            if(auto it = _lower_bound_changes.find(tmp_indices[i]);
+               it != _lower_bound_changes.end())
+                tmp_lower_bounds[i] = it->second;
+            if(auto it = _upper_bound_changes.find(tmp_indices[i]);
+               it != _upper_bound_changes.end())
+                tmp_upper_bounds[i] = it->second;
+        }
+        _lower_bound_changes.clear();
+        _upper_bound_changes.clear();
+        check(Highs->changeColsBoundsBySet(
+            model, static_cast<HighsInt>(num_columns), tmp_indices.data(),
+            tmp_lower_bounds.data(), tmp_upper_bounds.data()));
+    }
+    // HiGHS stores rows as bounds : the rhs goes to the side given by the
+    // current sense of the row
+    void _flush_rhs_changes() {
+        if(_rhs_changes.empty()) return;
+        _load_sorted_changes(_rhs_changes);
+        const std::size_t num_rows = tmp_indices.size();
+        tmp_lower_bounds.resize(num_rows);
+        tmp_upper_bounds.resize(num_rows);
+        int dummy_int;
+        check(Highs->getRowsBySet(
+            model, static_cast<HighsInt>(num_rows), tmp_indices.data(),
+            &dummy_int, tmp_lower_bounds.data(), tmp_upper_bounds.data(),
+            &dummy_int, nullptr, nullptr, nullptr));
+        for(std::size_t i = 0; i < num_rows; ++i)
+            _set_row_rhs(tmp_lower_bounds[i], tmp_upper_bounds[i],
+                         tmp_scalars[i]);
+        check(Highs->changeRowsBoundsBySet(
+            model, static_cast<HighsInt>(num_rows), tmp_indices.data(),
+            tmp_lower_bounds.data(), tmp_upper_bounds.data()));
+    }
+    // rhs changes may target staged rows, which are flushed first
+    void _flush_modifications() {
+        _flush_staged_constraints();
+        _flush_objective_changes();
+        _flush_bounds_changes();
+        _flush_rhs_changes();
+    }
+
 private:
     template <bool distinct, linear_constraint LC>
     constraint _add_constraint(LC && lc) {
-        const HighsInt constr_id = static_cast<HighsInt>(num_constraints());
+        _invalidate_solution_caches();
+        const HighsInt constr_id = static_cast<HighsInt>(
+            _num_native_constraints() + staged_begins.size());
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids());
         _reset_cache();
         _register_variables_entries<distinct>(lc.linear_terms());
         const scalar b = lc.rhs();
-        check(Highs->addRow(model,
-                            (lc.sense() == constraint_sense::less_equal)
-                                ? -Highs->getInfinity(model)
-                                : b,
-                            (lc.sense() == constraint_sense::greater_equal)
-                                ? Highs->getInfinity(model)
-                                : b,
+        const scalar lower = (lc.sense() == constraint_sense::less_equal)
+                                 ? -Highs->getInfinity(model)
+                                 : b;
+        const scalar upper = (lc.sense() == constraint_sense::greater_equal)
+                                 ? Highs->getInfinity(model)
+                                 : b;
+        if(_constraints_batch_depth > 0) {
+            staged_begins.emplace_back(
+                static_cast<HighsInt>(staged_indices.size()));
+            staged_indices.insert(staged_indices.end(), tmp_indices.cbegin(),
+                                  tmp_indices.cend());
+            staged_scalars.insert(staged_scalars.end(), tmp_scalars.cbegin(),
+                                  tmp_scalars.cend());
+            staged_lower_bounds.emplace_back(lower);
+            staged_upper_bounds.emplace_back(upper);
+            return constraint(constr_id);
+        }
+        check(Highs->addRow(model, lower, upper,
                             static_cast<HighsInt>(tmp_indices.size()),
                             tmp_indices.data(), tmp_scalars.data()));
         return constraint(constr_id);
@@ -456,6 +771,10 @@ public:
     constraint add_constraint(distinct_variables_t, LC && lc) {
         return _add_constraint<true>(std::forward<LC>(lc));
     }
+    [[nodiscard]] auto batch_constraints() { return constraints_batch(*this); }
+    [[nodiscard]] auto batch_modifications() {
+        return modifications_batch(*this);
+    }
 
 private:
     template <bool distinct, linear_constraint LC>
@@ -495,6 +814,8 @@ private:
     }
     template <bool distinct, std::ranges::range IR, typename... CL>
     auto _add_constraints(IR && keys, CL &... constraint_lambdas) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
         if constexpr(!distinct) _prepare_coalescing(_num_var_native_ids());
         _reset_cache();
         tmp_begins.resize(0);
@@ -531,8 +852,60 @@ public:
                                       constraint_lambdas...);
     }
 
+private:
+    template <bool distinct, std::ranges::random_access_range IR,
+              typename... CL>
+    auto _add_constraints_parallel(IR && keys, CL &... constraint_lambdas) {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
+        const HighsInt offset =
+            static_cast<HighsInt>(_num_native_constraints());
+        auto rows = detail::build_rows_in_parallel<distinct, index, scalar>(
+            keys, _num_var_native_ids(),
+            [this](const variable & v) { return _native_id(v); },
+            constraint_lambdas...);
+        const std::size_t num_rows = rows.num_rows();
+        tmp_lower_bounds.resize(num_rows);
+        tmp_upper_bounds.resize(num_rows);
+        const scalar inf = Highs->getInfinity(model);
+        for(std::size_t i = 0; i < num_rows; ++i) {
+            const scalar b = rows.rhs[i];
+            tmp_lower_bounds[i] =
+                (rows.senses[i] == constraint_sense::less_equal) ? -inf : b;
+            tmp_upper_bounds[i] =
+                (rows.senses[i] == constraint_sense::greater_equal) ? inf : b;
+        }
+        check(Highs->addRows(model, static_cast<HighsInt>(num_rows),
+                             tmp_lower_bounds.data(), tmp_upper_bounds.data(),
+                             static_cast<HighsInt>(rows.indices.size()),
+                             rows.begins.data(), rows.indices.data(),
+                             rows.scalars.data()));
+        return constraints_range(
+            std::forward<IR>(keys),
+            std::views::transform(
+                std::views::iota(offset,
+                                 offset + static_cast<HighsInt>(num_rows)),
+                [](auto && i) { return constraint{i}; }));
+    }
+
+public:
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<false>(std::forward<IR>(keys),
+                                                constraint_lambdas...);
+    }
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &,
+                         distinct_variables_t, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<true>(std::forward<IR>(keys),
+                                               constraint_lambdas...);
+    }
+
 private:
     std::pair<double, double> _row_bounds(const constraint & constr) {
+        _flush_modifications();
         double lower, upper;
         int dummy_int;
         check(Highs->getRowsByRange(model, constr.id(), constr.id(), &dummy_int,
@@ -541,6 +914,7 @@ private:
         return std::make_pair(lower, upper);
     }
     auto _row_lhs_bounds(const constraint & constr) {
+        _flush_modifications();
         int dummy_int, num_nz;
         check(Highs->getRowsByRange(model, constr.id(), constr.id(), &dummy_int,
                                     nullptr, nullptr, &num_nz, nullptr, nullptr,
@@ -574,9 +948,7 @@ private:
         return constraint_sense::greater_equal;
     }
 
-public:
-    void set_constraint_rhs(constraint constr, double rhs) {
-        auto [lower, upper] = _row_bounds(constr);
+    void _set_row_rhs(double & lower, double & upper, const double rhs) {
         switch(_bounds_to_constraint_sense(lower, upper)) {
             case constraint_sense::equal:
                 lower = upper = rhs;
@@ -588,9 +960,21 @@ public:
                 lower = rhs;
                 break;
         }
+    }
+
+public:
+    void set_constraint_rhs(constraint constr, double rhs) {
+        _invalidate_solution_caches();
+        if(_modifications_batch_depth > 0) {
+            _rhs_changes.insert_or_assign(constr.id(), rhs);
+            return;
+        }
+        auto [lower, upper] = _row_bounds(constr);
+        _set_row_rhs(lower, upper, rhs);
         check(Highs->changeRowBounds(model, constr.id(), lower, upper));
     }
     void set_constraint_sense(constraint constr, constraint_sense new_sense) {
+        _invalidate_solution_caches();
         auto [lower, upper] = _row_bounds(constr);
         constraint_sense old_sense = _bounds_to_constraint_sense(lower, upper);
         if(old_sense == new_sense) return;
@@ -611,6 +995,7 @@ public:
         check(Highs->changeRowBounds(model, constr.id(), lower, upper));
     }
     void set_constraint_name(constraint constr, std::string name) {
+        _flush_staged_constraints();
         check(Highs->passRowName(model, constr.id(), name.c_str()));
     }
 
@@ -635,10 +1020,175 @@ public:
     }
     auto get_constraint_name(constraint constr) {
         char name[kHighsMaximumStringLength];
+        _flush_staged_constraints();
         check(Highs->getRowName(model, constr.id(), name));
         return std::string(name);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    //////////////////////////////// Solution /////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+protected:
+    // Highs_getSolution has no by-set variant : the whole array is fetched
+    // once per solve and shared by the returned mappings. Any modification
+    // of the model invalidates it, as the number of columns alone does not
+    // tell a removal followed by an addition from no change.
+    template <typename Fetch>
+    detail::shared_values<double> _get_cached_variables_values(
+        detail::solution_cache<double> & cache, Fetch && fetch) {
+        return cache.get(_num_var_native_ids(), std::forward<Fetch>(fetch));
+    }
+    auto _make_variables_values_mapping(detail::shared_values<double> values) {
+        return variable_mapping(
+            [this, values = std::move(values)](const variable & v) {
+                return values[static_cast<std::size_t>(_native_id(v))];
+            });
+    }
+    template <std::ranges::range VR>
+    std::vector<double> _gather_variables_values(
+        const detail::shared_values<double> & values, VR && vars) {
+        return _gather_values(vars, values.data(), [this](const variable & v) {
+            return _native_id(v);
+        });
+    }
+    auto _get_cached_solution() {
+        return _get_cached_variables_values(
+            _solution_cache, [this](double * solution) {
+                check(Highs->getSolution(model, solution, nullptr, nullptr,
+                                         nullptr));
+            });
+    }
+    auto _get_cached_dual_solution() {
+        auto num_constrs = num_constraints();
+        return _dual_solution_cache.get(num_constrs, [this](double * solution) {
+            check(Highs->getSolution(model, nullptr, nullptr, nullptr,
+                                     solution));
+        });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////// Basis //////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+public:
+    using basis = model_lp_basis<variable, constraint>;
+
+private:
+    static basis::code _basis_code(const HighsInt status) {
+        switch(status) {
+            case kHighsBasisStatusBasic:
+                return basis::code::basic;
+            case kHighsBasisStatusUpper:
+                return basis::code::nonbasic_at_upper_bound;
+            case kHighsBasisStatusZero:
+                return basis::code::nonbasic_free;
+            default:
+                return basis::code::nonbasic_at_lower_bound;
+        }
+    }
+    static HighsInt _basis_status(const basis::code code) {
+        switch(code) {
+            case basis::code::basic:
+                return kHighsBasisStatusBasic;
+            case basis::code::nonbasic_free:
+                return kHighsBasisStatusZero;
+            case basis::code::nonbasic_at_upper_bound:
+                return kHighsBasisStatusUpper;
+            default:
+                return kHighsBasisStatusLower;
+        }
+    }
+    std::size_t _num_var_handle_ids() {
+        return _remap_ids ? _native_ids_map.size() : _num_var_native_ids();
+    }
+    auto _var_handle_id_of() {
+        return [this](std::size_t i) {
+            return _var_handle(static_cast<int>(i)).uid();
+        };
+    }
+
+public:
+    // the basis of the last solve, read with one Highs_getBasis call ;
+    // without one, the slack basis
+    basis get_basis() {
+        _lazily_remove_variables();
+        _flush_modifications();
+        std::vector<HighsInt> col_status(_num_var_native_ids(),
+                                         kHighsBasisStatusLower);
+        std::vector<HighsInt> row_status(_num_native_constraints(),
+                                         kHighsBasisStatusBasic);
+        check(Highs->getBasis(model, col_status.data(), row_status.data()));
+        return basis::from_native(col_status, row_status,
+                                  _num_var_handle_ids(), _var_handle_id_of(),
+                                  _basis_code, _basis_code);
+    }
+    // warm starts the next solve from b, loaded with one Highs_setBasis call
+    void set_basis(const basis & b) {
+        _lazily_remove_variables();
+        _flush_modifications();
+        std::vector<HighsInt> col_status(_num_var_native_ids());
+        std::vector<HighsInt> row_status(_num_native_constraints());
+        b.to_native(col_status, row_status, _var_handle_id_of(),
+                    _basis_status, _basis_status);
+        check(Highs->setBasis(model, col_status.data(), row_status.data()));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////// Solution hint ///////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+private:
+    template <typename PM>
+    void _register_primal_hint(const PM & primal) {
+        const std::size_t num_cols = _num_var_native_ids();
+        tmp_scalars.resize(num_cols);
+        for(std::size_t i = 0; i < num_cols; ++i)
+            tmp_scalars[i] = static_cast<double>(
+                primal[_var_handle(static_cast<int>(i))]);
+    }
+
+public:
+    // Hands a full solution to HiGHS, e.g. the mappings returned by
+    // get_solution() and get_dual_solution() on a model of the same shape,
+    // read through the handles so that removed variables do not shift it.
+    // The next solve starts from it, with one Highs_setSolution call.
+    template <typename PM>
+        requires requires(const PM & primal, variable v) {
+            { primal[v] } -> std::convertible_to<double>;
+        }
+    void set_solution_hint(const PM & primal) {
+        _lazily_remove_variables();
+        _flush_modifications();
+        _register_primal_hint(primal);
+        check(Highs->setSolution(model, tmp_scalars.data(), nullptr, nullptr,
+                                 nullptr));
+    }
+    template <typename PM, typename DM>
+        requires requires(const PM & primal, const DM & dual, variable v,
+                          constraint c) {
+            { primal[v] } -> std::convertible_to<double>;
+            { dual[c] } -> std::convertible_to<double>;
+        }
+    void set_solution_hint(const PM & primal, const DM & dual) {
+        _lazily_remove_variables();
+        _flush_modifications();
+        _register_primal_hint(primal);
+        const std::size_t num_rows = _num_native_constraints();
+        std::vector<double> row_dual(num_rows);
+        for(std::size_t j = 0; j < num_rows; ++j)
+            row_dual[j] = static_cast<double>(
+                dual[constraint(static_cast<int>(j))]);
+        check(Highs->setSolution(model, tmp_scalars.data(), nullptr, nullptr,
+                                 row_dual.data()));
+    }
+
+public:
+    // the simplex iterations of the last solve, none when a solution hint
+    // already gave an optimal basis
+    std::size_t get_simplex_iteration_count() {
+        HighsInt n;
+        check(Highs->getIntInfoValue(model, "simplex_iteration_count", &n));
+        return static_cast<std::size_t>(n);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////// Limits //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -650,6 +1200,10 @@ public:
         check(Highs->getDoubleOptionValue(model, "time_limit", &t));
         return std::chrono::duration<double>(t);
     }
+
+    // No set_thread_count : HiGHS runs the solves of a process on one global
+    // scheduler, sized by the threads option of the first solve, so a thread
+    // count per model would not be honored.
 };
 
 }  // namespace highs::v1_10
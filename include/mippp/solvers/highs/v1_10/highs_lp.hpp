@@ -13,9 +13,15 @@ namespace mippp {
 namespace highs::v1_10 {
 
 class highs_lp : public highs_base {
+private:
+    explicit highs_lp(highs_base && base) : highs_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit highs_lp(const highs_api & api) : highs_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] highs_lp clone() { return highs_lp(_clone_base()); }
+
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////// Limits //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -79,6 +85,8 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_modifications();
+        _invalidate_solution_caches();
         if(num_variables() == 0u) {
             return;
         }
@@ -87,31 +95,22 @@ public:
     }
     double get_solution_value() { return Highs->getObjectiveValue(model); }
     auto get_solution() {
-        auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
-        check(Highs->getSolution(model, solution.get(), nullptr, nullptr,
-                                 nullptr));
-        return variable_mapping(
-            [this, solution = std::move(solution)](const variable & v) {
-                return *(solution.get() + _native_id(v));
-            });
+        return _make_variables_values_mapping(_get_cached_solution());
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _gather_variables_values(_get_cached_solution(), vars);
     }
     auto get_dual_solution() {
-        auto num_constrs = num_constraints();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_constrs);
-        check(Highs->getSolution(model, nullptr, nullptr, nullptr,
-                                 solution.get()));
-        return constraint_mapping(std::move(solution));
+        return constraint_mapping(_get_cached_dual_solution());
     }
     auto get_reduced_costs() {
-        auto num_vars = num_variables();
-        auto reduced_costs = std::make_unique_for_overwrite<double[]>(num_vars);
-        check(Highs->getSolution(model, nullptr, reduced_costs.get(), nullptr,
-                                 nullptr));
-        return variable_mapping([this, reduced_costs = std::move(
-                                           reduced_costs)](const variable & v) {
-            return *(reduced_costs.get() + _native_id(v));
-        });
+        return _make_variables_values_mapping(_get_cached_variables_values(
+            _reduced_costs_cache, [this](double * reduced_costs) {
+                check(Highs->getSolution(model, nullptr, reduced_costs,
+                                         nullptr, nullptr));
+            }));
     }
 };
 
@@ -15,10 +15,16 @@ namespace mippp {
 namespace highs::v1_10 {
 
 class highs_milp : public highs_base {
+private:
+    explicit highs_milp(highs_base && base) : highs_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit highs_milp(const highs_api & api)
         : highs_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] highs_milp clone() { return highs_milp(_clone_base()); }
+
     variable add_integer_variable(
         const variable_params params = default_variable_params) {
         return _add_variable(params, kHighsVarTypeInteger);
@@ -54,13 +60,16 @@ public:
             {.obj_coef = 0, .lower_bound = 0.0, .upper_bound = 1.0});
     }
     void set_continuous(variable v) noexcept {
+        _invalidate_solution_caches();
         check(Highs->changeColIntegrality(model, v.id(),
                                           kHighsVarTypeContinuous));
     }
     void set_integer(variable v) noexcept {
+        _invalidate_solution_caches();
         check(Highs->changeColIntegrality(model, v.id(), kHighsVarTypeInteger));
     }
     void set_binary(variable v) noexcept {
+        _invalidate_solution_caches();
         _set_variable_bounds(v, 0.0, 1.0);
         check(Highs->changeColIntegrality(model, v.id(), kHighsVarTypeInteger));
     }
@@ -145,6 +154,8 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_modifications();
+        _invalidate_solution_caches();
         if(num_variables() == 0u) {
             return;
         }
@@ -153,14 +164,12 @@ public:
     }
     double get_solution_value() { return Highs->getObjectiveValue(model); }
     auto get_solution() {
-        auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
-        check(Highs->getSolution(model, solution.get(), nullptr, nullptr,
-                                 nullptr));
-        return variable_mapping(
-            [this, solution = std::move(solution)](const variable & v) {
-                return *(solution.get() + _native_id(v));
-            });
+        return _make_variables_values_mapping(_get_cached_solution());
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _gather_variables_values(_get_cached_solution(), vars);
     }
 };
 
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <iostream>
-#include <map>
 #include <optional>
+#include <ranges>
 
+#include "mippp/detail/triangular_hessian.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
@@ -16,19 +17,16 @@ namespace mippp {
 namespace highs::v1_10 {
 
 class highs_qp : public highs_base {
+private:
+    detail::triangular_hessian<HighsInt, double> _hessian;
+
+    explicit highs_qp(highs_base && base) : highs_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit highs_qp(const highs_api & api) : highs_base(api) {}
 
-    struct variables_pair_cmp {
-        bool operator()(auto && p1, auto && p2) const {
-            auto [p1v1, p1v2] = p1;
-            if(p1v2 < p1v1) std::swap(p1v1, p1v2);
-            auto [p2v1, p2v2] = p2;
-            if(p2v2 < p2v1) std::swap(p2v1, p2v2);
-            if(p1v1 == p2v1) return p1v2 < p2v2;
-            return p1v1 < p2v1;
-        }
-    };
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] highs_qp clone() { return highs_qp(_clone_base()); }
 
     template <linear_expression LE>
     void set_objective(LE && le) {
@@ -46,38 +44,35 @@ public:
     void set_objective(distinct_variables_t, LE && le) {
         set_objective(std::forward<LE>(le));
     }
-    template <quadratic_expression QE>
-    void set_objective(QE && qe) {
-        const auto num_vars = num_variables();
+
+private:
+    template <bool distinct, quadratic_expression QE>
+    void _set_quadratic_objective(QE && qe) {
+        const auto num_vars = _num_var_native_ids();
         set_objective(qe.linear_part());
-        std::map<std::pair<variable, variable>, scalar, variables_pair_cmp>
-            factorized_terms;
-        for(auto && [var1, var2, coef] : qe.quadratic_terms()) {
-            factorized_terms[std::make_pair(var1, var2)] += coef;
-        }
-        tmp_begins.resize(num_vars);
-        tmp_indices.resize(0u);
-        tmp_scalars.resize(0u);
-        HighsInt next_row = 0;
-        for(auto && [vars_pair, coef] : factorized_terms) {
-            auto && [var1, var2] = vars_pair;
-            while(next_row <= _native_id(var1))
-                tmp_begins[static_cast<std::size_t>(next_row++)] =
-                    static_cast<HighsInt>(tmp_scalars.size());
-            tmp_indices.emplace_back(_native_id(var2));
-            tmp_scalars.emplace_back(2 * coef);
-        }
-        while(next_row < static_cast<int>(num_vars))
-            tmp_begins[static_cast<std::size_t>(next_row++)] =
-                static_cast<HighsInt>(tmp_scalars.size());
+        _hessian.clear();
+        auto && terms = qe.quadratic_terms();
+        if constexpr(std::ranges::sized_range<decltype(terms)>)
+            _hessian.reserve(
+                static_cast<std::size_t>(std::ranges::size(terms)));
+        for(auto && [var1, var2, coef] : terms)
+            _hessian.add_term(_native_id(var1), _native_id(var2), coef);
+        _hessian.template build<distinct>(num_vars);
         check(Highs->passHessian(
-            model, static_cast<int>(num_vars),
-            static_cast<int>(tmp_scalars.size()), kHighsHessianFormatTriangular,
-            tmp_begins.data(), tmp_indices.data(), tmp_scalars.data()));
+            model, static_cast<HighsInt>(num_vars),
+            static_cast<HighsInt>(_hessian.num_entries()),
+            kHighsHessianFormatTriangular, _hessian.begins().data(),
+            _hessian.indices().data(), _hessian.values().data()));
+    }
+
+public:
+    template <quadratic_expression QE>
+    void set_objective(QE && qe) {
+        _set_quadratic_objective<false>(std::forward<QE>(qe));
     }
     template <quadratic_expression QE>
     void set_objective(distinct_variables_t, QE && qe) {
-        set_objective(std::forward<QE>(qe));
+        _set_quadratic_objective<true>(std::forward<QE>(qe));
     }
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////// Limits //////////////////////////////////
@@ -141,6 +136,8 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_modifications();
+        _invalidate_solution_caches();
         if(num_variables() == 0u) {
             return;
         }
@@ -149,21 +146,15 @@ public:
     }
     double get_solution_value() { return Highs->getObjectiveValue(model); }
     auto get_solution() {
-        auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
-        check(Highs->getSolution(model, solution.get(), nullptr, nullptr,
-                                 nullptr));
-        return variable_mapping(
-            [this, solution = std::move(solution)](const variable & v) {
-                return *(solution.get() + _native_id(v));
-            });
+        return _make_variables_values_mapping(_get_cached_solution());
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _gather_variables_values(_get_cached_solution(), vars);
     }
     auto get_dual_solution() {
-        auto num_constrs = num_constraints();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_constrs);
-        check(Highs->getSolution(model, nullptr, nullptr, nullptr,
-                                 solution.get()));
-        return constraint_mapping(std::move(solution));
+        return constraint_mapping(_get_cached_dual_solution());
     }
 };
 
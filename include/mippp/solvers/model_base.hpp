@@ -4,6 +4,8 @@
 #include <ranges>
 #include <vector>
 
+#include "mippp/detail/coalescing.hpp"
+#include "mippp/detail/solution_cache.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
@@ -31,8 +33,16 @@ protected:
     std::vector<_Index> tmp_indices;
     std::vector<_Scalar> tmp_scalars;
     unsigned int register_count;
+    std::vector<unsigned int> tmp_coalescing_table;
+    std::size_t _coalescing_ids_end;
 
-    [[nodiscard]] explicit model_base() : register_count(0) {}
+    // filled on the first read after each solve, see solution_cache
+    detail::solution_cache<_Scalar> _solution_cache;
+    detail::solution_cache<_Scalar> _dual_solution_cache;
+    detail::solution_cache<_Scalar> _reduced_costs_cache;
+
+    [[nodiscard]] explicit model_base()
+        : register_count(0), _coalescing_ids_end(0) {}
 
     constexpr model_base(const model_base &) = default;
     constexpr model_base(model_base &&) = default;
@@ -102,14 +112,34 @@ protected:
     };
 
     // ids_end = max_id + 1 ; for contiguous ids (ids_end = num_ids)
+    // the dense cache is only grown by rows long enough to need it
     void _prepare_coalescing(const std::size_t ids_end) {
-        tmp_entry_index_cache.resize(ids_end);
+        _coalescing_ids_end = ids_end;
     }
     void _reset_cache() {
         tmp_indices.resize(0);
         tmp_scalars.resize(0);
     }
 
+    void _invalidate_solution_caches() noexcept {
+        _solution_cache.invalidate();
+        _dual_solution_cache.invalidate();
+        _reduced_costs_cache.invalidate();
+    }
+    // values[proj(e)] of each entity e of the range, in the range order
+    template <std::ranges::range ER, typename IdProj = EntityId>
+    static std::vector<_Scalar> _gather_values(ER && entities,
+                                               const _Scalar * values,
+                                               IdProj proj = {}) {
+        std::vector<_Scalar> gathered;
+        if constexpr(std::ranges::sized_range<ER>)
+            gathered.reserve(std::ranges::size(entities));
+        for(auto && e : entities)
+            gathered.emplace_back(
+                values[static_cast<std::ptrdiff_t>(proj(e))]);
+        return gathered;
+    }
+
     template <std::ranges::range Entries, typename IdProj = EntityId>
         requires linear_term<std::ranges::range_value_t<Entries>> &&
                  std::is_invocable_r_v<_Index, IdProj,
@@ -127,6 +157,14 @@ protected:
                                        linear_term_variable_t<
                                            std::ranges::range_value_t<Entries>>>
     void _register_coalescing_entries(Entries && entries, IdProj proj = {}) {
+        if(tmp_entry_index_cache.size() < _coalescing_ids_end) {
+            const std::size_t first = tmp_indices.size();
+            _register_raw_entries(std::forward<Entries>(entries), proj);
+            detail::coalesce_entries(tmp_entry_index_cache, register_count,
+                                     tmp_coalescing_table, tmp_indices,
+                                     tmp_scalars, first, _coalescing_ids_end);
+            return;
+        }
         ++register_count;
         for(auto && [entity, coef] : entries) {
             const _Index entity_id = proj(entity);
@@ -136,7 +174,8 @@ protected:
                 tmp_scalars[p.second] += static_cast<_Scalar>(coef);
                 continue;
             }
-            p = std::make_pair(register_count, tmp_indices.size());
+            p = std::make_pair(register_count,
+                               static_cast<unsigned int>(tmp_indices.size()));
             tmp_indices.emplace_back(entity_id);
             tmp_scalars.emplace_back(coef);
         }
@@ -167,6 +206,17 @@ protected:
             _register_coalescing_entries(std::forward<Entries>(entries));
         }
     }
+
+public:
+    // Releases the scratch buffers used to register rows and columns, among
+    // which the dense coalescing cache of one pair per variable. They are
+    // reallocated on demand by the next insertions.
+    void shrink_scratch_buffers() {
+        tmp_entry_index_cache = {};
+        tmp_coalescing_table = {};
+        tmp_indices = {};
+        tmp_scalars = {};
+    }
 };
 
 }  // namespace mippp
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <exception>
+#include <utility>
+
+namespace mippp {
+
+// Scope returned by model.batch_modifications() : while it is alive,
+// set_objective_coefficient, set_variable_lower_bound,
+// set_variable_upper_bound and set_constraint_rhs record the new values on
+// the mippp side, keeping only the last value written for each variable or
+// constraint. The recorded values are sent to the solver with one array call
+// per attribute when the scope ends, when commit() is called, or earlier if
+// an operation needs to see them (reading an attribute, solve, ...). If the
+// scope is left by an exception, the values still recorded are discarded.
+template <typename Model>
+class modifications_batch {
+private:
+    Model * _model;
+    int _uncaught_exceptions;
+
+public:
+    [[nodiscard]] explicit modifications_batch(Model & model)
+        : _model(&model), _uncaught_exceptions(std::uncaught_exceptions()) {
+        _model->_begin_modifications_batch();
+    }
+    ~modifications_batch() noexcept(false) {
+        if(_model == nullptr) return;
+        if(std::uncaught_exceptions() > _uncaught_exceptions) {
+            _model->_discard_modifications_batch();
+            return;
+        }
+        _model->_end_modifications_batch();
+    }
+
+    modifications_batch(const modifications_batch &) = delete;
+    modifications_batch(modifications_batch && other) noexcept
+        : _model(std::exchange(other._model, nullptr))
+        , _uncaught_exceptions(other._uncaught_exceptions) {}
+
+    modifications_batch & operator=(const modifications_batch &) = delete;
+    modifications_batch & operator=(modifications_batch &&) = delete;
+
+    void commit() {
+        if(_model == nullptr) return;
+        std::exchange(_model, nullptr)->_end_modifications_batch();
+    }
+};
+
+}  // namespace mippp
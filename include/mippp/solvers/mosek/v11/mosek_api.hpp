@@ -35,6 +35,7 @@ enum MSKproblemtypee : int {
 };
 MSKrescodee MSK_getprobtype(MSKtask_t task, MSKproblemtypee * probtype);
 MSKrescodee MSK_deletetask(MSKtask_t * task);
+MSKrescodee MSK_clonetask(MSKtask_t task, MSKtask_t * clonedtask);
 MSKrescodee MSK_deleteenv(MSKenv_t * env);
 MSKrescodee MSK_getcodedesc(MSKrescodee code, char * symname, char * str);
 enum MSKstreamtypee : int {
@@ -127,7 +128,10 @@ MSKrescodee MSK_getnumvar(MSKtask_t task, MSKint32t * numvar);
 MSKrescodee MSK_getnumcon(MSKtask_t task, MSKint32t * numcon);
 MSKrescodee MSK_getnumanz(MSKtask_t task, MSKint32t * numanz);
 
-enum MSKiparame : int { MSK_IPAR_OPTIMIZER = 110 };
+enum MSKiparame : int {
+    MSK_IPAR_NUM_THREADS = 100,
+    MSK_IPAR_OPTIMIZER = 110
+};
 enum MSKoptimizertypee : int {
     MSK_OPTIMIZER_CONIC = 0,
     MSK_OPTIMIZER_DUAL_SIMPLEX = 1,
@@ -193,6 +197,8 @@ MSKrescodee MSK_putxxslice(MSKtask_t task, MSKsoltypee whichsol,
                            MSKint32t first, MSKint32t last,
                            const MSKrealt * xx);
 MSKrescodee MSK_getxx(MSKtask_t task, MSKsoltypee whichsol, MSKrealt * xx);
+MSKrescodee MSK_getxxslice(MSKtask_t task, MSKsoltypee whichsol,
+                           MSKint32t first, MSKint32t last, MSKrealt * xx);
 enum MSKstakeye : int {
     MSK_SK_UNK = 0,
     MSK_SK_BAS = 1,
@@ -354,6 +360,8 @@ MSKrescodee MSK_putcallbackfunc(MSKtask_t task, MSKcallbackfunc func,
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -367,6 +375,7 @@ namespace mosek::v11 {
     F(MSK_makeemptytask, makeemptytask)                 \
     F(MSK_getprobtype, getprobtype)                     \
     F(MSK_deletetask, deletetask)                       \
+    F(MSK_clonetask, clonetask)                         \
     F(MSK_deleteenv, deleteenv)                         \
     F(MSK_getcodedesc, getcodedesc)                     \
     F(MSK_linkfunctotaskstream, linkfunctotaskstream)   \
@@ -417,6 +426,7 @@ namespace mosek::v11 {
     F(MSK_putxx, putxx)                                 \
     F(MSK_putxxslice, putxxslice)                       \
     F(MSK_getxx, getxx)                                 \
+    F(MSK_getxxslice, getxxslice)                       \
     F(MSK_solutiondef, solutiondef)                     \
     F(MSK_getsolsta, getsolsta)                         \
     F(MSK_getsolution, getsolution)                     \
@@ -425,13 +435,13 @@ namespace mosek::v11 {
 
 #define DECLARE_MOSEK_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);    \
-    SHORT##_fun_t const * SHORT;
+    detail::solver_function<SHORT##_fun_t> SHORT;
 #define CONSTRUCT_MOSEK_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<SHORT##_fun_t>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 
 class mosek_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
 public:
     MOSEK_FUNCTIONS(DECLARE_MOSEK_FUNCTIONS)
@@ -5,6 +5,7 @@
 #include <numeric>
 #include <optional>
 #include <ranges>
+#include <type_traits>
 #include <vector>
 
 #include "mippp/linear_constraint.hpp"
@@ -40,6 +41,8 @@ public:
 protected:
     const mosek_api * MSK;
     MSKenv_t env;
+    // the clones of a model share its environment, deleted with the last
+    std::shared_ptr<std::remove_pointer_t<MSKenv_t>> _env_owner;
     MSKtask_t task;
 
     std::vector<indice> tmp_begins;
@@ -67,11 +70,12 @@ public:
         const auto env_path_str =
             (std::filesystem::temp_directory_path() / "mosek_").string();
         check(MSK->makeenv(&env, env_path_str.c_str()));
+        _env_owner = std::shared_ptr<std::remove_pointer_t<MSKenv_t>>(
+            env, [api = MSK](MSKenv_t e) { api->deleteenv(&e); });
         check(MSK->makeemptytask(env, &task));
     }
     ~mosek_base() {
         if(task) check(MSK->deletetask(&task));
-        if(env) check(MSK->deleteenv(&env));
     }
 
     constexpr mosek_base(const mosek_base &) = delete;
@@ -79,6 +83,7 @@ public:
         : model_base<int, double>(std::move(other))
         , MSK(other.MSK)
         , env(other.env)
+        , _env_owner(std::move(other._env_owner))
         , task(other.task)
         , tmp_begins(std::move(other.tmp_begins))
         , tmp_boundkeye(std::move(other.tmp_boundkeye))
@@ -91,6 +96,24 @@ public:
     constexpr mosek_base & operator=(const mosek_base &) = delete;
     constexpr mosek_base & operator=(mosek_base && other) = delete;
 
+protected:
+    // other on task_copy, a copy of its task and parameters : the handles of
+    // other stay valid and no solution is copied
+    mosek_base(const mosek_base & other, MSKtask_t task_copy)
+        : model_base<int, double>(other)
+        , MSK(other.MSK)
+        , env(other.env)
+        , _env_owner(other._env_owner)
+        , task(task_copy) {
+        _invalidate_solution_caches();
+    }
+    mosek_base _clone_base() {
+        MSKtask_t task_copy = nullptr;
+        check(MSK->clonetask(task, &task_copy));
+        return mosek_base(*this, task_copy);
+    }
+
+public:
     std::size_t num_variables() {
         MSKint32t num;
         check(MSK->getnumvar(task, &num));
@@ -442,6 +465,48 @@ public:
         return _add_constraints<true>(std::forward<IR>(keys),
                                       constraint_lambdas...);
     }
+
+    // 0 lets MOSEK choose
+    void set_thread_count(std::size_t n) {
+        check(MSK->putintparam(task, MSK_IPAR_NUM_THREADS,
+                               static_cast<MSKint32t>(n)));
+    }
+    std::size_t get_thread_count() {
+        MSKint32t n;
+        check(MSK->getintparam(task, MSK_IPAR_NUM_THREADS, &n));
+        return static_cast<std::size_t>(n);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //////////////////////////////// Solution /////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+protected:
+    auto _get_cached_solution(MSKsoltypee whichsol) {
+        return _solution_cache.get(num_variables(), [&](double * solution) {
+            check(MSK->getxx(task, whichsol, solution));
+        });
+    }
+    // MSK_getxxslice reads a range of columns : only the span of the
+    // requested ones is fetched, unless the whole solution is cached
+    template <std::ranges::range VR>
+    std::vector<double> _get_solution_values(MSKsoltypee whichsol,
+                                             VR && vars) {
+        if(const double * x = _solution_cache.cached(num_variables()))
+            return _gather_values(vars, x);
+        tmp_indices.clear();
+        for(auto && v : vars) tmp_indices.emplace_back(v.id());
+        if(tmp_indices.empty()) return {};
+        const auto [min_id, max_id] = std::ranges::minmax(tmp_indices);
+        tmp_scalars.resize(static_cast<std::size_t>(max_id - min_id + 1));
+        check(MSK->getxxslice(task, whichsol, min_id, max_id + 1,
+                              tmp_scalars.data()));
+        std::vector<double> values;
+        values.reserve(tmp_indices.size());
+        for(auto && id : tmp_indices)
+            values.emplace_back(
+                tmp_scalars[static_cast<std::size_t>(id - min_id)]);
+        return values;
+    }
 };
 
 }  // namespace mosek::v11
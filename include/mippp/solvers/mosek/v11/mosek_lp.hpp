@@ -15,9 +15,14 @@ class mosek_lp : public mosek_base {
 private:
     MSKprostae lp_status;
 
+    explicit mosek_lp(mosek_base && base) : mosek_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit mosek_lp(const mosek_api & api) : mosek_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] mosek_lp clone() { return mosek_lp(_clone_base()); }
+
     ///////////////////////////////////////////////////////////////////////////
     ////////////////////////////// Solve status ///////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -93,6 +98,7 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _invalidate_solution_caches();
         check(MSK->optimize(task));
         check(MSK->getprosta(task, MSK_SOL_BAS, &lp_status));
         _status = _get_status();
@@ -103,27 +109,30 @@ public:
         return val;
     }
     auto get_solution() {
-        auto solution =
-            std::make_unique_for_overwrite<double[]>(num_variables());
-        check(MSK->getxx(task, MSK_SOL_BAS, solution.get()));
-        return variable_mapping(std::move(solution));
+        return variable_mapping(_get_cached_solution(MSK_SOL_BAS));
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_solution_values(MSK_SOL_BAS, vars);
     }
     auto get_dual_solution() {
-        auto dual_solution =
-            std::make_unique_for_overwrite<double[]>(num_constraints());
-        check(MSK->getsolution(task, MSK_SOL_BAS, nullptr, nullptr, nullptr,
-                               nullptr, nullptr, nullptr, nullptr,
-                               dual_solution.get(), nullptr, nullptr, nullptr,
-                               nullptr, nullptr));
-        return constraint_mapping(std::move(dual_solution));
+        return constraint_mapping(_dual_solution_cache.get(
+            num_constraints(), [this](double * dual_solution) {
+                check(MSK->getsolution(task, MSK_SOL_BAS, nullptr, nullptr,
+                                       nullptr, nullptr, nullptr, nullptr,
+                                       nullptr, dual_solution, nullptr,
+                                       nullptr, nullptr, nullptr, nullptr));
+            }));
     }
     auto get_reduced_costs() {
         const auto num_vars = num_variables();
-        auto reduced_costs = std::make_unique_for_overwrite<double[]>(num_vars);
-        check(MSK->getreducedcosts(task, MSK_SOL_BAS, 0,
-                                   static_cast<int>(num_vars),
-                                   reduced_costs.get()));
-        return variable_mapping(std::move(reduced_costs));
+        return variable_mapping(_reduced_costs_cache.get(
+            num_vars, [&](double * reduced_costs) {
+                check(MSK->getreducedcosts(task, MSK_SOL_BAS, 0,
+                                           static_cast<int>(num_vars),
+                                           reduced_costs));
+            }));
     }
 };
 
@@ -14,12 +14,18 @@ namespace mippp {
 namespace mosek::v11 {
 
 class mosek_milp : public mosek_base {
+private:
+    explicit mosek_milp(mosek_base && base) : mosek_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit mosek_milp(const mosek_api & api) : mosek_base(api) {
         check(MSK->putintparam(task, MSK_IPAR_OPTIMIZER,
                                MSK_OPTIMIZER_MIXED_INT));
     }
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] mosek_milp clone() { return mosek_milp(_clone_base()); }
+
     variable add_integer_variable(
         const variable_params params = default_variable_params) {
         int var_id = static_cast<int>(num_variables());
@@ -188,6 +194,7 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _invalidate_solution_caches();
         check(MSK->optimize(task));
         _status = _get_status();
     }
@@ -198,10 +205,14 @@ public:
         return val;
     }
     auto get_solution() {
-        const auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
-        if(num_vars > 0) check(MSK->getxx(task, MSK_SOL_ITG, solution.get()));
-        return variable_mapping(std::move(solution));
+        if(num_variables() == 0u)
+            return variable_mapping(_solution_cache.get(0u, [](double *) {}));
+        return variable_mapping(_get_cached_solution(MSK_SOL_ITG));
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_solution_values(MSK_SOL_ITG, vars);
     }
 };
 
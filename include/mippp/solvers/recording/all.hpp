@@ -0,0 +1,11 @@
+#pragma once
+
+#include "mippp/solvers/recording/recording_lp.hpp"
+#include "mippp/solvers/recording/recording_milp.hpp"
+
+namespace mippp {
+
+using recording_lp = recording::recording_lp;
+using recording_milp = recording::recording_milp;
+
+}  // namespace mippp
@@ -0,0 +1,611 @@
+#pragma once
+
+// recording_base: an in-memory model that no solver is attached to.
+//
+// Columns are stored as flat arrays (objective, bounds, types) and rows in CSR
+// arrays (begins / indices / values), filled from the same scratch buffers and
+// coalescing routines of model_base as the solver backends. Timing a model
+// build against it therefore measures the modeling layer alone, with no
+// solver license and no dynamic library loaded. The recorded arrays can then
+// be read back in bulk with get_constraints_matrix() and friends.
+//
+// Variable handles are the column indices. A removed column is kept as a
+// tombstone fixed to 0 with no entries and its index is reused by the next
+// add_variable() or add_column(), as solver backends without remapping do.
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_concepts.hpp"
+#include "mippp/model_entities.hpp"
+
+#include "mippp/solvers/model_base.hpp"
+
+namespace mippp {
+namespace recording {
+
+enum class variable_type : char { continuous = 'C', integer = 'I' };
+
+class recording_base : public model_base<int, double> {
+public:
+    using index = std::size_t;
+    using variable_id = int;
+    using constraint_id = int;
+    using scalar = double;
+    using variable = model_variable<variable_id, scalar>;
+    using constraint = model_constraint<constraint_id>;
+    template <typename Map>
+    struct variable_mapping : entity_mapping<variable, Map> {
+        variable_mapping(Map && t)
+            : entity_mapping<variable, Map>(std::move(t)) {}
+    };
+    template <typename Map>
+    struct constraint_mapping : entity_mapping<constraint, Map> {
+        constraint_mapping(Map && t)
+            : entity_mapping<constraint, Map>(std::move(t)) {}
+    };
+
+    static constexpr scalar infinity = std::numeric_limits<scalar>::infinity();
+
+    struct constraints_matrix {
+        std::span<const index> begins;  // num_constraints() + 1 offsets
+        std::span<const variable_id> indices;
+        std::span<const scalar> values;
+    };
+
+protected:
+    bool _maximize;
+    scalar _objective_offset;
+
+    std::vector<scalar> _objective_coefs;
+    std::vector<scalar> _lower_bounds;
+    std::vector<scalar> _upper_bounds;
+    std::vector<variable_type> _variable_types;
+    std::vector<bool> _removed_variables;
+    std::vector<variable_id> _free_variable_ids;
+    std::vector<std::string> _variable_names;  // resized on first name
+
+    std::vector<index> _row_begins;
+    std::vector<variable_id> _row_indices;
+    std::vector<scalar> _row_values;
+    std::vector<constraint_sense> _row_senses;
+    std::vector<scalar> _row_rhs;
+    std::vector<std::string> _constraint_names;  // resized on first name
+
+    // add_column entries, merged into the CSR arrays on the next row read
+    std::vector<std::tuple<constraint_id, variable_id, scalar>>
+        _column_entries;
+
+public:
+    [[nodiscard]] explicit recording_base()
+        : model_base<int, double>()
+        , _maximize(false)
+        , _objective_offset(0.0)
+        , _row_begins{0} {}
+
+    void reserve(std::size_t num_vars, std::size_t num_constrs,
+                 std::size_t num_entries) {
+        _objective_coefs.reserve(num_vars);
+        _lower_bounds.reserve(num_vars);
+        _upper_bounds.reserve(num_vars);
+        _variable_types.reserve(num_vars);
+        _removed_variables.reserve(num_vars);
+        _row_begins.reserve(num_constrs + 1);
+        _row_senses.reserve(num_constrs);
+        _row_rhs.reserve(num_constrs);
+        _row_indices.reserve(num_entries);
+        _row_values.reserve(num_entries);
+    }
+
+    std::size_t num_variables() {
+        return _objective_coefs.size() - _free_variable_ids.size();
+    }
+    std::size_t num_constraints() { return _row_senses.size(); }
+    std::size_t num_entries() {
+        return _row_indices.size() + _column_entries.size();
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    //////////////////////////////// Objective ////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    void set_maximization() { _maximize = true; }
+    void set_minimization() { _maximize = false; }
+    bool is_maximization() const { return _maximize; }
+
+    void set_objective_offset(scalar offset) { _objective_offset = offset; }
+    template <linear_expression LE>
+    void set_objective(LE && le) {
+        std::ranges::fill(_objective_coefs, 0.0);
+        for(auto && [var, coef] : le.linear_terms())
+            _objective_coefs[var.uid()] += coef;
+        set_objective_offset(le.constant());
+    }
+    template <linear_expression LE>
+    void set_objective(distinct_variables_t, LE && le) {
+        set_objective(std::forward<LE>(le));
+    }
+    template <linear_expression LE>
+    void add_objective(LE && le) {
+        for(auto && [var, coef] : le.linear_terms())
+            _objective_coefs[var.uid()] += coef;
+        set_objective_offset(get_objective_offset() + le.constant());
+    }
+    template <linear_expression LE>
+    void add_objective(distinct_variables_t, LE && le) {
+        add_objective(std::forward<LE>(le));
+    }
+
+    scalar get_objective_offset() { return _objective_offset; }
+    auto get_objective() {
+        return linear_expression_view(
+            std::views::transform(
+                std::views::filter(
+                    std::views::iota(variable_id{0},
+                                     static_cast<variable_id>(
+                                         _objective_coefs.size())),
+                    [this](variable_id i) {
+                        return !_removed_variables[static_cast<std::size_t>(
+                            i)];
+                    }),
+                [this](variable_id i) {
+                    return std::make_pair(
+                        variable(i),
+                        _objective_coefs[static_cast<std::size_t>(i)]);
+                }),
+            get_objective_offset());
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    //////////////////////////////// Variables ////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+protected:
+    variable _add_variable(const variable_params & params,
+                           variable_type type) {
+        if(!_free_variable_ids.empty()) {
+            const variable_id var_id = _free_variable_ids.back();
+            _free_variable_ids.pop_back();
+            const auto j = static_cast<std::size_t>(var_id);
+            _objective_coefs[j] = params.obj_coef;
+            _lower_bounds[j] = params.lower_bound.value_or(-infinity);
+            _upper_bounds[j] = params.upper_bound.value_or(infinity);
+            _variable_types[j] = type;
+            _removed_variables[j] = false;
+            return variable(var_id);
+        }
+        const auto var_id = static_cast<variable_id>(_objective_coefs.size());
+        _objective_coefs.emplace_back(params.obj_coef);
+        _lower_bounds.emplace_back(params.lower_bound.value_or(-infinity));
+        _upper_bounds.emplace_back(params.upper_bound.value_or(infinity));
+        _variable_types.emplace_back(type);
+        _removed_variables.emplace_back(false);
+        return variable(var_id);
+    }
+    std::size_t _add_variables(std::size_t count,
+                               const variable_params & params,
+                               variable_type type) {
+        const std::size_t offset = _objective_coefs.size();
+        _objective_coefs.resize(offset + count, params.obj_coef);
+        _lower_bounds.resize(offset + count,
+                             params.lower_bound.value_or(-infinity));
+        _upper_bounds.resize(offset + count,
+                             params.upper_bound.value_or(infinity));
+        _variable_types.resize(offset + count, type);
+        _removed_variables.resize(offset + count, false);
+        return offset;
+    }
+
+public:
+    variable add_variable(
+        const variable_params params = default_variable_params) {
+        return _add_variable(params, variable_type::continuous);
+    }
+    auto add_variables(std::size_t count,
+                       variable_params params = default_variable_params) {
+        const std::size_t offset =
+            _add_variables(count, params, variable_type::continuous);
+        return _make_variables_view(offset, count);
+    }
+    template <typename IL>
+    auto add_variables(std::size_t count, IL && id_lambda,
+                       variable_params params = default_variable_params) {
+        const std::size_t offset =
+            _add_variables(count, params, variable_type::continuous);
+        return _make_indexed_variables_view(offset, count,
+                                            std::forward<IL>(id_lambda));
+    }
+
+    variable add_named_variable(
+        const std::string & name,
+        const variable_params params = default_variable_params) {
+        variable v = add_variable(params);
+        set_variable_name(v, name);
+        return v;
+    }
+    template <typename NL>
+    auto add_named_variables(std::size_t count, NL && name_lambda,
+                             variable_params params = default_variable_params) {
+        const std::size_t offset =
+            _add_variables(count, params, variable_type::continuous);
+        return _make_named_variables_view(offset, count,
+                                          std::forward<NL>(name_lambda), this);
+    }
+    template <typename IL, typename NL>
+    auto add_named_variables(std::size_t count, IL && id_lambda,
+                             NL && name_lambda,
+                             variable_params params = default_variable_params) {
+        const std::size_t offset =
+            _add_variables(count, params, variable_type::continuous);
+        return _make_indexed_named_variables_view(
+            offset, count, std::forward<IL>(id_lambda),
+            std::forward<NL>(name_lambda), this);
+    }
+
+private:
+    template <typename ER>
+    variable _add_column(ER && entries, const variable_params & params) {
+        const variable v = _add_variable(params, variable_type::continuous);
+        for(auto && [constr, coef] : entries)
+            _column_entries.emplace_back(constr.id(), v.id(),
+                                         static_cast<scalar>(coef));
+        return v;
+    }
+
+public:
+    template <std::ranges::range ER>
+    variable add_column(
+        ER && entries, const variable_params params = default_variable_params) {
+        return _add_column(entries, params);
+    }
+    variable add_column(
+        std::initializer_list<std::pair<constraint, scalar>> entries,
+        const variable_params params = default_variable_params) {
+        return _add_column(entries, params);
+    }
+    // The columns are appended, so that the new variables are contiguous even
+    // when removed variables could be recycled.
+    template <std::ranges::range IR, typename EL, typename PL>
+    auto add_columns(IR && keys, EL && entries_lambda, PL && params_lambda) {
+        const std::size_t offset = _objective_coefs.size();
+        for(auto && key : keys) {
+            const variable_params params = params_lambda(key);
+            const auto var_id = static_cast<variable_id>(
+                _add_variables(1, params, variable_type::continuous));
+            for(auto && [constr, coef] : entries_lambda(key))
+                _column_entries.emplace_back(constr.id(), var_id,
+                                             static_cast<scalar>(coef));
+        }
+        return _make_variables_view(offset, _objective_coefs.size() - offset);
+    }
+    template <std::ranges::range IR, typename EL>
+    auto add_columns(IR && keys, EL && entries_lambda) {
+        return add_columns(
+            std::forward<IR>(keys), std::forward<EL>(entries_lambda),
+            [](auto &&) { return default_variable_params; });
+    }
+
+protected:
+    // Removes the entries of the columns flagged in _removed_variables, in one
+    // pass over the CSR arrays whatever the number of removed columns.
+    void _purge_removed_entries() {
+        _merge_column_entries();
+        index new_entry = 0;
+        index row_begin = 0;
+        for(std::size_t r = 0; r < num_constraints(); ++r) {
+            const index row_end = _row_begins[r + 1];
+            for(index e = row_begin; e < row_end; ++e) {
+                const auto j = static_cast<std::size_t>(_row_indices[e]);
+                if(_removed_variables[j]) continue;
+                _row_indices[new_entry] = _row_indices[e];
+                _row_values[new_entry] = _row_values[e];
+                ++new_entry;
+            }
+            row_begin = row_end;
+            _row_begins[r + 1] = new_entry;
+        }
+        _row_indices.resize(new_entry);
+        _row_values.resize(new_entry);
+    }
+    void _mark_removed(variable v) {
+        const std::size_t j = v.uid();
+        if(_removed_variables[j]) return;
+        _objective_coefs[j] = 0.0;
+        _lower_bounds[j] = _upper_bounds[j] = 0.0;
+        _variable_types[j] = variable_type::continuous;
+        _removed_variables[j] = true;
+        if(j < _variable_names.size()) _variable_names[j].clear();
+        _free_variable_ids.emplace_back(v.id());
+    }
+
+public:
+    void remove_variable(variable v) {
+        _mark_removed(v);
+        _purge_removed_entries();
+    }
+    template <std::ranges::range VR>
+    void remove_variables(VR && variables) {
+        for(auto && v : variables) _mark_removed(v);
+        _purge_removed_entries();
+    }
+
+    void set_objective_coefficient(variable v, scalar c) {
+        _objective_coefs[v.uid()] = c;
+    }
+    void set_variable_lower_bound(variable v, scalar lb) {
+        _lower_bounds[v.uid()] = lb;
+    }
+    void set_variable_upper_bound(variable v, scalar ub) {
+        _upper_bounds[v.uid()] = ub;
+    }
+    void set_variable_name(variable v, const std::string & name) {
+        if(_variable_names.size() <= v.uid())
+            _variable_names.resize(_objective_coefs.size());
+        _variable_names[v.uid()] = name;
+    }
+
+    scalar get_objective_coefficient(variable v) {
+        return _objective_coefs[v.uid()];
+    }
+    scalar get_variable_lower_bound(variable v) {
+        return _lower_bounds[v.uid()];
+    }
+    scalar get_variable_upper_bound(variable v) {
+        return _upper_bounds[v.uid()];
+    }
+    std::string get_variable_name(variable v) {
+        if(v.uid() < _variable_names.size()) return _variable_names[v.uid()];
+        return {};
+    }
+    bool is_integer(variable v) const {
+        return _variable_types[v.uid()] == variable_type::integer;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /////////////////////////////// Constraints ///////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+protected:
+    // Sorts the pending add_column entries into the CSR arrays, keeping the
+    // entries of each row in insertion order.
+    void _merge_column_entries() {
+        if(_column_entries.empty()) return;
+        const std::size_t num_rows = num_constraints();
+        std::vector<index> new_begins(num_rows + 1, 0);
+        for(std::size_t r = 0; r < num_rows; ++r)
+            new_begins[r + 1] = _row_begins[r + 1] - _row_begins[r];
+        for(auto && [row, col, coef] : _column_entries)
+            ++new_begins[static_cast<std::size_t>(row) + 1];
+        for(std::size_t r = 0; r < num_rows; ++r)
+            new_begins[r + 1] += new_begins[r];
+
+        std::vector<variable_id> new_indices(new_begins.back());
+        std::vector<scalar> new_values(new_begins.back());
+        std::vector<index> cursors(new_begins.begin(), new_begins.end() - 1);
+        for(std::size_t r = 0; r < num_rows; ++r) {
+            for(index e = _row_begins[r]; e < _row_begins[r + 1]; ++e) {
+                new_indices[cursors[r]] = _row_indices[e];
+                new_values[cursors[r]] = _row_values[e];
+                ++cursors[r];
+            }
+        }
+        for(auto && [row, col, coef] : _column_entries) {
+            index & cursor = cursors[static_cast<std::size_t>(row)];
+            new_indices[cursor] = col;
+            new_values[cursor] = coef;
+            ++cursor;
+        }
+        _row_begins = std::move(new_begins);
+        _row_indices = std::move(new_indices);
+        _row_values = std::move(new_values);
+        _column_entries.clear();
+    }
+    constraint _append_row(constraint_sense sense, scalar rhs) {
+        const auto constr_id = static_cast<constraint_id>(num_constraints());
+        _row_indices.insert(_row_indices.end(), tmp_indices.begin(),
+                            tmp_indices.end());
+        _row_values.insert(_row_values.end(), tmp_scalars.begin(),
+                           tmp_scalars.end());
+        _row_begins.emplace_back(_row_indices.size());
+        _row_senses.emplace_back(sense);
+        _row_rhs.emplace_back(rhs);
+        return constraint(constr_id);
+    }
+
+private:
+    template <bool distinct, linear_constraint LC>
+    constraint _add_constraint(LC && lc) {
+        if constexpr(!distinct) _prepare_coalescing(_objective_coefs.size());
+        _reset_cache();
+        _register_variables_entries<distinct>(lc.linear_terms());
+        return _append_row(lc.sense(), lc.rhs());
+    }
+
+public:
+    template <linear_constraint LC>
+    constraint add_constraint(LC && lc) {
+        return _add_constraint<false>(std::forward<LC>(lc));
+    }
+    template <linear_constraint LC>
+    constraint add_constraint(distinct_variables_t, LC && lc) {
+        return _add_constraint<true>(std::forward<LC>(lc));
+    }
+
+private:
+    template <bool distinct, typename Key, typename LastConstrLambda>
+        requires linear_constraint<std::invoke_result_t<LastConstrLambda, Key>>
+    void _register_first_valued_constraint(const Key & key,
+                                           LastConstrLambda & lc_lambda) {
+        _add_constraint<distinct>(lc_lambda(key));
+    }
+    template <bool distinct, typename Key, typename OptConstrLambda,
+              typename... Tail>
+        requires detail::optional_type<
+                     std::invoke_result_t<OptConstrLambda, Key>> &&
+                 linear_constraint<detail::optional_type_value_t<
+                     std::invoke_result_t<OptConstrLambda, Key>>>
+    void _register_first_valued_constraint(const Key & key,
+                                           OptConstrLambda & opt_lc_lambda,
+                                           Tail &... tail) {
+        if(const auto & opt_lc = opt_lc_lambda(key)) {
+            _add_constraint<distinct>(opt_lc.value());
+            return;
+        }
+        _register_first_valued_constraint<distinct>(key, tail...);
+    }
+    template <bool distinct, std::ranges::range IR, typename... CL>
+    auto _add_constraints(IR && keys, CL &... constraint_lambdas) {
+        const auto offset = static_cast<constraint_id>(num_constraints());
+        for(auto && key : keys)
+            _register_first_valued_constraint<distinct>(key,
+                                                        constraint_lambdas...);
+        const auto constr_end = static_cast<constraint_id>(num_constraints());
+        return constraints_range(
+            std::forward<IR>(keys),
+            std::views::transform(std::views::iota(offset, constr_end),
+                                  [](auto && i) { return constraint{i}; }));
+    }
+
+public:
+    template <std::ranges::range IR, typename... CL>
+    auto add_constraints(IR && keys, CL &&... constraint_lambdas) {
+        return _add_constraints<false>(std::forward<IR>(keys),
+                                       constraint_lambdas...);
+    }
+    template <std::ranges::range IR, typename... CL>
+    auto add_constraints(distinct_variables_t, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints<true>(std::forward<IR>(keys),
+                                      constraint_lambdas...);
+    }
+
+    // Replacing a row shifts the entries of the following ones : O(nnz).
+    template <std::ranges::range ER>
+    void set_constraint_lhs(constraint c, ER && entries) {
+        _merge_column_entries();
+        _prepare_coalescing(_objective_coefs.size());
+        _reset_cache();
+        _register_variables_entries<false>(entries);
+        const std::size_t r = c.uid();
+        const auto begin = static_cast<std::ptrdiff_t>(_row_begins[r]);
+        const auto end = static_cast<std::ptrdiff_t>(_row_begins[r + 1]);
+        _row_indices.erase(_row_indices.begin() + begin,
+                           _row_indices.begin() + end);
+        _row_values.erase(_row_values.begin() + begin,
+                          _row_values.begin() + end);
+        _row_indices.insert(_row_indices.begin() + begin, tmp_indices.begin(),
+                            tmp_indices.end());
+        _row_values.insert(_row_values.begin() + begin, tmp_scalars.begin(),
+                           tmp_scalars.end());
+        const auto shift = static_cast<std::ptrdiff_t>(tmp_indices.size()) -
+                           (end - begin);
+        for(std::size_t i = r + 1; i < _row_begins.size(); ++i)
+            _row_begins[i] = static_cast<index>(
+                static_cast<std::ptrdiff_t>(_row_begins[i]) + shift);
+    }
+    void set_constraint_lhs(
+        constraint c,
+        std::initializer_list<std::pair<variable, scalar>> entries) {
+        set_constraint_lhs(c, std::views::all(entries));
+    }
+    void set_constraint_sense(constraint c, constraint_sense s) {
+        _row_senses[c.uid()] = s;
+    }
+    void set_constraint_rhs(constraint c, scalar rhs) {
+        _row_rhs[c.uid()] = rhs;
+    }
+    void set_constraint_name(constraint c, const std::string & name) {
+        if(_constraint_names.size() <= c.uid())
+            _constraint_names.resize(num_constraints());
+        _constraint_names[c.uid()] = name;
+    }
+
+    auto get_constraint_lhs(constraint c) {
+        _merge_column_entries();
+        const std::size_t r = c.uid();
+        return std::views::transform(
+            std::views::iota(_row_begins[r], _row_begins[r + 1]),
+            [this](index e) {
+                return std::make_pair(variable(_row_indices[e]),
+                                      _row_values[e]);
+            });
+    }
+    constraint_sense get_constraint_sense(constraint c) {
+        return _row_senses[c.uid()];
+    }
+    scalar get_constraint_rhs(constraint c) { return _row_rhs[c.uid()]; }
+    auto get_constraint(constraint c) {
+        return linear_constraint_view(
+            linear_expression_view(get_constraint_lhs(c),
+                                   -get_constraint_rhs(c)),
+            get_constraint_sense(c));
+    }
+    std::string get_constraint_name(constraint c) {
+        if(c.uid() < _constraint_names.size()) return _constraint_names[c.uid()];
+        return {};
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /////////////////////////////// Bulk access ///////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Views over the recorded arrays, indexed by variable and constraint ids
+    // and invalidated by the next modification of the model.
+    constraints_matrix get_constraints_matrix() {
+        _merge_column_entries();
+        return {_row_begins, _row_indices, _row_values};
+    }
+    std::span<const constraint_sense> get_constraints_senses() const {
+        return _row_senses;
+    }
+    std::span<const scalar> get_constraints_rhs() const { return _row_rhs; }
+    std::span<const scalar> get_objective_coefficients() const {
+        return _objective_coefs;
+    }
+    std::span<const scalar> get_variables_lower_bounds() const {
+        return _lower_bounds;
+    }
+    std::span<const scalar> get_variables_upper_bounds() const {
+        return _upper_bounds;
+    }
+    std::span<const variable_type> get_variables_types() const {
+        return _variable_types;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    ////////////////////////////// Solve status ///////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+private:
+    using status_variant = std::variant<status::unknown, status::optimal>;
+
+    status_variant _status;
+
+public:
+    const status_variant & solve_status() const { return _status; }
+    ///////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////// Solve //////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // There is no solver to run : the status stays unknown and no solution is
+    // available, so that the values read are NaNs.
+    void solve() { _status = status::unknown{}; }
+    scalar get_solution_value() {
+        return std::numeric_limits<scalar>::quiet_NaN();
+    }
+    auto get_solution() {
+        return variable_mapping([](const variable &) {
+            return std::numeric_limits<scalar>::quiet_NaN();
+        });
+    }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<scalar> get_solution(VR && vars) {
+        std::vector<scalar> values;
+        for(auto && v : vars)
+            values.emplace_back(get_solution()[v]);
+        return values;
+    }
+};
+
+}  // namespace recording
+}  // namespace mippp
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "mippp/model_concepts.hpp"
+
+#include "mippp/solvers/recording/recording_base.hpp"
+
+namespace mippp {
+namespace recording {
+
+class recording_lp : public recording_base {
+public:
+    [[nodiscard]] explicit recording_lp() : recording_base() {}
+};
+
+}  // namespace recording
+}  // namespace mippp
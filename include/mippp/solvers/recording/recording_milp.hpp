@@ -0,0 +1,61 @@
+#pragma once
+
+#include "mippp/model_concepts.hpp"
+
+#include "mippp/solvers/recording/recording_base.hpp"
+
+namespace mippp {
+namespace recording {
+
+class recording_milp : public recording_base {
+public:
+    [[nodiscard]] explicit recording_milp() : recording_base() {}
+
+    variable add_integer_variable(
+        const variable_params params = default_variable_params) {
+        return _add_variable(params, variable_type::integer);
+    }
+    auto add_integer_variables(
+        std::size_t count, variable_params params = default_variable_params) {
+        const std::size_t offset =
+            _add_variables(count, params, variable_type::integer);
+        return _make_variables_view(offset, count);
+    }
+    template <typename IL>
+    auto add_integer_variables(
+        std::size_t count, IL && id_lambda,
+        variable_params params = default_variable_params) {
+        const std::size_t offset =
+            _add_variables(count, params, variable_type::integer);
+        return _make_indexed_variables_view(offset, count,
+                                            std::forward<IL>(id_lambda));
+    }
+    variable add_binary_variable() {
+        return add_integer_variable(
+            {.obj_coef = 0, .lower_bound = 0.0, .upper_bound = 1.0});
+    }
+    auto add_binary_variables(std::size_t count) {
+        return add_integer_variables(
+            count, {.obj_coef = 0, .lower_bound = 0.0, .upper_bound = 1.0});
+    }
+    template <typename IL>
+    auto add_binary_variables(std::size_t count, IL && id_lambda) {
+        return add_integer_variables(
+            count, std::forward<IL>(id_lambda),
+            {.obj_coef = 0, .lower_bound = 0.0, .upper_bound = 1.0});
+    }
+    void set_continuous(variable v) {
+        _variable_types[v.uid()] = variable_type::continuous;
+    }
+    void set_integer(variable v) {
+        _variable_types[v.uid()] = variable_type::integer;
+    }
+    void set_binary(variable v) {
+        set_integer(v);
+        set_variable_lower_bound(v, 0.0);
+        set_variable_upper_bound(v, 1.0);
+    }
+};
+
+}  // namespace recording
+}  // namespace mippp
@@ -63,6 +63,21 @@ SCIP_RETCODE SCIPreleaseVar(SCIP * scip, SCIP_VAR ** var);
 SCIP_RETCODE SCIPreleaseCons(SCIP * scip, SCIP_CONS ** cons);
 SCIP_RETCODE SCIPfree(SCIP ** scip);
 
+using SCIP_HASHMAP = struct SCIP_HashMap;
+using BMS_BLKMEM = struct BMS_BlkMem;
+BMS_BLKMEM * SCIPblkmem(SCIP * scip);
+SCIP_RETCODE SCIPhashmapCreate(SCIP_HASHMAP ** hashmap, BMS_BLKMEM * blkmem,
+                               int mapsize);
+void SCIPhashmapFree(SCIP_HASHMAP ** hashmap);
+void * SCIPhashmapGetImage(SCIP_HASHMAP * hashmap, void * origin);
+SCIP_RETCODE SCIPcopyOrig(SCIP * sourcescip, SCIP * targetscip,
+                          SCIP_HASHMAP * varmap, SCIP_HASHMAP * consmap,
+                          const char * suffix, SCIP_Bool enablepricing,
+                          SCIP_Bool threadsafe, SCIP_Bool passmessagehdlr,
+                          SCIP_Bool * valid);
+SCIP_RETCODE SCIPcaptureVar(SCIP * scip, SCIP_VAR * var);
+SCIP_RETCODE SCIPcaptureCons(SCIP * scip, SCIP_CONS * cons);
+
 enum SCIP_OBJSENSE : int {
     SCIP_OBJSENSE_MAXIMIZE = -1,
     SCIP_OBJSENSE_MINIMIZE = +1
@@ -159,6 +174,8 @@ SCIP_Longint SCIPgetNNZs(SCIP * scip);
 SCIP_RETCODE SCIPsetRealParam(SCIP * scip, const char * name, SCIP_Real value);
 SCIP_RETCODE SCIPgetRealParam(SCIP * scip, const char * name,
                               SCIP_Real * value);
+SCIP_RETCODE SCIPsetIntParam(SCIP * scip, const char * name, int value);
+SCIP_RETCODE SCIPgetIntParam(SCIP * scip, const char * name, int * value);
 
 enum SCIP_STATUS : int {
     SCIP_STATUS_UNKNOWN = 0,
@@ -283,10 +300,41 @@ SCIP_RETCODE SCIPincludeConshdlrBasic(
 );
 SCIP_CONSHDLRDATA * SCIPconshdlrGetData(SCIP_CONSHDLR * conshdlr);
 
+using SCIP_SEPA = struct SCIP_Sepa;
+using SCIP_SEPADATA = struct SCIP_SepaData;
+using SCIP_ROW = struct SCIP_Row;
+using SCIP_SEPAEXECLP = SCIP_RETCODE(SCIP * scip, SCIP_SEPA * sepa,
+                                     SCIP_RESULT * result,
+                                     SCIP_Bool allowlocal, int depth);
+using SCIP_SEPAEXECSOL = SCIP_RETCODE(SCIP * scip, SCIP_SEPA * sepa,
+                                      SCIP_SOL * sol, SCIP_RESULT * result,
+                                      SCIP_Bool allowlocal, int depth);
+SCIP_RETCODE SCIPincludeSepaBasic(SCIP * scip, SCIP_SEPA ** sepa,
+                                  const char * name, const char * desc,
+                                  int priority, int freq,
+                                  SCIP_Real maxbounddist,
+                                  SCIP_Bool usessubscip, SCIP_Bool delay,
+                                  SCIP_SEPAEXECLP * sepaexeclp,
+                                  SCIP_SEPAEXECSOL * sepaexecsol,
+                                  SCIP_SEPADATA * sepadata);
+SCIP_SEPADATA * SCIPsepaGetData(SCIP_SEPA * sepa);
+SCIP_RETCODE SCIPcreateEmptyRowSepa(SCIP * scip, SCIP_ROW ** row,
+                                    SCIP_SEPA * sepa, const char * name,
+                                    SCIP_Real lhs, SCIP_Real rhs,
+                                    SCIP_Bool local, SCIP_Bool modifiable,
+                                    SCIP_Bool removable);
+SCIP_RETCODE SCIPaddVarsToRow(SCIP * scip, SCIP_ROW * row, int nvars,
+                              SCIP_VAR ** vars, SCIP_Real * vals);
+SCIP_RETCODE SCIPaddRow(SCIP * scip, SCIP_ROW * row, SCIP_Bool forcecut,
+                        SCIP_Bool * infeasible);
+SCIP_RETCODE SCIPreleaseRow(SCIP * scip, SCIP_ROW ** row);
+
 }  // namespace scip::v8
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -301,9 +349,18 @@ namespace scip::v8 {
     F(SCIPreleaseVar, releaseVar)                       \
     F(SCIPreleaseCons, releaseCons)                     \
     F(SCIPfree, free)                                   \
+    F(SCIPblkmem, blkmem)                               \
+    F(SCIPhashmapCreate, hashmapCreate)                 \
+    F(SCIPhashmapFree, hashmapFree)                     \
+    F(SCIPhashmapGetImage, hashmapGetImage)             \
+    F(SCIPcopyOrig, copyOrig)                           \
+    F(SCIPcaptureVar, captureVar)                       \
+    F(SCIPcaptureCons, captureCons)                     \
     F(SCIPinfinity, infinity)                           \
     F(SCIPsetRealParam, setRealParam)                   \
     F(SCIPgetRealParam, getRealParam)                   \
+    F(SCIPsetIntParam, setIntParam)                     \
+    F(SCIPgetIntParam, getIntParam)                     \
     F(SCIPsetObjsense, setObjsense)                     \
     F(SCIPaddOrigObjoffset, addOrigObjoffset)           \
     F(SCIPgetOrigObjoffset, getOrigObjoffset)           \
@@ -336,17 +393,23 @@ namespace scip::v8 {
     F(SCIPgetSolVal, getSolVal)                         \
     F(SCIPgetSolVals, getSolVals)                       \
     F(SCIPincludeConshdlrBasic, includeConshdlrBasic)   \
-    F(SCIPconshdlrGetData, conshdlrGetData)
+    F(SCIPconshdlrGetData, conshdlrGetData)             \
+    F(SCIPincludeSepaBasic, includeSepaBasic)           \
+    F(SCIPsepaGetData, sepaGetData)                     \
+    F(SCIPcreateEmptyRowSepa, createEmptyRowSepa)       \
+    F(SCIPaddVarsToRow, addVarsToRow)                   \
+    F(SCIPaddRow, addRow)                               \
+    F(SCIPreleaseRow, releaseRow)
 
 #define DECLARE_SCIP_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);   \
-    SHORT##_fun_t const * SHORT;
+    detail::solver_function<SHORT##_fun_t> SHORT;
 #define CONSTRUCT_SCIP_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<SHORT##_fun_t>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 
 class scip_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
 public:
     SCIP_FUNCTIONS(DECLARE_SCIP_FUNCTIONS)
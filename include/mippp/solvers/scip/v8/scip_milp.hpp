@@ -6,6 +6,7 @@
 #include <ranges>
 #include <vector>
 
+#include "mippp/detail/solution_cache.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
@@ -56,6 +57,8 @@ protected:
     std::vector<SCIP_Real> tmp_reals;
     unsigned int register_count;
 
+    detail::solution_cache<double> _solution_cache;
+
     void _prepare_coalescing(const std::size_t ids_end) {
         tmp_entry_index_cache.resize(ids_end);
     }
@@ -110,7 +113,8 @@ public:
         : SCIP(other.SCIP)
         , model(other.model)
         , variables(std::move(other.variables))
-        , constraints(std::move(other.constraints)) {
+        , constraints(std::move(other.constraints))
+        , _solution_cache(std::move(other._solution_cache)) {
         other.model = nullptr;
     }
 
@@ -145,7 +149,58 @@ private:
                                  error_messages[-retval]);
     }
 
+    // other copied in model_copy, varmap and consmap mapping its variables
+    // and constraints to their copies : the handles of other stay valid
+    scip_milp(const scip_milp & other, struct Scip * model_copy,
+              SCIP_HASHMAP * varmap, SCIP_HASHMAP * consmap)
+        : SCIP(other.SCIP), model(model_copy), register_count(0) {
+        variables.reserve(other.variables.size());
+        for(SCIP_VAR * var : other.variables) {
+            auto * var_copy =
+                static_cast<SCIP_VAR *>(SCIP->hashmapGetImage(varmap, var));
+            check(SCIP->captureVar(model, var_copy));
+            variables.emplace_back(var_copy);
+        }
+        constraints.reserve(other.constraints.size());
+        for(SCIP_CONS * cons : other.constraints) {
+            auto * cons_copy =
+                static_cast<SCIP_CONS *>(SCIP->hashmapGetImage(consmap, cons));
+            check(SCIP->captureCons(model, cons_copy));
+            constraints.emplace_back(cons_copy);
+        }
+    }
+
 public:
+    // an independent copy of the original problem and the parameters, in
+    // which the handles stay valid. The callbacks are not copied
+    [[nodiscard]] scip_milp clone() {
+        struct Scip * model_copy;
+        check(SCIP->create(&model_copy));
+        SCIP_HASHMAP * varmap = nullptr;
+        SCIP_HASHMAP * consmap = nullptr;
+        auto free_maps = [&] {
+            if(varmap) SCIP->hashmapFree(&varmap);
+            if(consmap) SCIP->hashmapFree(&consmap);
+        };
+        try {
+            check(SCIP->hashmapCreate(&varmap, SCIP->blkmem(model_copy),
+                                      static_cast<int>(variables.size())));
+            check(SCIP->hashmapCreate(&consmap, SCIP->blkmem(model_copy),
+                                      static_cast<int>(constraints.size())));
+            // valid is false when a callback handler cannot be copied
+            SCIP_Bool valid;
+            check(SCIP->copyOrig(model, model_copy, varmap, consmap, "",
+                                 FALSE, FALSE, TRUE, &valid));
+            scip_milp copy(*this, model_copy, varmap, consmap);
+            free_maps();
+            return copy;
+        } catch(...) {
+            free_maps();
+            SCIP->free(&model_copy);
+            throw;
+        }
+    }
+
     std::size_t num_variables() { return variables.size(); }
     std::size_t num_constraints() { return constraints.size(); }
     std::size_t num_entries() {
@@ -591,6 +646,100 @@ public:
             -1, -1, false, nullptr, nullptr, nullptr, nullptr,
             reinterpret_cast<SCIP_CONSHDLRDATA *>(ptr)));
     }
+
+    // Cuts are separated from the LP relaxation of the nodes by a separator,
+    // which SCIP calls with the LP solution as current solution.
+    class node_relaxation_callback_handle : public callback_handle_base {
+    private:
+        SCIP_SEPA * sepa;
+
+    public:
+        node_relaxation_callback_handle(const scip_api * api,
+                                        scip_milp & milp_, SCIP_SEPA * sepa_,
+                                        SCIP_RESULT * result_)
+            : callback_handle_base(api, milp_, result_), sepa(sepa_) {
+            *result = SCIP_DIDNOTFIND;
+        }
+
+    private:
+        template <bool distinct, linear_constraint LC>
+        void _add_cut(LC && lc) {
+            if constexpr(!distinct) milp._prepare_coalescing(num_variables());
+            milp._reset_cache();
+            milp._register_variables_entries<distinct>(lc.linear_terms());
+            const double b = lc.rhs();
+            const double inf = SCIP->infinity(milp.model);
+            SCIP_ROW * row = nullptr;
+            check(SCIP->createEmptyRowSepa(
+                milp.model, &row, sepa, "",
+                (lc.sense() == constraint_sense::less_equal) ? -inf : b,
+                (lc.sense() == constraint_sense::greater_equal) ? inf : b,
+                FALSE, FALSE, TRUE));
+            check(SCIP->addVarsToRow(milp.model, row,
+                                     static_cast<int>(milp.tmp_vars.size()),
+                                     milp.tmp_vars.data(),
+                                     milp.tmp_reals.data()));
+            SCIP_Bool infeasible;
+            check(SCIP->addRow(milp.model, row, FALSE, &infeasible));
+            check(SCIP->releaseRow(milp.model, &row));
+            // a cutoff reported by an earlier cut must not be downgraded
+            if(infeasible)
+                *result = SCIP_CUTOFF;
+            else if(*result != SCIP_CUTOFF)
+                *result = SCIP_SEPARATED;
+        }
+
+    public:
+        template <linear_constraint LC>
+        void add_cut(LC && lc) {
+            _add_cut<false>(std::forward<LC>(lc));
+        }
+        template <linear_constraint LC>
+        void add_cut(distinct_variables_t, LC && lc) {
+            _add_cut<true>(std::forward<LC>(lc));
+        }
+        auto get_relaxation_solution() {
+            auto num_vars = num_variables();
+            auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
+            check(SCIP->getSolVals(milp.model, nullptr,
+                                   static_cast<int>(num_vars),
+                                   milp.variables.data(), solution.get()));
+            return variable_mapping(std::move(solution));
+        }
+    };
+
+private:
+    SCIP_SEPA * node_relaxation_separator = nullptr;
+    std::function<void(node_relaxation_callback_handle &)>
+        node_relaxation_callback;
+    // the separator data, i.e. the model, is only reachable through the
+    // loaded library, that the static separation method does not know of
+    static inline scip_api::sepaGetData_fun_t const * _sepa_get_data =
+        nullptr;
+
+    static SCIP_RETCODE node_relaxation_callback_fun(
+        [[maybe_unused]] struct Scip * scip, SCIP_SEPA * sepa,
+        SCIP_RESULT * result, [[maybe_unused]] SCIP_Bool allowlocal,
+        [[maybe_unused]] int depth) {
+        auto * model = reinterpret_cast<scip_milp *>(_sepa_get_data(sepa));
+        node_relaxation_callback_handle handle(model->SCIP, *model, sepa,
+                                               result);
+        model->node_relaxation_callback(handle);
+        return SCIP_OKAY;
+    }
+
+public:
+    template <typename F>
+    void set_node_relaxation_callback(F && f) {
+        node_relaxation_callback = std::forward<F>(f);
+        if(node_relaxation_separator) return;
+        _sepa_get_data = SCIP->sepaGetData;
+        check(SCIP->includeSepaBasic(
+            model, &node_relaxation_separator, "node_relaxation_callback",
+            "node_relaxation_callback", 0, 1, 1.0, FALSE, FALSE,
+            node_relaxation_callback_fun, nullptr,
+            reinterpret_cast<SCIP_SEPADATA *>(this)));
+    }
     ///////////////////////////////////////////////////////////////////////////
     ////////////////////////// Tolerance parameters ///////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -611,6 +760,20 @@ public:
         return tol;
     }
     ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////// Threads /////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // SCIP solves on one thread, the concurrent solvers it may run on are
+    // bounded by parallel/maxnthreads
+    void set_thread_count(std::size_t n) {
+        check(SCIPsetIntParam(model, "parallel/maxnthreads",
+                              static_cast<int>(n)));
+    }
+    std::size_t get_thread_count() {
+        int n;
+        check(SCIPgetIntParam(model, "parallel/maxnthreads", &n));
+        return static_cast<std::size_t>(n);
+    }
+    ///////////////////////////////////////////////////////////////////////////
     ////////////////////////////// Solve status ///////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     // clang-format off
@@ -664,17 +827,38 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _solution_cache.invalidate();
         check(SCIP->solve(model));
         _status = _get_status();
     }
     double get_solution_value() { return SCIP->getPrimalbound(model); }
     auto get_solution() {
-        auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
+        const auto num_vars = num_variables();
+        return variable_mapping(
+            _solution_cache.get(num_vars, [&](double * solution) {
+                SCIP_SOL * sol = SCIP->getBestSol(model);
+                check(SCIP->getSolVals(model, sol, static_cast<int>(num_vars),
+                                       variables.data(), solution));
+            }));
+    }
+    // only the requested variables, unless the whole solution is cached
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        std::vector<double> values;
+        if(const double * x = _solution_cache.cached(num_variables())) {
+            for(auto && v : vars)
+                values.emplace_back(x[static_cast<std::size_t>(v.id())]);
+            return values;
+        }
+        tmp_vars.clear();
+        for(auto && v : vars)
+            tmp_vars.emplace_back(variables[static_cast<std::size_t>(v.id())]);
+        values.resize(tmp_vars.size());
         SCIP_SOL * sol = SCIP->getBestSol(model);
-        check(SCIP->getSolVals(model, sol, static_cast<int>(num_vars),
-                               variables.data(), solution.get()));
-        return variable_mapping(std::move(solution));
+        check(SCIP->getSolVals(model, sol, static_cast<int>(tmp_vars.size()),
+                               tmp_vars.data(), values.data()));
+        return values;
     }
 };
 
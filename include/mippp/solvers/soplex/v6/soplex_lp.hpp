@@ -5,6 +5,7 @@
 #include <ranges>
 #include <vector>
 
+#include "mippp/detail/solution_cache.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
@@ -47,6 +48,9 @@ private:
     void * model;
     double objective_offset;
     std::vector<double> tmp_scalars;
+    // filled on the first read after each solve, see solution_cache
+    detail::solution_cache<double> _solution_cache;
+    detail::solution_cache<double> _dual_solution_cache;
 
 public:
     [[nodiscard]] explicit soplex_lp(const soplex_api & api)
@@ -56,11 +60,13 @@ public:
     }
 
     constexpr soplex_lp(const soplex_lp &) = delete;
-    constexpr soplex_lp(soplex_lp && other) noexcept
+    soplex_lp(soplex_lp && other) noexcept
         : SoPlex(other.SoPlex)
         , model(other.model)
         , objective_offset(other.objective_offset)
-        , tmp_scalars(std::move(other.tmp_scalars)) {
+        , tmp_scalars(std::move(other.tmp_scalars))
+        , _solution_cache(std::move(other._solution_cache))
+        , _dual_solution_cache(std::move(other._dual_solution_cache)) {
         other.model = nullptr;
     }
 
@@ -274,6 +280,7 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
         using namespace status;
+        _invalidate_solution_caches();
         if(num_variables() == 0u) {
             return;
         }
@@ -316,19 +323,38 @@ public:
     double get_solution_value() {
         return objective_offset + SoPlex->objValueReal(model);
     }
-    auto get_solution() {
-        auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
-        SoPlex->getPrimalReal(model, solution.get(),
-                              static_cast<int>(num_vars));
-        return variable_mapping(std::move(solution));
+    auto get_solution() { return variable_mapping(_get_cached_solution()); }
+    // SoPlex has no by-set getter : gathered from the cached solution
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        const auto solution = _get_cached_solution();
+        std::vector<double> values;
+        if constexpr(std::ranges::sized_range<VR>)
+            values.reserve(std::ranges::size(vars));
+        for(auto && v : vars)
+            values.emplace_back(solution[static_cast<std::size_t>(v.id())]);
+        return values;
     }
     auto get_dual_solution() {
-        auto num_constrs = num_constraints();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_constrs);
-        SoPlex->getDualReal(model, solution.get(),
-                            static_cast<int>(num_constrs));
-        return constraint_mapping(std::move(solution));
+        const auto num_constrs = num_constraints();
+        return constraint_mapping(
+            _dual_solution_cache.get(num_constrs, [&](double * solution) {
+                SoPlex->getDualReal(model, solution,
+                                    static_cast<int>(num_constrs));
+            }));
+    }
+
+private:
+    void _invalidate_solution_caches() noexcept {
+        _solution_cache.invalidate();
+        _dual_solution_cache.invalidate();
+    }
+    detail::shared_values<double> _get_cached_solution() {
+        const auto num_vars = num_variables();
+        return _solution_cache.get(num_vars, [&](double * solution) {
+            SoPlex->getPrimalReal(model, solution, static_cast<int>(num_vars));
+        });
     }
 };
 
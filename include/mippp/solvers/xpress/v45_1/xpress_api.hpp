@@ -17,6 +17,8 @@ int XPRSgetlicerrmsg(char * buffer, int maxbytes);
 
 int XPRScreateprob(XPRSprob * p_prob);
 int XPRSdestroyprob(XPRSprob prob);
+int XPRScopyprob(XPRSprob dest, XPRSprob src, const char * name);
+int XPRScopycontrols(XPRSprob dest, XPRSprob src);
 int XPRSgetlasterror(XPRSprob prob, char * errmsg);
 
 enum ObjSense : int { XPRS_OBJ_MINIMIZE = 1, XPRS_OBJ_MAXIMIZE = -1 };
@@ -49,6 +51,7 @@ int XPRSchgrhs(XPRSprob prob, int nrows, const int rowind[],
 
 enum IntergerAttribute : int {
     XPRS_COLS = 1018,
+    XPRS_ORIGINALCOLS = 1214,
     XPRS_ROWS = 1001,
     XPRS_ELEMS = 1006,
     XPRS_LPSTATUS = 1010,
@@ -113,6 +116,10 @@ int XPRSgetduals(XPRSprob prob, int * status, double duals[], int first,
 int XPRSgetredcosts(XPRSprob prob, int * status, double djs[], int first,
                     int last);
 
+// basis statuses of XPRSgetbasis and XPRSloadbasis, rows first
+int XPRSgetbasis(XPRSprob prob, int rstatus[], int cstatus[]);
+int XPRSloadbasis(XPRSprob prob, const int rstatus[], const int cstatus[]);
+
 enum DblCtrlPar : int {
     XPRS_FEASTOL = 7003,
     XPRS_MIPTOL = 7009,
@@ -120,6 +127,9 @@ enum DblCtrlPar : int {
 };
 int XPRSsetdblcontrol(XPRSprob prob, int control, double value);
 int XPRSgetdblcontrol(XPRSprob prob, int control, double * p_value);
+enum IntCtrlPar : int { XPRS_THREADS = 8278 };
+int XPRSsetintcontrol(XPRSprob prob, int control, int value);
+int XPRSgetintcontrol(XPRSprob prob, int control, int * p_value);
 
 int XPRSaddmipsol(XPRSprob prob, int length, const double solval[],
                   const int colind[], const char * name);
@@ -146,12 +156,22 @@ int XPRSremovecboptnode(XPRSprob prob,
 int XPRSaddcuts(XPRSprob prob, int ncuts, const int cuttype[],
                 const char rowtype[], const double rhs[], const int start[],
                 const int colind[], const double cutcoef[]);
+// cuts on the original variables, presolved by Xpress
+int XPRSaddmanagedcuts(XPRSprob prob, int globalvalid, int ncuts,
+                       const char rowtype[], const double rhs[],
+                       const int start[], const int colind[],
+                       const double cutcoef[]);
+// the node relaxation mapped back to the original variables
+int XPRSgetcallbacksolution(XPRSprob prob, int * p_available, double x[],
+                            int first, int last);
 int XPRSloaddelayedrows(XPRSprob prob, int nrows, const int rowind[]);
 
 }  // namespace xpress::v45_1
 }  // namespace mippp
 #endif
 
+#include <memory>
+
 #include "dylib.hpp"
 
 #include "mippp/detail/solver_library.hpp"
@@ -160,54 +180,62 @@ int XPRSloaddelayedrows(XPRSprob prob, int nrows, const int rowind[]);
 namespace mippp {
 namespace xpress::v45_1 {
 
-#define XPRESS_FUNCTIONS(F)                     \
-    F(XPRSinit, init)                           \
-    F(XPRSfree, free)                           \
-    F(XPRSgetlicerrmsg, getlicerrmsg)           \
-    F(XPRScreateprob, createprob)               \
-    F(XPRSdestroyprob, destroyprob)             \
-    F(XPRSgetlasterror, getlasterror)           \
-    F(XPRSchgobjsense, chgobjsense)             \
-    F(XPRSchgobj, chgobj)                       \
-    F(XPRSgetobj, getobj)                       \
-    F(XPRSchgmqobj, chgmqobj)                   \
-    F(XPRSaddcols, addcols)                     \
-    F(XPRSchgbounds, chgbounds)                 \
-    F(XPRSgetlb, getlb)                         \
-    F(XPRSgetub, getub)                         \
-    F(XPRSchgcoltype, chgcoltype)               \
-    F(XPRSaddrows, addrows)                     \
-    F(XPRSchgrowtype, chgrowtype)               \
-    F(XPRSchgrhs, chgrhs)                       \
-    F(XPRSgetintattrib, getintattrib)           \
-    F(XPRSgetstrattrib, getstrattrib)           \
-    F(XPRSgetdblattrib, getdblattrib)           \
-    F(XPRSaddnames, addnames)                   \
-    F(XPRSgetnamelist, getnamelist)             \
-    F(XPRSlpoptimize, lpoptimize)               \
-    F(XPRSmipoptimize, mipoptimize)             \
-    F(XPRSgetsolution, getsolution)             \
-    F(XPRSgetduals, getduals)                   \
-    F(XPRSgetredcosts, getredcosts)             \
-    F(XPRSsetdblcontrol, setdblcontrol)         \
-    F(XPRSgetdblcontrol, getdblcontrol)         \
-    F(XPRSaddmipsol, addmipsol)                 \
-    F(XPRSaddcbpreintsol, addcbpreintsol)       \
-    F(XPRSremovecbpreintsol, removecbpreintsol) \
-    F(XPRSaddcboptnode, addcboptnode)           \
-    F(XPRSremovecboptnode, removecboptnode)     \
-    F(XPRSaddcuts, addcuts)                     \
+#define XPRESS_FUNCTIONS(F)                         \
+    F(XPRSinit, init)                               \
+    F(XPRSfree, free)                               \
+    F(XPRSgetlicerrmsg, getlicerrmsg)               \
+    F(XPRScreateprob, createprob)                   \
+    F(XPRSdestroyprob, destroyprob)                 \
+    F(XPRScopyprob, copyprob)                       \
+    F(XPRScopycontrols, copycontrols)               \
+    F(XPRSgetlasterror, getlasterror)               \
+    F(XPRSchgobjsense, chgobjsense)                 \
+    F(XPRSchgobj, chgobj)                           \
+    F(XPRSgetobj, getobj)                           \
+    F(XPRSchgmqobj, chgmqobj)                       \
+    F(XPRSaddcols, addcols)                         \
+    F(XPRSchgbounds, chgbounds)                     \
+    F(XPRSgetlb, getlb)                             \
+    F(XPRSgetub, getub)                             \
+    F(XPRSchgcoltype, chgcoltype)                   \
+    F(XPRSaddrows, addrows)                         \
+    F(XPRSchgrowtype, chgrowtype)                   \
+    F(XPRSchgrhs, chgrhs)                           \
+    F(XPRSgetintattrib, getintattrib)               \
+    F(XPRSgetstrattrib, getstrattrib)               \
+    F(XPRSgetdblattrib, getdblattrib)               \
+    F(XPRSaddnames, addnames)                       \
+    F(XPRSgetnamelist, getnamelist)                 \
+    F(XPRSlpoptimize, lpoptimize)                   \
+    F(XPRSmipoptimize, mipoptimize)                 \
+    F(XPRSgetsolution, getsolution)                 \
+    F(XPRSgetduals, getduals)                       \
+    F(XPRSgetredcosts, getredcosts)                 \
+    F(XPRSgetbasis, getbasis)                       \
+    F(XPRSloadbasis, loadbasis)                     \
+    F(XPRSsetdblcontrol, setdblcontrol)             \
+    F(XPRSgetdblcontrol, getdblcontrol)             \
+    F(XPRSsetintcontrol, setintcontrol)             \
+    F(XPRSgetintcontrol, getintcontrol)             \
+    F(XPRSaddmipsol, addmipsol)                     \
+    F(XPRSaddcbpreintsol, addcbpreintsol)           \
+    F(XPRSremovecbpreintsol, removecbpreintsol)     \
+    F(XPRSaddcboptnode, addcboptnode)               \
+    F(XPRSremovecboptnode, removecboptnode)         \
+    F(XPRSaddcuts, addcuts)                         \
+    F(XPRSaddmanagedcuts, addmanagedcuts)           \
+    F(XPRSgetcallbacksolution, getcallbacksolution) \
     F(XPRSloaddelayedrows, loaddelayedrows)
 
 #define DECLARE_XPRESS_FUNCTIONS(FULL, SHORT) \
     using SHORT##_fun_t = decltype(FULL);     \
-    SHORT##_fun_t const * SHORT;
+    detail::solver_function<SHORT##_fun_t> SHORT;
 #define CONSTRUCT_XPRESS_FUNCTIONS(FULL, SHORT) \
-    , SHORT(lib.get_function<SHORT##_fun_t>(#FULL))
+    , SHORT(detail::load_solver_function<SHORT##_fun_t>(*lib, #FULL))
 
 class xpress_api {
 private:
-    dylib::library lib;
+    std::shared_ptr<const dylib::library> lib;
 
 public:
     XPRESS_FUNCTIONS(DECLARE_XPRESS_FUNCTIONS)
@@ -1,16 +1,19 @@
 #pragma once
 
+#include <execution>
 #include <memory>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <vector>
 
+#include "mippp/detail/parallel_rows.hpp"
 #include "mippp/linear_constraint.hpp"
 #include "mippp/linear_expression.hpp"
 #include "mippp/model_concepts.hpp"
 #include "mippp/model_entities.hpp"
 
+#include "mippp/solvers/constraints_batch.hpp"
 #include "mippp/solvers/model_base.hpp"
 #include "mippp/solvers/xpress/v45_1/xpress_api.hpp"
 
@@ -44,6 +47,17 @@ protected:
     std::vector<char> tmp_types;
     std::vector<double> tmp_rhs;
 
+    // rows added by add_constraint inside a batch_constraints() scope
+    int _constraints_batch_depth;
+    std::vector<int> staged_begins;
+    std::vector<int> staged_indices;
+    std::vector<double> staged_scalars;
+    std::vector<char> staged_types;
+    std::vector<double> staged_rhs;
+
+    template <typename>
+    friend class mippp::constraints_batch;
+
     void check(const int error) { XPRS->_check(prob, error); }
     static constexpr char constraint_sense_to_xpress_sense(
         constraint_sense rel) {
@@ -60,7 +74,10 @@ protected:
 
 public:
     [[nodiscard]] explicit xpress_base(const xpress_api & api)
-        : model_base<int, double>(), XPRS(&api), objective_offset(0.0) {
+        : model_base<int, double>()
+        , XPRS(&api)
+        , objective_offset(0.0)
+        , _constraints_batch_depth(0) {
         check(XPRS->createprob(&prob));
     }
     ~xpress_base() {
@@ -76,24 +93,57 @@ public:
         , objective_offset(other.objective_offset)
         , tmp_begins(std::move(other.tmp_begins))
         , tmp_types(std::move(other.tmp_types))
-        , tmp_rhs(std::move(other.tmp_rhs)) {
+        , tmp_rhs(std::move(other.tmp_rhs))
+        , _constraints_batch_depth(other._constraints_batch_depth)
+        , staged_begins(std::move(other.staged_begins))
+        , staged_indices(std::move(other.staged_indices))
+        , staged_scalars(std::move(other.staged_scalars))
+        , staged_types(std::move(other.staged_types))
+        , staged_rhs(std::move(other.staged_rhs)) {
         other.prob = nullptr;
     }
 
     constexpr xpress_base & operator=(const xpress_base &) = delete;
     constexpr xpress_base & operator=(xpress_base && other) = delete;
 
+protected:
+    // other on prob_copy, a copy of its problem and controls : the handles
+    // of other stay valid, its staged rows are already added and no
+    // solution is copied
+    xpress_base(const xpress_base & other, XPRSprob prob_copy)
+        : model_base<int, double>(other)
+        , XPRS(other.XPRS)
+        , prob(prob_copy)
+        , objective_offset(other.objective_offset)
+        , _constraints_batch_depth(0) {
+        _invalidate_solution_caches();
+    }
+    xpress_base _clone_base() {
+        _flush_staged_constraints();
+        XPRSprob prob_copy;
+        check(XPRS->createprob(&prob_copy));
+        try {
+            XPRS->_check(prob_copy, XPRS->copyprob(prob_copy, prob, ""));
+            XPRS->_check(prob_copy, XPRS->copycontrols(prob_copy, prob));
+        } catch(...) {
+            XPRS->destroyprob(prob_copy);
+            throw;
+        }
+        return xpress_base(*this, prob_copy);
+    }
+
+public:
     std::size_t num_variables() {
         int num_vars;
         check(XPRS->getintattrib(prob, XPRS_COLS, &num_vars));
         return static_cast<std::size_t>(num_vars);
     }
     std::size_t num_constraints() {
-        int num_constrs;
-        check(XPRS->getintattrib(prob, XPRS_ROWS, &num_constrs));
-        return static_cast<std::size_t>(num_constrs);
+        _flush_staged_constraints();
+        return _num_native_constraints();
     }
     std::size_t num_entries() {
+        _flush_staged_constraints();
         int num_entries;
         check(XPRS->getintattrib(prob, XPRS_ELEMS, &num_entries));
         return static_cast<std::size_t>(num_entries);
@@ -271,6 +321,7 @@ public:
 private:
     template <typename ER>
     inline variable _add_column(ER && entries, const variable_params & params) {
+        _flush_staged_constraints();
         const int var_id = static_cast<int>(num_variables());
         const int cmatbeg = 0;
         _reset_cache();
@@ -341,16 +392,59 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     /////////////////////////////// Constraints ///////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
+protected:
+    std::size_t _num_native_constraints() {
+        int num_constrs;
+        check(XPRS->getintattrib(prob, XPRS_ROWS, &num_constrs));
+        return static_cast<std::size_t>(num_constrs);
+    }
+
+    void _begin_constraints_batch() { ++_constraints_batch_depth; }
+    void _end_constraints_batch() {
+        if(--_constraints_batch_depth == 0) _flush_staged_constraints();
+    }
+    void _discard_constraints_batch() {
+        if(--_constraints_batch_depth == 0) _clear_staged_constraints();
+    }
+    void _clear_staged_constraints() {
+        staged_begins.resize(0);
+        staged_indices.resize(0);
+        staged_scalars.resize(0);
+        staged_types.resize(0);
+        staged_rhs.resize(0);
+    }
+    void _flush_staged_constraints() {
+        if(staged_rhs.empty()) return;
+        const int error = XPRS->addrows(
+            prob, static_cast<int>(staged_rhs.size()),
+            static_cast<int>(staged_indices.size()), staged_types.data(),
+            staged_rhs.data(), nullptr, staged_begins.data(),
+            staged_indices.data(), staged_scalars.data());
+        _clear_staged_constraints();
+        check(error);
+    }
+
 private:
     template <bool distinct, linear_constraint LC>
     constraint _add_constraint(LC && lc) {
-        int constr_id = static_cast<int>(num_constraints());
+        int constr_id =
+            static_cast<int>(_num_native_constraints() + staged_rhs.size());
         if constexpr(!distinct) _prepare_coalescing(num_variables());
         _reset_cache();
         _register_variables_entries<distinct>(lc.linear_terms());
         int matbegin = 0;
         const double b = lc.rhs();
         const char sense = constraint_sense_to_xpress_sense(lc.sense());
+        if(_constraints_batch_depth > 0) {
+            staged_begins.emplace_back(static_cast<int>(staged_indices.size()));
+            staged_indices.insert(staged_indices.end(), tmp_indices.cbegin(),
+                                  tmp_indices.cend());
+            staged_scalars.insert(staged_scalars.end(), tmp_scalars.cbegin(),
+                                  tmp_scalars.cend());
+            staged_types.emplace_back(sense);
+            staged_rhs.emplace_back(b);
+            return constraint(constr_id);
+        }
         check(XPRS->addrows(prob, 1, static_cast<int>(tmp_indices.size()),
                             &sense, &b, nullptr, &matbegin, tmp_indices.data(),
                             tmp_scalars.data()));
@@ -366,6 +460,7 @@ public:
     constraint add_constraint(distinct_variables_t, LC && lc) {
         return _add_constraint<true>(std::forward<LC>(lc));
     }
+    [[nodiscard]] auto batch_constraints() { return constraints_batch(*this); }
 
 private:
     template <bool distinct, linear_constraint LC>
@@ -398,6 +493,7 @@ private:
     }
     template <bool distinct, std::ranges::range IR, typename... CL>
     auto _add_constraints(IR && keys, CL &&... constraint_lambdas) {
+        _flush_staged_constraints();
         if constexpr(!distinct) _prepare_coalescing(num_variables());
         _reset_cache();
         tmp_begins.resize(0);
@@ -433,6 +529,81 @@ public:
         return _add_constraints<true>(std::forward<IR>(keys),
                                       constraint_lambdas...);
     }
+
+private:
+    template <bool distinct, std::ranges::random_access_range IR,
+              typename... CL>
+    auto _add_constraints_parallel(IR && keys, CL &... constraint_lambdas) {
+        _flush_staged_constraints();
+        const int offset = static_cast<int>(_num_native_constraints());
+        auto rows = detail::build_rows_in_parallel<distinct, int, double>(
+            keys, num_variables(),
+            [](const variable & v) { return v.id(); },
+            constraint_lambdas...);
+        const std::size_t num_rows = rows.num_rows();
+        tmp_types.resize(num_rows);
+        std::ranges::transform(rows.senses, tmp_types.begin(),
+                               constraint_sense_to_xpress_sense);
+        check(XPRS->addrows(prob, static_cast<int>(num_rows),
+                            static_cast<int>(rows.indices.size()),
+                            tmp_types.data(), rows.rhs.data(), nullptr,
+                            rows.begins.data(), rows.indices.data(),
+                            rows.scalars.data()));
+        return constraints_range(
+            std::forward<IR>(keys),
+            std::views::transform(
+                std::views::iota(offset,
+                                 offset + static_cast<int>(num_rows)),
+                [](auto && i) { return constraint{i}; }));
+    }
+
+public:
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<false>(std::forward<IR>(keys),
+                                                constraint_lambdas...);
+    }
+    template <std::ranges::random_access_range IR, typename... CL>
+    auto add_constraints(const std::execution::parallel_policy &,
+                         distinct_variables_t, IR && keys,
+                         CL &&... constraint_lambdas) {
+        return _add_constraints_parallel<true>(std::forward<IR>(keys),
+                                               constraint_lambdas...);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    //////////////////////////////// Solution /////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+protected:
+    auto _get_cached_solution() {
+        const auto num_vars = num_variables();
+        return _solution_cache.get(num_vars, [&](double * solution) {
+            check(XPRS->getsolution(prob, nullptr, solution, 0,
+                                    static_cast<int>(num_vars) - 1));
+        });
+    }
+    // XPRSgetsolution reads a range of columns : only the span of the
+    // requested ones is fetched, unless the whole solution is cached
+    template <std::ranges::range VR>
+    std::vector<double> _get_solution_values(VR && vars) {
+        if(const double * x = _solution_cache.cached(num_variables()))
+            return _gather_values(vars, x);
+        tmp_indices.clear();
+        for(auto && v : vars) tmp_indices.emplace_back(v.id());
+        if(tmp_indices.empty()) return {};
+        const auto [min_id, max_id] = std::ranges::minmax(tmp_indices);
+        tmp_scalars.resize(static_cast<std::size_t>(max_id - min_id + 1));
+        check(XPRS->getsolution(prob, nullptr, tmp_scalars.data(), min_id,
+                                max_id));
+        std::vector<double> values;
+        values.reserve(tmp_indices.size());
+        for(auto && id : tmp_indices)
+            values.emplace_back(
+                tmp_scalars[static_cast<std::size_t>(id - min_id)]);
+        return values;
+    }
+
+public:
     ///////////////////////////////////////////////////////////////////////////
     ////////////////////////// Tolerance parameters ///////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -455,6 +626,17 @@ public:
         check(XPRS->getdblcontrol(prob, XPRS_TIMELIMIT, &t));
         return std::chrono::duration<double>(t);
     }
+
+    // -1 lets Xpress choose
+    void set_thread_count(std::size_t n) {
+        check(XPRS->setintcontrol(prob, XPRS_THREADS,
+                                  n == 0 ? -1 : static_cast<int>(n)));
+    }
+    std::size_t get_thread_count() {
+        int n;
+        check(XPRS->getintcontrol(prob, XPRS_THREADS, &n));
+        return n < 0 ? 0 : static_cast<std::size_t>(n);
+    }
 };
 
 }  // namespace xpress::v45_1
@@ -6,6 +6,7 @@
 
 #include "mippp/model_concepts.hpp"
 #include "mippp/model_entities.hpp"
+#include "mippp/model_lp_basis.hpp"
 
 #include "mippp/solvers/xpress/v45_1/xpress_base.hpp"
 
@@ -13,10 +14,16 @@ namespace mippp {
 namespace xpress::v45_1 {
 
 class xpress_lp : public xpress_base {
+private:
+    explicit xpress_lp(xpress_base && base) : xpress_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit xpress_lp(const xpress_api & api)
         : xpress_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] xpress_lp clone() { return xpress_lp(_clone_base()); }
+
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////// Limits //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -83,6 +90,8 @@ public:
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     void solve() {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
         check(XPRS->lpoptimize(prob, nullptr));
         _status = _get_status();
     }
@@ -91,27 +100,78 @@ public:
         check(XPRS->getdblattrib(prob, XPRS_LPOBJVAL, &val));
         return objective_offset + val;
     }
-    auto get_solution() {
-        const auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
-        check(XPRS->getsolution(prob, nullptr, solution.get(), 0,
-                                static_cast<int>(num_vars) - 1));
-        return variable_mapping(std::move(solution));
+    auto get_solution() { return variable_mapping(_get_cached_solution()); }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_solution_values(vars);
     }
     auto get_dual_solution() {
         const auto num_constrs = num_constraints();
-        auto dual_solution =
-            std::make_unique_for_overwrite<double[]>(num_constrs);
-        check(XPRS->getduals(prob, nullptr, dual_solution.get(), 0,
-                             static_cast<int>(num_constrs) - 1));
-        return constraint_mapping(std::move(dual_solution));
+        return constraint_mapping(_dual_solution_cache.get(
+            num_constrs, [&](double * dual_solution) {
+                check(XPRS->getduals(prob, nullptr, dual_solution, 0,
+                                     static_cast<int>(num_constrs) - 1));
+            }));
     }
     auto get_reduced_costs() {
         const auto num_vars = num_variables();
-        auto reduced_costs = std::make_unique_for_overwrite<double[]>(num_vars);
-        check(XPRS->getredcosts(prob, nullptr, reduced_costs.get(), 0,
-                                static_cast<int>(num_vars) - 1));
-        return variable_mapping(std::move(reduced_costs));
+        return variable_mapping(_reduced_costs_cache.get(
+            num_vars, [&](double * reduced_costs) {
+                check(XPRS->getredcosts(prob, nullptr, reduced_costs, 0,
+                                        static_cast<int>(num_vars) - 1));
+            }));
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////// Basis //////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    using basis = model_lp_basis<variable, constraint>;
+
+private:
+    // 0 : nonbasic at lower bound, 1 : basic, 2 : nonbasic at upper bound,
+    // 3 : superbasic
+    static basis::code _basis_code(const int status) {
+        switch(status) {
+            case 1:
+                return basis::code::basic;
+            case 2:
+                return basis::code::nonbasic_at_upper_bound;
+            case 3:
+                return basis::code::nonbasic_free;
+            default:
+                return basis::code::nonbasic_at_lower_bound;
+        }
+    }
+    static int _basis_status(const basis::code code) {
+        switch(code) {
+            case basis::code::basic:
+                return 1;
+            case basis::code::nonbasic_free:
+                return 3;
+            case basis::code::nonbasic_at_upper_bound:
+                return 2;
+            default:
+                return 0;
+        }
+    }
+    static std::size_t _handle_id(const std::size_t i) { return i; }
+
+public:
+    // the basis of the last solve, read with one XPRSgetbasis call
+    basis get_basis() {
+        std::vector<int> rstatus(num_constraints());
+        std::vector<int> cstatus(num_variables());
+        check(XPRS->getbasis(prob, rstatus.data(), cstatus.data()));
+        return basis::from_native(cstatus, rstatus, cstatus.size(),
+                                  _handle_id, _basis_code, _basis_code);
+    }
+    // warm starts the next solve from b, loaded with one XPRSloadbasis call
+    void set_basis(const basis & b) {
+        std::vector<int> rstatus(num_constraints());
+        std::vector<int> cstatus(num_variables());
+        b.to_native(cstatus, rstatus, _handle_id, _basis_status,
+                    _basis_status);
+        check(XPRS->loadbasis(prob, rstatus.data(), cstatus.data()));
     }
 };
 
@@ -14,10 +14,16 @@ namespace mippp {
 namespace xpress::v45_1 {
 
 class xpress_milp : public xpress_base {
+private:
+    explicit xpress_milp(xpress_base && base) : xpress_base(std::move(base)) {}
+
 public:
     [[nodiscard]] explicit xpress_milp(const xpress_api & api)
         : xpress_base(api) {}
 
+    // an independent copy of the model, in which its handles stay valid
+    [[nodiscard]] xpress_milp clone() { return xpress_milp(_clone_base()); }
+
     variable add_integer_variable(
         const variable_params params = default_variable_params) {
         int var_id = static_cast<int>(num_variables());
@@ -135,9 +141,62 @@ public:
         }
     };
 
+    // The node problem is presolved : the relaxation and the cuts are mapped
+    // from and to the original variables by Xpress.
+    class node_relaxation_callback_handle : public callback_handle_base {
+    public:
+        node_relaxation_callback_handle(const xpress_api * api,
+                                        XPRSprob prob_,
+                                        const double obj_offset)
+            : callback_handle_base(api, prob_, obj_offset) {}
+
+        std::size_t num_variables() {
+            int num_vars;
+            check(XPRS->getintattrib(prob, XPRS_ORIGINALCOLS, &num_vars));
+            return static_cast<std::size_t>(num_vars);
+        }
+
+    private:
+        template <bool distinct, linear_constraint LC>
+        void _add_cut(LC && lc) {
+            if constexpr(!distinct) _prepare_coalescing(num_variables());
+            _reset_cache();
+            _register_variables_entries<distinct>(lc.linear_terms());
+            const char rowtype = constraint_sense_to_xpress_sense(lc.sense());
+            const double rhs = lc.rhs();
+            const int start[] = {0, static_cast<int>(tmp_indices.size())};
+            check(XPRS->addmanagedcuts(prob, 1, 1, &rowtype, &rhs, start,
+                                       tmp_indices.data(),
+                                       tmp_scalars.data()));
+        }
+
+    public:
+        template <linear_constraint LC>
+        void add_cut(LC && lc) {
+            _add_cut<false>(std::forward<LC>(lc));
+        }
+        template <linear_constraint LC>
+        void add_cut(distinct_variables_t, LC && lc) {
+            _add_cut<true>(std::forward<LC>(lc));
+        }
+        auto get_relaxation_solution() {
+            const auto num_vars = num_variables();
+            auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
+            int available;
+            check(XPRS->getcallbacksolution(prob, &available, solution.get(),
+                                            0, static_cast<int>(num_vars) - 1));
+            if(!available)
+                throw std::runtime_error(
+                    "Xpress: no relaxation solution available");
+            return variable_mapping(std::move(solution));
+        }
+    };
+
 private:
     std::function<void(candidate_solution_callback_handle &)>
         candidate_solution_callback;
+    std::function<void(node_relaxation_callback_handle &)>
+        node_relaxation_callback;
 
     static void candidate_solution_callback_fun(
         XPRSprob cbprob, void * cbdata, [[maybe_unused]] int soltype,
@@ -147,6 +206,13 @@ private:
             model->XPRS, cbprob, model->objective_offset, p_reject);
         model->candidate_solution_callback(handle);
     }
+    static void node_relaxation_callback_fun(
+        XPRSprob cbprob, void * cbdata, [[maybe_unused]] int * p_infeasible) {
+        auto * model = static_cast<xpress_milp *>(cbdata);
+        node_relaxation_callback_handle handle(model->XPRS, cbprob,
+                                               model->objective_offset);
+        model->node_relaxation_callback(handle);
+    }
 
 public:
     template <typename F>
@@ -155,6 +221,13 @@ public:
         check(XPRS->addcbpreintsol(prob, candidate_solution_callback_fun, this,
                                    1));
     }
+    template <typename F>
+    void set_node_relaxation_callback(F && f) {
+        if(!node_relaxation_callback)
+            check(XPRS->addcboptnode(prob, node_relaxation_callback_fun, this,
+                                     1));
+        node_relaxation_callback = std::forward<F>(f);
+    }
     ///////////////////////////////////////////////////////////////////////////
     //////////////////////////////// MIP start ////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -261,19 +334,22 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     ////////////////////////////////// Solve //////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
-    void solve() { check(XPRS->mipoptimize(prob, nullptr)); }
+    void solve() {
+        _flush_staged_constraints();
+        _invalidate_solution_caches();
+        check(XPRS->mipoptimize(prob, nullptr));
+    }
 
     double get_solution_value() {
         double val;
         check(XPRS->getdblattrib(prob, XPRS_MIPOBJVAL, &val));
         return objective_offset + val;
     }
-    auto get_solution() {
-        const auto num_vars = num_variables();
-        auto solution = std::make_unique_for_overwrite<double[]>(num_vars);
-        check(XPRS->getsolution(prob, nullptr, solution.get(), 0,
-                                static_cast<int>(num_vars) - 1));
-        return variable_mapping(std::move(solution));
+    auto get_solution() { return variable_mapping(_get_cached_solution()); }
+    template <std::ranges::range VR>
+        requires std::same_as<std::ranges::range_value_t<VR>, variable>
+    std::vector<double> get_solution(VR && vars) {
+        return _get_solution_values(vars);
     }
 };
 
@@ -4,6 +4,7 @@
 #include <array>
 #include <concepts>
 #include <cstddef>
+#include <functional>
 #include <limits>
 #include <ranges>
 #include <tuple>
@@ -441,12 +442,58 @@ struct at_most_k_random : at_most_k<Pred> {
 template <typename G, typename Pred>
 at_most_k_random(std::size_t, G, Pred) -> at_most_k_random<Pred, G>;
 
+namespace detail {
+// Streams the positions [0, n) and keeps in heap the (at most) k least ones
+// under less, as a max-heap : the worst kept position is on top, and is
+// replaced whenever a better one streams by. O(n log k) time, and no
+// allocation once heap has grown to k.
+template <typename Less>
+void bounded_heap_select(const std::size_t n, const std::size_t k,
+                         Less && less, std::vector<std::size_t> & heap) {
+    heap.resize(0);
+    if(k == 0) return;
+    std::size_t i = 0;
+    for(; i < n && heap.size() < k; ++i) heap.emplace_back(i);
+    std::ranges::make_heap(heap, less);
+    for(; i < n; ++i) {
+        if(!less(i, heap.front())) continue;
+        std::ranges::pop_heap(heap, less);
+        heap.back() = i;
+        std::ranges::push_heap(heap, less);
+    }
+}
+
+// The candidates handed to select by column_manager : a random access range
+// that outlives the selection, which can thus be returned as positions.
+template <typename R>
+concept indexable_candidates = std::ranges::random_access_range<R> &&
+                               std::ranges::sized_range<R> &&
+                               std::ranges::borrowed_range<R>;
+
+template <typename R>
+auto candidates_at(R & candidates) {
+    return [first = std::ranges::begin(candidates)](
+               std::size_t i) -> std::ranges::range_reference_t<R> {
+        return first[static_cast<std::ranges::range_difference_t<R>>(i)];
+    };
+}
+}  // namespace detail
+
 // the 'count' best candidates according to 'cmp' (applied to entries, lesser
-// is better)
+// is better), in unspecified order unless 'sorted' is set, then best first.
+// The candidates are streamed through a bounded heap whose buffer is kept
+// from a select to the next, so that a strategy object reused across the
+// pricing rounds selects without allocating; select is thus not reentrant.
 template <typename Pred, typename Comp>
 struct at_most_k_best : at_most_k<Pred> {
     using at_most_k<Pred>::count;
     [[no_unique_address]] Comp cmp;
+    bool sorted = false;
+
+private:
+    mutable std::vector<std::size_t> _heap;
+
+public:
     template <typename C, typename... T>
         requires std::constructible_from<Comp, C &&> &&
                      std::constructible_from<Pred, T &&...>
@@ -455,19 +502,117 @@ struct at_most_k_best : at_most_k<Pred> {
         , cmp(std::forward<C>(cmp_)) {}
     template <std::ranges::range R, typename Proj = std::identity>
     auto select(R && candidates, Proj proj = {}) const {
-        auto selected = std::ranges::to<std::vector>(candidates);
-        const std::size_t budget =
-            std::min<std::size_t>(count, selected.size());
-        std::ranges::nth_element(
-            selected, selected.begin() + static_cast<std::ptrdiff_t>(budget),
-            cmp, proj);
-        selected.resize(budget);
-        return selected;
+        if constexpr(detail::indexable_candidates<R>) {
+            auto at = detail::candidates_at(candidates);
+            auto less = [&](std::size_t a, std::size_t b) {
+                return std::invoke(cmp, std::invoke(proj, at(a)),
+                                   std::invoke(proj, at(b)));
+            };
+            detail::bounded_heap_select(std::ranges::size(candidates), count,
+                                        less, _heap);
+            if(sorted) std::ranges::sort_heap(_heap, less);
+            return std::views::transform(_heap, at);
+        } else {
+            auto selected = std::ranges::to<std::vector>(candidates);
+            select(selected, proj);
+            return std::ranges::to<std::vector>(
+                std::views::transform(_heap, detail::candidates_at(selected)));
+        }
     }
 };
 template <typename C, typename Pred>
 at_most_k_best(std::size_t, C, Pred) -> at_most_k_best<Pred, C>;
 
+// The 'count' candidates of lowest (or highest) property P, e.g. the most
+// negative reduced costs. Same as at_most_k_best with a comparator reading P,
+// but the values of P are first gathered into a contiguous buffer : the
+// blocks of candidates that cannot enter the heap are then discarded on
+// their best value, a reduction that the compiler vectorizes when P is a
+// plain double.
+template <typename P, typename Pred, typename Comp>
+    requires std::totally_ordered<typename P::value_type>
+struct at_most_k_extreme : at_most_k<Pred> {
+    using at_most_k<Pred>::count;
+    bool sorted = false;
+
+private:
+    mutable std::vector<typename P::value_type> _values;
+    mutable std::vector<std::size_t> _heap;
+
+public:
+    template <typename... T>
+        requires std::constructible_from<Pred, T &&...>
+    at_most_k_extreme(const std::size_t & count_, T &&... args)
+        : at_most_k<Pred>(count_, std::forward<T>(args)...) {}
+    template <std::ranges::range R, typename Proj = std::identity>
+    auto select(R && candidates, Proj proj = {}) const {
+        if constexpr(detail::indexable_candidates<R>) {
+            auto at = detail::candidates_at(candidates);
+            const std::size_t n = std::ranges::size(candidates);
+            _values.resize(n);
+            for(std::size_t i = 0; i < n; ++i)
+                _values[i] = std::get<1>(std::invoke(proj, at(i)))
+                                .template get<P>();
+            _select(n);
+            return std::views::transform(_heap, at);
+        } else {
+            auto selected = std::ranges::to<std::vector>(candidates);
+            select(selected, proj);
+            return std::ranges::to<std::vector>(
+                std::views::transform(_heap, detail::candidates_at(selected)));
+        }
+    }
+
+private:
+    static constexpr std::size_t lanes = 4;
+    static constexpr std::size_t block_size = 16;
+
+    // the best value of the block [i, i + block_size), reduced over lanes
+    // independent accumulators that the compiler maps to SIMD min/max
+    static auto _best_of_block(const Comp & comp,
+                               const typename P::value_type * v) {
+        std::array<typename P::value_type, lanes> best;
+        for(std::size_t l = 0; l < lanes; ++l) best[l] = v[l];
+        for(std::size_t j = lanes; j < block_size; j += lanes)
+            for(std::size_t l = 0; l < lanes; ++l)
+                if(comp(v[j + l], best[l])) best[l] = v[j + l];
+        for(std::size_t l = 1; l < lanes; ++l)
+            if(comp(best[l], best[0])) best[0] = best[l];
+        return best[0];
+    }
+
+    void _select(const std::size_t n) const {
+        const Comp comp{};
+        const auto * v = _values.data();
+        auto less = [&](std::size_t a, std::size_t b) {
+            return comp(v[a], v[b]);
+        };
+        const std::size_t k = std::min(count, n);
+        detail::bounded_heap_select(k, k, less, _heap);
+        std::size_t i = k;
+        const auto push = [&](std::size_t j) {
+            if(!comp(v[j], v[_heap.front()])) return;
+            std::ranges::pop_heap(_heap, less);
+            _heap.back() = j;
+            std::ranges::push_heap(_heap, less);
+        };
+        if(k > 0) {
+            for(; i + block_size <= n; i += block_size) {
+                if(!comp(_best_of_block(comp, v + i), v[_heap.front()]))
+                    continue;
+                for(std::size_t j = i; j < i + block_size; ++j) push(j);
+            }
+            for(; i < n; ++i) push(i);
+        }
+        if(sorted) std::ranges::sort_heap(_heap, less);
+    }
+};
+
+template <typename P, typename Pred = conjunction<>>
+using at_most_k_lowest = at_most_k_extreme<P, Pred, std::ranges::less>;
+template <typename P, typename Pred = conjunction<>>
+using at_most_k_highest = at_most_k_extreme<P, Pred, std::ranges::greater>;
+
 using evict_never = none;
 
 // evicts columns whose reduced cost stayed above 'threshold' for their K last
@@ -3,16 +3,19 @@
 #include <algorithm>
 #include <concepts>
 #include <cstddef>
+#include <limits>
 #include <optional>
 #include <ranges>
+#include <thread>
 #include <type_traits>
 #include <utility>
-#include <variant>
 #include <vector>
 
 #include "mippp/container/unordered_dense_map.hpp"
+#include "mippp/detail/flat_hash_index.hpp"
 #include "mippp/model_concepts.hpp"
 #include "mippp/utility/column_generation.hpp"
+#include "mippp/utility/parallel_solve.hpp"
 
 namespace mippp {
 
@@ -52,53 +55,114 @@ public:
     };
 
 private:
-    using column_entry = std::variant<in_pool_state, in_master_state>;
-    using column_map =
-        unordered_dense_map<ColumnSeed, column_entry, Hash, KeyEqual>;
-    using map_value_type = column_map::value_type;
+    // The pool and master columns live in two maps, each storing its entries
+    // contiguously : scans, updates and views only touch the relevant side,
+    // and a transition moves one entry from a map to the other.
+    using pool_map =
+        unordered_dense_map<ColumnSeed, in_pool_state, Hash, KeyEqual>;
+    using master_map =
+        unordered_dense_map<ColumnSeed, in_master_state, Hash, KeyEqual>;
+    using pool_value_type = typename pool_map::value_type;
+    using master_value_type = typename master_map::value_type;
 
     struct in_pool_entry_proj {
-        in_pool_entry operator()(map_value_type * node) const {
-            return {node->first, std::get<in_pool_state>(node->second)};
+        in_pool_entry operator()(const pool_value_type * node) const {
+            return {node->first, node->second};
         }
-        in_pool_entry operator()(const map_value_type & node) const {
-            return {node.first, std::get<in_pool_state>(node.second)};
+        in_pool_entry operator()(const pool_value_type & node) const {
+            return {node.first, node.second};
         }
     };
     struct in_master_entry_proj {
-        in_master_entry operator()(map_value_type * node) const {
-            return {node->first, std::get<in_master_state>(node->second)};
+        in_master_entry operator()(const master_value_type * node) const {
+            return {node->first, node->second};
         }
-        in_master_entry operator()(const map_value_type & node) const {
-            return {node.first, std::get<in_master_state>(node.second)};
+        in_master_entry operator()(const master_value_type & node) const {
+            return {node.first, node.second};
         }
     };
 
-    column_map _columns;
-    std::size_t _num_master_columns = 0;
-    // scratch buffer reused across the pricing rounds; the node pointers stay
-    // valid while selecting/transitioning because manage_columns never
-    // inserts nor erases
-    std::vector<map_value_type *> _tmp_candidates;
-
 public:
-    void reserve(std::size_t num_columns) { _columns.reserve(num_columns); }
-    std::size_t num_columns() const noexcept { return _columns.size(); }
-    std::size_t num_master_columns() const noexcept {
-        return _num_master_columns;
+    // The seeds generated by one pricing thread, hashed as they are staged so
+    // that emplace_staged_columns does not hash them again. Each thread
+    // stages into its own buffer, so staging needs no synchronization.
+    class staging_buffer {
+    private:
+        friend column_manager;
+        std::vector<ColumnSeed> _seeds;
+        std::vector<std::size_t> _hashes;
+
+    public:
+        template <typename S>
+            requires std::constructible_from<ColumnSeed, S &&>
+        void stage(S && seed) {
+            _seeds.emplace_back(std::forward<S>(seed));
+            _hashes.emplace_back(pool_map::hash_of(_seeds.back()));
+        }
+        void reserve(std::size_t n) {
+            _seeds.reserve(n);
+            _hashes.reserve(n);
+        }
+        std::size_t size() const noexcept { return _seeds.size(); }
+        bool empty() const noexcept { return _seeds.empty(); }
+        void clear() noexcept {
+            _seeds.clear();
+            _hashes.clear();
+        }
+    };
+
+private:
+    pool_map _pool;
+    master_map _master;
+    // scratch buffers reused across the pricing rounds; the node pointers
+    // stay valid while selecting because the maps are only modified once the
+    // selection is consumed
+    std::vector<pool_value_type *> _tmp_pool_candidates;
+    std::vector<master_value_type *> _tmp_master_candidates;
+    std::vector<std::size_t> _tmp_positions;
+
+    // Below this many staged seeds per thread, emplace_staged_columns spends
+    // more on spawning threads than it saves.
+    static constexpr std::size_t min_staged_seeds_per_thread = 4096;
+
+    struct staged_seed {
+        std::size_t buffer;
+        std::size_t i;
+    };
+    // The partition of a staged seed, from the high bits of its hash : the
+    // flat_hash_index of a partition probes with the low bits, which thus
+    // stay as spread as in the pool.
+    static std::size_t _staging_partition(const std::size_t hash,
+                                          const std::size_t num_partitions) {
+        constexpr int shift = std::numeric_limits<std::size_t>::digits - 16;
+        return ((hash >> shift) * num_partitions) >> 16;
     }
-    std::size_t num_pool_columns() const noexcept {
-        return _columns.size() - _num_master_columns;
+
+    // Erases the entries at the positions of _tmp_positions, whose seeds may
+    // have been moved from. Erasure is swap-and-pop, so the positions are
+    // erased from the last one, that no later erasure can displace.
+    template <typename Map>
+    void _erase_positions(Map & map) {
+        std::ranges::sort(_tmp_positions, std::ranges::greater{});
+        for(const std::size_t i : _tmp_positions)
+            map.erase(map.begin() + static_cast<std::ptrdiff_t>(i));
     }
+
+public:
+    // reserves the pool, where most columns live
+    void reserve(std::size_t num_columns) { _pool.reserve(num_columns); }
+    std::size_t num_columns() const noexcept {
+        return _pool.size() + _master.size();
+    }
+    std::size_t num_master_columns() const noexcept { return _master.size(); }
+    std::size_t num_pool_columns() const noexcept { return _pool.size(); }
     bool contains(const ColumnSeed & seed) const {
-        return _columns.contains(seed);
+        return _pool.contains(seed) || _master.contains(seed);
     }
     std::optional<variable> master_variable(const ColumnSeed & seed) const {
-        auto it = _columns.find(seed);
-        if(it == _columns.end() ||
-           !std::holds_alternative<in_master_state>(it->second))
-            return std::nullopt;
-        return std::get<in_master_state>(it->second).var;
+        auto it = _master.find(seed);
+        if(it == _master.end()) return std::nullopt;
+        return it->second.var;
     }
 
     ////////////////////////////// emplacement //////////////////////////////
@@ -106,7 +170,8 @@ public:
     template <typename S>
         requires std::constructible_from<ColumnSeed, S &&>
     bool emplace_column(S && seed) {
-        return _columns.try_emplace(std::forward<S>(seed), in_pool_state{})
+        if(_master.contains(seed)) return false;
+        return _pool.try_emplace(std::forward<S>(seed), in_pool_state{})
             .second;
     }
     // registers a column already added to the master model, e.g. the initial
@@ -114,12 +179,10 @@ public:
     template <typename S>
         requires std::constructible_from<ColumnSeed, S &&>
     bool emplace_master_column(S && seed, variable v) {
+        if(_pool.contains(seed)) return false;
         auto && [it, inserted] =
-            _columns.try_emplace(std::forward<S>(seed), in_master_state{v});
-        if(inserted) {
-            std::get<in_master_state>(it->second).notify(activated{});
-            ++_num_master_columns;
-        }
+            _master.try_emplace(std::forward<S>(seed), in_master_state{v});
+        if(inserted) it->second.notify(activated{});
         return inserted;
     }
     template <std::ranges::input_range R>
@@ -128,20 +191,128 @@ public:
     emplace_columns_result emplace_columns(R && seeds) {
         emplace_columns_result result;
         for(auto && seed : seeds) {
-            auto && [it, inserted] = _columns.try_emplace(
-                std::forward<decltype(seed)>(seed), in_pool_state{});
-            if(inserted) {
-                ++result.num_inserted;
+            if(!_master.empty() && _master.contains(seed)) {
+                ++result.num_already_in_master;
                 continue;
             }
-            if(std::holds_alternative<in_master_state>(it->second))
-                ++result.num_already_in_master;
+            if(_pool.try_emplace(std::forward<decltype(seed)>(seed),
+                                 in_pool_state{})
+                   .second)
+                ++result.num_inserted;
             else
                 ++result.num_already_in_pool;
         }
         return result;
     }
 
+    // Merges the staging buffers of concurrent pricing threads, then clears
+    // them, with the same outcome and counts as emplace_columns over the
+    // concatenated buffers. The seeds are first looked up in the master and
+    // the pool by chunks, then deduplicated among themselves by partitions of
+    // the hash space, both in parallel ; only the final insertion of the new
+    // seeds in the pool is serial, and it hashes nothing. num_threads = 0
+    // picks a thread count suited to the number of staged seeds.
+    template <std::ranges::random_access_range R>
+        requires std::ranges::sized_range<R> &&
+                 std::same_as<std::ranges::range_reference_t<R>,
+                              staging_buffer &>
+    emplace_columns_result emplace_staged_columns(
+        R && buffers, const std::size_t num_threads = 0) {
+        const auto buffer = [&](std::size_t b) -> staging_buffer & {
+            return std::ranges::begin(buffers)[static_cast<
+                std::ranges::range_difference_t<R>>(b)];
+        };
+        const std::size_t num_buffers = std::ranges::size(buffers);
+        std::vector<std::size_t> offsets(num_buffers + 1, 0);
+        for(std::size_t b = 0; b < num_buffers; ++b)
+            offsets[b + 1] = offsets[b] + buffer(b).size();
+        const std::size_t num_staged = offsets.back();
+        const std::size_t num_workers =
+            std::max<std::size_t>(1, std::min(num_staged, [&]() {
+                if(num_threads > 0) return num_threads;
+                return std::min<std::size_t>(
+                    num_staged / min_staged_seeds_per_thread,
+                    std::thread::hardware_concurrency());
+            }()));
+
+        // lookups in the master and the pool, chunk t of the concatenated
+        // buffers on worker t, that files the new seeds by partition
+        std::vector<std::vector<std::vector<staged_seed>>> filed(
+            num_workers, std::vector<std::vector<staged_seed>>(num_workers));
+        std::vector<emplace_columns_result> results(num_workers);
+        detail::run_jobs_in_parallel(
+            num_workers, num_workers, [&](std::size_t t) {
+                const std::size_t first = num_staged * t / num_workers;
+                const std::size_t last = num_staged * (t + 1) / num_workers;
+                std::size_t b = static_cast<std::size_t>(
+                    std::ranges::upper_bound(offsets, first) -
+                    offsets.begin() - 1);
+                for(std::size_t g = first; g < last; ++g) {
+                    while(g == offsets[b + 1]) ++b;
+                    const std::size_t i = g - offsets[b];
+                    const ColumnSeed & seed = buffer(b)._seeds[i];
+                    const std::size_t hash = buffer(b)._hashes[i];
+                    if(!_master.empty() && _master.contains(seed, hash))
+                        ++results[t].num_already_in_master;
+                    else if(_pool.contains(seed, hash))
+                        ++results[t].num_already_in_pool;
+                    else
+                        filed[t][_staging_partition(hash, num_workers)]
+                            .push_back({b, i});
+                }
+            });
+
+        // deduplication of the new seeds of partition p, in staging order,
+        // the first occurrence of a seed being the one inserted
+        std::vector<std::vector<staged_seed>> new_seeds(num_workers);
+        detail::run_jobs_in_parallel(
+            num_workers, num_workers, [&](std::size_t p) {
+                detail::flat_hash_index index;
+                std::vector<std::size_t> hashes;
+                for(std::size_t t = 0; t < num_workers; ++t) {
+                    for(const staged_seed & s : filed[t][p]) {
+                        const ColumnSeed & seed = buffer(s.buffer)._seeds[s.i];
+                        const std::size_t hash =
+                            buffer(s.buffer)._hashes[s.i];
+                        const auto duplicate = [&](std::size_t j) {
+                            const staged_seed & o = new_seeds[p][j];
+                            return hashes[j] == hash &&
+                                   KeyEqual{}(buffer(o.buffer)._seeds[o.i],
+                                              seed);
+                        };
+                        if(index.find(hash, duplicate) !=
+                           detail::flat_hash_index::npos) {
+                            ++results[p].num_already_in_pool;
+                            continue;
+                        }
+                        new_seeds[p].push_back(s);
+                        hashes.push_back(hash);
+                        index.insert(hashes);
+                    }
+                }
+            });
+
+        emplace_columns_result result;
+        std::size_t num_new = 0;
+        for(std::size_t t = 0; t < num_workers; ++t) {
+            result.num_already_in_pool += results[t].num_already_in_pool;
+            result.num_already_in_master += results[t].num_already_in_master;
+            num_new += new_seeds[t].size();
+        }
+        _pool.reserve(_pool.size() + num_new);
+        for(auto && partition : new_seeds) {
+            for(const staged_seed & s : partition) {
+                staging_buffer & b = buffer(s.buffer);
+                _pool.try_emplace_hashed(b._hashes[s.i],
+                                         std::move(b._seeds[s.i]),
+                                         in_pool_state{});
+            }
+        }
+        result.num_inserted = num_new;
+        for(std::size_t b = 0; b < num_buffers; ++b) buffer(b).clear();
+        return result;
+    }
+
     //////////////////////////////// pricing ////////////////////////////////
 
     // The update methods broadcast events (see column_generation.hpp) to the
@@ -157,9 +328,7 @@ public:
     template <typename F>
         requires std::invocable<F &, const ColumnSeed &>
     void update_pool_columns(F && make_event) {
-        for(auto & [seed, entry] : _columns)
-            if(auto * state = std::get_if<in_pool_state>(&entry))
-                state->notify(make_event(seed));
+        for(auto & [seed, state] : _pool) state.notify(make_event(seed));
     }
 
     // broadcasts to every master column the event produced by
@@ -174,9 +343,8 @@ public:
     template <typename F>
         requires std::invocable<F &, const ColumnSeed &, const variable &>
     void update_master_columns(F && make_event) {
-        for(auto & [seed, entry] : _columns)
-            if(auto * state = std::get_if<in_master_state>(&entry))
-                state->notify(make_event(seed, state->var));
+        for(auto & [seed, state] : _master)
+            state.notify(make_event(seed, state.var));
     }
 
     // broadcasts to every column the event produced by make_event(seed), e.g.
@@ -185,25 +353,18 @@ public:
     template <typename F>
         requires std::invocable<F &, const ColumnSeed &>
     void update_columns(F && make_event) {
-        for(auto & [seed, entry] : _columns)
-            std::visit([&](auto & state) { state.notify(make_event(seed)); },
-                       entry);
+        for(auto & [seed, state] : _pool) state.notify(make_event(seed));
+        for(auto & [seed, state] : _master) state.notify(make_event(seed));
     }
 
     // broadcasts pool_event(seed) to pool columns and
-    // master_event(seed, var) to master columns in a single pass
+    // master_event(seed, var) to master columns
     template <typename PF, typename MF>
         requires std::invocable<PF &, const ColumnSeed &> &&
                  std::invocable<MF &, const ColumnSeed &, const variable &>
     void update_columns(PF && pool_event, MF && master_event) {
-        for(auto & [seed, entry] : _columns) {
-            if(auto * state = std::get_if<in_pool_state>(&entry))
-                state->notify(pool_event(seed));
-            else {
-                auto & ms = std::get<in_master_state>(entry);
-                ms.notify(master_event(seed, ms.var));
-            }
-        }
+        update_pool_columns(pool_event);
+        update_master_columns(master_event);
     }
 
     /////////////////////////////// management ///////////////////////////////
@@ -220,18 +381,21 @@ public:
     //         model.remove_variables(std::views::transform(
     //             evicted_entries, [](auto && e) { return e.second.var; }));
     //     }
+    // Only the master columns are scanned for eviction and only the pool
+    // columns for activation.
     template <typename AS, typename ES, typename AF, typename RF>
         requires requires(AS & as, ES & es, AF & add, Model & m,
                           const in_pool_entry & pe, const in_master_entry & me,
-                          std::vector<map_value_type *> & candidates,
+                          std::vector<pool_value_type *> & pool_candidates,
+                          std::vector<master_value_type *> & master_candidates,
                           const ColumnSeed & seed) {
             { as.predicate(pe) } -> std::convertible_to<bool>;
             { es.predicate(me) } -> std::convertible_to<bool>;
             {
-                as.select(candidates, in_pool_entry_proj{})
+                as.select(pool_candidates, in_pool_entry_proj{})
             } -> std::ranges::input_range;
             {
-                es.select(candidates, in_master_entry_proj{})
+                es.select(master_candidates, in_master_entry_proj{})
             } -> std::ranges::input_range;
             { add(m, seed) } -> std::convertible_to<variable>;
         }
@@ -243,48 +407,46 @@ public:
         manage_columns_result result;
         // the candidates are materialized as node handles before any
         // selection or transition : the strategies may thus copy, reorder or
-        // iterate them at will and the transitions below mutate the actual
-        // map nodes instead of going through live filter views
-        _tmp_candidates.resize(0);
-        for(auto & node : _columns) {
-            if(auto * state = std::get_if<in_master_state>(&node.second);
-               state != nullptr &&
-               eviction_strategy.predicate(in_master_entry{node.first, *state}))
-                _tmp_candidates.emplace_back(&node);
-        }
-        auto && nodes_to_evict =
-            eviction_strategy.select(_tmp_candidates, in_master_entry_proj{});
+        // iterate them at will, and the maps are modified only once the
+        // selected nodes have all been moved to the other side
+        _tmp_master_candidates.resize(0);
+        for(auto & node : _master)
+            if(eviction_strategy.predicate(in_master_entry_proj{}(node)))
+                _tmp_master_candidates.emplace_back(&node);
+        auto && nodes_to_evict = eviction_strategy.select(
+            _tmp_master_candidates, in_master_entry_proj{});
         remove_columns_lambda(
             model,
             std::views::transform(nodes_to_evict, in_master_entry_proj{}));
-        for(map_value_type * node : nodes_to_evict) {
+        _tmp_positions.resize(0);
+        for(master_value_type * node : nodes_to_evict) {
             in_pool_state new_state{};
-            detail::transfer_common_properties(
-                std::get<in_master_state>(node->second), new_state);
+            detail::transfer_common_properties(node->second, new_state);
             new_state.notify(deactivated{});
-            node->second = std::move(new_state);
-            ++result.num_evicted;
+            _pool.try_emplace(std::move(node->first), std::move(new_state));
+            _tmp_positions.emplace_back(
+                static_cast<std::size_t>(node - _master.values().data()));
         }
-        _num_master_columns -= result.num_evicted;
-
-        _tmp_candidates.resize(0);
-        for(auto & node : _columns) {
-            if(auto * state = std::get_if<in_pool_state>(&node.second);
-               state != nullptr &&
-               activation_strategy.predicate(in_pool_entry{node.first, *state}))
-                _tmp_candidates.emplace_back(&node);
-        }
-        auto && nodes_to_activate =
-            activation_strategy.select(_tmp_candidates, in_pool_entry_proj{});
-        for(map_value_type * node : nodes_to_activate) {
+        result.num_evicted = _tmp_positions.size();
+        _erase_positions(_master);
+
+        _tmp_pool_candidates.resize(0);
+        for(auto & node : _pool)
+            if(activation_strategy.predicate(in_pool_entry_proj{}(node)))
+                _tmp_pool_candidates.emplace_back(&node);
+        auto && nodes_to_activate = activation_strategy.select(
+            _tmp_pool_candidates, in_pool_entry_proj{});
+        _tmp_positions.resize(0);
+        for(pool_value_type * node : nodes_to_activate) {
             in_master_state new_state{add_column_lambda(model, node->first)};
-            detail::transfer_common_properties(
-                std::get<in_pool_state>(node->second), new_state);
+            detail::transfer_common_properties(node->second, new_state);
             new_state.notify(activated{});
-            node->second = std::move(new_state);
-            ++result.num_activated;
+            _master.try_emplace(std::move(node->first), std::move(new_state));
+            _tmp_positions.emplace_back(
+                static_cast<std::size_t>(node - _pool.values().data()));
         }
-        _num_master_columns += result.num_activated;
+        result.num_activated = _tmp_positions.size();
+        _erase_positions(_pool);
         return result;
     }
     template <typename AS, typename ES, typename AF>
@@ -317,26 +479,18 @@ public:
     template <typename F>
         requires detail::column_predicate<F, in_pool_entry>
     std::size_t purge_pool(F && predicate) {
-        return erase_if(_columns, [&](map_value_type & node) {
-            auto * state = std::get_if<in_pool_state>(&node.second);
-            return state != nullptr &&
-                   predicate(in_pool_entry{node.first, *state});
+        return erase_if(_pool, [&](const pool_value_type & node) {
+            return predicate(in_pool_entry_proj{}(node));
         });
     }
 
     ///////////////////////////////// views /////////////////////////////////
 
     auto pool_columns() const noexcept {
-        return _columns | std::views::filter([](const map_value_type & node) {
-                   return std::holds_alternative<in_pool_state>(node.second);
-               }) |
-               std::views::transform(in_pool_entry_proj{});
+        return _pool | std::views::transform(in_pool_entry_proj{});
     }
     auto master_columns() const noexcept {
-        return _columns | std::views::filter([](const map_value_type & node) {
-                   return std::holds_alternative<in_master_state>(node.second);
-               }) |
-               std::views::transform(in_master_entry_proj{});
+        return _master | std::views::transform(in_master_entry_proj{});
     }
 };
 
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "mippp/container/unordered_dense_map.hpp"
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////// Cut pool ///////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The cuts already sent to a model from its callbacks, so that separation
+// routines rediscovering a cut, from another incumbent or another thread, do
+// not send it again.
+//
+// A cut is stored in canonical form : its terms sorted by variable id with
+// the duplicate variables merged, a >= constraint turned into a <= one, and
+// its coefficients scaled so that the largest one is 1 in absolute value. The
+// pool is keyed by the canonical left-hand side only, hence a cut whose
+// left-hand side is known is either a duplicate, dominated by the known cut
+// (a larger right-hand side), or dominates it and replaces it. Coefficients
+// are compared exactly once scaled, as the cuts of a separation routine are
+// built the same way each time they are found.
+//
+// The cuts of one callback call are gathered in a batch, which checks each
+// cut against the pool and adds the survivors to the callback handle at once:
+//
+//     model.set_candidate_solution_callback([&](auto & handle) {
+//         auto cuts = pool.new_batch();
+//         for(...) cuts.add(xsum(...) <= k);
+//         cuts.add_lazy_constraints(handle);
+//     });
+//
+// The pool is shared by the threads of the solver, a batch by none.
+template <typename Model>
+class cut_pool {
+public:
+    using variable = typename Model::variable;
+    using variable_id = typename Model::variable_id;
+    using scalar = typename Model::scalar;
+
+private:
+    struct canonical_lhs {
+        constraint_sense sense;  // less_equal or equal
+        std::vector<std::pair<variable_id, scalar>> terms;
+
+        friend bool operator==(const canonical_lhs &,
+                               const canonical_lhs &) = default;
+    };
+    struct canonical_lhs_hash {
+        static std::size_t combine(std::size_t seed, std::size_t h) {
+            return seed ^ (h + 0x9e3779b97f4a7c15ull + (seed << 6) +
+                           (seed >> 2));
+        }
+        std::size_t operator()(const canonical_lhs & lhs) const {
+            std::size_t seed = static_cast<std::size_t>(lhs.sense);
+            for(auto && [id, coef] : lhs.terms) {
+                seed = combine(seed, std::hash<variable_id>{}(id));
+                seed = combine(seed, std::hash<scalar>{}(coef));
+            }
+            return seed;
+        }
+    };
+    struct cut_stats {
+        scalar rhs;
+        std::size_t num_hits = 0;
+        std::size_t last_hit_round;
+    };
+    using cuts_map = unordered_dense_map<canonical_lhs, cut_stats,
+                                         canonical_lhs_hash>;
+
+    mutable std::mutex _mutex;
+    cuts_map _cuts;
+    std::size_t _round = 0;
+    scalar _rhs_tolerance;
+
+    template <linear_constraint LC>
+    static std::pair<canonical_lhs, scalar> _canonicalize(LC && lc) {
+        canonical_lhs lhs;
+        for(auto && [v, coef] : lc.linear_terms())
+            lhs.terms.emplace_back(v.id(), static_cast<scalar>(coef));
+        std::ranges::sort(lhs.terms, {},
+                          &std::pair<variable_id, scalar>::first);
+        // merge the duplicate variables and drop the null coefficients
+        auto out = lhs.terms.begin();
+        for(auto it = lhs.terms.begin(); it != lhs.terms.end();) {
+            auto [id, coef] = *it;
+            while(++it != lhs.terms.end() && it->first == id)
+                coef += it->second;
+            if(coef != scalar{0}) *out++ = {id, coef};
+        }
+        lhs.terms.erase(out, lhs.terms.end());
+
+        auto rhs = static_cast<scalar>(lc.rhs());
+        lhs.sense = lc.sense();
+        scalar scale = scalar{0};
+        for(auto && [id, coef] : lhs.terms)
+            scale = std::max(scale, std::abs(coef));
+        if(scale == scalar{0}) scale = scalar{1};
+        if(lhs.sense == constraint_sense::greater_equal) {
+            lhs.sense = constraint_sense::less_equal;
+            scale = -scale;
+        } else if(lhs.sense == constraint_sense::equal &&
+                  !lhs.terms.empty() && lhs.terms.front().second < 0) {
+            scale = -scale;
+        }
+        for(auto & term : lhs.terms) term.second /= scale;
+        return {std::move(lhs), rhs / scale};
+    }
+
+public:
+    explicit cut_pool(const scalar rhs_tolerance = scalar{1e-9})
+        : _rhs_tolerance(rhs_tolerance) {}
+
+    cut_pool(const cut_pool &) = delete;
+    cut_pool & operator=(const cut_pool &) = delete;
+
+    // The cuts of one callback call, in canonical form.
+    class batch {
+    private:
+        friend cut_pool;
+        cut_pool * _pool;
+        std::vector<std::pair<canonical_lhs, scalar>> _cuts;
+        // the first cut rejected by the pool, see add_lazy_constraints
+        std::optional<std::pair<canonical_lhs, scalar>> _rejected;
+
+        explicit batch(cut_pool & pool) : _pool(&pool) {}
+
+    public:
+        // Adds the cut to the batch and to the pool unless the pool knows it
+        // already or knows a dominating cut. Returns whether it was added.
+        template <linear_constraint LC>
+        bool add(LC && lc) {
+            auto cut = _canonicalize(std::forward<LC>(lc));
+            if(!_pool->_try_insert(cut.first, cut.second)) {
+                if(!_rejected) _rejected.emplace(std::move(cut));
+                return false;
+            }
+            _cuts.emplace_back(std::move(cut));
+            return true;
+        }
+
+        std::size_t size() const noexcept { return _cuts.size(); }
+        bool empty() const noexcept { return _cuts.empty(); }
+
+        // the cuts of the batch, as linear constraints on distinct variables
+        auto constraints() const {
+            return std::views::transform(_cuts, [](auto && cut) {
+                return linear_constraint_view(
+                    linear_expression_view(
+                        std::views::transform(
+                            cut.first.terms,
+                            [](auto && term) {
+                                return std::pair<variable, scalar>(
+                                    variable(term.first), term.second);
+                            }),
+                        -cut.second),
+                    cut.first.sense);
+            });
+        }
+
+        // Adds the cuts of the batch to the callback handle and empties the
+        // batch. Returns the number of cuts added.
+        //
+        // A candidate solution violating only known cuts must be rejected
+        // all the same : the cut may still be on its way to the solver from
+        // another thread. Hence, lacking new cuts, the first rejected one is
+        // sent again.
+        template <typename Handle>
+        std::size_t add_lazy_constraints(Handle & handle) {
+            if(_cuts.empty() && _rejected)
+                _cuts.emplace_back(std::move(*_rejected));
+            for(auto && c : constraints())
+                handle.add_lazy_constraint(distinct_variables, c);
+            return _flush();
+        }
+        template <typename Handle>
+        std::size_t add_cuts(Handle & handle) {
+            for(auto && c : constraints())
+                handle.add_cut(distinct_variables, c);
+            return _flush();
+        }
+
+    private:
+        std::size_t _flush() {
+            const std::size_t num_cuts = _cuts.size();
+            _cuts.clear();
+            _rejected.reset();
+            return num_cuts;
+        }
+    };
+
+    batch new_batch() { return batch(*this); }
+
+private:
+    bool _try_insert(const canonical_lhs & lhs, const scalar rhs) {
+        std::lock_guard lock(_mutex);
+        auto [it, inserted] =
+            _cuts.try_emplace(lhs, cut_stats{rhs, 0, _round});
+        if(inserted) return true;
+        cut_stats & stats = it->second;
+        ++stats.num_hits;
+        stats.last_hit_round = _round;
+        if(lhs.sense == constraint_sense::less_equal
+               ? rhs >= stats.rhs - _rhs_tolerance
+               : std::abs(rhs - stats.rhs) <= _rhs_tolerance)
+            return false;
+        stats.rhs = rhs;
+        return true;
+    }
+
+public:
+    std::size_t size() const {
+        std::lock_guard lock(_mutex);
+        return _cuts.size();
+    }
+    bool empty() const { return size() == 0u; }
+    void clear() {
+        std::lock_guard lock(_mutex);
+        _cuts.clear();
+    }
+
+    // The number of times the cut, or a cut it dominates, was offered again
+    // after it entered the pool.
+    template <linear_constraint LC>
+    std::size_t num_hits(LC && lc) const {
+        auto cut = _canonicalize(std::forward<LC>(lc));
+        std::lock_guard lock(_mutex);
+        auto it = _cuts.find(cut.first);
+        return it == _cuts.end() ? 0u : it->second.num_hits;
+    }
+
+    // Ends an aging round : forgets the cuts neither added nor hit during the
+    // current round and the max_idle_rounds previous ones, and returns their
+    // number. A forgotten cut stays in the model, it is only sent again if
+    // rediscovered.
+    std::size_t age(const std::size_t max_idle_rounds) {
+        std::lock_guard lock(_mutex);
+        std::size_t num_removed = 0;
+        for(auto it = _cuts.begin(); it != _cuts.end();) {
+            if(_round - it->second.last_hit_round > max_idle_rounds) {
+                it = _cuts.erase(it);
+                ++num_removed;
+            } else {
+                ++it;
+            }
+        }
+        ++_round;
+        return num_removed;
+    }
+};
+
+}  // namespace mippp
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+struct parallel_solve_options {
+    // total number of threads shared by the solves, 0 for all the cores
+    std::size_t num_threads = 0;
+    // threads given to each solve, so that num_threads / threads_per_model
+    // models are solved at once ; models get the spare threads when there are
+    // fewer of them than that
+    std::size_t threads_per_model = 1;
+};
+
+namespace detail {
+
+struct thread_budget {
+    std::size_t num_workers;
+    std::size_t threads_per_model;
+};
+
+inline thread_budget split_thread_budget(
+    const std::size_t num_models, const parallel_solve_options & options) {
+    const std::size_t num_threads =
+        options.num_threads > 0
+            ? options.num_threads
+            : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    const std::size_t threads_per_model =
+        std::clamp<std::size_t>(options.threads_per_model, 1, num_threads);
+    const std::size_t num_workers =
+        std::min(num_models, num_threads / threads_per_model);
+    if(num_workers == 0) return {0, threads_per_model};
+    return {num_workers, num_threads / num_workers};
+}
+
+// Runs job(i) for i in [0, num_jobs) on num_workers threads, the calling
+// thread included. Each worker takes the next index from a shared counter,
+// so that long solves do not hold back the others. The first exception
+// stops the distribution of new jobs and is rethrown once all workers
+// are joined.
+template <typename Job>
+void run_jobs_in_parallel(const std::size_t num_jobs,
+                          const std::size_t num_workers, Job && job) {
+    std::atomic<std::size_t> next_job{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto work = [&]() {
+        for(std::size_t i; (i = next_job.fetch_add(1)) < num_jobs;) {
+            try {
+                job(i);
+            } catch(...) {
+                std::lock_guard lock(error_mutex);
+                if(!error) error = std::current_exception();
+                next_job.store(num_jobs);
+            }
+        }
+    };
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(num_workers - 1);
+        for(std::size_t t = 1; t < num_workers; ++t)
+            threads.emplace_back(work);
+        work();
+    }  // joins
+    if(error) std::rethrow_exception(error);
+}
+
+// A model that cannot bound its threads would take every core and
+// oversubscribe the machine, hence it is rejected.
+template <typename Model>
+void prepare_parallel_solve(Model & model, const std::size_t num_threads) {
+    static_assert(has_thread_count<Model>,
+                  "parallel_solve needs models with set_thread_count");
+    model.set_thread_count(num_threads);
+}
+
+}  // namespace detail
+
+// Solves the models of a range concurrently, within the thread budget of
+// options. on_solved(i, models[i]) is called as soon as models[i] is solved,
+// in completion order, from the worker threads but never two at a time.
+template <std::ranges::random_access_range MR, typename OnSolved>
+    requires std::ranges::sized_range<MR>
+void parallel_solve(MR && models, OnSolved && on_solved,
+                    const parallel_solve_options & options = {}) {
+    const std::size_t num_models = std::ranges::size(models);
+    const auto [num_workers, threads_per_model] =
+        detail::split_thread_budget(num_models, options);
+    if(num_workers == 0) return;
+    std::mutex on_solved_mutex;
+    detail::run_jobs_in_parallel(num_models, num_workers, [&](std::size_t i) {
+        auto & model = std::ranges::begin(models)[static_cast<
+            std::ranges::range_difference_t<MR>>(i)];
+        detail::prepare_parallel_solve(model, threads_per_model);
+        model.solve();
+        std::lock_guard lock(on_solved_mutex);
+        std::invoke(on_solved, i, model);
+    });
+}
+
+// Same, for the models make_model(i) for i in [0, num_models), which are
+// built in the worker threads and destroyed after their on_solved call, so
+// that at most one model per worker is alive at a time. make_model is called
+// concurrently ; the models it builds usually share one solver api object.
+template <typename Factory, typename OnSolved>
+    requires std::invocable<Factory &, std::size_t>
+void parallel_solve(const std::size_t num_models, Factory && make_model,
+                    OnSolved && on_solved,
+                    const parallel_solve_options & options = {}) {
+    const auto [num_workers, threads_per_model] =
+        detail::split_thread_budget(num_models, options);
+    if(num_workers == 0) return;
+    std::mutex on_solved_mutex;
+    detail::run_jobs_in_parallel(num_models, num_workers, [&](std::size_t i) {
+        auto model = std::invoke(make_model, i);
+        detail::prepare_parallel_solve(model, threads_per_model);
+        model.solve();
+        std::lock_guard lock(on_solved_mutex);
+        std::invoke(on_solved, i, model);
+    });
+}
+
+}  // namespace mippp
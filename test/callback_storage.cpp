@@ -0,0 +1,94 @@
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "mippp/detail/callback_storage.hpp"
+
+using namespace mippp::detail;
+
+namespace {
+
+struct fake_handle {
+    int num_calls = 0;
+};
+
+}  // namespace
+
+GTEST_TEST(callback_storage, holder) {
+    callback_holder<fake_handle> callback;
+    ASSERT_FALSE(callback);
+    auto counter = std::make_unique<int>(0);
+    // move-only callables, which std::function rejects
+    callback.emplace([c = std::move(counter)](fake_handle & handle) {
+        ++handle.num_calls;
+        ++*c;
+    });
+    ASSERT_TRUE(callback);
+    fake_handle handle;
+    callback(handle);
+    callback(handle);
+    ASSERT_EQ(handle.num_calls, 2);
+    callback.emplace([](fake_handle & h) { h.num_calls = -1; });
+    callback(handle);
+    ASSERT_EQ(handle.num_calls, -1);
+}
+
+GTEST_TEST(callback_storage, buffers_reused) {
+    per_thread_buffers<double> buffers;
+    double * first;
+    double * second;
+    {
+        const auto guard = buffers.release_on_return();
+        first = buffers.local(100);
+        first[99] = 1.0;
+        // the fetches of a call do not overwrite each other
+        second = buffers.local(100);
+        ASSERT_NE(second, first);
+        ASSERT_EQ(first[99], 1.0);
+    }
+    ASSERT_EQ(buffers.local(100), first);
+    ASSERT_EQ(buffers.local(10), second);
+    ASSERT_EQ(buffers.num_threads(), 1u);
+    buffers.release();
+    buffers.local(1000)[999] = 1.0;
+    ASSERT_EQ(buffers.num_threads(), 1u);
+    buffers.clear();
+    ASSERT_EQ(buffers.num_threads(), 0u);
+}
+
+GTEST_TEST(callback_storage, buffers_per_thread) {
+    per_thread_buffers<double> buffers;
+    constexpr std::size_t num_threads = 8;
+    constexpr std::size_t num_calls = 1000;
+    std::vector<const double *> first_buffers(num_threads);
+    std::vector<std::size_t> num_reused(num_threads, 0);
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            first_buffers[t] = buffers.local(64);
+            buffers.release();
+            for(std::size_t i = 0; i < num_calls; ++i) {
+                const auto guard = buffers.release_on_return();
+                double * values = buffers.local(64);
+                for(std::size_t j = 0; j < 64; ++j)
+                    values[j] = static_cast<double>(t);
+                for(std::size_t j = 0; j < 64; ++j)
+                    if(values[j] != static_cast<double>(t)) return;
+                if(values == first_buffers[t]) ++num_reused[t];
+            }
+        });
+    }
+    for(auto & thread : threads) thread.join();
+    ASSERT_EQ(buffers.num_threads(), num_threads);
+    ASSERT_EQ(std::set<const double *>(first_buffers.begin(),
+                                       first_buffers.end())
+                  .size(),
+              num_threads);
+    for(std::size_t t = 0; t < num_threads; ++t)
+        ASSERT_EQ(num_reused[t], num_calls);
+}
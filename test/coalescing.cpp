@@ -0,0 +1,77 @@
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "mippp/detail/coalescing.hpp"
+
+// Both strategies must merge the duplicates into their first occurrence and
+// keep the first occurrences order, so that rows are identical whichever one
+// coalesce_entries picks.
+
+using namespace mippp::detail;
+
+namespace {
+
+struct segment {
+    std::vector<int> indices;
+    std::vector<double> scalars;
+};
+
+// a prefix that must be left untouched, then 7 entries over 4 distinct ids
+segment make_segment(int stride) {
+    return segment{{-1, 3 * stride, 1 * stride, 3 * stride, 0, 1 * stride,
+                    2 * stride, 3 * stride},
+                   {42.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0}};
+}
+
+void check_coalesced(const segment & s, int stride) {
+    ASSERT_EQ(s.indices, (std::vector<int>{-1, 3 * stride, 1 * stride, 0,
+                                           2 * stride}));
+    ASSERT_EQ(s.scalars, (std::vector<double>{42.0, 11.0, 7.0, 4.0, 6.0}));
+}
+
+}  // namespace
+
+GTEST_TEST(coalescing, stamps) {
+    coalescing_cache cache(4);
+    unsigned int stamp = 0;
+    auto s = make_segment(1);
+    coalesce_with_stamps(cache, stamp, s.indices, s.scalars, 1);
+    check_coalesced(s, 1);
+    // a new stamp forgets the previous row
+    s.indices.resize(1);
+    s.scalars.resize(1);
+    s.indices.insert(s.indices.end(), {0, 0});
+    s.scalars.insert(s.scalars.end(), {1.0, 1.0});
+    coalesce_with_stamps(cache, stamp, s.indices, s.scalars, 1);
+    ASSERT_EQ(s.indices, (std::vector<int>{-1, 0}));
+    ASSERT_EQ(s.scalars, (std::vector<double>{42.0, 2.0}));
+}
+
+GTEST_TEST(coalescing, hash_table) {
+    std::vector<unsigned int> table;
+    for(int stride : {1, 64, 1 << 20}) {
+        auto s = make_segment(stride);
+        coalesce_with_hash_table(table, s.indices, s.scalars, 1);
+        check_coalesced(s, stride);
+    }
+}
+
+GTEST_TEST(coalescing, dense_cache_is_lazy) {
+    coalescing_cache cache;
+    std::vector<unsigned int> table;
+    unsigned int stamp = 0;
+    // a short row over many ids does not allocate the dense cache
+    const std::size_t ids_end = 1 << 24;
+    auto s = make_segment(1 << 20);
+    coalesce_entries(cache, stamp, table, s.indices, s.scalars, 1, ids_end);
+    check_coalesced(s, 1 << 20);
+    ASSERT_TRUE(cache.empty());
+    // a row that covers a large share of the ids does
+    auto d = make_segment(1);
+    coalesce_entries(cache, stamp, table, d.indices, d.scalars, 1, 4);
+    check_coalesced(d, 1);
+    ASSERT_EQ(cache.size(), 4u);
+}
@@ -2,7 +2,9 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <iterator>
 #include <optional>
+#include <thread>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -314,6 +316,76 @@ GTEST_TEST(column_manager, at_most_k_best_ranks_by_state_property) {
     EXPECT_EQ(activated_seeds, (std::vector<int>{2, 4}));  // -5.0 and -3.0
 }
 
+GTEST_TEST(column_manager, at_most_k_lowest_selects_sorted) {
+    // the property-keyed selector, reused across rounds, returns the most
+    // negative reduced costs best first
+    manager columns;
+    fake_model model;
+    for(int seed = 0; seed < 100; ++seed) columns.emplace_column(seed);
+    auto rc_of = [](const int & seed) {
+        return -static_cast<double>((seed * 37) % 100);
+    };
+    columns.update_pool_columns(
+        [&](const int & seed) { return priced{rc_of(seed)}; });
+
+    at_most_k_lowest<reduced_cost, negative<reduced_cost>> strategy(3);
+    strategy.sorted = true;
+    std::vector<int> activated_seeds;
+    auto add_column = [&](fake_model & m, const int & seed) {
+        activated_seeds.push_back(seed);
+        return m.new_variable();
+    };
+    for(int round = 0; round < 2; ++round)
+        columns.manage_columns(model, strategy, add_column);
+
+    // -99, -98, -97 then -96, -95, -94
+    ASSERT_EQ(activated_seeds.size(), 6u);
+    for(std::size_t i = 0; i < activated_seeds.size(); ++i)
+        EXPECT_EQ(rc_of(activated_seeds[i]), -99.0 + static_cast<double>(i));
+}
+
+GTEST_TEST(column_manager, top_k_selectors_match_sorting) {
+    // both selectors against a full sort, on plain (seed, state) candidates
+    using state = manager::in_pool_state;
+    std::vector<std::pair<int, state>> nodes(1000);
+    for(int i = 0; i < 1000; ++i) {
+        nodes[static_cast<std::size_t>(i)].first = i;
+        nodes[static_cast<std::size_t>(i)].second.notify(
+            priced{static_cast<double>((i * 7919) % 1009)});
+    }
+    std::vector<std::pair<int, state> *> candidates;
+    for(auto & node : nodes) candidates.push_back(&node);
+    auto proj = [](const std::pair<int, state> * node) {
+        return std::pair<const int &, const state &>(node->first,
+                                                     node->second);
+    };
+    auto rc = [](const std::pair<int, state> * node) {
+        return node->second.get<reduced_cost>();
+    };
+    auto by_rc = [](const auto & a, const auto & b) {
+        return a.second.template get<reduced_cost>() >
+               b.second.template get<reduced_cost>();
+    };
+    std::vector<double> sorted_rcs;
+    for(auto * node : candidates) sorted_rcs.push_back(rc(node));
+    std::ranges::sort(sorted_rcs, std::ranges::greater{});
+
+    for(std::size_t k : {0u, 1u, 17u, 1000u, 2000u}) {
+        at_most_k_highest<reduced_cost> highest(k);
+        highest.sorted = true;
+        at_most_k_best best(k, by_rc, conjunction<>{});
+        best.sorted = true;
+        const std::size_t expected_size = std::min<std::size_t>(k, 1000);
+        for(auto && selected :
+            {std::ranges::to<std::vector>(highest.select(candidates, proj)),
+             std::ranges::to<std::vector>(best.select(candidates, proj))}) {
+            ASSERT_EQ(selected.size(), expected_size);
+            for(std::size_t i = 0; i < expected_size; ++i)
+                EXPECT_EQ(rc(selected[i]), sorted_rcs[i]);
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////// Properties survive or reset across pool <-> master transitions //////
 ///////////////////////////////////////////////////////////////////////////////
@@ -347,6 +419,58 @@ GTEST_TEST(column_manager, age_resets_and_times_activated_persists) {
     EXPECT_EQ(master_get<times_activated>(columns, 7), 2u);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/////////// Staged seeds merge as emplace_columns would insert them ///////////
+///////////////////////////////////////////////////////////////////////////////
+
+GTEST_TEST(column_manager, staged_columns_match_emplace_columns) {
+    // four pricing threads stage overlapping seeds, some already in the pool
+    // or the master, and the merge must agree with the serial emplacement
+    constexpr std::size_t num_pricers = 4;
+    auto generated = [](std::size_t t) {
+        std::vector<int> seeds;
+        for(int k = 0; k < 3000; ++k)
+            seeds.push_back((k * static_cast<int>(t + 3)) % 5000);
+        return seeds;
+    };
+    manager serial;
+    manager staged;
+    fake_model model;
+    for(manager * columns : {&serial, &staged}) {
+        for(int seed = 0; seed < 100; ++seed) columns->emplace_column(seed);
+        for(int seed = 100; seed < 150; ++seed)
+            columns->emplace_master_column(seed, model.new_variable());
+    }
+
+    std::vector<manager::staging_buffer> buffers(num_pricers);
+    {
+        std::vector<std::jthread> pricers;
+        for(std::size_t t = 0; t < num_pricers; ++t)
+            pricers.emplace_back([&, t] {
+                for(int seed : generated(t)) buffers[t].stage(seed);
+            });
+    }
+    for(std::size_t num_threads : {std::size_t{3}, std::size_t{0}}) {
+        std::vector<int> all_generated;
+        for(std::size_t t = 0; t < num_pricers; ++t)
+            std::ranges::copy(generated(t), std::back_inserter(all_generated));
+        manager expected = serial;
+        manager merged = staged;
+        std::vector<manager::staging_buffer> copies = buffers;
+        auto expected_result = expected.emplace_columns(all_generated);
+        auto result = merged.emplace_staged_columns(copies, num_threads);
+
+        EXPECT_EQ(result.num_inserted, expected_result.num_inserted);
+        EXPECT_EQ(result.num_already_in_pool,
+                  expected_result.num_already_in_pool);
+        EXPECT_EQ(result.num_already_in_master,
+                  expected_result.num_already_in_master);
+        EXPECT_EQ(merged.num_pool_columns(), expected.num_pool_columns());
+        for(int seed : all_generated) EXPECT_TRUE(merged.contains(seed));
+        for(auto && buffer : copies) EXPECT_TRUE(buffer.empty());
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /////////////// purge_pool erases matching pool columns only //////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -374,3 +498,66 @@ GTEST_TEST(column_manager, purge_pool_spares_master_columns) {
     EXPECT_EQ(columns.num_master_columns(), 1u);
     EXPECT_TRUE(columns.contains(4));
 }
+
+///////////////////////////////////////////////////////////////////////////////
+/////////// Pool and master partitions stay consistent across rounds //////////
+///////////////////////////////////////////////////////////////////////////////
+
+GTEST_TEST(column_manager, partitions_survive_repeated_transitions) {
+    // each round activates the columns priced negative and evicts the master
+    // columns priced positive, flipping the signs of a moving subset
+    manager columns;
+    fake_model model;
+    constexpr int num_seeds = 50;
+    for(int seed = 0; seed < num_seeds; ++seed) columns.emplace_column(seed);
+
+    std::unordered_map<int, int> variables;
+    auto add_column = [&](fake_model & m, const int & seed) {
+        EXPECT_FALSE(variables.contains(seed));
+        return variables[seed] = m.new_variable();
+    };
+    auto remove_columns = [&](fake_model &, auto && evicted_entries) {
+        for(auto && [seed, state] : evicted_entries) {
+            EXPECT_EQ(variables.at(seed), state.var);
+            variables.erase(seed);
+        }
+    };
+    for(int round = 0; round < 20; ++round) {
+        auto rc = [round](const int & seed) {
+            return (seed * 7 + round * 3) % 5 < 2 ? -1.0 : 1.0;
+        };
+        columns.update_pool_columns(
+            [&](const int & seed) { return priced{rc(seed)}; });
+        columns.update_master_columns(
+            [&](const int & seed, const int &) { return priced{rc(seed)}; });
+        columns.manage_columns(model, all<negative<reduced_cost>>{},
+                               all<positive<reduced_cost>>{}, add_column,
+                               remove_columns);
+
+        std::vector<int> pool_seeds;
+        for(auto && [seed, state] : columns.pool_columns())
+            pool_seeds.push_back(seed);
+        std::vector<int> master_seeds;
+        for(auto && [seed, state] : columns.master_columns()) {
+            master_seeds.push_back(seed);
+            ASSERT_EQ(columns.master_variable(seed), variables.at(seed));
+        }
+        ASSERT_EQ(master_seeds.size(), variables.size());
+        ASSERT_EQ(pool_seeds.size(), columns.num_pool_columns());
+        ASSERT_EQ(master_seeds.size(), columns.num_master_columns());
+        ASSERT_EQ(columns.num_columns(), std::size_t{num_seeds});
+        std::vector<int> all_seeds = pool_seeds;
+        all_seeds.insert(all_seeds.end(), master_seeds.begin(),
+                         master_seeds.end());
+        std::ranges::sort(all_seeds);
+        for(int seed = 0; seed < num_seeds; ++seed)
+            ASSERT_EQ(all_seeds[static_cast<std::size_t>(seed)], seed);
+        for(int seed : pool_seeds)
+            ASSERT_FALSE(columns.master_variable(seed).has_value());
+    }
+    // a seed already in the master is not emplaced in the pool again
+    ASSERT_GT(columns.num_master_columns(), 0u);
+    auto && [seed, state] = *columns.master_columns().begin();
+    EXPECT_FALSE(columns.emplace_column(seed));
+    EXPECT_EQ(columns.num_columns(), std::size_t{num_seeds});
+}
@@ -0,0 +1,166 @@
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_entities.hpp"
+#include "mippp/utility/cut_pool.hpp"
+
+using namespace mippp;
+using namespace mippp::operators;
+
+namespace {
+
+// the cut pool only needs the entity types of the model
+struct fake_model {
+    using variable_id = int;
+    using scalar = double;
+    using variable = model_variable<variable_id, scalar>;
+};
+using variable = fake_model::variable;
+
+// records the constraints added from a batch, as a callback handle would
+// send them to the solver
+struct fake_handle {
+    struct row {
+        std::vector<std::pair<int, double>> terms;
+        constraint_sense sense;
+        double rhs;
+    };
+    std::vector<row> rows;
+
+    template <linear_constraint LC>
+    void add_lazy_constraint(distinct_variables_t, LC && lc) {
+        row r{{}, lc.sense(), lc.rhs()};
+        for(auto && [v, coef] : lc.linear_terms())
+            r.terms.emplace_back(v.id(), coef);
+        rows.push_back(std::move(r));
+    }
+    template <linear_constraint LC>
+    void add_cut(distinct_variables_t, LC && lc) {
+        add_lazy_constraint(distinct_variables, std::forward<LC>(lc));
+    }
+};
+
+}  // namespace
+
+GTEST_TEST(cut_pool, duplicates) {
+    cut_pool<fake_model> pool;
+    variable x(0), y(1);
+    auto cuts = pool.new_batch();
+    ASSERT_TRUE(cuts.add(x + y <= 1));
+    ASSERT_FALSE(cuts.add(y + x <= 1));
+    ASSERT_FALSE(cuts.add(2 * x + 2 * y <= 2));
+    ASSERT_FALSE(cuts.add(-x - y >= -1));
+    ASSERT_FALSE(cuts.add(x + y + x - x <= 1));
+    ASSERT_TRUE(cuts.add(x - y <= 1));
+    ASSERT_EQ(cuts.size(), 2u);
+    ASSERT_EQ(pool.size(), 2u);
+    ASSERT_EQ(pool.num_hits(x + y <= 1), 4u);
+    ASSERT_EQ(pool.num_hits(x - y <= 1), 0u);
+}
+
+GTEST_TEST(cut_pool, dominated) {
+    cut_pool<fake_model> pool;
+    variable x(0), y(1);
+    auto cuts = pool.new_batch();
+    ASSERT_TRUE(cuts.add(x + y <= 1));
+    ASSERT_FALSE(cuts.add(x + y <= 2));
+    ASSERT_FALSE(cuts.add(3 * x + 3 * y <= 4));
+    ASSERT_TRUE(cuts.add(x + y <= 0.5));
+    ASSERT_FALSE(cuts.add(x + y <= 1));
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_TRUE(cuts.add(x + y == 0.5));
+    ASSERT_FALSE(cuts.add(-x - y == -0.5));
+    ASSERT_TRUE(cuts.add(x + y == 0.25));
+    ASSERT_EQ(pool.size(), 2u);
+}
+
+GTEST_TEST(cut_pool, batch_canonical_constraints) {
+    cut_pool<fake_model> pool;
+    variable x(0), y(1), z(2);
+    fake_handle handle;
+    auto cuts = pool.new_batch();
+    cuts.add(z + 2 * x + z + 2 * y >= 4);
+    cuts.add(4 * y - 2 * x == 2);
+    ASSERT_EQ(cuts.add_lazy_constraints(handle), 2u);
+    ASSERT_TRUE(cuts.empty());
+    ASSERT_EQ(handle.rows.size(), 2u);
+
+    auto & r1 = handle.rows[0];
+    ASSERT_EQ(r1.sense, constraint_sense::less_equal);
+    ASSERT_EQ(r1.terms, (std::vector<std::pair<int, double>>{
+                            {0, -1.0}, {1, -1.0}, {2, -1.0}}));
+    ASSERT_EQ(r1.rhs, -2.0);
+
+    auto & r2 = handle.rows[1];
+    ASSERT_EQ(r2.sense, constraint_sense::equal);
+    ASSERT_EQ(r2.terms,
+              (std::vector<std::pair<int, double>>{{0, 0.5}, {1, -1.0}}));
+    ASSERT_EQ(r2.rhs, -0.5);
+
+    ASSERT_EQ(cuts.add_cuts(handle), 0u);
+    ASSERT_EQ(handle.rows.size(), 2u);
+}
+
+GTEST_TEST(cut_pool, lazy_constraints_resend_rejected) {
+    cut_pool<fake_model> pool;
+    variable x(0), y(1);
+    fake_handle handle;
+    auto cuts = pool.new_batch();
+    cuts.add(x + y <= 1);
+    ASSERT_EQ(cuts.add_lazy_constraints(handle), 1u);
+    // the candidate violates a known cut only : it is sent again for the
+    // candidate to be rejected, but not as a user cut
+    ASSERT_FALSE(cuts.add(x + y <= 2));
+    ASSERT_EQ(cuts.add_lazy_constraints(handle), 1u);
+    ASSERT_EQ(handle.rows.size(), 2u);
+    ASSERT_EQ(handle.rows[1].rhs, 2.0);
+    ASSERT_FALSE(cuts.add(x + y <= 1));
+    ASSERT_EQ(cuts.add_cuts(handle), 0u);
+    ASSERT_EQ(handle.rows.size(), 2u);
+}
+
+GTEST_TEST(cut_pool, aging) {
+    cut_pool<fake_model> pool;
+    variable x(0), y(1), z(2);
+    auto cuts = pool.new_batch();
+    cuts.add(x + y <= 1);
+    cuts.add(y + z <= 1);
+    ASSERT_EQ(pool.age(1), 0u);
+    cuts.add(x + y <= 1);  // hit
+    ASSERT_EQ(pool.age(1), 0u);
+    ASSERT_EQ(pool.age(1), 1u);  // y + z idle for 2 rounds
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_EQ(pool.num_hits(x + y <= 1), 1u);
+    ASSERT_TRUE(cuts.add(y + z <= 1));  // forgotten, hence new
+    ASSERT_EQ(pool.age(0), 1u);
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_EQ(pool.age(0), 1u);
+    ASSERT_TRUE(pool.empty());
+}
+
+GTEST_TEST(cut_pool, concurrent_batches) {
+    cut_pool<fake_model> pool;
+    constexpr int num_threads = 8;
+    constexpr int num_cuts = 1000;
+    std::atomic<std::size_t> num_added{0};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&]() {
+            fake_handle handle;
+            auto cuts = pool.new_batch();
+            for(int i = 0; i < num_cuts; ++i)
+                if(cuts.add(variable(i) + variable(i + 1) <= 1)) ++num_added;
+            cuts.add_lazy_constraints(handle);
+        });
+    }
+    for(auto & thread : threads) thread.join();
+    ASSERT_EQ(num_added.load(), static_cast<std::size_t>(num_cuts));
+    ASSERT_EQ(pool.size(), static_cast<std::size_t>(num_cuts));
+}
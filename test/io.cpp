@@ -0,0 +1,309 @@
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mippp/io/lp_writer.hpp"
+#include "mippp/io/mps_reader.hpp"
+#include "mippp/io/mps_writer.hpp"
+#include "mippp/io/snapshot.hpp"
+#include "mippp/solvers/recording/all.hpp"
+
+#include "assert_helper.hpp"
+
+using namespace mippp;
+
+namespace {
+
+void build_model(recording_milp & model) {
+    using namespace operators;
+    auto x = model.add_variables(3);
+    auto y = model.add_integer_variable(
+        {.obj_coef = 0, .lower_bound = -2, .upper_bound = 7});
+    model.set_variable_lower_bound(x[2], -recording_milp::infinity);
+    model.set_maximization();
+    model.set_objective(2 * x[0] + 3 * x[1] - y + 1.5);
+    model.add_constraint(x[0] + 2 * x[1] + x[0] <= 4);
+    model.add_constraint(x[1] - x[2] + y >= -1);
+    model.add_constraint(x[2] + y == 3);
+    model.set_constraint_name(model.add_constraint(x[0] <= 0.1), "cap");
+}
+
+void assert_same_model(recording_milp & a, recording_milp & b) {
+    ASSERT_EQ(a.is_maximization(), b.is_maximization());
+    ASSERT_EQ(a.get_objective_offset(), b.get_objective_offset());
+    ASSERT_EQ_RANGES(a.get_objective_coefficients(),
+                     b.get_objective_coefficients());
+    ASSERT_EQ_RANGES(a.get_variables_lower_bounds(),
+                     b.get_variables_lower_bounds());
+    ASSERT_EQ_RANGES(a.get_variables_upper_bounds(),
+                     b.get_variables_upper_bounds());
+    ASSERT_EQ_RANGES(a.get_variables_types(), b.get_variables_types());
+    auto [a_begins, a_indices, a_values] = a.get_constraints_matrix();
+    auto [b_begins, b_indices, b_values] = b.get_constraints_matrix();
+    ASSERT_EQ_RANGES(a_begins, b_begins);
+    ASSERT_EQ_RANGES(a_indices, b_indices);
+    ASSERT_EQ_RANGES(a_values, b_values);
+    ASSERT_EQ_RANGES(a.get_constraints_senses(), b.get_constraints_senses());
+    ASSERT_EQ_RANGES(a.get_constraints_rhs(), b.get_constraints_rhs());
+}
+
+// Hides the bulk add_columns, so that column-major snapshots are transposed.
+struct rows_only_milp : recording_milp {
+    template <typename... Args>
+    void add_columns(Args &&...) = delete;
+};
+static_assert(has_add_columns<recording_milp>);
+static_assert(!has_add_columns<rows_only_milp>);
+
+}  // namespace
+
+// A budget of 1 entry transposes the COLUMNS section one column at a time.
+GTEST_TEST(io, mps_round_trip) {
+    recording_milp model;
+    build_model(model);
+    for(const std::size_t budget : {std::size_t{1}, std::size_t{3},
+                                    std::size_t{1} << 20}) {
+        std::ostringstream os;
+        io::write_mps(os, model,
+                      {.buffer_size = 16, .max_transposed_entries = budget});
+        recording_milp read;
+        auto [vars, constrs] = io::parse_mps(
+            os.str(), read, {.read_names = true, .constraints_batch_size = 3});
+        ASSERT_EQ(vars.size(), 4u);
+        ASSERT_EQ(constrs.size(), 4u);
+        assert_same_model(model, read);
+        ASSERT_EQ(read.get_variable_name(vars[3]), "x3");
+        ASSERT_EQ(read.get_constraint_name(constrs[3]), "cap");
+    }
+}
+
+GTEST_TEST(io, lp_format) {
+    recording_milp model;
+    build_model(model);
+    std::ostringstream os;
+    io::write_lp(os, model, {.buffer_size = 16});
+    ASSERT_EQ(os.str(),
+              "\\ Problem name: MIPPP\n"
+              "Maximize\n"
+              " obj: + 2 x0 + 3 x1 - 1 x3 + 1.5\n"
+              "Subject To\n"
+              " c0: + 2 x0 + 2 x1 <= 4\n"
+              " c1: + 1 x1 - 1 x2 + 1 x3 >= -1\n"
+              " c2: + 1 x2 + 1 x3 = 3\n"
+              " cap: + 1 x0 <= 0.1\n"
+              "Bounds\n"
+              " x2 free\n"
+              " -2 <= x3 <= 7\n"
+              "Generals\n"
+              " x3\n"
+              "End\n");
+}
+
+// The columns of a model with removed variables are its remaining variables,
+// numbered in order.
+GTEST_TEST(io, write_after_remove_variable) {
+    recording_milp model;
+    build_model(model);
+    model.remove_variable(recording_milp::variable(0));
+    std::ostringstream lp;
+    io::write_lp(lp, model);
+    ASSERT_EQ(lp.str(),
+              "\\ Problem name: MIPPP\n"
+              "Maximize\n"
+              " obj: + 3 x0 - 1 x2 + 1.5\n"
+              "Subject To\n"
+              " c0: + 2 x0 <= 4\n"
+              " c1: + 1 x0 - 1 x1 + 1 x2 >= -1\n"
+              " c2: + 1 x1 + 1 x2 = 3\n"
+              " cap: + 0 x0 <= 0.1\n"
+              "Bounds\n"
+              " x1 free\n"
+              " -2 <= x2 <= 7\n"
+              "Generals\n"
+              " x2\n"
+              "End\n");
+
+    std::ostringstream mps;
+    io::write_mps(mps, model, {.max_transposed_entries = 1});
+    recording_milp read;
+    io::parse_mps(mps.str(), read);
+    ASSERT_EQ(read.num_variables(), 3u);
+    ASSERT_EQ(read.num_constraints(), 4u);
+    ASSERT_EQ_RANGES(read.get_objective_coefficients(),
+                     std::vector<double>{3, 0, -1});
+    ASSERT_EQ_RANGES(read.get_variables_lower_bounds(),
+                     std::vector<double>{0, -recording_milp::infinity, -2});
+    ASSERT_EQ_RANGES(read.get_variables_types(),
+                     std::vector<recording::variable_type>{
+                         recording::variable_type::continuous,
+                         recording::variable_type::continuous,
+                         recording::variable_type::integer});
+    auto [begins, indices, values] = read.get_constraints_matrix();
+    ASSERT_EQ_RANGES(begins, std::vector<std::size_t>{0, 1, 4, 6, 6});
+    ASSERT_EQ_RANGES(indices, std::vector<std::size_t>{0, 0, 1, 2, 1, 2});
+    ASSERT_EQ_RANGES(values, std::vector<double>{2, 1, -1, 1, 1, 1});
+    for(const auto layout : {io::snapshot_layout::row_major,
+                             io::snapshot_layout::column_major}) {
+        std::ostringstream os;
+        io::write_snapshot(os, model,
+                           {.layout = layout, .max_transposed_entries = 1});
+        recording_milp read_snapshot;
+        io::parse_snapshot(os.str(), read_snapshot);
+        assert_same_model(read, read_snapshot);
+    }
+
+    // the freed uid is reused by the next variable, written as the first
+    // column
+    model.add_variable({.obj_coef = 5});
+    std::ostringstream readded;
+    io::write_mps(readded, model);
+    recording_milp read_readded;
+    io::parse_mps(readded.str(), read_readded);
+    ASSERT_EQ_RANGES(read_readded.get_objective_coefficients(),
+                     std::vector<double>{5, 3, 0, -1});
+}
+
+GTEST_TEST(io, constraints_stream) {
+    using namespace operators;
+    recording_milp model;
+    auto x = model.add_variables(4);
+    const auto rows =
+        std::views::iota(0, 3) |
+        std::views::transform([&](int i) { return x[i] + 3 * x[i + 1] >= i; });
+    std::ostringstream os;
+    io::write_mps(os, 4, 2 * x[0] - x[3], rows, [](std::size_t j) {
+        return io::column_attributes{
+            .lower_bound = 0, .upper_bound = 1, .integer = (j == 3)};
+    });
+
+    recording_milp read;
+    io::parse_mps(os.str(), read);
+    ASSERT_EQ(read.num_variables(), 4u);
+    ASSERT_EQ(read.num_constraints(), 3u);
+    ASSERT_FALSE(read.is_maximization());
+    ASSERT_EQ_RANGES(read.get_objective_coefficients(),
+                     std::vector<double>{2, 0, 0, -1});
+    ASSERT_EQ_RANGES(read.get_variables_upper_bounds(),
+                     std::vector<double>{1, 1, 1, 1});
+    ASSERT_EQ_RANGES(read.get_variables_types(),
+                     std::vector<recording::variable_type>{
+                         recording::variable_type::continuous,
+                         recording::variable_type::continuous,
+                         recording::variable_type::continuous,
+                         recording::variable_type::integer});
+    ASSERT_EQ_RANGES(read.get_constraints_rhs(),
+                     std::vector<double>{0, 1, 2});
+}
+
+GTEST_TEST(io, read_mps_file) {
+    recording_milp model;
+    build_model(model);
+    const auto path = std::filesystem::temp_directory_path() / "mippp_io.mps";
+    {
+        std::ofstream file(path);
+        io::write_mps(file, model);
+    }
+    recording_milp read;
+    io::read_mps(path, read);
+    std::filesystem::remove(path);
+    assert_same_model(model, read);
+}
+
+GTEST_TEST(io, binary_bound_with_value) {
+    // the value field some writers put on BV lines is ignored
+    recording_milp model;
+    io::parse_mps("ROWS\n N  obj\nCOLUMNS\n    x0  obj  1\n"
+                  "    x1  obj  2\n    x2  obj  3\nBOUNDS\n"
+                  " BV BND  x0  1\n BV  x1  1\n BV BND  x2\nENDATA\n",
+                  model);
+    ASSERT_EQ(model.num_variables(), 3u);
+    ASSERT_EQ_RANGES(model.get_variables_lower_bounds(),
+                     std::vector<double>{0, 0, 0});
+    ASSERT_EQ_RANGES(model.get_variables_upper_bounds(),
+                     std::vector<double>{1, 1, 1});
+    ASSERT_EQ_RANGES(model.get_variables_types(),
+                     std::vector<recording::variable_type>(
+                         3, recording::variable_type::integer));
+}
+
+GTEST_TEST(io, unsupported_input) {
+    recording_lp lp;
+    ASSERT_THROW(io::parse_mps("ROWS\n N  obj\nRANGES\n", lp),
+                 std::runtime_error);
+    ASSERT_THROW(io::parse_mps("ROWS\n N  obj\nCOLUMNS\n"
+                               "    M0  'MARKER'  'INTORG'\n"
+                               "    x0  obj  1\n",
+                               lp),
+                 std::invalid_argument);
+}
+
+GTEST_TEST(io, snapshot_round_trip) {
+    recording_milp model;
+    build_model(model);
+    for(const auto layout : {io::snapshot_layout::row_major,
+                             io::snapshot_layout::column_major}) {
+        std::ostringstream os;
+        io::write_snapshot(os, model,
+                           {.layout = layout,
+                            .names = true,
+                            .buffer_size = 16,
+                            .max_transposed_entries = 3});
+        recording_milp read;
+        auto [vars, constrs] = io::parse_snapshot(
+            os.str(), read, {.read_names = true, .constraints_batch_size = 3});
+        ASSERT_EQ(vars.size(), 4u);
+        ASSERT_EQ(constrs.size(), 4u);
+        assert_same_model(model, read);
+        ASSERT_EQ(read.get_variable_name(vars[3]), "");
+        ASSERT_EQ(read.get_constraint_name(constrs[3]), "cap");
+
+        rows_only_milp rows_only;
+        io::parse_snapshot(os.str(), rows_only);
+        assert_same_model(model, rows_only);
+    }
+}
+
+GTEST_TEST(io, read_snapshot_file) {
+    recording_milp model;
+    build_model(model);
+    const auto path = std::filesystem::temp_directory_path() / "mippp_io.snp";
+    {
+        std::ofstream file(path, std::ios::binary);
+        io::write_snapshot(file, model,
+                           {.layout = io::snapshot_layout::column_major});
+    }
+    recording_milp read;
+    io::read_snapshot(path, read);
+    std::filesystem::remove(path);
+    assert_same_model(model, read);
+}
+
+GTEST_TEST(io, invalid_snapshot) {
+    recording_milp model;
+    build_model(model);
+    std::ostringstream os;
+    io::write_snapshot(os, model);
+    const std::string snapshot = os.str();
+    recording_milp read;
+    ASSERT_THROW(io::parse_snapshot("MIPPPMPS", read), std::runtime_error);
+    ASSERT_THROW(io::parse_snapshot("NOTASNAP" + snapshot.substr(8), read),
+                 std::runtime_error);
+    ASSERT_THROW(io::parse_snapshot(
+                     std::string_view(snapshot).substr(0, snapshot.size() - 8),
+                     read),
+                 std::runtime_error);
+    // the 4 senses are the last section, padded to 8 bytes
+    std::string bad_sense = snapshot;
+    bad_sense[bad_sense.size() - 8] = 5;
+    ASSERT_THROW(io::parse_snapshot(bad_sense, read), std::runtime_error);
+    recording_lp lp;
+    ASSERT_THROW(io::parse_snapshot(snapshot, lp), std::invalid_argument);
+}
@@ -0,0 +1,114 @@
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "mippp/utility/parallel_solve.hpp"
+
+using namespace mippp;
+
+namespace {
+
+// Records what parallel_solve did to it, and how many solves overlapped.
+struct counting_model {
+    inline static std::atomic<std::size_t> num_running{0};
+    inline static std::atomic<std::size_t> max_running{0};
+
+    std::size_t thread_count = 0;
+    std::size_t num_solves = 0;
+
+    void set_thread_count(std::size_t n) { thread_count = n; }
+    std::size_t get_thread_count() { return thread_count; }
+    void solve() {
+        const std::size_t running = ++num_running;
+        std::size_t max = max_running.load();
+        while(running > max && !max_running.compare_exchange_weak(max, running))
+            ;
+        ++num_solves;
+        --num_running;
+    }
+};
+static_assert(has_thread_count<counting_model>);
+
+struct failing_model {
+    void set_thread_count(std::size_t) {}
+    std::size_t get_thread_count() { return 0; }
+    void solve() { throw std::runtime_error("solve failed"); }
+};
+
+}  // namespace
+
+GTEST_TEST(parallel_solve, split_thread_budget) {
+    auto budget = detail::split_thread_budget(100, {.num_threads = 8});
+    ASSERT_EQ(budget.num_workers, 8u);
+    ASSERT_EQ(budget.threads_per_model, 1u);
+    budget = detail::split_thread_budget(
+        100, {.num_threads = 8, .threads_per_model = 3});
+    ASSERT_EQ(budget.num_workers, 2u);
+    ASSERT_EQ(budget.threads_per_model, 4u);
+    budget = detail::split_thread_budget(3, {.num_threads = 8});
+    ASSERT_EQ(budget.num_workers, 3u);
+    ASSERT_EQ(budget.threads_per_model, 2u);
+    budget = detail::split_thread_budget(
+        10, {.num_threads = 2, .threads_per_model = 4});
+    ASSERT_EQ(budget.num_workers, 1u);
+    ASSERT_EQ(budget.threads_per_model, 2u);
+    budget = detail::split_thread_budget(0, {.num_threads = 8});
+    ASSERT_EQ(budget.num_workers, 0u);
+}
+
+GTEST_TEST(parallel_solve, models_range) {
+    std::vector<counting_model> models(50);
+    std::vector<std::size_t> solved;
+    counting_model::max_running = 0;
+    parallel_solve(
+        models,
+        [&](std::size_t i, counting_model & model) {
+            ASSERT_EQ(&model, &models[i]);
+            solved.emplace_back(i);
+        },
+        {.num_threads = 4});
+    ASSERT_EQ(solved.size(), models.size());
+    std::vector<bool> seen(models.size(), false);
+    for(auto i : solved) {
+        ASSERT_FALSE(seen[i]);
+        seen[i] = true;
+    }
+    for(auto && model : models) {
+        ASSERT_EQ(model.num_solves, 1u);
+        ASSERT_EQ(model.thread_count, 1u);
+    }
+    ASSERT_LE(counting_model::max_running.load(), 4u);
+}
+
+GTEST_TEST(parallel_solve, factory) {
+    std::atomic<std::size_t> num_built{0};
+    std::vector<std::size_t> thread_counts(6, 0);
+    parallel_solve(
+        thread_counts.size(),
+        [&](std::size_t) {
+            ++num_built;
+            return counting_model{};
+        },
+        [&](std::size_t i, counting_model & model) {
+            ASSERT_EQ(model.num_solves, 1u);
+            thread_counts[i] = model.thread_count;
+        },
+        {.num_threads = 12, .threads_per_model = 2});
+    ASSERT_EQ(num_built.load(), 6u);
+    for(auto n : thread_counts) ASSERT_EQ(n, 2u);
+}
+
+GTEST_TEST(parallel_solve, exception) {
+    std::vector<failing_model> models(10);
+    std::size_t num_solved = 0;
+    ASSERT_THROW(parallel_solve(
+                     models,
+                     [&](std::size_t, failing_model &) { ++num_solved; },
+                     {.num_threads = 3}),
+                 std::runtime_error);
+    ASSERT_EQ(num_solved, 0u);
+}
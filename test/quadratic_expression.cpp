@@ -3,6 +3,7 @@
 
 #include <concepts>
 #include <ranges>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -241,6 +242,58 @@ GTEST_TEST(quadratic_expression_operators, square_references_named_operand) {
                                                    {Var(1), Var(2), 4.0}});
 }
 
+///////////////////////////////////////////////////////////////////////////////
+////////////////////////// Squares emit a triangle ////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+GTEST_TEST(quadratic_expression_operators, square_emits_each_pair_once) {
+    std::vector<Var> vars{Var(1), Var(2), Var(3)};
+    auto e = materialize(xsum(vars, [](auto && v) { return v * 2.0; }));
+    auto terms = square(e).quadratic_terms();
+    ASSERT_EQ(std::ranges::distance(terms), 6);
+    ASSERT_EQ(std::ranges::size(terms), 6u);
+    ASSERT_EQ_RANGES(terms, std::vector<std::tuple<Var, Var, double>>{
+                                {Var(1), Var(1), 4.0},
+                                {Var(1), Var(2), 8.0},
+                                {Var(1), Var(3), 8.0},
+                                {Var(2), Var(2), 4.0},
+                                {Var(2), Var(3), 8.0},
+                                {Var(3), Var(3), 4.0}});
+}
+
+GTEST_TEST(quadratic_expression_operators, product_of_named_operand_is_square) {
+    std::vector<Var> vars{Var(1), Var(2), Var(3)};
+    auto e1 = materialize(xsum(vars));
+    auto e2 = materialize(xsum(vars));
+    ASSERT_EQ(std::ranges::distance((e1 * e1).quadratic_terms()), 6);
+    ASSERT_QUAD_TERMS((e1 * e1).quadratic_terms(),
+                      {{Var(1), Var(1), 1.0},
+                       {Var(2), Var(2), 1.0},
+                       {Var(3), Var(3), 1.0},
+                       {Var(1), Var(2), 2.0},
+                       {Var(1), Var(3), 2.0},
+                       {Var(2), Var(3), 2.0}});
+    // equal but distinct operands: the whole product is emitted
+    ASSERT_EQ(std::ranges::distance((e1 * e2).quadratic_terms()), 9);
+    ASSERT_QUAD_TERMS((e1 * e2).quadratic_terms(),
+                      {{Var(1), Var(1), 1.0},
+                       {Var(2), Var(2), 1.0},
+                       {Var(3), Var(3), 1.0},
+                       {Var(1), Var(2), 2.0},
+                       {Var(1), Var(3), 2.0},
+                       {Var(2), Var(3), 2.0}});
+}
+
+GTEST_TEST(quadratic_expression_operators, square_of_empty_expression) {
+    std::vector<Var> vars;
+    auto e = materialize(xsum(vars) + 1.0);
+    ASSERT_EQ(std::ranges::distance(square(e).quadratic_terms()), 0);
+    ASSERT_EQ(std::ranges::distance((e * (Var(1) + Var(2))).quadratic_terms()),
+              0);
+    ASSERT_EQ(std::ranges::distance(((Var(1) + Var(2)) * e).quadratic_terms()),
+              0);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /////////////////////// Statically-zero constant branches /////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,64 @@
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "mippp/detail/solver_library.hpp"
+
+using namespace mippp::detail;
+
+namespace {
+
+// the C math library stands for a solver library : it is there on every
+// glibc system and exports plain C functions
+constexpr const char * libm_path = "libm.so.6";
+
+std::shared_ptr<const dylib::library> load_libm() {
+    return load_solver_library(libm_path, "LIBM", {"m"}, {"cos"});
+}
+
+}  // namespace
+
+GTEST_TEST(solver_library, shared_handles) {
+#if !defined(__linux__)
+    GTEST_SKIP() << "libm.so.6 is a glibc library";
+#endif
+    auto & registry = solver_library_registry::instance();
+    registry.clear();
+    auto lib = load_libm();
+    ASSERT_EQ(registry.num_libraries(), 1u);
+    ASSERT_EQ(load_libm(), lib);
+    ASSERT_EQ(registry.num_libraries(), 1u);
+
+    std::vector<std::shared_ptr<const dylib::library>> libs(8);
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < libs.size(); ++t)
+        threads.emplace_back([&, t]() { libs[t] = load_libm(); });
+    for(auto & thread : threads) thread.join();
+    for(auto && l : libs) ASSERT_EQ(l, lib);
+
+    // the handles of the apis outlive clear()
+    registry.clear();
+    ASSERT_EQ(registry.num_libraries(), 0u);
+    ASSERT_NE(lib->get_function<double(double)>("cos"), nullptr);
+    ASSERT_NE(load_libm(), lib);
+}
+
+GTEST_TEST(solver_library, lazy_function) {
+#if !defined(__linux__)
+    GTEST_SKIP() << "libm.so.6 is a glibc library";
+#endif
+    auto lib = load_libm();
+    lazy_function<double(double)> cos_function(*lib, "cos");
+    ASSERT_EQ(cos_function(0.0), 1.0);
+    const lazy_function<double(double)> copy(cos_function);
+    ASSERT_EQ(static_cast<double (*)(double)>(copy),
+              static_cast<double (*)(double)>(cos_function));
+
+    lazy_function<double(double)> missing(*lib, "mippp_missing_symbol");
+    ASSERT_THROW(static_cast<void>(static_cast<double (*)(double)>(missing)),
+                 dylib::symbol_error);
+}
@@ -10,14 +10,37 @@ struct cbc_milp_test : public model_test<cbc_api, cbc_milp> {
     static void SetUpTestSuite() { construct_api("CBC"); }
 };
 INSTANTIATE_TEST(Cbc, LpModelTest, cbc_milp_test);
+INSTANTIATE_TEST(Cbc, PartialSolutionTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, MilpModelTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, ReadableObjectiveTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, ModifiableObjectiveTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, ReadableVariablesBoundsTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, MipStartTest, cbc_milp_test);
+INSTANTIATE_TEST(Cbc, NodeRelaxationCallbackTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, ModifiableVariablesBoundsTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, NamedVariablesTest, cbc_milp_test);
+INSTANTIATE_TEST(Cbc, CloneTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, AddColumnTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, ReadableConstraintsTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, SudokuTest, cbc_milp_test);
 INSTANTIATE_TEST(Cbc, TimeLimitTest, cbc_milp_test);
+
+// the same model loaded in Cbc at once by the first solve
+struct cbc_milp_staged_test : public cbc_milp_test {
+    auto new_model() const {
+        return cbc_milp(api.value(), cbc_milp::staged_build);
+    }
+};
+INSTANTIATE_TEST(CbcStaged, LpModelTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, MilpModelTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, ReadableObjectiveTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, ModifiableObjectiveTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, ReadableVariablesBoundsTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, ModifiableVariablesBoundsTest,
+                 cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, MipStartTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, NamedVariablesTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, CloneTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, AddColumnTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, ReadableConstraintsTest, cbc_milp_staged_test);
+INSTANTIATE_TEST(CbcStaged, SudokuTest, cbc_milp_staged_test);
@@ -8,15 +8,19 @@ struct clp_lp_test : public model_test<clp_api, clp_lp> {
     static void SetUpTestSuite() { construct_api("CLP"); }
 };
 INSTANTIATE_TEST(Clp, LpModelTest, clp_lp_test);
+INSTANTIATE_TEST(Clp, PartialSolutionTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, ReadableObjectiveTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, ModifiableObjectiveTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, ReadableVariablesBoundsTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, ModifiableVariablesBoundsTest, clp_lp_test);
+INSTANTIATE_TEST(Clp, BulkModificationsTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, NamedVariablesTest, clp_lp_test);
+INSTANTIATE_TEST(Clp, CloneTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, AddColumnTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, RemoveVariableTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, DualSolutionTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, ReducedCostsTest, clp_lp_test);
+INSTANTIATE_TEST(Clp, LpBasisTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, LpStatusTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, CuttingStockTest, clp_lp_test);
 INSTANTIATE_TEST(Clp, ColumnManagerTest, clp_lp_test);
@@ -8,12 +8,16 @@ struct copt_lp_test : public model_test<copt_api, copt_lp> {
     static void SetUpTestSuite() { construct_api("COPT"); }
 };
 INSTANTIATE_TEST(COPT_lp, LpModelTest, copt_lp_test);
+INSTANTIATE_TEST(COPT_lp, PartialSolutionTest, copt_lp_test);
 INSTANTIATE_TEST(COPT_lp, ReadableObjectiveTest, copt_lp_test);
 INSTANTIATE_TEST(COPT_lp, ModifiableObjectiveTest, copt_lp_test);
 INSTANTIATE_TEST(COPT_lp, ReadableVariablesBoundsTest, copt_lp_test);
 INSTANTIATE_TEST(COPT_lp, ModifiableVariablesBoundsTest, copt_lp_test);
 INSTANTIATE_TEST(COPT_lp, NamedVariablesTest, copt_lp_test);
+INSTANTIATE_TEST(COPT_lp, CloneTest, copt_lp_test);
 INSTANTIATE_TEST(COPT_lp, AddColumnTest, copt_lp_test);
+INSTANTIATE_TEST(COPT_lp, ConstraintsBatchTest, copt_lp_test);
+INSTANTIATE_TEST(COPT_lp, ParallelConstraintsTest, copt_lp_test);
 INSTANTIATE_TEST(COPT_lp, DualSolutionTest, copt_lp_test);
 INSTANTIATE_TEST(COPT_lp, ReducedCostsTest, copt_lp_test);
 INSTANTIATE_TEST(COPT_lp, LpStatusTest, copt_lp_test);
@@ -23,15 +27,20 @@ struct copt_milp_test : public model_test<copt_api, copt_milp> {
     static void SetUpTestSuite() { construct_api("COPT"); }
 };
 INSTANTIATE_TEST(COPT_milp, LpModelTest, copt_milp_test);
+INSTANTIATE_TEST(COPT_milp, PartialSolutionTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, MilpModelTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, ReadableObjectiveTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, ModifiableObjectiveTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, ReadableVariablesBoundsTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, ModifiableVariablesBoundsTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, NamedVariablesTest, copt_milp_test);
+INSTANTIATE_TEST(COPT_milp, CloneTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, AddColumnTest, copt_milp_test);
+INSTANTIATE_TEST(COPT_milp, ConstraintsBatchTest, copt_milp_test);
+INSTANTIATE_TEST(COPT_milp, ParallelConstraintsTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, SudokuTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, CandidateSolutionCallbackTest, copt_milp_test);
+INSTANTIATE_TEST(COPT_milp, NodeRelaxationCallbackTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, TravellingSalesmanTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, TimeLimitTest, copt_milp_test);
 INSTANTIATE_TEST(COPT_milp, MipStartTest, copt_milp_test);
\ No newline at end of file
@@ -8,16 +8,22 @@ struct cplex_lp_test : public model_test<cplex_api, cplex_lp> {
     static void SetUpTestSuite() { construct_api("CPLEX"); }
 };
 INSTANTIATE_TEST(CPLEX_lp, LpModelTest, cplex_lp_test);
+INSTANTIATE_TEST(CPLEX_lp, PartialSolutionTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, ReadableObjectiveTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, ModifiableObjectiveTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, ReadableVariablesBoundsTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, ModifiableVariablesBoundsTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, NamedVariablesTest, cplex_lp_test);
+INSTANTIATE_TEST(CPLEX_lp, CloneTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, AddColumnTest, cplex_lp_test);
+INSTANTIATE_TEST(CPLEX_lp, ConstraintsBatchTest, cplex_lp_test);
+INSTANTIATE_TEST(CPLEX_lp, ModificationsBatchTest, cplex_lp_test);
+INSTANTIATE_TEST(CPLEX_lp, ParallelConstraintsTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, RemoveVariableTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, ReadableConstraintsTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, DualSolutionTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, ReducedCostsTest, cplex_lp_test);
+INSTANTIATE_TEST(CPLEX_lp, LpBasisTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, LpStatusTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, CuttingStockTest, cplex_lp_test);
 INSTANTIATE_TEST(CPLEX_lp, ColumnManagerTest, cplex_lp_test);
@@ -27,17 +33,23 @@ struct cplex_milp_test : public model_test<cplex_api, cplex_milp> {
     static void SetUpTestSuite() { construct_api("CPLEX"); }
 };
 INSTANTIATE_TEST(CPLEX_milp, LpModelTest, cplex_milp_test);
+INSTANTIATE_TEST(CPLEX_milp, PartialSolutionTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, MilpModelTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, ReadableObjectiveTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, ModifiableObjectiveTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, ReadableVariablesBoundsTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, ModifiableVariablesBoundsTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, NamedVariablesTest, cplex_milp_test);
+INSTANTIATE_TEST(CPLEX_milp, CloneTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, AddColumnTest, cplex_milp_test);
+INSTANTIATE_TEST(CPLEX_milp, ConstraintsBatchTest, cplex_milp_test);
+INSTANTIATE_TEST(CPLEX_milp, ModificationsBatchTest, cplex_milp_test);
+INSTANTIATE_TEST(CPLEX_milp, ParallelConstraintsTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, RemoveVariableTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, ReadableConstraintsTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, SudokuTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, CandidateSolutionCallbackTest, cplex_milp_test);
+INSTANTIATE_TEST(CPLEX_milp, NodeRelaxationCallbackTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, TravellingSalesmanTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, TimeLimitTest, cplex_milp_test);
 INSTANTIATE_TEST(CPLEX_milp, MipStartTest, cplex_milp_test);
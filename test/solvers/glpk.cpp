@@ -8,14 +8,17 @@ struct glpk_lp_test : public model_test<glpk_api, glpk_lp> {
     static void SetUpTestSuite() { construct_api("GLPK"); }
 };
 INSTANTIATE_TEST(GLPK_lp, LpModelTest, glpk_lp_test);
+INSTANTIATE_TEST(GLPK_lp, PartialSolutionTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, ReadableObjectiveTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, ModifiableObjectiveTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, ReadableVariablesBoundsTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, ModifiableVariablesBoundsTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, NamedVariablesTest, glpk_lp_test);
+INSTANTIATE_TEST(GLPK_lp, CloneTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, AddColumnTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, DualSolutionTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, ReducedCostsTest, glpk_lp_test);
+INSTANTIATE_TEST(GLPK_lp, LpBasisTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, LpStatusTest, glpk_lp_test);
 INSTANTIATE_TEST(GLPK_lp, CuttingStockTest, glpk_lp_test);
 
@@ -23,10 +26,12 @@ struct glpk_milp_test : public model_test<glpk_api, glpk_milp> {
     static void SetUpTestSuite() { construct_api("GLPK"); }
 };
 INSTANTIATE_TEST(GLPK_milp, LpModelTest, glpk_milp_test);
+INSTANTIATE_TEST(GLPK_milp, PartialSolutionTest, glpk_milp_test);
 INSTANTIATE_TEST(GLPK_milp, MilpModelTest, glpk_milp_test);
 INSTANTIATE_TEST(GLPK_milp, ReadableObjectiveTest, glpk_milp_test);
 INSTANTIATE_TEST(GLPK_milp, ModifiableObjectiveTest, glpk_milp_test);
 INSTANTIATE_TEST(GLPK_milp, ReadableVariablesBoundsTest, glpk_milp_test);
 INSTANTIATE_TEST(GLPK_milp, ModifiableVariablesBoundsTest, glpk_milp_test);
 INSTANTIATE_TEST(GLPK_milp, NamedVariablesTest, glpk_milp_test);
+INSTANTIATE_TEST(GLPK_milp, CloneTest, glpk_milp_test);
 INSTANTIATE_TEST(GLPK_milp, AddColumnTest, glpk_milp_test);
@@ -8,17 +8,23 @@ struct gurobi_lp_test : public model_test<gurobi_api, gurobi_lp> {
     static void SetUpTestSuite() { construct_api("GUROBI"); }
 };
 INSTANTIATE_TEST(Gurobi_lp, LpModelTest, gurobi_lp_test);
+INSTANTIATE_TEST(Gurobi_lp, PartialSolutionTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, ReadableObjectiveTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, ModifiableObjectiveTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, ReadableVariablesBoundsTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, ModifiableVariablesBoundsTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, NamedVariablesTest, gurobi_lp_test);
+INSTANTIATE_TEST(Gurobi_lp, CloneTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, AddColumnTest, gurobi_lp_test);
+INSTANTIATE_TEST(Gurobi_lp, ConstraintsBatchTest, gurobi_lp_test);
+INSTANTIATE_TEST(Gurobi_lp, ModificationsBatchTest, gurobi_lp_test);
+INSTANTIATE_TEST(Gurobi_lp, ParallelConstraintsTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, RemoveVariableTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, ReadableConstraintsTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, LpStatusTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, DualSolutionTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, ReducedCostsTest, gurobi_lp_test);
+INSTANTIATE_TEST(Gurobi_lp, LpBasisTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, CuttingStockTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, ColumnManagerTest, gurobi_lp_test);
 INSTANTIATE_TEST(Gurobi_lp, LpFuzzyTest, gurobi_lp_test);
@@ -27,17 +33,23 @@ struct gurobi_milp_test : public model_test<gurobi_api, gurobi_milp> {
     static void SetUpTestSuite() { construct_api("GUROBI"); }
 };
 INSTANTIATE_TEST(Gurobi_milp, LpModelTest, gurobi_milp_test);
+INSTANTIATE_TEST(Gurobi_milp, PartialSolutionTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, MilpModelTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, ReadableObjectiveTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, ModifiableObjectiveTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, ReadableVariablesBoundsTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, ModifiableVariablesBoundsTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, NamedVariablesTest, gurobi_milp_test);
+INSTANTIATE_TEST(Gurobi_milp, CloneTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, AddColumnTest, gurobi_milp_test);
+INSTANTIATE_TEST(Gurobi_milp, ConstraintsBatchTest, gurobi_milp_test);
+INSTANTIATE_TEST(Gurobi_milp, ModificationsBatchTest, gurobi_milp_test);
+INSTANTIATE_TEST(Gurobi_milp, ParallelConstraintsTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, RemoveVariableTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, ReadableConstraintsTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, SudokuTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, CandidateSolutionCallbackTest, gurobi_milp_test);
+INSTANTIATE_TEST(Gurobi_milp, NodeRelaxationCallbackTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, TravellingSalesmanTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, TimeLimitTest, gurobi_milp_test);
 INSTANTIATE_TEST(Gurobi_milp, MipStartTest, gurobi_milp_test);
@@ -8,16 +8,23 @@ struct highs_lp_test : public model_test<highs_api, highs_lp> {
     static void SetUpTestSuite() { construct_api("HIGHS"); }
 };
 INSTANTIATE_TEST(HiGHS_lp, LpModelTest, highs_lp_test);
+INSTANTIATE_TEST(HiGHS_lp, PartialSolutionTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, ReadableObjectiveTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, ModifiableObjectiveTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, ReadableVariablesBoundsTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, ModifiableVariablesBoundsTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, NamedVariablesTest, highs_lp_test);
+INSTANTIATE_TEST(HiGHS_lp, CloneTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, AddColumnTest, highs_lp_test);
+INSTANTIATE_TEST(HiGHS_lp, ConstraintsBatchTest, highs_lp_test);
+INSTANTIATE_TEST(HiGHS_lp, ModificationsBatchTest, highs_lp_test);
+INSTANTIATE_TEST(HiGHS_lp, ParallelConstraintsTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, RemoveVariableTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, ReadableConstraintsTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, DualSolutionTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, ReducedCostsTest, highs_lp_test);
+INSTANTIATE_TEST(HiGHS_lp, LpBasisTest, highs_lp_test);
+INSTANTIATE_TEST(HiGHS_lp, SolutionHintTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, LpStatusTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, CuttingStockTest, highs_lp_test);
 INSTANTIATE_TEST(HiGHS_lp, ColumnManagerTest, highs_lp_test);
@@ -27,15 +34,21 @@ struct highs_milp_test : public model_test<highs_api, highs_milp> {
     static void SetUpTestSuite() { construct_api("HIGHS"); }
 };
 INSTANTIATE_TEST(HiGHS_milp, LpModelTest, highs_milp_test);
+INSTANTIATE_TEST(HiGHS_milp, PartialSolutionTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, MilpModelTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, ReadableObjectiveTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, ModifiableObjectiveTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, ReadableVariablesBoundsTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, ModifiableVariablesBoundsTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, NamedVariablesTest, highs_milp_test);
+INSTANTIATE_TEST(HiGHS_milp, CloneTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, AddColumnTest, highs_milp_test);
+INSTANTIATE_TEST(HiGHS_milp, ConstraintsBatchTest, highs_milp_test);
+INSTANTIATE_TEST(HiGHS_milp, ModificationsBatchTest, highs_milp_test);
+INSTANTIATE_TEST(HiGHS_milp, ParallelConstraintsTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, RemoveVariableTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, ReadableConstraintsTest, highs_milp_test);
+INSTANTIATE_TEST(HiGHS_milp, SolutionHintTest, highs_milp_test);
 INSTANTIATE_TEST(HiGHS_milp, SudokuTest, highs_milp_test);
 // INSTANTIATE_TEST(HiGHS_milp, MipStartTest, highs_milp_test);
 
@@ -43,13 +56,18 @@ struct highs_qp_test : public model_test<highs_api, highs_qp> {
     static void SetUpTestSuite() { construct_api("HIGHS"); }
 };
 INSTANTIATE_TEST(HiGHS_qp, LpModelTest, highs_qp_test);
+INSTANTIATE_TEST(HiGHS_qp, PartialSolutionTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, QpModelTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, ReadableObjectiveTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, ModifiableObjectiveTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, ReadableVariablesBoundsTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, ModifiableVariablesBoundsTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, NamedVariablesTest, highs_qp_test);
+INSTANTIATE_TEST(HiGHS_qp, CloneTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, AddColumnTest, highs_qp_test);
+INSTANTIATE_TEST(HiGHS_qp, ConstraintsBatchTest, highs_qp_test);
+INSTANTIATE_TEST(HiGHS_qp, ModificationsBatchTest, highs_qp_test);
+INSTANTIATE_TEST(HiGHS_qp, ParallelConstraintsTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, RemoveVariableTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, ReadableConstraintsTest, highs_qp_test);
 INSTANTIATE_TEST(HiGHS_qp, DualSolutionTest, highs_qp_test);
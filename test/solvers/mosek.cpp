@@ -8,11 +8,13 @@ struct mosek_lp_test : public model_test<mosek_api, mosek_lp> {
     static void SetUpTestSuite() { construct_api("MOSEK"); }
 };
 INSTANTIATE_TEST(MOSEK_lp, LpModelTest, mosek_lp_test);
+INSTANTIATE_TEST(MOSEK_lp, PartialSolutionTest, mosek_lp_test);
 INSTANTIATE_TEST(MOSEK_lp, ReadableObjectiveTest, mosek_lp_test);
 INSTANTIATE_TEST(MOSEK_lp, ModifiableObjectiveTest, mosek_lp_test);
 INSTANTIATE_TEST(MOSEK_lp, ReadableVariablesBoundsTest, mosek_lp_test);
 INSTANTIATE_TEST(MOSEK_lp, ModifiableVariablesBoundsTest, mosek_lp_test);
 INSTANTIATE_TEST(MOSEK_lp, NamedVariablesTest, mosek_lp_test);
+INSTANTIATE_TEST(MOSEK_lp, CloneTest, mosek_lp_test);
 INSTANTIATE_TEST(MOSEK_lp, AddColumnTest, mosek_lp_test);
 INSTANTIATE_TEST(MOSEK_lp, DualSolutionTest, mosek_lp_test);
 INSTANTIATE_TEST(MOSEK_lp, ReducedCostsTest, mosek_lp_test);
@@ -23,12 +25,14 @@ struct mosek_milp_test : public model_test<mosek_api, mosek_milp> {
     static void SetUpTestSuite() { construct_api("MOSEK"); }
 };
 INSTANTIATE_TEST(MOSEK_milp, LpModelTest, mosek_milp_test);
+INSTANTIATE_TEST(MOSEK_milp, PartialSolutionTest, mosek_milp_test);
 INSTANTIATE_TEST(MOSEK_milp, MilpModelTest, mosek_milp_test);
 INSTANTIATE_TEST(MOSEK_milp, ReadableObjectiveTest, mosek_milp_test);
 INSTANTIATE_TEST(MOSEK_milp, ModifiableObjectiveTest, mosek_milp_test);
 INSTANTIATE_TEST(MOSEK_milp, ReadableVariablesBoundsTest, mosek_milp_test);
 INSTANTIATE_TEST(MOSEK_milp, ModifiableVariablesBoundsTest, mosek_milp_test);
 INSTANTIATE_TEST(MOSEK_milp, NamedVariablesTest, mosek_milp_test);
+INSTANTIATE_TEST(MOSEK_milp, CloneTest, mosek_milp_test);
 INSTANTIATE_TEST(MOSEK_milp, AddColumnTest, mosek_milp_test);
 INSTANTIATE_TEST(MOSEK_milp, SudokuTest, mosek_milp_test);
 // INSTANTIATE_TEST(MOSEK_milp, MipStartTest, mosek_milp_test);
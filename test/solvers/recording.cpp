@@ -0,0 +1,78 @@
+#include "mippp/solvers/recording/all.hpp"
+
+using namespace mippp;
+
+#include "test_suites/all.hpp"
+
+static_assert(lp_model<recording_lp>);
+static_assert(milp_model<recording_milp>);
+static_assert(sized_model<recording_lp>);
+static_assert(has_named_variables<recording_lp>);
+static_assert(has_named_constraints<recording_lp>);
+static_assert(has_readable_objective<recording_lp>);
+static_assert(has_modifiable_objective<recording_lp>);
+static_assert(has_readable_variables_bounds<recording_lp>);
+static_assert(has_modifiable_variables_bounds<recording_lp>);
+static_assert(has_readable_constraints<recording_lp>);
+static_assert(has_modifiable_constraint_lhs<recording_lp>);
+static_assert(has_modifiable_constraint_sense<recording_lp>);
+static_assert(has_modifiable_constraint_rhs<recording_lp>);
+static_assert(has_add_column<recording_lp>);
+static_assert(has_add_columns<recording_lp>);
+static_assert(has_remove_variable<recording_lp>);
+
+// No api to load : only the suites that do not solve are instantiated.
+template <typename Model>
+struct recording_test : public ::testing::Test {
+    using model_type = Model;
+    auto new_model() const { return Model(); }
+    template <typename F>
+    void SkipOnLicenseError(F && f) {
+        f();
+    }
+};
+using recording_lp_test = recording_test<recording_lp>;
+INSTANTIATE_TEST(Recording_lp, ReadableObjectiveTest, recording_lp_test);
+INSTANTIATE_TEST(Recording_lp, ReadableVariablesBoundsTest, recording_lp_test);
+INSTANTIATE_TEST(Recording_lp, NamedVariablesTest, recording_lp_test);
+INSTANTIATE_TEST(Recording_lp, ReadableConstraintsTest, recording_lp_test);
+
+using recording_milp_test = recording_test<recording_milp>;
+INSTANTIATE_TEST(Recording_milp, ReadableObjectiveTest, recording_milp_test);
+INSTANTIATE_TEST(Recording_milp, ReadableConstraintsTest, recording_milp_test);
+
+GTEST_TEST(recording_lp, csr_arrays) {
+    using namespace operators;
+    recording_lp model;
+    auto x = model.add_variables(3);
+    model.add_constraint(x[0] + 2 * x[2] + x[0] <= 4);
+    model.add_constraints(std::views::iota(0, 2),
+                          [&](int i) { return x[i] + x[i + 1] >= i; });
+    auto [begins, indices, values] = model.get_constraints_matrix();
+    ASSERT_EQ_RANGES(begins, std::vector<std::size_t>{0, 2, 4, 6});
+    ASSERT_EQ_RANGES(indices, std::vector<int>{0, 2, 0, 1, 1, 2});
+    ASSERT_EQ_RANGES(values, std::vector<double>{2, 2, 1, 1, 1, 1});
+    ASSERT_EQ(model.num_entries(), 6u);
+}
+
+GTEST_TEST(recording_lp, add_column_and_remove_variables) {
+    using namespace operators;
+    recording_lp model;
+    auto x = model.add_variables(2);
+    auto c1 = model.add_constraint(x[0] + x[1] <= 1);
+    auto c2 = model.add_constraint(x[1] >= 0);
+    auto y = model.add_column({{c2, 3.0}, {c1, 2.0}});
+    ASSERT_LIN_TERMS(model.get_constraint_lhs(c1),
+                     {{x[0], 1.0}, {x[1], 1.0}, {y, 2.0}});
+    ASSERT_LIN_TERMS(model.get_constraint_lhs(c2), {{x[1], 1.0}, {y, 3.0}});
+
+    model.remove_variable(x[1]);
+    ASSERT_EQ(model.num_variables(), 2u);
+    ASSERT_LIN_TERMS(model.get_constraint_lhs(c1), {{x[0], 1.0}, {y, 2.0}});
+    ASSERT_LIN_TERMS(model.get_constraint_lhs(c2), {{y, 3.0}});
+
+    auto z = model.add_column({{c2, 4.0}});
+    ASSERT_EQ(z, x[1]);  // the removed column index is reused
+    ASSERT_LIN_TERMS(model.get_constraint_lhs(c2), {{y, 3.0}, {z, 4.0}});
+    ASSERT_EQ(model.num_entries(), 4u);
+}
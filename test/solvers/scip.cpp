@@ -8,11 +8,14 @@ struct scip_milp_test : public model_test<scip_api, scip_milp> {
     static void SetUpTestSuite() { construct_api("SCIP"); }
 };
 INSTANTIATE_TEST(SCIP, LpModelTest, scip_milp_test);
+INSTANTIATE_TEST(SCIP, PartialSolutionTest, scip_milp_test);
 INSTANTIATE_TEST(SCIP, MilpModelTest, scip_milp_test);
 INSTANTIATE_TEST(SCIP, ReadableObjectiveTest, scip_milp_test);
 INSTANTIATE_TEST(SCIP, ModifiableObjectiveTest, scip_milp_test);
 INSTANTIATE_TEST(SCIP, ReadableVariablesBoundsTest, scip_milp_test);
 INSTANTIATE_TEST(SCIP, ModifiableVariablesBoundsTest, scip_milp_test);
 INSTANTIATE_TEST(SCIP, NamedVariablesTest, scip_milp_test);
+INSTANTIATE_TEST(SCIP, CloneTest, scip_milp_test);
 // INSTANTIATE_TEST(SCIP, CandidateSolutionCallbackTest, scip_milp_test);
+INSTANTIATE_TEST(SCIP, NodeRelaxationCallbackTest, scip_milp_test);
 INSTANTIATE_TEST(SCIP, SudokuTest, scip_milp_test);
@@ -8,14 +8,19 @@ struct xpress_lp_test : public model_test<xpress_api, xpress_lp> {
     static void SetUpTestSuite() { construct_api("XPRESS"); }
 };
 INSTANTIATE_TEST(Xpress_lp, LpModelTest, xpress_lp_test);
+INSTANTIATE_TEST(Xpress_lp, PartialSolutionTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, ReadableObjectiveTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, ModifiableObjectiveTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, ReadableVariablesBoundsTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, ModifiableVariablesBoundsTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, NamedVariablesTest, xpress_lp_test);
+INSTANTIATE_TEST(Xpress_lp, CloneTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, AddColumnTest, xpress_lp_test);
+INSTANTIATE_TEST(Xpress_lp, ConstraintsBatchTest, xpress_lp_test);
+INSTANTIATE_TEST(Xpress_lp, ParallelConstraintsTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, DualSolutionTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, ReducedCostsTest, xpress_lp_test);
+INSTANTIATE_TEST(Xpress_lp, LpBasisTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, LpStatusTest, xpress_lp_test);
 INSTANTIATE_TEST(Xpress_lp, CuttingStockTest, xpress_lp_test);
 
@@ -23,14 +28,19 @@ struct xpress_milp_test : public model_test<xpress_api, xpress_milp> {
     static void SetUpTestSuite() { construct_api("XPRESS"); }
 };
 INSTANTIATE_TEST(Xpress_milp, LpModelTest, xpress_milp_test);
+INSTANTIATE_TEST(Xpress_milp, PartialSolutionTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, MilpModelTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, ReadableObjectiveTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, ModifiableObjectiveTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, ReadableVariablesBoundsTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, ModifiableVariablesBoundsTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, NamedVariablesTest, xpress_milp_test);
+INSTANTIATE_TEST(Xpress_milp, CloneTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, AddColumnTest, xpress_milp_test);
+INSTANTIATE_TEST(Xpress_milp, ConstraintsBatchTest, xpress_milp_test);
+INSTANTIATE_TEST(Xpress_milp, ParallelConstraintsTest, xpress_milp_test);
 // INSTANTIATE_TEST(Xpress_milp, CandidateSolutionCallbackTest, xpress_milp_test);
+INSTANTIATE_TEST(Xpress_milp, NodeRelaxationCallbackTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, SudokuTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, TimeLimitTest, xpress_milp_test);
 INSTANTIATE_TEST(Xpress_milp, MipStartTest, xpress_milp_test);
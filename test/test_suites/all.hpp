@@ -82,10 +82,14 @@ struct model_test : public ::testing::Test {
 };
 
 #include "add_column.hpp"
+#include "bulk_modifications.hpp"
 #include "candidate_solution_callback.hpp"
+#include "clone.hpp"
 #include "column_manager.hpp"
+#include "constraints_batch.hpp"
 #include "cutting_stock.hpp"
 #include "dual_solution.hpp"
+#include "lp_basis.hpp"
 #include "lp_fuzzy_tests.hpp"
 #include "lp_model.hpp"
 #include "lp_status.hpp"
@@ -93,13 +97,18 @@ struct model_test : public ::testing::Test {
 #include "mip_start.hpp"
 #include "modifiable_objective.hpp"
 #include "modifiable_variables_bounds.hpp"
+#include "modifications_batch.hpp"
 #include "named_variables.hpp"
+#include "node_relaxation_callback.hpp"
+#include "parallel_constraints.hpp"
+#include "partial_solution.hpp"
 #include "qp_model.hpp"
 #include "readable_constraints.hpp"
 #include "readable_objective.hpp"
 #include "readable_variables_bounds.hpp"
 #include "reduced_costs.hpp"
 #include "remove_variable.hpp"
+#include "solution_hint.hpp"
 #include "sudoku.hpp"
 #include "time_limit.hpp"
 #include "travelling_salesman.hpp"
\ No newline at end of file
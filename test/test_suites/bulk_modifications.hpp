@@ -0,0 +1,182 @@
+#pragma once
+
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <array>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/model_concepts.hpp"
+
+#include "assert_helper.hpp"
+
+namespace mippp {
+
+template <typename T>
+struct BulkModificationsTest : public T {
+    using typename T::model_type;
+    static_assert(has_bulk_modifications<model_type>);
+};
+
+// the overloads without a range and the views over the arrays of the model,
+// which are not part of has_bulk_modifications
+template <typename T>
+concept has_dense_bulk_modifications =
+    requires(T & model, std::span<const model_scalar_t<T>> s) {
+        model.set_objective_coefficients(s);
+        model.set_variables_bounds(s, s);
+        model.set_constraints_rhs(s);
+        { model.get_objective_coefficients() } -> std::ranges::sized_range;
+        { model.get_variables_lower_bounds() } -> std::ranges::sized_range;
+        { model.get_variables_upper_bounds() } -> std::ranges::sized_range;
+        { model.get_constraints_lower_bounds() } -> std::ranges::sized_range;
+        { model.get_constraints_upper_bounds() } -> std::ranges::sized_range;
+    };
+TYPED_TEST_SUITE_P(BulkModificationsTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(BulkModificationsTest);
+
+TYPED_TEST_P(BulkModificationsTest, set_objective_and_rhs) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        auto c1 = model.add_constraint(2 * x1 + 3 * x2 + x3 <= 1);
+        auto c2 = model.add_constraint(4 * x1 + x2 + 2 * x3 <= 1);
+        auto c3 = model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 <= 1);
+        model.set_maximization();
+        model.set_objective_coefficients(std::array{x3, x1, x2},
+                                         std::vector{3.0, 5.0, 4.0});
+        model.set_constraints_rhs(std::array{c2, c3, c1},
+                                  std::vector{11.0, 8.0, 5.0});
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 13.0, TEST_EPSILON);
+        auto solution = model.get_solution();
+        ASSERT_NEAR(solution[x1], 2.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x2], 0.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x3], 1.0, TEST_EPSILON);
+    });
+}
+TYPED_TEST_P(BulkModificationsTest, rhs_keeps_senses) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x = model.add_variable({.upper_bound = 10});
+        auto c1 = model.add_constraint(x <= 1);
+        auto c2 = model.add_constraint(x >= 0);
+        auto c3 = model.add_constraint(2 * x == 2);
+        model.set_constraints_rhs(std::array{c1, c2, c3},
+                                  std::vector{8.0, 3.0, 8.0});
+        ASSERT_EQ(model.get_constraint_sense(c1), constraint_sense::less_equal);
+        ASSERT_EQ(model.get_constraint_sense(c2),
+                  constraint_sense::greater_equal);
+        ASSERT_EQ(model.get_constraint_sense(c3), constraint_sense::equal);
+        ASSERT_EQ(model.get_constraint_rhs(c1), 8.0);
+        ASSERT_EQ(model.get_constraint_rhs(c2), 3.0);
+        ASSERT_EQ(model.get_constraint_rhs(c3), 8.0);
+        model.set_minimization();
+        model.set_objective(x);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 4.0, TEST_EPSILON);
+    });
+}
+TYPED_TEST_P(BulkModificationsTest, set_variables_bounds) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto X = model.add_variables(4);
+        model.set_variables_bounds(std::array{X[3], X[1]},
+                                   std::vector{-4.0, 1.0},
+                                   std::vector{-2.0, 3.0});
+        ASSERT_EQ(model.get_variable_lower_bound(X[3]), -4.0);
+        ASSERT_EQ(model.get_variable_upper_bound(X[3]), -2.0);
+        ASSERT_EQ(model.get_variable_lower_bound(X[1]), 1.0);
+        ASSERT_EQ(model.get_variable_upper_bound(X[1]), 3.0);
+        ASSERT_EQ(model.get_variable_lower_bound(X[0]), 0.0);
+        model.set_maximization();
+        model.set_objective(X[1] + X[3]);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 1.0, TEST_EPSILON);
+    });
+}
+TYPED_TEST_P(BulkModificationsTest, dense_setters_and_views) {
+    using model_type = typename TypeParam::model_type;
+    if constexpr(has_dense_bulk_modifications<model_type>) {
+        this->SkipOnLicenseError([this]() {
+            using namespace operators;
+            auto model = this->new_model();
+            auto x1 = model.add_variable();
+            auto x2 = model.add_variable();
+            model.add_constraint(x1 + x2 <= 1);
+            model.add_constraint(x1 - x2 >= 0);
+            model.set_maximization();
+            model.set_objective_coefficients(std::vector{2.0, 1.0});
+            model.set_variables_bounds(std::vector{0.0, 0.0},
+                                       std::vector{3.0, 3.0});
+            model.set_constraints_rhs(std::vector{4.0, -1.0});
+            ASSERT_EQ_RANGES(model.get_objective_coefficients(),
+                             std::vector{2.0, 1.0});
+            ASSERT_EQ_RANGES(model.get_variables_lower_bounds(),
+                             std::vector{0.0, 0.0});
+            ASSERT_EQ_RANGES(model.get_variables_upper_bounds(),
+                             std::vector{3.0, 3.0});
+            ASSERT_EQ(model.get_constraints_upper_bounds()[0], 4.0);
+            ASSERT_EQ(model.get_constraints_lower_bounds()[1], -1.0);
+            model.solve();
+            ASSERT_NEAR(model.get_solution_value(), 7.0, TEST_EPSILON);
+            auto solution = model.get_solution();
+            ASSERT_NEAR(solution[x1], 3.0, TEST_EPSILON);
+            ASSERT_NEAR(solution[x2], 1.0, TEST_EPSILON);
+        });
+    }
+}
+TYPED_TEST_P(BulkModificationsTest, sizes_mismatch) {
+    using model_type = typename TypeParam::model_type;
+    this->SkipOnLicenseError([this]() {
+        auto model = this->new_model();
+        auto X = model.add_variables(2);
+        ASSERT_THROW(model.set_objective_coefficients(
+                         std::array{X[0], X[1]}, std::vector{1.0}),
+                     std::invalid_argument);
+        // a range that is not sized is counted while it is walked
+        auto vars = std::array{X[0], X[1]};
+        auto unsized = vars | std::views::filter([](auto &&) { return true; });
+        ASSERT_THROW(
+            model.set_objective_coefficients(unsized, std::vector{1.0}),
+            std::invalid_argument);
+        ASSERT_THROW(model.set_objective_coefficients(
+                         unsized, std::vector{1.0, 2.0, 3.0}),
+                     std::invalid_argument);
+        // no bound is written when a size does not match
+        model.set_variable_lower_bound(X[0], -1.0);
+        model.set_variable_upper_bound(X[0], 1.0);
+        ASSERT_THROW(model.set_variables_bounds(unsized, std::vector{0.0},
+                                                std::vector{2.0}),
+                     std::invalid_argument);
+        ASSERT_THROW(
+            model.set_variables_bounds(std::array{X[0], X[1]},
+                                       std::vector{0.0, 0.0}, std::vector{2.0}),
+            std::invalid_argument);
+        ASSERT_EQ(model.get_variable_lower_bound(X[0]), -1.0);
+        ASSERT_EQ(model.get_variable_upper_bound(X[0]), 1.0);
+        if constexpr(has_dense_bulk_modifications<model_type>) {
+            ASSERT_THROW(model.set_variables_bounds(std::vector{0.0, 0.0},
+                                                    std::vector{1.0}),
+                         std::invalid_argument);
+            ASSERT_THROW(model.set_objective_coefficients(
+                             std::vector{1.0, 2.0, 3.0}),
+                         std::invalid_argument);
+        }
+    });
+}
+
+REGISTER_TYPED_TEST_SUITE_P(BulkModificationsTest, set_objective_and_rhs,
+                            rhs_keeps_senses, set_variables_bounds,
+                            dense_setters_and_views, sizes_mismatch);
+
+}  // namespace mippp
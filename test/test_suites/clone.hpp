@@ -0,0 +1,115 @@
+#pragma once
+
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/model_concepts.hpp"
+
+#include "assert_helper.hpp"
+
+namespace mippp {
+
+template <typename T>
+struct CloneTest : public T {
+    using typename T::model_type;
+    static_assert(has_clone<model_type>);
+};
+TYPED_TEST_SUITE_P(CloneTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(CloneTest);
+
+TYPED_TEST_P(CloneTest, modify_clone) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        model.set_minimization();
+        model.set_objective(5 * x1 + 4 * x2 + 3 * x3);
+        model.add_constraint(2 * x1 + 2 * x2 - x3 >= 5);
+        model.add_constraint(4 * x1 + x2 + 2 * x3 <= 11);
+        model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 == 8);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 12.0, TEST_EPSILON);
+
+        auto copy = model.clone();
+        ASSERT_EQ(copy.num_variables(), 3);
+        ASSERT_EQ(copy.num_constraints(), 3);
+        copy.add_constraint(x2 == 0);
+        ASSERT_EQ(copy.num_constraints(), 4);
+        ASSERT_EQ(model.num_constraints(), 3);
+
+        copy.solve();
+        ASSERT_NEAR(copy.get_solution_value(), 93.0 / 7.0, TEST_EPSILON);
+        {
+            auto solution = copy.get_solution();
+            ASSERT_NEAR(solution[x1], 18.0 / 7.0, TEST_EPSILON);
+            ASSERT_NEAR(solution[x2], 0.0, TEST_EPSILON);
+            ASSERT_NEAR(solution[x3], 1.0 / 7.0, TEST_EPSILON);
+        }
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 12.0, TEST_EPSILON);
+        {
+            auto solution = model.get_solution();
+            ASSERT_NEAR(solution[x1], 2.0, TEST_EPSILON);
+            ASSERT_NEAR(solution[x2], 0.5, TEST_EPSILON);
+            ASSERT_NEAR(solution[x3], 0.0, TEST_EPSILON);
+        }
+    });
+}
+
+TYPED_TEST_P(CloneTest, clone_after_remove) {
+    using namespace operators;
+    using model_type = typename TypeParam::model_type;
+    if constexpr(has_remove_variable<model_type>) {
+        this->SkipOnLicenseError([this]() {
+            auto model = this->new_model();
+            auto x1 = model.add_variable();
+            auto x2 = model.add_variable();
+            auto x3 = model.add_variable();
+            model.set_minimization();
+            model.set_objective(5 * x1 + 4 * x2 + 3 * x3);
+            model.add_constraint(2 * x1 + 2 * x2 - x3 >= 5);
+            model.add_constraint(4 * x1 + x2 + 2 * x3 <= 11);
+            model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 == 8);
+            model.remove_variable(x2);
+
+            auto copy = model.clone();
+            ASSERT_EQ(copy.num_variables(), 2);
+            copy.solve();
+            ASSERT_NEAR(copy.get_solution_value(), 93.0 / 7.0, TEST_EPSILON);
+            {
+                auto solution = copy.get_solution();
+                ASSERT_NEAR(solution[x1], 18.0 / 7.0, TEST_EPSILON);
+                ASSERT_NEAR(solution[x3], 1.0 / 7.0, TEST_EPSILON);
+            }
+        });
+    } else {
+        GTEST_SKIP();
+    }
+}
+
+TYPED_TEST_P(CloneTest, clone_keeps_parameters) {
+    using model_type = typename TypeParam::model_type;
+    if constexpr(has_feasibility_tolerance<model_type>) {
+        this->SkipOnLicenseError([this]() {
+            auto model = this->new_model();
+            model.add_variable();
+            model.set_feasibility_tolerance(1e-5);
+            if constexpr(has_optimality_tolerance<model_type>)
+                model.set_optimality_tolerance(1e-3);
+            auto copy = model.clone();
+            ASSERT_NEAR(copy.get_feasibility_tolerance(), 1e-5, 1e-12);
+            if constexpr(has_optimality_tolerance<model_type>)
+                ASSERT_NEAR(copy.get_optimality_tolerance(), 1e-3, 1e-12);
+        });
+    } else {
+        GTEST_SKIP();
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(CloneTest, modify_clone, clone_after_remove,
+                            clone_keeps_parameters);
+
+}  // namespace mippp
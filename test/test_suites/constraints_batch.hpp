@@ -0,0 +1,90 @@
+#pragma once
+
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+template <typename T>
+struct ConstraintsBatchTest : public T {
+    using typename T::model_type;
+    static_assert(has_constraints_batch<model_type>);
+};
+TYPED_TEST_SUITE_P(ConstraintsBatchTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ConstraintsBatchTest);
+
+TYPED_TEST_P(ConstraintsBatchTest, flush_at_scope_end) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        {
+            auto batch = model.batch_constraints();
+            auto c1 = model.add_constraint(2 * x1 + 3 * x2 + x3 <= 5);
+            auto c2 = model.add_constraint(4 * x1 + x2 + 2 * x3 <= 11);
+            auto c3 = model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 <= 8);
+            ASSERT_EQ(c1.id(), 0);
+            ASSERT_EQ(c2.id(), 1);
+            ASSERT_EQ(c3.id(), 2);
+        }
+        ASSERT_EQ(model.num_constraints(), 3);
+        model.set_maximization();
+        model.set_objective(5 * x1 + 4 * x2 + 3 * x3);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 13.0, TEST_EPSILON);
+        auto solution = model.get_solution();
+        ASSERT_NEAR(solution[x1], 2.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x2], 0.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x3], 1.0, TEST_EPSILON);
+    });
+}
+TYPED_TEST_P(ConstraintsBatchTest, read_forces_flush) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto batch = model.batch_constraints();
+        model.add_constraint(x1 + x2 <= 1);
+        model.add_constraint(x1 - x2 >= 0);
+        ASSERT_EQ(model.num_constraints(), 2);
+        auto c3 = model.add_constraint(x1 + 2 * x2 == 1);
+        ASSERT_EQ(c3.id(), 2);
+        batch.commit();
+        ASSERT_EQ(model.num_constraints(), 3);
+        auto c4 = model.add_constraint(x2 <= 1);
+        ASSERT_EQ(c4.id(), 3);
+        ASSERT_EQ(model.num_constraints(), 4);
+    });
+}
+TYPED_TEST_P(ConstraintsBatchTest, exception_discards_staged_rows) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        model.add_constraint(x1 + x2 <= 1);
+        try {
+            auto batch = model.batch_constraints();
+            model.add_constraint(x1 - x2 >= 0);
+            model.add_constraint(x1 + 2 * x2 == 1);
+            throw std::runtime_error("abort batch");
+        } catch(const std::runtime_error &) {
+        }
+        ASSERT_EQ(model.num_constraints(), 1);
+        auto c2 = model.add_constraint(x1 <= 1);
+        ASSERT_EQ(c2.id(), 1);
+    });
+}
+
+REGISTER_TYPED_TEST_SUITE_P(ConstraintsBatchTest, flush_at_scope_end,
+                            read_forces_flush, exception_discards_staged_rows);
+
+}  // namespace mippp
@@ -0,0 +1,139 @@
+#pragma once
+
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <variant>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+template <typename T>
+struct LpBasisTest : public T {
+    using typename T::model_type;
+    static_assert(has_lp_basis_warm_start<model_type>);
+};
+TYPED_TEST_SUITE_P(LpBasisTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(LpBasisTest);
+
+TYPED_TEST_P(LpBasisTest, optimal_basis) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        using namespace basis_status;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        model.set_maximization();
+        model.set_objective(5 * x1 + 4 * x2 + 3 * x3);
+        auto c1 = model.add_constraint(-2 * x1 - 2 * x2 + x3 <= -5);
+        auto c2 = model.add_constraint(4 * x1 + x2 + 2 * x3 <= 11);
+        auto c3 = model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 <= 8);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 13.3333333333, TEST_EPSILON);
+        auto basis = model.get_basis();
+        ASSERT_TRUE(std::holds_alternative<basic>(basis.get_status(x1)));
+        ASSERT_TRUE(std::holds_alternative<nonbasic_at_lower_bound>(
+            basis.get_status(x2)));
+        ASSERT_TRUE(std::holds_alternative<nonbasic_at_lower_bound>(
+            basis.get_status(x3)));
+        ASSERT_TRUE(basis.is_basic(c1));
+        ASSERT_TRUE(basis.is_basic(c2));
+        ASSERT_FALSE(basis.is_basic(c3));
+    });
+}
+TYPED_TEST_P(LpBasisTest, warm_start_after_add_column) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        using namespace basis_status;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        model.set_maximization();
+        model.set_objective(5 * x1 + 4 * x2 + 3 * x3);
+        model.add_constraint(-2 * x1 - 2 * x2 + x3 <= -5);
+        model.add_constraint(4 * x1 + x2 + 2 * x3 <= 11);
+        auto c3 = model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 <= 8);
+        model.solve();
+        auto basis = model.get_basis();
+        auto x4 = model.add_column({{c3, 1.0}}, {.obj_coef = 4.0});
+        auto c4 = model.add_constraint(x4 <= 10);
+        // entities added after the basis was taken are in the slack basis
+        ASSERT_TRUE(std::holds_alternative<nonbasic_at_lower_bound>(
+            basis.get_status(x4)));
+        ASSERT_TRUE(basis.is_basic(c4));
+        model.set_basis(basis);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 14.5, TEST_EPSILON);
+        auto solution = model.get_solution();
+        ASSERT_NEAR(solution[x1], 2.5, TEST_EPSILON);
+        ASSERT_NEAR(solution[x2], 0.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x3], 0.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x4], 0.5, TEST_EPSILON);
+    });
+}
+TYPED_TEST_P(LpBasisTest, warm_start_from_optimal_basis) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        using namespace basis_status;
+        auto model = this->new_model();
+        auto x1 = model.add_variable({.upper_bound = 3});
+        auto x2 = model.add_variable();
+        model.set_maximization();
+        model.set_objective(2 * x1 + x2);
+        model.add_constraint(x1 + x2 <= 4);
+        model.solve();
+        auto basis = model.get_basis();
+        ASSERT_TRUE(std::holds_alternative<nonbasic_at_upper_bound>(
+            basis.get_status(x1)));
+        ASSERT_TRUE(basis.is_basic(x2));
+        model.set_objective(2 * x1 + 3 * x2);
+        model.set_basis(basis);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 12.0, TEST_EPSILON);
+        auto solution = model.get_solution();
+        ASSERT_NEAR(solution[x1], 0.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x2], 4.0, TEST_EPSILON);
+    });
+}
+TYPED_TEST_P(LpBasisTest, warm_start_after_remove_variable) {
+    using model_type = typename TypeParam::model_type;
+    if constexpr(has_remove_variable<model_type>) {
+        this->SkipOnLicenseError([this]() {
+            using namespace operators;
+            using namespace basis_status;
+            auto model = this->new_model();
+            auto x1 = model.add_variable({.upper_bound = 3});
+            auto y = model.add_variable();
+            auto x2 = model.add_variable();
+            model.set_maximization();
+            model.set_objective(2 * x1 + x2);
+            model.add_constraint(x1 + y + x2 <= 4);
+            model.solve();
+            auto basis = model.get_basis();
+            // the removal is still pending when the basis is loaded
+            model.remove_variable(y);
+            model.set_objective(2 * x1 + 3 * x2);
+            model.set_basis(basis);
+            model.solve();
+            ASSERT_NEAR(model.get_solution_value(), 12.0, TEST_EPSILON);
+            auto solution = model.get_solution();
+            ASSERT_NEAR(solution[x1], 0.0, TEST_EPSILON);
+            ASSERT_NEAR(solution[x2], 4.0, TEST_EPSILON);
+            auto new_basis = model.get_basis();
+            ASSERT_TRUE(std::holds_alternative<nonbasic_at_lower_bound>(
+                new_basis.get_status(x1)));
+            ASSERT_TRUE(new_basis.is_basic(x2));
+        });
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(LpBasisTest, optimal_basis,
+                            warm_start_after_add_column,
+                            warm_start_from_optimal_basis,
+                            warm_start_after_remove_variable);
+
+}  // namespace mippp
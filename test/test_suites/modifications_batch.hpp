@@ -0,0 +1,105 @@
+#pragma once
+
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+template <typename T>
+struct ModificationsBatchTest : public T {
+    using typename T::model_type;
+    static_assert(has_modifications_batch<model_type>);
+};
+TYPED_TEST_SUITE_P(ModificationsBatchTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ModificationsBatchTest);
+
+TYPED_TEST_P(ModificationsBatchTest, flush_at_scope_end) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        auto c1 = model.add_constraint(2 * x1 + 3 * x2 + x3 <= 1);
+        auto c2 = model.add_constraint(4 * x1 + x2 + 2 * x3 <= 1);
+        auto c3 = model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 <= 1);
+        model.set_maximization();
+        {
+            auto batch = model.batch_modifications();
+            model.set_objective_coefficient(x1, 5);
+            model.set_objective_coefficient(x2, 4);
+            model.set_objective_coefficient(x3, 3);
+            model.set_constraint_rhs(c1, 5);
+            model.set_constraint_rhs(c2, 11);
+            model.set_constraint_rhs(c3, 8);
+        }
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 13.0, TEST_EPSILON);
+        auto solution = model.get_solution();
+        ASSERT_NEAR(solution[x1], 2.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x2], 0.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x3], 1.0, TEST_EPSILON);
+    });
+}
+TYPED_TEST_P(ModificationsBatchTest, last_write_wins) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto c = model.add_constraint(x1 + x2 <= 4);
+        model.set_maximization();
+        auto batch = model.batch_modifications();
+        model.set_objective_coefficient(x1, 1);
+        model.set_objective_coefficient(x1, 2);
+        ASSERT_EQ(model.get_objective_coefficient(x1), 2);
+        model.set_variable_upper_bound(x1, 5);
+        model.set_variable_upper_bound(x1, 3);
+        model.set_variable_lower_bound(x2, 1);
+        model.set_constraint_rhs(c, 10);
+        model.set_constraint_rhs(c, 6);
+        ASSERT_EQ(model.get_variable_lower_bound(x1), 0);
+        ASSERT_EQ(model.get_variable_upper_bound(x1), 3);
+        ASSERT_EQ(model.get_variable_lower_bound(x2), 1);
+        ASSERT_EQ(model.get_constraint_rhs(c), 6);
+        model.set_objective_coefficient(x2, 1);
+        batch.commit();
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 9.0, TEST_EPSILON);
+        auto solution = model.get_solution();
+        ASSERT_NEAR(solution[x1], 3.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x2], 3.0, TEST_EPSILON);
+    });
+}
+TYPED_TEST_P(ModificationsBatchTest, exception_discards_changes) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x = model.add_variable();
+        auto c = model.add_constraint(x <= 2);
+        model.set_maximization();
+        model.set_objective(1 * x);
+        try {
+            auto batch = model.batch_modifications();
+            model.set_objective_coefficient(x, -1);
+            model.set_variable_upper_bound(x, 1);
+            model.set_constraint_rhs(c, 1);
+            throw std::runtime_error("abort batch");
+        } catch(const std::runtime_error &) {
+        }
+        ASSERT_EQ(model.get_objective_coefficient(x), 1);
+        ASSERT_EQ(model.get_constraint_rhs(c), 2);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 2.0, TEST_EPSILON);
+    });
+}
+
+REGISTER_TYPED_TEST_SUITE_P(ModificationsBatchTest, flush_at_scope_end,
+                            last_write_wins, exception_discards_changes);
+
+}  // namespace mippp
@@ -0,0 +1,63 @@
+#pragma once
+
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+template <typename T>
+struct NodeRelaxationCallbackTest : public T {
+    using typename T::model_type;
+    static_assert(has_node_relaxation_callback<model_type>);
+};
+TYPED_TEST_SUITE_P(NodeRelaxationCallbackTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(NodeRelaxationCallbackTest);
+
+// The stable sets of the 5-cycle : the LP relaxation reaches 3 at x = 0.5,
+// which the odd cycle cut x0 + ... + x4 <= 2 separates. No clique of the
+// cycle has more than 2 vertices, so presolve cannot strengthen the edges
+// into that cut, and the weights are not integral so that the bound 3 is not
+// rounded down. Hence the root relaxation reaches the callback, which must
+// add the cut at least once.
+TYPED_TEST_P(NodeRelaxationCallbackTest, odd_cycle_cut) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x = model.add_binary_variables(5);
+        model.set_maximization();
+        model.set_objective(1.0 * x[0] + 1.1 * x[1] + 1.2 * x[2] +
+                            1.3 * x[3] + 1.4 * x[4]);
+        for(std::size_t i = 0; i < 5; ++i)
+            model.add_constraint(x[i] + x[(i + 1) % 5] <= 1);
+        std::atomic<int> num_calls = 0;
+        std::atomic<int> num_cuts = 0;
+        model.set_node_relaxation_callback([&](auto & handle) {
+            ++num_calls;
+            auto relaxation = handle.get_relaxation_solution();
+            double sum = 0.0;
+            for(std::size_t i = 0; i < 5; ++i) {
+                const auto v = x[i];
+                ASSERT_GE(relaxation[v], -TEST_EPSILON);
+                ASSERT_LE(relaxation[v], 1 + TEST_EPSILON);
+                sum += relaxation[v];
+            }
+            if(sum <= 2 + TEST_EPSILON) return;
+            handle.add_cut(x[0] + x[1] + x[2] + x[3] + x[4] <= 2);
+            ++num_cuts;
+        });
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 2.6, TEST_EPSILON);
+        ASSERT_GE(num_calls.load(), 1);
+        ASSERT_GE(num_cuts.load(), 1);
+    });
+}
+
+REGISTER_TYPED_TEST_SUITE_P(NodeRelaxationCallbackTest, odd_cycle_cut);
+
+}  // namespace mippp
@@ -0,0 +1,114 @@
+#pragma once
+
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <execution>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/linear_expression.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+template <typename T>
+struct ParallelConstraintsTest : public T {
+    using typename T::model_type;
+    static_assert(lp_model<model_type>);
+};
+TYPED_TEST_SUITE_P(ParallelConstraintsTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ParallelConstraintsTest);
+
+TYPED_TEST_P(ParallelConstraintsTest, optional_lambdas) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        model.set_minimization();
+        model.set_objective(5 * x1 + 4 * x2 + 3 * x3);
+        auto c = model.add_constraints(
+            std::execution::par, std::views::iota(0, 3),
+            [&](int i) { return OPT((i == 0), 2 * x1 + 2 * x2 - x3 >= 5); },
+            [&](int i) { return OPT((i == 1), 4 * x1 + x2 + 2 * x3 <= 11); },
+            [&](int) { return 3 * x1 + 4 * x2 + 2 * x3 == 8; });
+        ASSERT_EQ(model.num_constraints(), 3);
+        ASSERT_EQ(c(0).id(), 0);
+        ASSERT_EQ(c(1).id(), 1);
+        ASSERT_EQ(c(2).id(), 2);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 12.0, TEST_EPSILON);
+        auto solution = model.get_solution();
+        ASSERT_NEAR(solution[x1], 2.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x2], 0.5, TEST_EPSILON);
+        ASSERT_NEAR(solution[x3], 0.0, TEST_EPSILON);
+    });
+}
+TYPED_TEST_P(ParallelConstraintsTest, matches_serial_rows) {
+    using model_type = typename TypeParam::model_type;
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        const int n = 4096;
+        const auto keys = std::views::iota(0, n);
+        const auto build = [&](auto & model, auto &&... policy) {
+            auto x = model.add_variables(static_cast<std::size_t>(n));
+            model.set_maximization();
+            model.set_objective(xsum(keys, [&](int i) { return x[i]; }));
+            // x[i] appears twice : rows must be coalesced in every slice, and
+            // coefficients, senses and rhs differ from a row to the next so
+            // that a reordering or a mixing of rows is noticed
+            return model.add_constraints(
+                policy..., keys,
+                [&](int i) {
+                    return OPT((i % 2 == 0),
+                               x[i] + (i % 3 + 1) * x[(i + 1) % n] + x[i] <=
+                                   i % 5 + 2);
+                },
+                [&](int i) {
+                    return x[i] + (i % 7 + 1) * x[(i + 1) % n] >= -(i % 5);
+                });
+        };
+        auto serial_model = this->new_model();
+        auto serial_rows = build(serial_model);
+        auto parallel_model = this->new_model();
+        auto rows = build(parallel_model, std::execution::par);
+        ASSERT_EQ(parallel_model.num_constraints(),
+                  static_cast<std::size_t>(n));
+        ASSERT_EQ(parallel_model.num_entries(), serial_model.num_entries());
+        ASSERT_EQ(rows(0).id(), 0);
+        ASSERT_EQ(rows(n - 1).id(), n - 1);
+        if constexpr(has_readable_constraints<model_type>) {
+            const auto sorted_terms = [](auto && lhs) {
+                std::vector<std::pair<std::size_t, double>> terms;
+                for(auto && [var, coef] : lhs)
+                    terms.emplace_back(var.uid(), coef);
+                std::ranges::sort(terms);
+                return terms;
+            };
+            for(int i = 0; i < n; ++i) {
+                ASSERT_EQ(
+                    sorted_terms(parallel_model.get_constraint_lhs(rows(i))),
+                    sorted_terms(
+                        serial_model.get_constraint_lhs(serial_rows(i))));
+                ASSERT_EQ(parallel_model.get_constraint_sense(rows(i)),
+                          serial_model.get_constraint_sense(serial_rows(i)));
+                ASSERT_EQ(parallel_model.get_constraint_rhs(rows(i)),
+                          serial_model.get_constraint_rhs(serial_rows(i)));
+            }
+        }
+        serial_model.solve();
+        parallel_model.solve();
+        ASSERT_NEAR(parallel_model.get_solution_value(),
+                    serial_model.get_solution_value(), TEST_EPSILON);
+    });
+}
+
+REGISTER_TYPED_TEST_SUITE_P(ParallelConstraintsTest, optional_lambdas,
+                            matches_serial_rows);
+
+}  // namespace mippp
@@ -0,0 +1,76 @@
+#pragma once
+
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+template <typename T>
+struct PartialSolutionTest : public T {
+    using typename T::model_type;
+    static_assert(has_partial_solution<model_type>);
+};
+TYPED_TEST_SUITE_P(PartialSolutionTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(PartialSolutionTest);
+
+TYPED_TEST_P(PartialSolutionTest, subset_in_range_order) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        model.set_maximization();
+        model.set_objective(5 * x1 + 4 * x2 + 3 * x3);
+        model.add_constraint(2 * x1 + 3 * x2 + x3 <= 5);
+        model.add_constraint(4 * x1 + x2 + 2 * x3 <= 11);
+        model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 <= 8);
+        model.solve();
+        // before any full fetch : only the requested columns are read
+        const std::vector vars = {x3, x1};
+        auto values = model.get_solution(vars);
+        ASSERT_EQ(values.size(), 2);
+        ASSERT_NEAR(values[0], 1.0, TEST_EPSILON);
+        ASSERT_NEAR(values[1], 2.0, TEST_EPSILON);
+        // after a full fetch : read from the cached solution
+        auto solution = model.get_solution();
+        ASSERT_NEAR(solution[x2], 0.0, TEST_EPSILON);
+        auto cached_values = model.get_solution(vars);
+        ASSERT_NEAR(cached_values[0], 1.0, TEST_EPSILON);
+        ASSERT_NEAR(cached_values[1], 2.0, TEST_EPSILON);
+        ASSERT_TRUE(model.get_solution(std::vector<decltype(x1)>{}).empty());
+    });
+}
+TYPED_TEST_P(PartialSolutionTest, solve_refreshes_cache) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable({.upper_bound = 1});
+        auto x2 = model.add_variable({.upper_bound = 1});
+        model.set_maximization();
+        model.set_objective(2 * x1 + x2);
+        model.add_constraint(x1 + x2 <= 1);
+        model.solve();
+        auto first_solution = model.get_solution();
+        ASSERT_NEAR(first_solution[x1], 1.0, TEST_EPSILON);
+        model.set_objective(x1 + 2 * x2);
+        model.solve();
+        auto second_solution = model.get_solution();
+        ASSERT_NEAR(second_solution[x1], 0.0, TEST_EPSILON);
+        ASSERT_NEAR(second_solution[x2], 1.0, TEST_EPSILON);
+        ASSERT_NEAR(model.get_solution(std::vector{x2})[0], 1.0,
+                    TEST_EPSILON);
+        // a mapping returned before the solve keeps its values
+        ASSERT_NEAR(first_solution[x1], 1.0, TEST_EPSILON);
+    });
+}
+
+REGISTER_TYPED_TEST_SUITE_P(PartialSolutionTest, subset_in_range_order,
+                            solve_refreshes_cache);
+
+}  // namespace mippp
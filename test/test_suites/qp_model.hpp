@@ -50,8 +50,44 @@ TYPED_TEST_P(QpModelTest, set_objective_distinct_variables) {
         EXPECT_NEAR(solution[x2], 1.75, TEST_EPSILON);
     });
 }
+// x1 * x2 and x2 * x1 are the same off-diagonal entry of the Hessian
+TYPED_TEST_P(QpModelTest, cross_terms) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        model.set_minimization();
+        model.set_objective(x1 * x1 + 0.5 * x1 * x2 + x2 * x2 +
+                            0.5 * x2 * x1 - 3 * x1 - 3 * x2);
+        model.solve();
+        EXPECT_NEAR(model.get_solution_value(), -3.0, TEST_EPSILON);
+        auto solution = model.get_solution();
+        EXPECT_NEAR(solution[x1], 1.0, TEST_EPSILON);
+        EXPECT_NEAR(solution[x2], 1.0, TEST_EPSILON);
+    });
+}
+// a square emits each pair of its terms once, so the square of an
+// expression over distinct variables is itself distinct
+TYPED_TEST_P(QpModelTest, set_objective_distinct_square) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        model.set_minimization();
+        model.set_objective(distinct_variables, square(x1 - 2 * x2 + 1));
+        model.add_constraint(x1 + x2 == 5);
+        model.solve();
+        EXPECT_NEAR(model.get_solution_value(), 0.0, TEST_EPSILON);
+        auto solution = model.get_solution();
+        EXPECT_NEAR(solution[x1], 3.0, TEST_EPSILON);
+        EXPECT_NEAR(solution[x2], 2.0, TEST_EPSILON);
+    });
+}
 
 REGISTER_TYPED_TEST_SUITE_P(QpModelTest, test,
-                            set_objective_distinct_variables);
+                            set_objective_distinct_variables, cross_terms,
+                            set_objective_distinct_square);
 
 }  // namespace mippp
\ No newline at end of file
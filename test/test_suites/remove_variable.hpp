@@ -3,6 +3,8 @@
 #undef NDEBUG
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "mippp/linear_constraint.hpp"
 #include "mippp/model_concepts.hpp"
 
@@ -296,10 +298,54 @@ TYPED_TEST_P(RemoveVariableTest, solve_remove_addnamedvar_solve) {
     });
 }
 
+TYPED_TEST_P(RemoveVariableTest, solve_get_remove_addvar_get) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable();
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        model.set_minimization();
+        model.set_objective(5 * x1 + 4 * x2 + 3 * x3);
+        model.add_constraint(2 * x1 + 2 * x2 - x3 >= 5);
+        model.add_constraint(4 * x1 + x2 + 2 * x3 <= 11);
+        model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 == 8);
+        model.solve();
+        {
+            auto solution = model.get_solution();
+            ASSERT_NEAR(solution[x2], 0.5, TEST_EPSILON);
+            ASSERT_NEAR(solution[x3], 0.0, TEST_EPSILON);
+        }
+
+        // x3 moves to the native column of x2 and x4 takes the last one :
+        // the number of columns is the one of the solution read above, which
+        // must not be served for the modified model
+        model.remove_variable(x2);
+        auto x4 = model.add_variable(
+            {.obj_coef = 2, .lower_bound = -1, .upper_bound = std::nullopt});
+        ASSERT_EQ(model.num_variables(), 3);
+
+        model.solve();
+        {
+            auto solution = model.get_solution();
+            ASSERT_NEAR(solution[x1], 18.0 / 7.0, TEST_EPSILON);
+            ASSERT_NEAR(solution[x3], 1.0 / 7.0, TEST_EPSILON);
+            ASSERT_NEAR(solution[x4], -1.0, TEST_EPSILON);
+        }
+        if constexpr(has_partial_solution<decltype(model)>) {
+            const std::vector vars = {x4, x3};
+            auto values = model.get_solution(vars);
+            ASSERT_NEAR(values[0], -1.0, TEST_EPSILON);
+            ASSERT_NEAR(values[1], 1.0 / 7.0, TEST_EPSILON);
+        }
+    });
+}
+
 REGISTER_TYPED_TEST_SUITE_P(RemoveVariableTest, remove_solve,
                             solve_remove_solve, remove_addvar_solve,
                             solve_remove_addvar_solve, remove_addcol_solve,
                             solve_remove_addcol_solve, remove_addnamedvar_solve,
-                            solve_remove_addnamedvar_solve);
+                            solve_remove_addnamedvar_solve,
+                            solve_get_remove_addvar_get);
 
 }  // namespace mippp
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include "mippp/linear_constraint.hpp"
+#include "mippp/model_concepts.hpp"
+
+namespace mippp {
+
+template <typename T>
+struct SolutionHintTest : public T {
+    using typename T::model_type;
+    static_assert(has_solution_hint<model_type>);
+};
+TYPED_TEST_SUITE_P(SolutionHintTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(SolutionHintTest);
+
+TYPED_TEST_P(SolutionHintTest, same_shape_model) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto build = [this]() {
+            auto model = this->new_model();
+            auto x1 = model.add_variable();
+            auto x2 = model.add_variable();
+            auto x3 = model.add_variable();
+            model.set_maximization();
+            model.set_objective(5 * x1 + 4 * x2 + 3 * x3);
+            model.add_constraint(2 * x1 + 3 * x2 + x3 <= 5);
+            model.add_constraint(4 * x1 + x2 + 2 * x3 <= 11);
+            model.add_constraint(3 * x1 + 4 * x2 + 2 * x3 <= 8);
+            return model;
+        };
+        auto model = build();
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 13.0, TEST_EPSILON);
+        auto next_model = build();
+        if constexpr(has_dual_solution<decltype(model)>) {
+            next_model.set_solution_hint(model.get_solution(),
+                                         model.get_dual_solution());
+        } else {
+            next_model.set_solution_hint(model.get_solution());
+        }
+        next_model.solve();
+        ASSERT_NEAR(next_model.get_solution_value(), 13.0, TEST_EPSILON);
+        // the optimum (2, 0, 1) is not degenerate, its hint gives the optimal
+        // basis and the simplex has nothing left to do
+        if constexpr(requires { next_model.get_simplex_iteration_count(); })
+            ASSERT_EQ(next_model.get_simplex_iteration_count(), 0u);
+    });
+}
+TYPED_TEST_P(SolutionHintTest, after_remove_variable) {
+    this->SkipOnLicenseError([this]() {
+        using namespace operators;
+        auto model = this->new_model();
+        auto x1 = model.add_variable({.upper_bound = 3});
+        auto x2 = model.add_variable();
+        auto x3 = model.add_variable();
+        model.set_maximization();
+        model.set_objective(2 * x1 + x2 + x3);
+        model.add_constraint(x1 + x2 + x3 <= 4);
+        model.remove_variable(x2);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 7.0, TEST_EPSILON);
+        auto solution = model.get_solution();
+        ASSERT_NEAR(solution[x1], 3.0, TEST_EPSILON);
+        ASSERT_NEAR(solution[x3], 1.0, TEST_EPSILON);
+        model.set_objective(x1 + 3 * x3);
+        model.set_solution_hint(solution);
+        model.solve();
+        ASSERT_NEAR(model.get_solution_value(), 12.0, TEST_EPSILON);
+        auto new_solution = model.get_solution();
+        ASSERT_NEAR(new_solution[x1], 0.0, TEST_EPSILON);
+        ASSERT_NEAR(new_solution[x3], 4.0, TEST_EPSILON);
+    });
+}
+
+REGISTER_TYPED_TEST_SUITE_P(SolutionHintTest, same_shape_model,
+                            after_remove_variable);
+
+}  // namespace mippp
@@ -0,0 +1,71 @@
+#undef NDEBUG
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "mippp/detail/triangular_hessian.hpp"
+
+using namespace mippp;
+
+namespace {
+
+template <typename S>
+std::vector<typename S::value_type> to_vector(S && s) {
+    return {s.begin(), s.end()};
+}
+
+}  // namespace
+
+GTEST_TEST(triangular_hessian, lower_triangle_csc) {
+    detail::triangular_hessian<int, double> hessian;
+    hessian.add_term(2, 2, 1.0);
+    hessian.add_term(0, 2, 3.0);
+    hessian.add_term(1, 0, 4.0);
+    hessian.add_term(0, 0, 5.0);
+    hessian.build(3);
+    ASSERT_EQ(hessian.num_entries(), 4u);
+    ASSERT_EQ(to_vector(hessian.begins()), (std::vector<int>{0, 3, 3, 4}));
+    ASSERT_EQ(to_vector(hessian.indices()), (std::vector<int>{0, 1, 2, 2}));
+    ASSERT_EQ(to_vector(hessian.values()),
+              (std::vector<double>{10.0, 4.0, 3.0, 2.0}));
+}
+
+GTEST_TEST(triangular_hessian, merge_duplicates) {
+    detail::triangular_hessian<int, double> hessian;
+    hessian.add_term(1, 0, 1.0);
+    hessian.add_term(1, 1, 1.0);
+    hessian.add_term(0, 1, 2.0);
+    hessian.add_term(1, 1, 0.5);
+    hessian.build(2);
+    ASSERT_EQ(to_vector(hessian.begins()), (std::vector<int>{0, 1, 2}));
+    ASSERT_EQ(to_vector(hessian.indices()), (std::vector<int>{1, 1}));
+    ASSERT_EQ(to_vector(hessian.values()), (std::vector<double>{3.0, 3.0}));
+}
+
+GTEST_TEST(triangular_hessian, distinct) {
+    detail::triangular_hessian<int, double> hessian;
+    hessian.add_term(3, 1, 1.0);
+    hessian.add_term(0, 0, 1.0);
+    hessian.add_term(1, 1, 2.0);
+    hessian.build<true>(4);
+    ASSERT_EQ(to_vector(hessian.begins()), (std::vector<int>{0, 1, 3, 3, 3}));
+    ASSERT_EQ(to_vector(hessian.indices()), (std::vector<int>{0, 1, 3}));
+    ASSERT_EQ(to_vector(hessian.values()),
+              (std::vector<double>{2.0, 4.0, 1.0}));
+}
+
+GTEST_TEST(triangular_hessian, rebuild) {
+    detail::triangular_hessian<int, double> hessian;
+    hessian.add_term(0, 1, 1.0);
+    hessian.build(2);
+    hessian.clear();
+    hessian.build(3);
+    ASSERT_EQ(hessian.num_entries(), 0u);
+    ASSERT_EQ(to_vector(hessian.begins()), (std::vector<int>{0, 0, 0, 0}));
+    hessian.clear();
+    hessian.add_term(2, 0, 1.5);
+    hessian.build(3);
+    ASSERT_EQ(to_vector(hessian.begins()), (std::vector<int>{0, 1, 1, 1}));
+    ASSERT_EQ(to_vector(hessian.indices()), (std::vector<int>{2}));
+    ASSERT_EQ(to_vector(hessian.values()), (std::vector<double>{1.5}));
+}
@@ -381,6 +381,23 @@ GTEST_TEST(unordered_dense_map, reserve_preserves_lookup) {
     ASSERT_EQ(m.at(2), 20);
 }
 
+// enough keys to grow the index several times, with keys sharing their low
+// bits, then enough erasures and insertions to fill it with deleted slots
+GTEST_TEST(unordered_dense_map, growth_and_erase_churn) {
+    map_t m;
+    for(int i = 0; i < 5000; ++i) m[i * 1024] = i;
+    ASSERT_EQ(m.size(), 5000u);
+    for(int i = 0; i < 5000; ++i) ASSERT_EQ(m.at(i * 1024), i);
+    for(int round = 0; round < 20; ++round) {
+        for(int i = 0; i < 5000; i += 2) ASSERT_EQ(m.erase(i * 1024), 1u);
+        for(int i = 0; i < 5000; i += 2) m[i * 1024] = i + round;
+    }
+    ASSERT_EQ(m.size(), 5000u);
+    for(int i = 0; i < 5000; ++i)
+        ASSERT_EQ(m.at(i * 1024), i % 2 == 0 ? i + 19 : i);
+    ASSERT_FALSE(m.contains(1));
+}
+
 GTEST_TEST(unordered_dense_map, dense_iteration_visits_all) {
     map_t m{{1, 10}, {2, 20}, {3, 30}};
     long sum_k = 0, sum_v = 0;
@@ -410,6 +427,20 @@ GTEST_TEST(unordered_dense_map, iterator_mutates_value) {
     ASSERT_EQ(m.at(1), 42);
 }
 
+GTEST_TEST(unordered_dense_map, prehashed_overloads) {
+    map_t m{{1, 10}};
+    const std::size_t h2 = map_t::hash_of(2);
+    ASSERT_TRUE(m.contains(1, map_t::hash_of(1)));
+    ASSERT_FALSE(m.contains(2, h2));
+    auto [it, inserted] = m.try_emplace_hashed(h2, 2, 20);
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(it->second, 20);
+    ASSERT_FALSE(m.try_emplace_hashed(h2, 2, 30).second);
+    ASSERT_EQ(m.at(2), 20);  // same index as the plain overloads
+    ASSERT_EQ(m.erase(2), 1u);
+    ASSERT_FALSE(m.contains(2, h2));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////// Move-only mapped types are supported ////////////////////
 ///////////////////////////////////////////////////////////////////////////////